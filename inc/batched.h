@@ -0,0 +1,604 @@
+#ifndef __BATCHED_H__
+#define __BATCHED_H__
+/**
+ * \file batched.h
+ * \brief definitions for batched small-matrix factorizations
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <algorithm>
+#include <common.h>
+#include <simd.h>
+#include <damm_memory.h>
+#include <omp.h>
+
+/**
+ * \brief Batched small-matrix factorizations.
+ *
+ * \note
+ * A single 8×8 or 16×16 factorization cannot fill a SIMD register: the row
+ * segments shrink below the register width after a few elimination steps and
+ * the work falls into scalar tails. The batched routines instead vectorize
+ * across matrices. Each SIMD lane holds a different matrix, so one instruction
+ * advances S::elements<T>() factorizations at once and every step of the
+ * algorithm runs at full register width regardless of N.
+ *
+ * \note
+ * Interleaved layout: a batch of `count` M×N matrices is stored as an
+ * (M·N)×count matrix X where X[i·N + j][b] holds element (i, j) of matrix b.
+ * A register load from row i·N + j therefore gathers the same element of
+ * consecutive matrices. Use interleave() and deinterleave() to convert from
+ * and to per-matrix storage.
+ *
+ * \note
+ * Batches whose count is not a multiple of the register width are completed by
+ * padding the trailing lanes with identity matrices.
+ */
+namespace damm
+{
+namespace batch
+{
+	/**
+	 * \brief Convert a batch of per-matrix storage to the interleaved layout.
+	 *
+	 * \param A      Array of `count` matrices, each M×N
+	 * \param X      Output interleaved batch, (M·N)×count
+	 * \param M      Number of rows of each matrix
+	 * \param N      Number of columns of each matrix
+	 * \param count  Number of matrices in the batch
+	 */
+	template<typename T>
+	inline void
+	interleave(T*** A, T** X, const size_t M, const size_t N, const size_t count)
+	{
+		right<T>("interleave:", std::make_tuple(X, M * N, count));
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < N; ++j)
+				for (size_t b = 0; b < count; ++b)
+					X[i * N + j][b] = A[b][i][j];
+	}
+
+	/**
+	 * \brief Convert an interleaved batch back to per-matrix storage.
+	 *
+	 * \param X      Interleaved batch, (M·N)×count
+	 * \param A      Output array of `count` matrices, each M×N
+	 * \param M      Number of rows of each matrix
+	 * \param N      Number of columns of each matrix
+	 * \param count  Number of matrices in the batch
+	 */
+	template<typename T>
+	inline void
+	deinterleave(T** X, T*** A, const size_t M, const size_t N, const size_t count)
+	{
+		right<T>("deinterleave:", std::make_tuple(X, M * N, count));
+
+		#pragma omp parallel for schedule(static)
+		for (size_t b = 0; b < count; ++b)
+			for (size_t i = 0; i < M; ++i)
+				for (size_t j = 0; j < N; ++j)
+					A[b][i][j] = X[i * N + j][b];
+	}
+
+	/** 
+	 * \brief true if any lane of a select mask register is set.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline __attribute__((always_inline))
+	bool
+	_any(const typename S::template register_t<T> mask)
+	{
+		constexpr size_t W = S::template elements<T>();
+		alignas(S::bytes) T lanes[W];
+		_store<T, S>(lanes, mask);
+		return std::any_of(lanes, lanes + W, [](T x) { return x != T(0); });
+	}
+
+	/** 
+	 * \brief Pad an interleaved batch to a full register of lanes.
+	 *
+	 * Copies the `rem` trailing matrices starting at column `lane` of X into
+	 * a W-lane buffer and fills the unused lanes with identity matrices so
+	 * that they factor without failure.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline auto
+	_pad(T** X, const size_t lane, const size_t rem, const size_t N)
+	{
+		constexpr size_t W = S::template elements<T>();
+		auto Xp = aligned_alloc_2D<T, S::bytes>(N * N, W);
+
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+				for (size_t l = 0; l < W; ++l)
+					Xp[i * N + j][l] = (l < rem) ? X[i * N + j][lane + l] : T(i == j);
+
+		return Xp;
+	}
+
+	/** 
+	 * \brief Copy the first `rem` lanes of a padded buffer back into X.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T>
+	inline void
+	_unpad(T** Xp, T** X, const size_t lane, const size_t rem, const size_t rows)
+	{
+		for (size_t r = 0; r < rows; ++r)
+			std::copy(Xp[r], Xp[r] + rem, &X[r][lane]);
+	}
+
+	namespace tri
+	{
+		/** 
+		 * \brief Lane kernel for batched forward substitution L·y = b.
+		 * Low level function not intended for the public API.
+		 */
+		template<typename T, typename S, bool TR = false>
+		inline __attribute__((always_inline))
+		void
+		_forward_lanes(T** L, T** B, T** Y, const size_t lane, const size_t N, const bool unit_diag)
+		{
+			using register_t = typename S::template register_t<T>;
+
+			for (size_t i = 0; i < N; ++i)
+			{
+				register_t s = _loadu<T, S>(&B[i][lane]);
+
+				for (size_t p = 0; p < i; ++p)
+				{
+					const size_t lp = TR ? p * N + i : i * N + p;
+					s = _fnmadd<T, S>(_loadu<T, S>(&L[lp][lane]), _loadu<T, S>(&Y[p][lane]), s);
+				}
+
+				if (!unit_diag)
+					s = _div<T, S>(s, _loadu<T, S>(&L[i * N + i][lane]));
+
+				_storeu<T, S>(&Y[i][lane], s);
+			}
+		}
+
+		/** 
+		 * \brief Lane kernel for batched backward substitution U·x = y.
+		 *
+		 * TR = true reads the factor transposed, i.e. solves L^T·x = y with a
+		 * lower triangular L, which is the second half of a Cholesky solve.
+		 * Low level function not intended for the public API.
+		 */
+		template<typename T, typename S, bool TR = false>
+		inline __attribute__((always_inline))
+		void
+		_backward_lanes(T** U, T** Y, T** X, const size_t lane, const size_t N, const bool unit_diag)
+		{
+			using register_t = typename S::template register_t<T>;
+
+			for (size_t i = N; i-- > 0; )
+			{
+				register_t s = _loadu<T, S>(&Y[i][lane]);
+
+				for (size_t p = i + 1; p < N; ++p)
+				{
+					const size_t up = TR ? p * N + i : i * N + p;
+					s = _fnmadd<T, S>(_loadu<T, S>(&U[up][lane]), _loadu<T, S>(&X[p][lane]), s);
+				}
+
+				if (!unit_diag)
+					s = _div<T, S>(s, _loadu<T, S>(&U[i * N + i][lane]));
+
+				_storeu<T, S>(&X[i][lane], s);
+			}
+		}
+
+		/** 
+		 * \brief Scalar kernel for a single matrix of a batch (remainder lanes).
+		 * Low level function not intended for the public API.
+		 */
+		template<typename T, bool FORWARD, bool TR = false>
+		inline void
+		_substitution_lane(T** A, T** B, T** X, const size_t b, const size_t N, const bool unit_diag)
+		{
+			for (size_t n = 0; n < N; ++n)
+			{
+				const size_t i = FORWARD ? n : N - 1 - n;
+				T s = B[i][b];
+
+				const size_t p_begin = FORWARD ? 0 : i + 1;
+				const size_t p_end = FORWARD ? i : N;
+				for (size_t p = p_begin; p < p_end; ++p)
+					s -= A[TR ? p * N + i : i * N + p][b] * X[p][b];
+
+				X[i][b] = unit_diag ? s : s / A[i * N + i][b];
+			}
+		}
+
+		/**
+		 * \brief Batched forward substitution. Solves L_b · y_b = b_b for every matrix b.
+		 *
+		 * \tparam T        Scalar type (float or double)
+		 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+		 *
+		 * \param L         Interleaved lower triangular factors, (N·N)×count
+		 * \param B         Interleaved right-hand sides, N×count
+		 * \param Y         Interleaved solutions, N×count (may alias B)
+		 * \param N         Dimension of each system
+		 * \param count     Number of systems in the batch
+		 * \param unit_diag If true, assumes unit diagonal
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		requires (std::is_floating_point_v<T> && !std::is_same_v<S, NONE>)
+		inline void
+		forward_substitution(T** L, T** B, T** Y, const size_t N, const size_t count,
+			const bool unit_diag = false)
+		{
+			right<T>("batch forward substitution:", std::make_tuple(L, N * N, count),
+				std::make_tuple(B, N, count), std::make_tuple(Y, N, count));
+
+			constexpr size_t W = S::template elements<T>();
+			const size_t simd_count = count - (count % W);
+
+			#pragma omp parallel for schedule(static)
+			for (size_t b = 0; b < simd_count; b += W)
+				_forward_lanes<T, S>(L, B, Y, b, N, unit_diag);
+
+			for (size_t b = simd_count; b < count; ++b)
+				_substitution_lane<T, true>(L, B, Y, b, N, unit_diag);
+		}
+
+		/**
+		 * \brief Batched backward substitution. Solves U_b · x_b = y_b for every matrix b.
+		 *
+		 * \tparam T        Scalar type (float or double)
+		 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+		 *
+		 * \param U         Interleaved upper triangular factors, (N·N)×count
+		 * \param Y         Interleaved right-hand sides, N×count
+		 * \param X         Interleaved solutions, N×count (may alias Y)
+		 * \param N         Dimension of each system
+		 * \param count     Number of systems in the batch
+		 * \param unit_diag If true, assumes unit diagonal
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		requires (std::is_floating_point_v<T> && !std::is_same_v<S, NONE>)
+		inline void
+		backward_substitution(T** U, T** Y, T** X, const size_t N, const size_t count,
+			const bool unit_diag = false)
+		{
+			right<T>("batch backward substitution:", std::make_tuple(U, N * N, count),
+				std::make_tuple(Y, N, count), std::make_tuple(X, N, count));
+
+			constexpr size_t W = S::template elements<T>();
+			const size_t simd_count = count - (count % W);
+
+			#pragma omp parallel for schedule(static)
+			for (size_t b = 0; b < simd_count; b += W)
+				_backward_lanes<T, S>(U, Y, X, b, N, unit_diag);
+
+			for (size_t b = simd_count; b < count; ++b)
+				_substitution_lane<T, false>(U, Y, X, b, N, unit_diag);
+		}
+	} // namespace tri
+
+	namespace lu
+	{
+		/** 
+		 * \brief Lane kernel for batched LU decomposition with partial pivoting.
+		 *
+		 * The pivot search keeps a running lane-wise maximum and its row index.
+		 * Because each lane may choose a different pivot row, the row interchange
+		 * is a lane-wise select between row k and every candidate row instead of
+		 * the pointer swap used by lu::decompose.
+		 *
+		 * \param perm  Scratch buffer of N×W elements holding the row permutation
+		 * \return true if no lane encountered a pivot below tolerance
+		 * Low level function not intended for the public API.
+		 */
+		template<typename T, typename S>
+		inline bool
+		_decompose_lanes(T** X, size_t** P, T* perm, const size_t lane, const size_t N)
+		{
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+			constexpr T tolerance = std::is_same_v<T, float> ? 1e-6f : 1e-12;
+
+			const register_t tol = _set1<T, S>(tolerance);
+			const register_t one = _set1<T, S>(T(1));
+			register_t singular = _set1<T, S>(T(0));
+
+			auto at = [&](const size_t i, const size_t j) { return &X[i * N + j][lane]; };
+
+			for (size_t i = 0; i < N; ++i)
+				_store<T, S>(&perm[i * W], _set1<T, S>(T(i)));
+
+			for (size_t k = 0; k < N; ++k)
+			{
+				// Lane-wise pivot search over column k
+				register_t best = _abs<T, S>(_loadu<T, S>(at(k, k)));
+				register_t pivot = _set1<T, S>(T(k));
+
+				for (size_t i = k + 1; i < N; ++i)
+				{
+					const register_t v = _abs<T, S>(_loadu<T, S>(at(i, k)));
+					pivot = _select<T, S, _CMP_GT_OQ>(v, best, _set1<T, S>(T(i)), pivot);
+					best = _max<T, S>(v, best);
+				}
+
+				singular = _select<T, S, _CMP_LT_OQ>(best, tol, one, singular);
+
+				// Lane-wise interchange of row k with the pivot row
+				for (size_t i = k + 1; i < N; ++i)
+				{
+					const register_t r = _set1<T, S>(T(i));
+
+					for (size_t j = 0; j < N; ++j)
+					{
+						const register_t a = _loadu<T, S>(at(k, j));
+						const register_t b = _loadu<T, S>(at(i, j));
+						_storeu<T, S>(at(k, j), _select<T, S, _CMP_EQ_OQ>(pivot, r, b, a));
+						_storeu<T, S>(at(i, j), _select<T, S, _CMP_EQ_OQ>(pivot, r, a, b));
+					}
+
+					const register_t a = _load<T, S>(&perm[k * W]);
+					const register_t b = _load<T, S>(&perm[i * W]);
+					_store<T, S>(&perm[k * W], _select<T, S, _CMP_EQ_OQ>(pivot, r, b, a));
+					_store<T, S>(&perm[i * W], _select<T, S, _CMP_EQ_OQ>(pivot, r, a, b));
+				}
+
+				// Multipliers and rank-1 update of the trailing submatrix
+				const register_t pivot_value = _loadu<T, S>(at(k, k));
+
+				for (size_t i = k + 1; i < N; ++i)
+				{
+					const register_t l = _div<T, S>(_loadu<T, S>(at(i, k)), pivot_value);
+					_storeu<T, S>(at(i, k), l);
+
+					for (size_t j = k + 1; j < N; ++j)
+						_storeu<T, S>(at(i, j), _fnmadd<T, S>(l, _loadu<T, S>(at(k, j)), _loadu<T, S>(at(i, j))));
+				}
+			}
+
+			for (size_t i = 0; i < N; ++i)
+				for (size_t l = 0; l < W; ++l)
+					P[i][lane + l] = static_cast<size_t>(perm[i * W + l]);
+
+			return !_any<T, S>(singular);
+		}
+
+		/**
+		 * \brief Batched LU decomposition with partial pivoting.
+		 *
+		 * Factors every matrix of an interleaved batch in place, P_b·A_b = L_b·U_b,
+		 * with S::elements<T>() factorizations advanced by each instruction.
+		 * The per-matrix result matches lu::decompose: L (unit diagonal, not stored)
+		 * below the diagonal and U on and above it.
+		 *
+		 * \tparam T        Scalar type (float or double)
+		 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+		 *
+		 * \param X         Interleaved batch, (N·N)×count, overwritten with L and U
+		 * \param P         Output interleaved permutations, N×count. P[i][b] is the
+		 *                  original row of matrix b now at row i.
+		 * \param N         Dimension of each matrix
+		 * \param count     Number of matrices in the batch
+		 *
+		 * \return true if every matrix was factored, false if any matrix is singular
+		 *
+		 * \note Unlike lu::decompose the final pivot is checked as well.
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		requires (std::is_floating_point_v<T> && !std::is_same_v<S, NONE>)
+		inline bool
+		decompose(T** X, size_t** P, const size_t N, const size_t count)
+		{
+			right<T>("batch decompose:", std::make_tuple(X, N * N, count));
+			right<size_t>("batch decompose:", std::make_tuple(P, N, count));
+
+			constexpr size_t W = S::template elements<T>();
+			const size_t simd_count = count - (count % W);
+			bool success = true;
+
+			#pragma omp parallel reduction(&&:success)
+			{
+				auto perm = aligned_alloc_1D<T, S::bytes>(N, W);
+
+				#pragma omp for schedule(static)
+				for (size_t b = 0; b < simd_count; b += W)
+					success = _decompose_lanes<T, S>(X, P, perm.get(), b, N) && success;
+			}
+
+			if (const size_t rem = count - simd_count; rem != 0)
+			{
+				auto Xp = _pad<T, S>(X, simd_count, rem, N);
+				auto Pp = aligned_alloc_2D<size_t, S::bytes>(N, W);
+				auto perm = aligned_alloc_1D<T, S::bytes>(N, W);
+
+				success = _decompose_lanes<T, S>(Xp.get(), Pp.get(), perm.get(), 0, N) && success;
+
+				_unpad(Xp.get(), X, simd_count, rem, N * N);
+				_unpad(Pp.get(), P, simd_count, rem, N);
+			}
+
+			return success;
+		}
+
+		/**
+		 * \brief Batched solve A_b · x_b = b_b from batched LU factors.
+		 *
+		 * \param X         Interleaved LU factors from batch::lu::decompose, (N·N)×count
+		 * \param P         Interleaved permutations from batch::lu::decompose, N×count
+		 * \param B         Interleaved right-hand sides, N×count
+		 * \param Y         Interleaved solutions, N×count (must not alias B)
+		 * \param N         Dimension of each system
+		 * \param count     Number of systems in the batch
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		requires (std::is_floating_point_v<T> && !std::is_same_v<S, NONE>)
+		inline void
+		solve(T** X, size_t** P, T** B, T** Y, const size_t N, const size_t count)
+		{
+			right<T>("batch solve:", std::make_tuple(X, N * N, count),
+				std::make_tuple(B, N, count), std::make_tuple(Y, N, count));
+			right<size_t>("batch solve:", std::make_tuple(P, N, count));
+
+			#pragma omp parallel for schedule(static)
+			for (size_t i = 0; i < N; ++i)
+				for (size_t b = 0; b < count; ++b)
+					Y[i][b] = B[P[i][b]][b];
+
+			tri::forward_substitution<T, S>(X, Y, Y, N, count, true);
+			tri::backward_substitution<T, S>(X, Y, Y, N, count, false);
+		}
+	} // namespace lu
+
+	namespace cholesky
+	{
+		/** 
+		 * \brief Lane kernel for batched Cholesky-Banachiewicz decomposition.
+		 * \return true if every lane is positive definite
+		 * Low level function not intended for the public API.
+		 */
+		template<typename T, typename S>
+		inline bool
+		_decompose_lanes(T** X, const size_t lane, const size_t N)
+		{
+			using register_t = typename S::template register_t<T>;
+
+			const register_t zero = _set1<T, S>(T(0));
+			const register_t one = _set1<T, S>(T(1));
+			register_t indefinite = zero;
+
+			auto at = [&](const size_t i, const size_t j) { return &X[i * N + j][lane]; };
+
+			for (size_t i = 0; i < N; ++i)
+			{
+				for (size_t j = 0; j < i; ++j)
+				{
+					register_t s = _loadu<T, S>(at(i, j));
+
+					for (size_t p = 0; p < j; ++p)
+						s = _fnmadd<T, S>(_loadu<T, S>(at(i, p)), _loadu<T, S>(at(j, p)), s);
+
+					_storeu<T, S>(at(i, j), _div<T, S>(s, _loadu<T, S>(at(j, j))));
+				}
+
+				register_t d = _loadu<T, S>(at(i, i));
+
+				for (size_t p = 0; p < i; ++p)
+				{
+					const register_t l = _loadu<T, S>(at(i, p));
+					d = _fnmadd<T, S>(l, l, d);
+				}
+
+				indefinite = _select<T, S, _CMP_LE_OQ>(d, zero, one, indefinite);
+				_storeu<T, S>(at(i, i), _sqrt<T, S>(d));
+
+				for (size_t j = i + 1; j < N; ++j)
+					_storeu<T, S>(at(i, j), zero);
+			}
+
+			return !_any<T, S>(indefinite);
+		}
+
+		/**
+		 * \brief Batched Cholesky decomposition (LL^T).
+		 *
+		 * Factors every symmetric positive-definite matrix of an interleaved batch
+		 * in place, A_b = L_b · L_b^T. The per-matrix result matches
+		 * cholesky::decompose: L in the lower triangle, zeros above it.
+		 *
+		 * \tparam T        Scalar type (float or double)
+		 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+		 *
+		 * \param X         Interleaved batch, (N·N)×count, overwritten with L
+		 * \param N         Dimension of each matrix
+		 * \param count     Number of matrices in the batch
+		 *
+		 * \return true if every matrix was factored, false if any matrix is not positive definite
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		requires (std::is_floating_point_v<T> && !std::is_same_v<S, NONE>)
+		inline bool
+		decompose(T** X, const size_t N, const size_t count)
+		{
+			right<T>("batch decompose:", std::make_tuple(X, N * N, count));
+
+			constexpr size_t W = S::template elements<T>();
+			const size_t simd_count = count - (count % W);
+			bool success = true;
+
+			#pragma omp parallel for schedule(static) reduction(&&:success)
+			for (size_t b = 0; b < simd_count; b += W)
+				success = _decompose_lanes<T, S>(X, b, N) && success;
+
+			if (const size_t rem = count - simd_count; rem != 0)
+			{
+				auto Xp = _pad<T, S>(X, simd_count, rem, N);
+				success = _decompose_lanes<T, S>(Xp.get(), 0, N) && success;
+				_unpad(Xp.get(), X, simd_count, rem, N * N);
+			}
+
+			return success;
+		}
+
+		/**
+		 * \brief Batched solve A_b · x_b = b_b from batched Cholesky factors.
+		 *
+		 * \param X         Interleaved factors from batch::cholesky::decompose, (N·N)×count
+		 * \param B         Interleaved right-hand sides, N×count
+		 * \param Y         Interleaved solutions, N×count (may alias B)
+		 * \param N         Dimension of each system
+		 * \param count     Number of systems in the batch
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		requires (std::is_floating_point_v<T> && !std::is_same_v<S, NONE>)
+		inline void
+		solve(T** X, T** B, T** Y, const size_t N, const size_t count)
+		{
+			right<T>("batch solve:", std::make_tuple(X, N * N, count),
+				std::make_tuple(B, N, count), std::make_tuple(Y, N, count));
+
+			constexpr size_t W = S::template elements<T>();
+			const size_t simd_count = count - (count % W);
+
+			#pragma omp parallel for schedule(static)
+			for (size_t b = 0; b < simd_count; b += W)
+			{
+				tri::_forward_lanes<T, S>(X, B, Y, b, N, false);
+				tri::_backward_lanes<T, S, true>(X, Y, Y, b, N, false);
+			}
+
+			for (size_t b = simd_count; b < count; ++b)
+			{
+				tri::_substitution_lane<T, true>(X, B, Y, b, N, false);
+				tri::_substitution_lane<T, false, true>(X, Y, Y, b, N, false);
+			}
+		}
+	} // namespace cholesky
+
+} // namespace batch
+} // namespace damm
+
+#endif //__BATCHED_H__
@@ -0,0 +1,908 @@
+#ifndef __BLAS_H__
+#define __BLAS_H__
+/**
+ * \file blas.h
+ * \brief definitions for level 1 BLAS on raw strided vectors
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <common.h>
+#include <simd.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Level 1 BLAS.
+ *
+ * \note
+ * The matrix operators take T** and reach a vector only through a 1×N view,
+ * which costs a pointer array, the argument checks of a matrix and the tile
+ * loops of a matrix kernel on every call. The routines here take a T* with
+ * a length and a stride, element k of x being x[k·incx], and run one loop.
+ *
+ * \note
+ * Unit stride vectors go through the SIMD dispatch tables, the reductions
+ * with four accumulators. Other strides are plain scalar loops; strides are
+ * positive.
+ *
+ * \note
+ * Vectors shorter than parallel_elements, and calls from inside a parallel
+ * region, run on the calling thread. Longer ones are split into one equal
+ * range per thread. Reductions combine the per thread results in thread
+ * order, so float results can depend on the thread count in the last bits.
+ *
+ * \note
+ * The kernels named with a leading underscore skip the argument checks and
+ * are what the solvers call in their inner loops.
+ */
+namespace damm
+{
+namespace blas
+{
+	/** \brief Below this many elements a call runs on the calling thread */
+	inline constexpr size_t parallel_elements = 32768;
+
+	/**
+	 * \brief Run f(lo, hi) over [0, N), split into one range per thread when N is large.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename F>
+	inline __attribute__((always_inline))
+	void
+	_split(const size_t N, F&& f)
+	{
+		if (N < parallel_elements || omp_in_parallel())
+		{
+			f(size_t(0), N);
+			return;
+		}
+
+		#pragma omp parallel
+		{
+			const size_t t = omp_get_thread_num();
+			const size_t nt = omp_get_num_threads();
+			f(N * t / nt, N * (t + 1) / nt);
+		}
+	}
+
+	/**
+	 * \brief Fold f(lo, hi) over [0, N) with combine, per thread results in thread order.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename R, typename F, typename C>
+	inline __attribute__((always_inline))
+	R
+	_split_reduce(const size_t N, F&& f, C&& combine)
+	{
+		if (N < parallel_elements || omp_in_parallel())
+			return f(size_t(0), N);
+
+		std::vector<R> partial(omp_get_max_threads());
+		size_t used = 0;
+
+		#pragma omp parallel
+		{
+			const size_t t = omp_get_thread_num();
+			const size_t nt = omp_get_num_threads();
+			partial[t] = f(N * t / nt, N * (t + 1) / nt);
+			#pragma omp single
+			used = nt;
+		}
+
+		R r = partial[0];
+		for (size_t t = 1; t < used; ++t)
+			r = combine(r, partial[t]);
+		return r;
+	}
+
+	/**
+	 * \brief Check a strided vector of N elements.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T>
+	inline void
+	_vector_right(const char* id, const T* x, const size_t N, const size_t inc)
+	{
+		if (inc == 0)
+			throw std::invalid_argument(std::string(id) + "stride must be positive");
+		right<T>(id, std::make_tuple(const_cast<T*>(x), size_t(1), (N - 1) * inc + 1));
+	}
+
+	/**
+	 * \brief kernel for Σ x[k]·y[k], k < n, conjugating x when C is set.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S, bool C = false>
+	inline __attribute__((always_inline))
+	T
+	_dot(const T* x, const T* y, const size_t n, const size_t incx = 1, const size_t incy = 1)
+	{
+		T sum = T(0);
+		size_t k = 0;
+
+		if (incx != 1 || incy != 1)
+		{
+			for (; k < n; ++k)
+				sum += (C ? conjugate(x[k * incx]) : x[k * incx]) * y[k * incy];
+			return sum;
+		}
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+
+			register_t acc0 = _set1<T, S>(T(0));
+			register_t acc1 = acc0, acc2 = acc0, acc3 = acc0;
+
+			[[maybe_unused]] register_t conj;
+			if constexpr (C && is_complex_v<T>)
+				conj = _set1<T, S>(T(1, -1));
+
+			auto fetch = [&](const size_t l)
+			{
+				register_t v = _loadu<T, S>(reinterpret_cast<const real_t*>(x + l));
+				if constexpr (C && is_complex_v<T>)
+					v = _mul<real_t, S>(v, conj);
+				return v;
+			};
+			auto load = [&](const size_t l)
+			{
+				return _loadu<T, S>(reinterpret_cast<const real_t*>(y + l));
+			};
+
+			for (; k + 4 * W <= n; k += 4 * W)
+			{
+				acc0 = _fmadd<T, S>(fetch(k), load(k), acc0);
+				acc1 = _fmadd<T, S>(fetch(k + W), load(k + W), acc1);
+				acc2 = _fmadd<T, S>(fetch(k + 2 * W), load(k + 2 * W), acc2);
+				acc3 = _fmadd<T, S>(fetch(k + 3 * W), load(k + 3 * W), acc3);
+			}
+			for (; k + W <= n; k += W)
+				acc0 = _fmadd<T, S>(fetch(k), load(k), acc0);
+
+			sum = _reduce_add<T, S>(_add<real_t, S>(_add<real_t, S>(acc0, acc1), _add<real_t, S>(acc2, acc3)));
+		}
+
+		for (; k < n; ++k)
+			sum += (C ? conjugate(x[k]) : x[k]) * y[k];
+
+		return sum;
+	}
+
+	/**
+	 * \brief kernel for y[k] += a·x[k], k < n.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_axpy(const T a, const T* x, T* y, const size_t n, const size_t incx = 1, const size_t incy = 1)
+	{
+		size_t k = 0;
+
+		if (incx != 1 || incy != 1)
+		{
+			for (; k < n; ++k)
+				y[k * incy] += a * x[k * incx];
+			return;
+		}
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+
+			const register_t va = _set1<T, S>(a);
+
+			for (; k + W <= n; k += W)
+				_storeu<T, S>(reinterpret_cast<real_t*>(y + k),
+					_fmadd<T, S>(va, _loadu<T, S>(reinterpret_cast<const real_t*>(x + k)),
+						_loadu<T, S>(reinterpret_cast<const real_t*>(y + k))));
+		}
+
+		for (; k < n; ++k)
+			y[k] += a * x[k];
+	}
+
+	/**
+	 * \brief kernel for y[k] = a·x[k] + b·y[k], k < n.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_axpby(const T a, const T* x, const T b, T* y, const size_t n, const size_t incx = 1, const size_t incy = 1)
+	{
+		size_t k = 0;
+
+		if (incx != 1 || incy != 1)
+		{
+			for (; k < n; ++k)
+				y[k * incy] = a * x[k * incx] + b * y[k * incy];
+			return;
+		}
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+
+			const register_t va = _set1<T, S>(a);
+			const register_t vb = _set1<T, S>(b);
+
+			for (; k + W <= n; k += W)
+				_storeu<T, S>(reinterpret_cast<real_t*>(y + k),
+					_fmadd<T, S>(va, _loadu<T, S>(reinterpret_cast<const real_t*>(x + k)),
+						_mul<T, S>(vb, _loadu<T, S>(reinterpret_cast<const real_t*>(y + k)))));
+		}
+
+		for (; k < n; ++k)
+			y[k] = a * x[k] + b * y[k];
+	}
+
+	/**
+	 * \brief kernel for x[k] = a·x[k], k < n.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_scal(const T a, T* x, const size_t n, const size_t incx = 1)
+	{
+		size_t k = 0;
+
+		if (incx != 1)
+		{
+			for (; k < n; ++k)
+				x[k * incx] *= a;
+			return;
+		}
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			constexpr size_t W = S::template elements<T>();
+
+			const auto va = _set1<T, S>(a);
+			for (; k + W <= n; k += W)
+				_storeu<T, S>(reinterpret_cast<real_t*>(x + k),
+					_mul<T, S>(va, _loadu<T, S>(reinterpret_cast<const real_t*>(x + k))));
+		}
+
+		// Counting the remainder down bounds the tail for the loop optimizer
+		for (size_t r = n - k; r; --r, ++k)
+			x[k] *= a;
+	}
+
+	/**
+	 * \brief kernel for the O fold of f(v) over the n real components v of x, unit
+	 * stride; g is the register form of f. Complex x is read as 2n reals.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S, typename O, typename F, typename G>
+	inline __attribute__((always_inline))
+	typename base<T>::type
+	_fold_components(const T* x, const size_t n, F&& f, G&& g)
+	{
+		using real_t = typename base<T>::type;
+
+		const real_t* v = reinterpret_cast<const real_t*>(x);
+		const size_t m = n * (is_complex_v<T> ? 2 : 1);
+
+		real_t r = real_t(0);
+		size_t k = 0;
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using register_t = typename S::template register_t<real_t>;
+			constexpr size_t W = S::template elements<real_t>();
+
+			register_t acc0 = _set1<real_t, S>(real_t(0));
+			register_t acc1 = acc0, acc2 = acc0, acc3 = acc0;
+			auto step = [&](const register_t a, const size_t l)
+			{
+				return O{}(a, g(_loadu<real_t, S>(v + l)));
+			};
+
+			for (; k + 4 * W <= m; k += 4 * W)
+			{
+				acc0 = step(acc0, k);
+				acc1 = step(acc1, k + W);
+				acc2 = step(acc2, k + 2 * W);
+				acc3 = step(acc3, k + 3 * W);
+			}
+			for (; k + W <= m; k += W)
+				acc0 = step(acc0, k);
+
+			alignas(S::bytes) real_t lanes[W];
+			_store<real_t, S>(lanes, O{}(O{}(acc0, acc1), O{}(acc2, acc3)));
+			for (size_t l = 0; l < W; ++l)
+				r = O{}(r, lanes[l]);
+		}
+
+		for (size_t q = m - k; q; --q, ++k)
+			r = O{}(r, f(v[k]));
+
+		return r;
+	}
+
+	/**
+	 * \brief Sum and max of two real scalars or two registers of reals, for _fold_components.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename R, typename S>
+	struct _lane_sum
+	{
+		template <typename V>
+		V operator()(const V a, const V b) const
+		{
+			if constexpr (std::is_same_v<V, R>)
+				return a + b;
+			else
+				return _add<R, S>(a, b);
+		}
+	};
+
+	template <typename R, typename S>
+	struct _lane_max
+	{
+		template <typename V>
+		V operator()(const V a, const V b) const
+		{
+			if constexpr (std::is_same_v<V, R>)
+				return std::max(a, b);
+			else
+				return _max<R, S>(a, b);
+		}
+	};
+
+	/**
+	 * \brief kernel for Σ |Re x[k]| + |Im x[k]|, k < n.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	typename base<T>::type
+	_asum(const T* x, const size_t n, const size_t incx = 1)
+	{
+		using real_t = typename base<T>::type;
+
+		if (incx != 1)
+		{
+			real_t r = real_t(0);
+			for (size_t k = 0; k < n; ++k)
+				r += std::abs(std::real(x[k * incx])) + std::abs(std::imag(x[k * incx]));
+			return r;
+		}
+
+		return _fold_components<T, S, _lane_sum<real_t, S>>(x, n,
+			[](const real_t v) { return std::abs(v); },
+			[](const auto v) { return _abs<real_t, S>(v); });
+	}
+
+	/**
+	 * \brief kernel for the largest |Re x[k]| and |Im x[k]|, k < n.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	typename base<T>::type
+	_amax(const T* x, const size_t n, const size_t incx = 1)
+	{
+		using real_t = typename base<T>::type;
+
+		if (incx != 1)
+		{
+			real_t r = real_t(0);
+			for (size_t k = 0; k < n; ++k)
+				r = std::max({r, std::abs(std::real(x[k * incx])), std::abs(std::imag(x[k * incx]))});
+			return r;
+		}
+
+		return _fold_components<T, S, _lane_max<real_t, S>>(x, n,
+			[](const real_t v) { return std::abs(v); },
+			[](const auto v) { return _abs<real_t, S>(v); });
+	}
+
+	/**
+	 * \brief kernel for Σ |x[k]|² / scale², k < n.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	typename base<T>::type
+	_sum_squares(const T* x, const size_t n, const size_t incx, const typename base<T>::type scale)
+	{
+		using real_t = typename base<T>::type;
+
+		const real_t inv = real_t(1) / scale;
+		if (incx != 1)
+		{
+			real_t r = real_t(0);
+			for (size_t k = 0; k < n; ++k)
+				r += std::norm(x[k * incx] * inv);
+			return r;
+		}
+
+		if constexpr (std::is_same_v<S, NONE>)
+			return _fold_components<T, S, _lane_sum<real_t, S>>(x, n,
+				[inv](const real_t v) { return (v * inv) * (v * inv); },
+				[](const auto v) { return v; });
+		else
+		{
+			const auto vinv = _set1<real_t, S>(inv);
+			return _fold_components<T, S, _lane_sum<real_t, S>>(x, n,
+				[inv](const real_t v) { return (v * inv) * (v * inv); },
+				[vinv](const auto v) { const auto s = _mul<real_t, S>(v, vinv); return _mul<real_t, S>(s, s); });
+		}
+	}
+
+	/**
+	 * \brief kernel for x[k], y[k] = c·x[k] + s·y[k], c·y[k] − conj(s)·x[k], k < n.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_rot(T* x, T* y, const typename base<T>::type c, const T s, const size_t n,
+		const size_t incx = 1, const size_t incy = 1)
+	{
+		size_t k = 0;
+		const T sc = conjugate(s);
+
+		if (incx != 1 || incy != 1)
+		{
+			for (; k < n; ++k)
+			{
+				const T a = x[k * incx], b = y[k * incy];
+				x[k * incx] = c * a + s * b;
+				y[k * incy] = c * b - sc * a;
+			}
+			return;
+		}
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+
+			const register_t vc = _set1<real_t, S>(c);
+			const register_t vs = _set1<T, S>(s);
+			const register_t vsc = _set1<T, S>(sc);
+
+			for (; k + W <= n; k += W)
+			{
+				const register_t a = _loadu<T, S>(reinterpret_cast<const real_t*>(x + k));
+				const register_t b = _loadu<T, S>(reinterpret_cast<const real_t*>(y + k));
+				_storeu<T, S>(reinterpret_cast<real_t*>(x + k), _fmadd<T, S>(vs, b, _mul<real_t, S>(vc, a)));
+				_storeu<T, S>(reinterpret_cast<real_t*>(y + k), _fnmadd<T, S>(vsc, a, _mul<real_t, S>(vc, b)));
+			}
+		}
+
+		for (; k < n; ++k)
+		{
+			const T a = x[k], b = y[k];
+			x[k] = c * a + s * b;
+			y[k] = c * b - sc * a;
+		}
+	}
+
+	/**
+	 * \brief Dot product Σ x[k]·y[k].
+	 *
+	 * \tparam T	Element type (float, double, complex variants, int16_t, int32_t or int64_t)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param x		First vector
+	 * \param y		Second vector
+	 * \param N		Number of elements
+	 * \param incx	Stride of x
+	 * \param incy	Stride of y
+	 *
+	 * \throws std::invalid_argument if a stride is zero
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline T
+	dot(const T* x, const T* y, const size_t N, const size_t incx = 1, const size_t incy = 1)
+	{
+		if (N == 0)
+			return T(0);
+
+		_vector_right("dot:", x, N, incx);
+		_vector_right("dot:", y, N, incy);
+
+		return _split_reduce<T>(N, [&](const size_t lo, const size_t hi)
+		{
+			return _dot<T, S>(x + lo * incx, y + lo * incy, hi - lo, incx, incy);
+		}, std::plus<>{});
+	}
+
+	/**
+	 * \brief Conjugated dot product Σ conj(x[k])·y[k]; dot for real T.
+	 *
+	 * \tparam T	Element type (float, double, complex variants, int16_t, int32_t or int64_t)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param x		Conjugated vector
+	 * \param y		Second vector
+	 * \param N		Number of elements
+	 * \param incx	Stride of x
+	 * \param incy	Stride of y
+	 *
+	 * \throws std::invalid_argument if a stride is zero
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline T
+	dotc(const T* x, const T* y, const size_t N, const size_t incx = 1, const size_t incy = 1)
+	{
+		if (N == 0)
+			return T(0);
+
+		_vector_right("dotc:", x, N, incx);
+		_vector_right("dotc:", y, N, incy);
+
+		return _split_reduce<T>(N, [&](const size_t lo, const size_t hi)
+		{
+			return _dot<T, S, true>(x + lo * incx, y + lo * incy, hi - lo, incx, incy);
+		}, std::plus<>{});
+	}
+
+	/**
+	 * \brief y ← a·x + y.
+	 *
+	 * \tparam T	Element type (float, double, complex variants, int16_t, int32_t or int64_t)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param a		Scale of x
+	 * \param x		Input vector
+	 * \param y		Input and output vector
+	 * \param N		Number of elements
+	 * \param incx	Stride of x
+	 * \param incy	Stride of y
+	 *
+	 * \throws std::invalid_argument if a stride is zero
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	axpy(const T a, const T* x, T* y, const size_t N, const size_t incx = 1, const size_t incy = 1)
+	{
+		if (N == 0)
+			return;
+
+		_vector_right("axpy:", x, N, incx);
+		_vector_right("axpy:", y, N, incy);
+
+		_split(N, [&](const size_t lo, const size_t hi)
+		{
+			_axpy<T, S>(a, x + lo * incx, y + lo * incy, hi - lo, incx, incy);
+		});
+	}
+
+	/**
+	 * \brief y ← a·x + b·y.
+	 *
+	 * \tparam T	Element type (float, double, complex variants, int16_t, int32_t or int64_t)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param a		Scale of x
+	 * \param x		Input vector
+	 * \param b		Scale of y
+	 * \param y		Input and output vector
+	 * \param N		Number of elements
+	 * \param incx	Stride of x
+	 * \param incy	Stride of y
+	 *
+	 * \throws std::invalid_argument if a stride is zero
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	axpby(const T a, const T* x, const T b, T* y, const size_t N, const size_t incx = 1, const size_t incy = 1)
+	{
+		if (N == 0)
+			return;
+
+		_vector_right("axpby:", x, N, incx);
+		_vector_right("axpby:", y, N, incy);
+
+		_split(N, [&](const size_t lo, const size_t hi)
+		{
+			_axpby<T, S>(a, x + lo * incx, b, y + lo * incy, hi - lo, incx, incy);
+		});
+	}
+
+	/**
+	 * \brief x ← a·x.
+	 *
+	 * \tparam T	Element type (float, double, complex variants, int16_t, int32_t or int64_t)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param a		Scale
+	 * \param x		Input and output vector
+	 * \param N		Number of elements
+	 * \param incx	Stride of x
+	 *
+	 * \throws std::invalid_argument if the stride is zero
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	scal(const T a, T* x, const size_t N, const size_t incx = 1)
+	{
+		if (N == 0)
+			return;
+
+		_vector_right("scal:", x, N, incx);
+
+		_split(N, [&](const size_t lo, const size_t hi)
+		{
+			_scal<T, S>(a, x + lo * incx, hi - lo, incx);
+		});
+	}
+
+	/**
+	 * \brief Euclidean norm ‖x‖₂.
+	 *
+	 * The sum of squares is first formed unscaled. Only when it overflows or
+	 * falls where squares lose precision is x read again, scaled by its
+	 * largest component, as in the reference nrm2.
+	 *
+	 * \tparam T	Element type (float, double, or complex variants)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param x		Input vector
+	 * \param N		Number of elements
+	 * \param incx	Stride of x
+	 *
+	 * \throws std::invalid_argument if the stride is zero
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	requires std::is_floating_point_v<typename base<T>::type>
+	inline typename base<T>::type
+	nrm2(const T* x, const size_t N, const size_t incx = 1)
+	{
+		using R = typename base<T>::type;
+
+		if (N == 0)
+			return R(0);
+
+		_vector_right("nrm2:", x, N, incx);
+
+		auto sum_squares = [&](const R scale)
+		{
+			return _split_reduce<R>(N, [&](const size_t lo, const size_t hi)
+			{
+				return _sum_squares<T, S>(x + lo * incx, hi - lo, incx, scale);
+			}, std::plus<>{});
+		};
+
+		const R ss = sum_squares(R(1));
+		constexpr R small = std::numeric_limits<R>::min() / std::numeric_limits<R>::epsilon();
+		if (ss >= small && ss <= std::numeric_limits<R>::max())
+			return std::sqrt(ss);
+
+		const R scale = _split_reduce<R>(N, [&](const size_t lo, const size_t hi)
+		{
+			return _amax<T, S>(x + lo * incx, hi - lo, incx);
+		}, [](const R a, const R b) { return std::max(a, b); });
+
+		if (scale == R(0) || !std::isfinite(scale))
+			return scale;
+
+		return scale * std::sqrt(sum_squares(scale));
+	}
+
+	/**
+	 * \brief Sum of magnitudes Σ |Re x[k]| + |Im x[k]|, as in the reference asum.
+	 *
+	 * \tparam T	Element type (float, double, or complex variants)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param x		Input vector
+	 * \param N		Number of elements
+	 * \param incx	Stride of x
+	 *
+	 * \throws std::invalid_argument if the stride is zero
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	requires std::is_floating_point_v<typename base<T>::type>
+	inline typename base<T>::type
+	asum(const T* x, const size_t N, const size_t incx = 1)
+	{
+		using R = typename base<T>::type;
+
+		if (N == 0)
+			return R(0);
+
+		_vector_right("asum:", x, N, incx);
+
+		return _split_reduce<R>(N, [&](const size_t lo, const size_t hi)
+		{
+			return _asum<T, S>(x + lo * incx, hi - lo, incx);
+		}, std::plus<>{});
+	}
+
+	/**
+	 * \brief Index of the first element of largest |Re x[k]| + |Im x[k]|, as in
+	 * the reference iamax but counted from zero.
+	 *
+	 * For real T the largest magnitude is found with SIMD and a second pass,
+	 * which stops at the first match, finds its index. Complex T is one
+	 * scalar pass.
+	 *
+	 * \tparam T	Element type (float, double, or complex variants)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param x		Input vector
+	 * \param N		Number of elements
+	 * \param incx	Stride of x
+	 *
+	 * \return the index, 0 when N is 0
+	 *
+	 * \throws std::invalid_argument if the stride is zero
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	requires std::is_floating_point_v<typename base<T>::type>
+	inline size_t
+	iamax(const T* x, const size_t N, const size_t incx = 1)
+	{
+		using R = typename base<T>::type;
+		using P = std::pair<R, size_t>;
+
+		if (N == 0)
+			return 0;
+
+		_vector_right("iamax:", x, N, incx);
+
+		auto magnitude = [](const T v) { return std::abs(std::real(v)) + std::abs(std::imag(v)); };
+
+		const P best = _split_reduce<P>(N, [&](const size_t lo, const size_t hi)
+		{
+			if constexpr (!is_complex_v<T>)
+			{
+				const R m = _amax<T, S>(x + lo * incx, hi - lo, incx);
+				for (size_t k = lo; k < hi; ++k)
+					if (std::abs(x[k * incx]) == m)
+						return P{m, k};
+			}
+
+			P b{R(-1), lo};
+			for (size_t k = lo; k < hi; ++k)
+				if (magnitude(x[k * incx]) > b.first)
+					b = {magnitude(x[k * incx]), k};
+			return b;
+		}, [](const P& a, const P& b) { return b.first > a.first ? b : a; });
+
+		return best.second;
+	}
+
+	/**
+	 * \brief Plane rotation x, y ← c·x + s·y, c·y − conj(s)·x.
+	 *
+	 * \tparam T	Element type (float, double, or complex variants)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param x		First vector, rotated in place
+	 * \param y		Second vector, rotated in place
+	 * \param c		Cosine, real
+	 * \param s		Sine
+	 * \param N		Number of elements
+	 * \param incx	Stride of x
+	 * \param incy	Stride of y
+	 *
+	 * \throws std::invalid_argument if a stride is zero
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	requires std::is_floating_point_v<typename base<T>::type>
+	inline void
+	rot(T* x, T* y, const typename base<T>::type c, const T s, const size_t N,
+		const size_t incx = 1, const size_t incy = 1)
+	{
+		if (N == 0)
+			return;
+
+		_vector_right("rot:", x, N, incx);
+		_vector_right("rot:", y, N, incy);
+
+		_split(N, [&](const size_t lo, const size_t hi)
+		{
+			_rot<T, S>(x + lo * incx, y + lo * incy, c, s, hi - lo, incx, incy);
+		});
+	}
+
+	/**
+	 * \brief y ← x.
+	 *
+	 * \param x		Input vector
+	 * \param y		Output vector
+	 * \param N		Number of elements
+	 * \param incx	Stride of x
+	 * \param incy	Stride of y
+	 *
+	 * \throws std::invalid_argument if a stride is zero
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	copy(const T* x, T* y, const size_t N, const size_t incx = 1, const size_t incy = 1)
+	{
+		if (N == 0)
+			return;
+
+		_vector_right("copy:", x, N, incx);
+		_vector_right("copy:", y, N, incy);
+
+		_split(N, [&](const size_t lo, const size_t hi)
+		{
+			if (incx == 1 && incy == 1)
+				std::copy(x + lo, x + hi, y + lo);
+			else
+				for (size_t k = lo; k < hi; ++k)
+					y[k * incy] = x[k * incx];
+		});
+	}
+
+	/**
+	 * \brief x ↔ y.
+	 *
+	 * \param x		First vector
+	 * \param y		Second vector
+	 * \param N		Number of elements
+	 * \param incx	Stride of x
+	 * \param incy	Stride of y
+	 *
+	 * \throws std::invalid_argument if a stride is zero
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	swap(T* x, T* y, const size_t N, const size_t incx = 1, const size_t incy = 1)
+	{
+		if (N == 0)
+			return;
+
+		_vector_right("swap:", x, N, incx);
+		_vector_right("swap:", y, N, incy);
+
+		_split(N, [&](const size_t lo, const size_t hi)
+		{
+			if (incx == 1 && incy == 1)
+				std::swap_ranges(x + lo, x + hi, y + lo);
+			else
+				for (size_t k = lo; k < hi; ++k)
+					std::swap(x[k * incx], y[k * incy]);
+		});
+	}
+
+} // namespace blas
+} // namespace damm
+
+#endif //__BLAS_H__
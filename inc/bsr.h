@@ -0,0 +1,374 @@
+#ifndef __BSR_H__
+#define __BSR_H__
+/**
+ * \file bsr.h
+ * \brief definitions for block sparse row matrices
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <common.h>
+#include <simd.h>
+#include <damm_kernels.h>
+#include <damm_memory.h>
+#include <omp.h>
+#include <multiply.h>
+#include <blas.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <stdexcept>
+
+/**
+ * \brief Block sparse row (BSR) matrices.
+ *
+ * An M×N bsr::matrix is divided into dense br×bc blocks, of which only the
+ * nonzero ones are stored. The pattern is kept like CSR over block indices:
+ * the blocks of block row I are row_ptr[I] .. row_ptr[I + 1] - 1, and block b
+ * sits in block column col_idx[b].
+ *
+ * Each block is stored transposed, bc rows of br elements, in one aligned
+ * allocation with a row pointer per block row of the transpose. This is the
+ * operand layout _multiply_block_simd reads its left factor in, so the product
+ * of a block with a dense panel runs on the register-tiled multiply kernel
+ * directly, without the transpose multiply performs on every call.
+ */
+namespace damm
+{
+	namespace bsr
+	{
+		/**
+		 * \brief An M×N block sparse matrix with br×bc blocks.
+		 *
+		 * \tparam T	Element type (float, double, complex<float>, complex<double>)
+		 */
+		template<typename T>
+		class matrix
+		{
+			using storage_t = decltype(aligned_alloc_2D<T, 64>(1, 1));
+			using pattern_t = std::pair<std::vector<size_t>, std::vector<size_t>>;
+
+			size_t M, N, br, bc;
+			std::vector<size_t> rows_ptr;
+			std::vector<size_t> cols_idx;
+			storage_t data;
+
+			/** \brief Check the shape against the block sizes */
+			static void
+			_check_shape(const size_t M, const size_t N, const size_t br, const size_t bc)
+			{
+				if (br == 0 || bc == 0)
+					throw std::invalid_argument("bsr::matrix: block sizes must be positive");
+				if (M == 0 || N == 0 || M % br != 0 || N % bc != 0)
+					throw std::invalid_argument("bsr::matrix: dimensions must be positive multiples of the block sizes");
+			}
+
+			/** \brief Block pattern of the blocks of A with a nonzero element */
+			static pattern_t
+			_pattern(T** A, const size_t M, const size_t N, const size_t br, const size_t bc)
+			{
+				_check_shape(M, N, br, bc);
+				right<T>("bsr::matrix:", std::make_tuple(A, M, N));
+
+				pattern_t pattern{{0}, {}};
+				auto& [row_ptr, col_idx] = pattern;
+				for (size_t I = 0; I < M / br; ++I)
+				{
+					for (size_t J = 0; J < N / bc; ++J)
+					{
+						bool nonzero = false;
+						for (size_t i = 0; i < br && !nonzero; ++i)
+							nonzero = std::any_of(A[I * br + i] + J * bc, A[I * br + i] + (J + 1) * bc,
+								[](const T& a) { return a != T(0); });
+						if (nonzero)
+							col_idx.push_back(J);
+					}
+					row_ptr.push_back(col_idx.size());
+				}
+				return pattern;
+			}
+
+			matrix(const size_t M, const size_t N, const size_t br, const size_t bc, pattern_t&& pattern)
+				: matrix(M, N, br, bc, std::move(pattern.first), std::move(pattern.second))
+			{
+			}
+
+		public:
+			/**
+			 * \brief A matrix with a given block pattern and zero blocks.
+			 *
+			 * \param M         Rows, a multiple of br
+			 * \param N         Columns, a multiple of bc
+			 * \param br        Block rows
+			 * \param bc        Block columns
+			 * \param row_ptr   M/br + 1 nondecreasing offsets into col_idx, from 0
+			 * \param col_idx   Block column of each stored block, below N/bc
+			 *
+			 * \throws std::invalid_argument if the shape or the pattern is malformed
+			 */
+			matrix(const size_t M, const size_t N, const size_t br, const size_t bc,
+				std::vector<size_t> row_ptr, std::vector<size_t> col_idx)
+				: M((_check_shape(M, N, br, bc), M)), N(N), br(br), bc(bc),
+				  rows_ptr(std::move(row_ptr)), cols_idx(std::move(col_idx)),
+				  data(aligned_alloc_2D<T, 64>(std::max<size_t>(cols_idx.size(), 1) * bc, br))
+			{
+				if (rows_ptr.size() != M / br + 1 || rows_ptr.front() != 0 || rows_ptr.back() != cols_idx.size())
+					throw std::invalid_argument("bsr::matrix: row_ptr does not describe col_idx");
+				if (!std::is_sorted(rows_ptr.begin(), rows_ptr.end()))
+					throw std::invalid_argument("bsr::matrix: row_ptr must be nondecreasing");
+				if (std::any_of(cols_idx.begin(), cols_idx.end(), [&](const size_t J) { return J >= N / bc; }))
+					throw std::invalid_argument("bsr::matrix: block column out of range");
+
+				std::fill(data[0], data[0] + std::max<size_t>(cols_idx.size(), 1) * bc * br, T(0));
+			}
+
+			/**
+			 * \brief Compress a dense matrix, keeping the blocks with a nonzero element.
+			 *
+			 * \param A     Dense input, M×N
+			 * \param M     Rows, a multiple of br
+			 * \param N     Columns, a multiple of bc
+			 * \param br    Block rows
+			 * \param bc    Block columns
+			 *
+			 * \throws std::invalid_argument if the shape is not a multiple of the blocks
+			 */
+			matrix(T** A, const size_t M, const size_t N, const size_t br, const size_t bc)
+				: matrix(M, N, br, bc, _pattern(A, M, N, br, bc))
+			{
+				for (size_t I = 0; I < M / br; ++I)
+					for (size_t b = rows_ptr[I]; b < rows_ptr[I + 1]; ++b)
+					{
+						T** Bt = block(b);
+						for (size_t i = 0; i < br; ++i)
+							for (size_t k = 0; k < bc; ++k)
+								Bt[k][i] = A[I * br + i][cols_idx[b] * bc + k];
+					}
+			}
+
+			size_t rows() const { return M; }
+			size_t cols() const { return N; }
+			size_t row_block() const { return br; }
+			size_t col_block() const { return bc; }
+			size_t block_rows() const { return M / br; }
+			size_t nonzero_blocks() const { return cols_idx.size(); }
+			const std::vector<size_t>& row_ptr() const { return rows_ptr; }
+			const std::vector<size_t>& col_idx() const { return cols_idx; }
+
+			/**
+			 * \brief Stored block b in kernel order, bc × br: block(b)[k][i] is
+			 * element (i, k) of the block.
+			 */
+			T** block(const size_t b) const { return data.get() + b * bc; }
+
+			/**
+			 * \brief Expand into the dense M×N matrix A, zeros included.
+			 */
+			void
+			to_dense(T** A) const
+			{
+				right<T>("bsr::to_dense:", std::make_tuple(A, M, N));
+
+				for (size_t i = 0; i < M; ++i)
+					std::fill(A[i], A[i] + N, T(0));
+
+				for (size_t I = 0; I < M / br; ++I)
+					for (size_t b = rows_ptr[I]; b < rows_ptr[I + 1]; ++b)
+					{
+						T** Bt = block(b);
+						for (size_t i = 0; i < br; ++i)
+							for (size_t k = 0; k < bc; ++k)
+								A[I * br + i][cols_idx[b] * bc + k] = Bt[k][i];
+					}
+			}
+		};
+
+		/**
+		 * \brief Accumulate one block times a dense panel into C rows, scalar.
+		 * Low level function not intended for the public API.
+		 */
+		template<typename T>
+		inline __attribute__((always_inline))
+		void
+		_multiply_edge(T** At, T** B, T** C,
+			const size_t r0, const size_t r1, const size_t c0, const size_t c1, const size_t K)
+		{
+			for (size_t i = r0; i < r1; ++i)
+				for (size_t k = 0; k < K; ++k)
+				{
+					const T a = At[k][i];
+					for (size_t j = c0; j < c1; ++j)
+						C[i][j] += a * B[k][j];
+				}
+		}
+
+		/**
+		 * \brief Block rows [I0, I1) of thread t of nt, holding about nnz / nt stored blocks.
+		 * Low level function not intended for the public API.
+		 */
+		inline std::pair<size_t, size_t>
+		_row_range(const std::vector<size_t>& row_ptr, const size_t block_rows, const size_t t, const size_t nt)
+		{
+			const size_t nnz = row_ptr.back();
+
+			// First block row whose blocks start at or after the thread's share
+			auto split = [&](const size_t s)
+			{
+				return size_t(std::lower_bound(row_ptr.begin(), row_ptr.end() - 1, s * nnz / nt) - row_ptr.begin());
+			};
+			return {t == 0 ? 0 : split(t), t + 1 == nt ? block_rows : split(t + 1)};
+		}
+
+		/**
+		 * \brief Block sparse by dense multiplication C += A × B.
+		 *
+		 * Threads own contiguous ranges of block rows holding equal numbers of
+		 * stored blocks, so the work is balanced by nonzeros rather than by rows
+		 * and no two threads write the same row of C. Within a block row the
+		 * columns of B are walked in l3 sized panels, and every stored block is
+		 * applied to its br×bc slice of the panel with _multiply_block_simd; the
+		 * ragged bottom and right edges of a block run scalar.
+		 *
+		 * \tparam T	Element type
+		 * \tparam S	SIMD instruction set (SSE, AVX, AVX512, or NONE)
+		 * \tparam K	Kernel policy
+		 *
+		 * \param A		Block sparse left factor, M×N
+		 * \param B		Dense right factor, N×P
+		 * \param C		Dense output, M×P, accumulated into
+		 * \param P		Columns of B and C
+		 */
+		template<typename T, typename S = decltype(detect_simd()), template<typename, typename> class K = multiply_kernel>
+		inline void
+		multiply(const matrix<T>& A, T** B, T** C, const size_t P)
+		{
+			const size_t M = A.rows();
+			const size_t N = A.cols();
+			const size_t br = A.row_block();
+			const size_t bc = A.col_block();
+
+			right<T>("bsr::multiply:",
+				std::make_tuple(B, N, P),
+				std::make_tuple(C, M, P));
+
+			const std::vector<size_t>& row_ptr = A.row_ptr();
+			const std::vector<size_t>& col_idx = A.col_idx();
+
+			using kernel_t = K<T, S>;
+			using blocking = typename kernel_t::blocking;
+
+			constexpr size_t l3_block = blocking::l3_block;
+			constexpr size_t kernel_rows = kernel_t::kernel_rows();
+			constexpr size_t kernel_cols = kernel_t::kernel_cols();
+
+			const size_t simd_br = std::is_same_v<S, NONE> ? 0 : br - br % kernel_rows;
+			const size_t simd_P = std::is_same_v<S, NONE> ? 0 : P - P % kernel_cols;
+
+			#pragma omp parallel
+			{
+				const auto [I0, I1] = _row_range(row_ptr, A.block_rows(), omp_get_thread_num(), omp_get_num_threads());
+
+				for (size_t I = I0; I < I1; ++I)
+				{
+					T** Cb = C + I * br;
+
+					if constexpr (!std::is_same_v<S, NONE>)
+					{
+						for (size_t j_block = 0; j_block < simd_P; j_block += l3_block)
+						{
+							const size_t j_end = std::min(j_block + l3_block, simd_P);
+
+							for (size_t b = row_ptr[I]; b < row_ptr[I + 1]; ++b)
+							{
+								T** At = A.block(b);
+								T** Bb = B + col_idx[b] * bc;
+
+								for (size_t i = 0; i < simd_br; i += kernel_rows)
+									for (size_t j = j_block; j < j_end; j += kernel_cols)
+										_multiply_block_simd<T, S, K>(At, Bb, Cb, i, j, 0, bc, j);
+							}
+						}
+					}
+
+					for (size_t b = row_ptr[I]; b < row_ptr[I + 1]; ++b)
+					{
+						T** At = A.block(b);
+						T** Bb = B + col_idx[b] * bc;
+
+						_multiply_edge(At, Bb, Cb, 0, simd_br, simd_P, P, bc);
+						_multiply_edge(At, Bb, Cb, simd_br, br, 0, P, bc);
+					}
+				}
+			}
+		}
+
+		/**
+		 * \brief Block sparse matrix-vector multiplication y += A × x.
+		 *
+		 * The transposed storage makes column k of a block a contiguous row of
+		 * br elements, so each block is applied as bc unit stride axpy updates
+		 * of the block's slice of y, y[I·br + i] += x[J·bc + k] · block[k][i].
+		 * Block rows are split over threads as in multiply once the stored
+		 * elements reach blas::parallel_elements.
+		 *
+		 * \tparam T	Element type
+		 * \tparam S	SIMD instruction set (SSE, AVX, AVX512, or NONE)
+		 *
+		 * \param A		Block sparse matrix, M×N
+		 * \param x		Dense input, N
+		 * \param y		Dense output, M, accumulated into
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		inline void
+		multiply_vector(const matrix<T>& A, const T* x, T* y)
+		{
+			const size_t br = A.row_block();
+			const size_t bc = A.col_block();
+
+			right<T>("bsr::multiply_vector:",
+				std::make_tuple(const_cast<T*>(x), size_t(1), A.cols()),
+				std::make_tuple(y, size_t(1), A.rows()));
+
+			const std::vector<size_t>& row_ptr = A.row_ptr();
+			const std::vector<size_t>& col_idx = A.col_idx();
+
+			#pragma omp parallel if(A.nonzero_blocks() * br * bc >= blas::parallel_elements)
+			{
+				const auto [I0, I1] = _row_range(row_ptr, A.block_rows(), omp_get_thread_num(), omp_get_num_threads());
+
+				for (size_t I = I0; I < I1; ++I)
+				{
+					T* yb = y + I * br;
+					for (size_t b = row_ptr[I]; b < row_ptr[I + 1]; ++b)
+					{
+						T** At = A.block(b);
+						const T* xb = x + col_idx[b] * bc;
+						for (size_t k = 0; k < bc; ++k)
+							blas::_axpy<T, S>(xb[k], At[k], yb, br);
+					}
+				}
+			}
+		}
+	} // namespace bsr
+} // namespace damm
+#endif //__BSR_H__
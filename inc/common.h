@@ -48,6 +48,27 @@ namespace damm
 		using type = T;
 	};
 
+	template <typename T>
+	inline constexpr bool is_complex_v = false;
+
+	template <typename T>
+	inline constexpr bool is_complex_v<std::complex<T>> = true;
+
+	/**
+	 \brief Complex conjugate that reduces to the identity for real types.
+
+	 std::conj promotes real arguments to std::complex, which would change the
+	 element type of real matrices. This keeps T unchanged.
+	*/
+	template <typename T>
+	constexpr T conjugate(const T& x)
+	{
+		if constexpr (is_complex_v<T>)
+			return std::conj(x);
+		else
+			return x;
+	}
+
 	//not SFINAE, this assumes the alternative is an stl compliant T, with ::value_type
 	//add SFINAE to this if needed
 	template<typename T>
@@ -0,0 +1,393 @@
+#ifndef __CONVERT_H__
+#define __CONVERT_H__
+/**
+ * \file convert.h
+ * \brief definitions for precision and layout conversion
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <complex>
+#include <algorithm>
+#include <common.h>
+#include <simd.h>
+#include <omp.h>
+
+/**
+ * \brief Precision and layout conversions between matrices.
+ *
+ * convert<Ts, Td> writes B = scale · A with the element type changed from Ts
+ * to Td: double ↔ float, float ↔ half, real → complex (imaginary part zero)
+ * and complex<double> ↔ complex<float>. convert_part extracts the real part,
+ * the imaginary part or the modulus of a complex matrix.
+ *
+ * A conversion streams each element once and has no reuse to block for, so
+ * instead of the two-level tiling of unite the contiguous storage of A and B
+ * is treated as one run, split into fixed chunks across OpenMP threads. This
+ * balances thin shapes such as 1×N as well as square ones. Each chunk is
+ * converted a register at a time with the native conversion instructions
+ * (cvtpd_ps, cvtps_pd, cvtps_ph, cvtph_ps) and a scalar tail.
+ */
+namespace damm
+{
+	/** \brief IEEE-754 binary16 storage type for float ↔ half conversions. */
+	using half = _Float16;
+
+	/**
+	 * \brief Component of a complex matrix selected by convert_part.
+	 */
+	enum class ComplexPart 
+	{
+		REAL,   ///< Re(z)
+		IMAG,   ///< Im(z)
+		ABS     ///< |z| = √(Re(z)² + Im(z)²), without rescaling against overflow
+	};
+
+	/** \brief Elements per chunk handed to one thread. */
+	inline constexpr size_t _convert_chunk = size_t(1) << 14;
+
+	/** \brief Scale type of convert<Ts, Td>: the wider of the two real types. */
+	template <typename Ts, typename Td>
+	using _convert_scale_t = std::conditional_t<
+		(sizeof(typename base<Ts>::type) >= sizeof(typename base<Td>::type)),
+		typename base<Ts>::type, typename base<Td>::type>;
+
+	/** 
+	 * \brief kernel for b[i] = Td(scale · a[i]), i < n.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename Ts, typename Td, typename S>
+	inline __attribute__((always_inline))
+	void
+	_convert_run(const Ts* a, Td* b, const size_t n, const _convert_scale_t<Ts, Td> scale)
+	{
+		size_t i = 0;
+
+		if constexpr (std::is_same_v<S, NONE> && !(is_complex_v<Ts> && is_complex_v<Td>))
+			;
+		else if constexpr (std::is_same_v<Ts, double> && std::is_same_v<Td, float>)
+		{
+			// Scale in double before rounding to float
+			const auto s = _set1<double, S>(scale);
+			constexpr size_t W = S::template elements<double>();
+			if constexpr (std::is_same_v<S, AVX512>)
+				for (; i + W <= n; i += W)
+					_mm256_storeu_ps(b + i, _mm512_cvtpd_ps(_mul<double, S>(_loadu<double, S>(a + i), s)));
+			else if constexpr (std::is_same_v<S, AVX>)
+				for (; i + W <= n; i += W)
+					_mm_storeu_ps(b + i, _mm256_cvtpd_ps(_mul<double, S>(_loadu<double, S>(a + i), s)));
+			else if constexpr (std::is_same_v<S, SSE>)
+				for (; i + W <= n; i += W)
+					_mm_storel_pi(reinterpret_cast<__m64*>(b + i), _mm_cvtpd_ps(_mul<double, S>(_loadu<double, S>(a + i), s)));
+		}
+		else if constexpr (std::is_same_v<Ts, float> && std::is_same_v<Td, double>)
+		{
+			const auto s = _set1<double, S>(scale);
+			constexpr size_t W = S::template elements<double>();
+			if constexpr (std::is_same_v<S, AVX512>)
+				for (; i + W <= n; i += W)
+					_storeu<double, S>(b + i, _mul<double, S>(_mm512_cvtps_pd(_mm256_loadu_ps(a + i)), s));
+			else if constexpr (std::is_same_v<S, AVX>)
+				for (; i + W <= n; i += W)
+					_storeu<double, S>(b + i, _mul<double, S>(_mm256_cvtps_pd(_mm_loadu_ps(a + i)), s));
+			else if constexpr (std::is_same_v<S, SSE>)
+				for (; i + W <= n; i += W)
+					_storeu<double, S>(b + i, _mul<double, S>(_mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(a + i)))), s));
+		}
+		else if constexpr (std::is_same_v<Ts, float> && std::is_same_v<Td, half>)
+		{
+			const auto s = _set1<float, S>(scale);
+			constexpr size_t W = S::template elements<float>();
+			constexpr int round = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+			if constexpr (std::is_same_v<S, AVX512>)
+				for (; i + W <= n; i += W)
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(b + i), _mm512_cvtps_ph(_mul<float, S>(_loadu<float, S>(a + i), s), round));
+			else if constexpr (std::is_same_v<S, AVX>)
+				for (; i + W <= n; i += W)
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), _mm256_cvtps_ph(_mul<float, S>(_loadu<float, S>(a + i), s), round));
+			else if constexpr (std::is_same_v<S, SSE>)
+				for (; i + W <= n; i += W)
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(b + i), _mm_cvtps_ph(_mul<float, S>(_loadu<float, S>(a + i), s), round));
+		}
+		else if constexpr (std::is_same_v<Ts, half> && std::is_same_v<Td, float>)
+		{
+			const auto s = _set1<float, S>(scale);
+			constexpr size_t W = S::template elements<float>();
+			if constexpr (std::is_same_v<S, AVX512>)
+				for (; i + W <= n; i += W)
+					_storeu<float, S>(b + i, _mul<float, S>(_mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i))), s));
+			else if constexpr (std::is_same_v<S, AVX>)
+				for (; i + W <= n; i += W)
+					_storeu<float, S>(b + i, _mul<float, S>(_mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i))), s));
+			else if constexpr (std::is_same_v<S, SSE>)
+				for (; i + W <= n; i += W)
+					_storeu<float, S>(b + i, _mul<float, S>(_mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + i))), s));
+		}
+		else if constexpr (std::is_same_v<Td, std::complex<Ts>>)
+		{
+			// Interleave with zeros: one register of reals fills two registers of complex
+			using R = Ts;
+			const auto s = _set1<R, S>(scale);
+			constexpr size_t W = S::template elements<R>();
+			auto* d = reinterpret_cast<R*>(b);
+			if constexpr (std::is_same_v<S, AVX512>)
+			{
+				constexpr auto even = std::is_same_v<R, float> ? 0x5555 : 0x55;
+				for (; i + W <= n; i += W)
+				{
+					const auto x = _mul<R, S>(_loadu<R, S>(a + i), s);
+					if constexpr (std::is_same_v<R, float>)
+					{
+						_mm512_storeu_ps(d + 2 * i, _mm512_maskz_expand_ps(even, x));
+						_mm512_storeu_ps(d + 2 * i + W, _mm512_maskz_expand_ps(even, _mm512_shuffle_f32x4(x, x, 0xEE)));
+					}
+					else
+					{
+						_mm512_storeu_pd(d + 2 * i, _mm512_maskz_expand_pd(even, x));
+						_mm512_storeu_pd(d + 2 * i + W, _mm512_maskz_expand_pd(even, _mm512_shuffle_f64x2(x, x, 0xEE)));
+					}
+				}
+			}
+			else
+			{
+				const auto zero = _set1<R, S>(R(0));
+				for (; i + W <= n; i += W)
+				{
+					const auto x = _mul<R, S>(_loadu<R, S>(a + i), s);
+					if constexpr (std::is_same_v<S, AVX> && std::is_same_v<R, float>)
+					{
+						const __m256 lo = _mm256_unpacklo_ps(x, zero);
+						const __m256 hi = _mm256_unpackhi_ps(x, zero);
+						_mm256_storeu_ps(d + 2 * i, _mm256_permute2f128_ps(lo, hi, 0x20));
+						_mm256_storeu_ps(d + 2 * i + W, _mm256_permute2f128_ps(lo, hi, 0x31));
+					}
+					else if constexpr (std::is_same_v<S, AVX>)
+					{
+						const __m256d lo = _mm256_unpacklo_pd(x, zero);
+						const __m256d hi = _mm256_unpackhi_pd(x, zero);
+						_mm256_storeu_pd(d + 2 * i, _mm256_permute2f128_pd(lo, hi, 0x20));
+						_mm256_storeu_pd(d + 2 * i + W, _mm256_permute2f128_pd(lo, hi, 0x31));
+					}
+					else if constexpr (std::is_same_v<R, float>)
+					{
+						_mm_storeu_ps(d + 2 * i, _mm_unpacklo_ps(x, zero));
+						_mm_storeu_ps(d + 2 * i + W, _mm_unpackhi_ps(x, zero));
+					}
+					else
+					{
+						_mm_storeu_pd(d + 2 * i, _mm_unpacklo_pd(x, zero));
+						_mm_storeu_pd(d + 2 * i + W, _mm_unpackhi_pd(x, zero));
+					}
+				}
+			}
+		}
+		else if constexpr (is_complex_v<Ts> && is_complex_v<Td>)
+		{
+			// complex<double> ↔ complex<float> converts the interleaved components
+			_convert_run<typename base<Ts>::type, typename base<Td>::type, S>(
+				reinterpret_cast<const typename base<Ts>::type*>(a), 
+				reinterpret_cast<typename base<Td>::type*>(b), 2 * n, scale);
+			return;
+		}
+		else if constexpr (std::is_same_v<Ts, Td> && !std::is_same_v<Ts, half>)
+		{
+			const auto s = _set1<Ts, S>(scale);
+			constexpr size_t W = S::template elements<Ts>();
+			for (; i + W <= n; i += W)
+				_storeu<Ts, S>(b + i, _mul<Ts, S>(_loadu<Ts, S>(a + i), s));
+		}
+
+		// Scale at the wider precision and round once, as the SIMD lanes do
+		for (; i < n; ++i)
+		{
+			if constexpr (std::is_same_v<Td, std::complex<Ts>>)
+				b[i] = Td(scale * a[i], 0);
+			else if constexpr (is_complex_v<Td>)
+				b[i] = Td(typename base<Td>::type(scale * a[i].real()), typename base<Td>::type(scale * a[i].imag()));
+			else
+				b[i] = Td(scale * a[i]);
+		}
+	}
+
+	/** 
+	 * \brief kernel for b[i] = scale · part(a[i]), i < n.
+	 * Low level function not intended for the public API.
+	 */
+	template <ComplexPart P, typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_part_run(const std::complex<T>* a, T* b, const size_t n, const T scale)
+	{
+		size_t i = 0;
+		auto* src = reinterpret_cast<const T*>(a);
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+			const register_t s = _set1<T, S>(scale);
+
+			for (; i + W <= n; i += W)
+			{
+				const register_t x = _loadu<T, S>(src + 2 * i);
+				const register_t y = _loadu<T, S>(src + 2 * i + W);
+				register_t re, im;
+
+				// Split W interleaved pairs into W real and W imaginary parts
+				if constexpr (std::is_same_v<S, AVX512> && std::is_same_v<T, float>)
+				{
+					const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+					re = _mm512_permutex2var_ps(x, even, y);
+					im = _mm512_permutex2var_ps(x, _mm512_add_epi32(even, _mm512_set1_epi32(1)), y);
+				}
+				else if constexpr (std::is_same_v<S, AVX512>)
+				{
+					const __m512i even = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+					re = _mm512_permutex2var_pd(x, even, y);
+					im = _mm512_permutex2var_pd(x, _mm512_add_epi64(even, _mm512_set1_epi64(1)), y);
+				}
+				else if constexpr (std::is_same_v<S, AVX> && std::is_same_v<T, float>)
+				{
+					re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0))), 0xD8));
+					im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(x, y, _MM_SHUFFLE(3, 1, 3, 1))), 0xD8));
+				}
+				else if constexpr (std::is_same_v<S, AVX>)
+				{
+					re = _mm256_permute4x64_pd(_mm256_unpacklo_pd(x, y), 0xD8);
+					im = _mm256_permute4x64_pd(_mm256_unpackhi_pd(x, y), 0xD8);
+				}
+				else if constexpr (std::is_same_v<T, float>)
+				{
+					re = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+					im = _mm_shuffle_ps(x, y, _MM_SHUFFLE(3, 1, 3, 1));
+				}
+				else
+				{
+					re = _mm_unpacklo_pd(x, y);
+					im = _mm_unpackhi_pd(x, y);
+				}
+
+				register_t r;
+				if constexpr (P == ComplexPart::REAL)
+					r = re;
+				else if constexpr (P == ComplexPart::IMAG)
+					r = im;
+				else
+					r = _sqrt<T, S>(_fmadd<T, S>(re, re, _mul<T, S>(im, im)));
+
+				_storeu<T, S>(b + i, _mul<T, S>(r, s));
+			}
+		}
+
+		for (; i < n; ++i)
+		{
+			const T re = src[2 * i];
+			const T im = src[2 * i + 1];
+			if constexpr (P == ComplexPart::REAL)
+				b[i] = scale * re;
+			else if constexpr (P == ComplexPart::IMAG)
+				b[i] = scale * im;
+			else
+				b[i] = scale * std::sqrt(re * re + im * im);
+		}
+	}
+
+	/**
+	 * \brief Convert a matrix to another element type, B = Td(scale · A).
+	 *
+	 * Supported pairs: double → float, float → double, float → half, half → float,
+	 * R → complex<R>, complex<double> ↔ complex<float>, and Ts = Td (scaled copy).
+	 * The scale is held at the wider of the two precisions, so narrowing
+	 * conversions apply it at the source precision and round to nearest even
+	 * once.
+	 *
+	 * \tparam Ts       Source element type
+	 * \tparam Td       Destination element type
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param A         Input matrix A (M×N)
+	 * \param B         Output matrix B (M×N)
+	 * \param M         Number of rows
+	 * \param N         Number of columns
+	 * \param scale     Scale fused into the conversion, at the wider precision
+	 */
+	template<typename Ts, typename Td, typename S = decltype(detect_simd())>
+	requires
+	(
+		std::is_same_v<Ts, Td> ||
+		(std::is_same_v<Ts, double> && std::is_same_v<Td, float>) ||
+		(std::is_same_v<Ts, float> && std::is_same_v<Td, double>) ||
+		(std::is_same_v<Ts, float> && std::is_same_v<Td, half>) ||
+		(std::is_same_v<Ts, half> && std::is_same_v<Td, float>) ||
+		(std::is_same_v<Td, std::complex<Ts>>) ||
+		(std::is_same_v<Ts, std::complex<double>> && std::is_same_v<Td, std::complex<float>>) ||
+		(std::is_same_v<Ts, std::complex<float>> && std::is_same_v<Td, std::complex<double>>)
+	)
+	inline void
+	convert(Ts** A, Td** B, const size_t M, const size_t N, const _convert_scale_t<Ts, Td> scale = 1)
+	{
+		right<Ts>("convert:", std::make_tuple(A, M, N));
+		right<Td>("convert:", std::make_tuple(B, M, N));
+
+		const Ts* a = A[0];
+		Td* b = B[0];
+		const size_t L = M * N;
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0; i < L; i += _convert_chunk)
+			_convert_run<Ts, Td, S>(a + i, b + i, std::min(_convert_chunk, L - i), scale);
+	}
+
+	/**
+	 * \brief Extract the real part, imaginary part or modulus of a complex matrix, B = scale · part(A).
+	 *
+	 * \tparam P        Component to extract (REAL, IMAG, ABS)
+	 * \tparam T        Real scalar type (float or double)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param A         Input complex matrix A (M×N)
+	 * \param B         Output real matrix B (M×N)
+	 * \param M         Number of rows
+	 * \param N         Number of columns
+	 * \param scale     Scale fused into the extraction
+	 */
+	template<ComplexPart P, typename T, typename S = decltype(detect_simd())>
+	requires (std::is_floating_point_v<T>)
+	inline void
+	convert_part(std::complex<T>** A, T** B, const size_t M, const size_t N, const T scale = 1)
+	{
+		right<std::complex<T>>("convert_part:", std::make_tuple(A, M, N));
+		right<T>("convert_part:", std::make_tuple(B, M, N));
+
+		const std::complex<T>* a = A[0];
+		T* b = B[0];
+		const size_t L = M * N;
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0; i < L; i += _convert_chunk)
+			_part_run<P, T, S>(a + i, b + i, std::min(_convert_chunk, L - i), scale);
+	}
+
+} //namespace damm
+
+#endif //__CONVERT_H__
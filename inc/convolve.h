@@ -0,0 +1,338 @@
+#ifndef __CONVOLVE_H__
+#define __CONVOLVE_H__
+/**
+ * \file convolve.h
+ * \brief definitions for convolution via implicit im2col
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <common.h>
+#include <simd.h>
+#include <damm_kernels.h>
+#include <omp.h>
+#include <multiply.h>
+
+#include <vector>
+#include <stdexcept>
+
+/**
+ * \brief Convolution as an implicit-im2col GEMM.
+ *
+ * A convolution layer is the product of the weight matrix (C_out × C_in·KH·KW)
+ * and the im2col matrix (C_in·KH·KW × OH·OW), whose columns are the receptive
+ * fields of each output pixel. The im2col matrix is KH·KW times the size of the
+ * input and is never formed here: each thread owns a strip of kernel_cols output
+ * pixels, gathers the l1_block rows of im2col it needs into a packed panel, and
+ * feeds that panel to the multiply micro-kernel against all output channels
+ * before moving to the next block of the reduction. Working memory is one
+ * l1_block × kernel_cols panel per thread, independent of the image size.
+ *
+ * Images are stored one channel per row: X is C_in × (H·W) with pixel (h, w) of
+ * channel c at X[c][h·W + w], and Y is C_out × (OH·OW) in the same layout. The
+ * weight of output channel o, input channel c and tap (kh, kw) is
+ * W[o][(c·KH + kh)·KW + kw]. A batch is a loop over images sharing W.
+ */
+namespace damm
+{
+	/**
+	 * \brief Stride, zero padding and dilation of a 2D convolution.
+	 */
+	struct conv_params
+	{
+		size_t stride_h = 1;    ///< vertical step between receptive fields
+		size_t stride_w = 1;    ///< horizontal step between receptive fields
+		size_t pad_h = 0;       ///< zero rows added above and below the input
+		size_t pad_w = 0;       ///< zero columns added left and right of the input
+		size_t dilation_h = 1;  ///< vertical spacing between kernel taps
+		size_t dilation_w = 1;  ///< horizontal spacing between kernel taps
+	};
+
+	/**
+	 * \brief Output length of a convolution along one axis.
+	 *
+	 * \param n         Input length
+	 * \param k         Kernel length
+	 * \param stride    Step between receptive fields
+	 * \param pad       Zero padding on each side
+	 * \param dilation  Spacing between kernel taps
+	 *
+	 * \return (n + 2·pad − dilation·(k − 1) − 1) / stride + 1
+	 *
+	 * \throws std::invalid_argument if stride, dilation or k is zero, or the
+	 *         dilated kernel does not fit in the padded input.
+	 */
+	inline size_t
+	conv_output_size(const size_t n, const size_t k, const size_t stride, const size_t pad, const size_t dilation)
+	{
+		if (stride == 0 || dilation == 0 || k == 0)
+			throw std::invalid_argument("conv: stride, dilation and kernel size must be positive");
+
+		const size_t span = dilation * (k - 1) + 1;
+		if (n + 2 * pad < span)
+			throw std::invalid_argument("conv: kernel exceeds padded input");
+
+		return (n + 2 * pad - span) / stride + 1;
+	}
+
+	/** 
+	 * \brief Gather rows [k_start, k_end) of the im2col matrix for `cols` output pixels into a panel.
+	 * Row k of the panel starts at panel + (k − k_start)·KC, columns past `cols` are zero.
+	 * ih0/iw0 hold the top-left input coordinate of each pixel's receptive field.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T>
+	inline __attribute__((always_inline))
+	void
+	_im2col_panel(T** X, T* panel, const size_t KC,
+		const std::ptrdiff_t* ih0, const std::ptrdiff_t* iw0, const size_t cols, const bool same_row,
+		const size_t k_start, const size_t k_end,
+		const size_t H, const size_t W, const size_t KH, const size_t KW,
+		const conv_params& p)
+	{
+		const std::ptrdiff_t h = H;
+		const std::ptrdiff_t w = W;
+
+		for (size_t k = k_start; k < k_end; ++k)
+		{
+			const size_t c = k / (KH * KW);
+			const size_t kh = (k / KW) % KH;
+			const size_t kw = k % KW;
+			const std::ptrdiff_t dh = kh * p.dilation_h;
+			const std::ptrdiff_t dw = kw * p.dilation_w;
+
+			const T* src = X[c];
+			T* dst = panel + (k - k_start) * KC;
+
+			// Unit stride within one output row reads a contiguous run of the input
+			const std::ptrdiff_t ih = ih0[0] + dh;
+			const std::ptrdiff_t iw = iw0[0] + dw;
+			if (same_row && ih >= 0 && ih < h && iw >= 0 && iw + std::ptrdiff_t(cols) <= w)
+				std::copy(src + ih * w + iw, src + ih * w + iw + cols, dst);
+			else
+				for (size_t j = 0; j < cols; ++j)
+				{
+					const std::ptrdiff_t y = ih0[j] + dh;
+					const std::ptrdiff_t x = iw0[j] + dw;
+					dst[j] = (y >= 0 && y < h && x >= 0 && x < w) ? src[y * w + x] : T(0);
+				}
+
+			std::fill(dst + cols, dst + KC, T(0));
+		}
+	}
+
+	/** 
+	 * \brief Scalar micro-kernel with the interface of _multiply_block_simd, for S = NONE.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, template<typename, typename> class K>
+	inline __attribute__((always_inline))
+	void
+	_conv_block(T** At, T** B, T** C,
+		const size_t row, const size_t col,
+		const size_t k_start, const size_t k_end,
+		const size_t b_col)
+	{
+		using kernel_t = K<T, NONE>;
+		constexpr size_t kernel_rows = kernel_t::kernel_rows();
+		constexpr size_t kernel_cols = kernel_t::kernel_cols();
+
+		for (size_t k = k_start; k < k_end; ++k)
+			for (size_t i = 0; i < kernel_rows; ++i)
+			{
+				const T a = At[k][row + i];
+				for (size_t j = 0; j < kernel_cols; ++j)
+					C[row + i][col + j] += a * B[k][b_col + j];
+			}
+	}
+
+	/**
+	 * \brief Convolution driver over output pixel strips.
+	 *
+	 * \param Wt    Transposed weights, C_in·KH·KW × Mp, with Mp = C_out rounded up to
+	 *              kernel_rows and the padding columns zero
+	 *
+	 * Strips that end past OH·OW, and output channels past the last full kernel_rows
+	 * tile, accumulate in a per-thread scratch strip so every micro-kernel call is full width.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S, template<typename, typename> class K>
+	inline __attribute__((always_inline))
+	void
+	_conv2d(T** X, T** Wt, T** Y,
+		const size_t C_in, const size_t H, const size_t W,
+		const size_t C_out, const size_t KH, const size_t KW,
+		const size_t OH, const size_t OW, const conv_params& p)
+	{
+		using kernel_t = K<T, S>;
+		using blocking = typename kernel_t::blocking;
+
+		constexpr size_t l1_block = blocking::l1_block;
+		constexpr size_t kernel_rows = kernel_t::kernel_rows();
+		constexpr size_t KC = kernel_t::kernel_cols();
+
+		const size_t Kdim = C_in * KH * KW;
+		const size_t P = OH * OW;
+		const size_t Mp = (C_out + kernel_rows - 1) / kernel_rows * kernel_rows;
+		const size_t M_full = C_out - C_out % kernel_rows;
+
+		#pragma omp parallel
+		{
+			auto panel = aligned_alloc_1D<T, S::bytes>(std::min(l1_block, Kdim), KC);
+			auto strip = aligned_alloc_2D<T, S::bytes>(Mp, KC);
+			std::vector<T*> panel_rows(Kdim);
+			std::vector<std::ptrdiff_t> ih0(KC), iw0(KC);
+
+			#pragma omp for schedule(static)
+			for (size_t col = 0; col < P; col += KC)
+			{
+				const size_t cols = std::min(KC, P - col);
+				for (size_t j = 0; j < cols; ++j)
+				{
+					const size_t oh = (col + j) / OW;
+					const size_t ow = (col + j) % OW;
+					ih0[j] = std::ptrdiff_t(oh * p.stride_h) - std::ptrdiff_t(p.pad_h);
+					iw0[j] = std::ptrdiff_t(ow * p.stride_w) - std::ptrdiff_t(p.pad_w);
+				}
+				const bool same_row = p.stride_w == 1 && col / OW == (col + cols - 1) / OW;
+
+				// Rows [0, m_direct) accumulate in place, the rest in the scratch strip
+				const size_t m_direct = cols == KC ? M_full : 0;
+				for (size_t r = m_direct; r < Mp; ++r)
+					for (size_t j = 0; j < KC; ++j)
+						strip[r][j] = (r < C_out && j < cols) ? Y[r][col + j] : T(0);
+
+				for (size_t k_block = 0; k_block < Kdim; k_block += l1_block)
+				{
+					const size_t k_end = std::min(k_block + l1_block, Kdim);
+
+					_im2col_panel<T>(X, panel.get(), KC, ih0.data(), iw0.data(), cols, same_row,
+						k_block, k_end, H, W, KH, KW, p);
+					for (size_t k = k_block; k < k_end; ++k)
+						panel_rows[k] = panel.get() + (k - k_block) * KC;
+
+					for (size_t r = 0; r < Mp; r += kernel_rows)
+					{
+						const bool direct = r < m_direct;
+						if constexpr (std::is_same_v<S, NONE>)
+							_conv_block<T, K>(Wt, panel_rows.data(), direct ? Y : strip.get(), 
+								r, direct ? col : 0, k_block, k_end, 0);
+						else
+							_multiply_block_simd<T, S, K>(Wt, panel_rows.data(), direct ? Y : strip.get(), 
+								r, direct ? col : 0, k_block, k_end, 0);
+					}
+				}
+
+				for (size_t r = m_direct; r < C_out; ++r)
+					std::copy(strip[r], strip[r] + cols, Y[r] + col);
+			}
+		}
+	}
+
+	/**
+	 * \brief 2D convolution (cross-correlation) Y += W ⋆ X over C_in → C_out channels.
+	 *
+	 * Computes
+	 *   Y[o][oh·OW + ow] += Σ_{c, kh, kw} W[o][(c·KH + kh)·KW + kw] · X[c][ih·W + iw],
+	 *   ih = oh·stride_h − pad_h + kh·dilation_h,  iw = ow·stride_w − pad_w + kw·dilation_w,
+	 * with taps outside the input reading zero. OH and OW are given by conv_output_size.
+	 *
+	 * \tparam T	Element type (float, double, complex<float>, complex<double>)
+	 * \tparam S	SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 * \tparam K	Kernel policy, shared with multiply
+	 *
+	 * \param X		Input image, C_in × (H·W)
+	 * \param Wk	Weights, C_out × (C_in·KH·KW)
+	 * \param Y		Output image, C_out × (OH·OW)
+	 * \param C_in	Input channels
+	 * \param H		Input height
+	 * \param W		Input width
+	 * \param C_out	Output channels
+	 * \param KH	Kernel height
+	 * \param KW	Kernel width
+	 * \param p		Stride, padding and dilation
+	 *
+	 * \note Like multiply, Y is accumulated into: zero it first, or preload a bias.
+	 * \throws std::invalid_argument if the geometry is invalid (see conv_output_size).
+	 */
+	template<typename T, typename S = decltype(detect_simd()), template<typename, typename> class K = multiply_kernel>
+	inline void
+	conv2d(T** X, T** Wk, T** Y,
+		const size_t C_in, const size_t H, const size_t W,
+		const size_t C_out, const size_t KH, const size_t KW,
+		const conv_params& p = {})
+	{
+		const size_t OH = conv_output_size(H, KH, p.stride_h, p.pad_h, p.dilation_h);
+		const size_t OW = conv_output_size(W, KW, p.stride_w, p.pad_w, p.dilation_w);
+		const size_t Kdim = C_in * KH * KW;
+
+		right<T>("conv2d:", 
+			std::make_tuple(X, C_in, H * W), 
+			std::make_tuple(Wk, C_out, Kdim), 
+			std::make_tuple(Y, C_out, OH * OW));
+
+		constexpr size_t kernel_rows = K<T, S>::kernel_rows();
+		const size_t Mp = (C_out + kernel_rows - 1) / kernel_rows * kernel_rows;
+
+		// The micro-kernel broadcasts a column of weights per reduction step
+		auto Wt = aligned_alloc_2D<T, S::bytes>(Kdim, Mp);
+		#pragma omp parallel for schedule(static)
+		for (size_t k = 0; k < Kdim; ++k)
+			for (size_t o = 0; o < Mp; ++o)
+				Wt[k][o] = o < C_out ? Wk[o][k] : T(0);
+
+		_conv2d<T, S, K>(X, Wt.get(), Y, C_in, H, W, C_out, KH, KW, OH, OW, p);
+	}
+
+	/**
+	 * \brief 1D convolution (cross-correlation) Y += W ⋆ X over C_in → C_out channels.
+	 *
+	 * Computes Y[o][t] += Σ_{c, k} W[o][c·KL + k] · X[c][t·stride − pad + k·dilation],
+	 * with taps outside the signal reading zero. This is conv2d with H = KH = 1.
+	 *
+	 * \param X			Input signal, C_in × L
+	 * \param Wk		Weights, C_out × (C_in·KL)
+	 * \param Y			Output signal, C_out × conv_output_size(L, KL, stride, pad, dilation)
+	 * \param C_in		Input channels
+	 * \param L			Input length
+	 * \param C_out		Output channels
+	 * \param KL		Kernel length
+	 * \param stride	Step between receptive fields
+	 * \param pad		Zero padding on each side
+	 * \param dilation	Spacing between kernel taps
+	 *
+	 * \note Like multiply, Y is accumulated into: zero it first, or preload a bias.
+	 */
+	template<typename T, typename S = decltype(detect_simd()), template<typename, typename> class K = multiply_kernel>
+	inline void
+	conv1d(T** X, T** Wk, T** Y,
+		const size_t C_in, const size_t L,
+		const size_t C_out, const size_t KL,
+		const size_t stride = 1, const size_t pad = 0, const size_t dilation = 1)
+	{
+		conv2d<T, S, K>(X, Wk, Y, C_in, 1, L, C_out, 1, KL, 
+			conv_params{.stride_h = 1, .stride_w = stride, .pad_h = 0, .pad_w = pad, .dilation_h = 1, .dilation_w = dilation});
+	}
+
+} //namespace damm
+
+#endif //__CONVOLVE_H__
@@ -32,10 +32,28 @@
 #include <fused_union.h>
 #include <fused_reduce.h>
 #include <transpose.h>
+#include <permute.h>
 #include <multiply.h>
 #include <householder.h>
 #include <decompose.h>
 #include <solve.h>
 #include <inverse.h>
+#include <determinant.h>
+#include <matfun.h>
+#include <batched.h>
+#include <random.h>
+#include <convert.h>
+#include <convolve.h>
+#include <kron.h>
+#include <scan.h>
+#include <reducer.h>
+#include <semiring.h>
+#include <packed.h>
+#include <bsr.h>
+#include <fft.h>
+#include <eig.h>
+#include <krylov.h>
+#include <segmented.h>
+#include <blas.h>
 
 #endif //__DAMM_H__
\ No newline at end of file
@@ -130,5 +130,21 @@ namespace damm
 		static consteval size_t kernel_cols() { return col_registers * register_elements(); }
 		using blocking = blocking_policy<T, S, fused_union_kernel>;
 	};
+
+	/**
+	 * \brief Policy defining the matrix inverse kernel 
+	 *
+	 * kernel_cols() is the panel width of the blocked Gauss-Jordan inverse.
+	 */
+	template<typename T, typename S>
+	struct inverse_kernel 
+	{
+		static consteval size_t register_elements() { return std::max(S::template elements<T>(), size_t(1)); }  
+		static constexpr size_t row_registers = 4;
+		static constexpr size_t col_registers = 4;
+		static consteval size_t kernel_rows() { return row_registers; } 
+		static consteval size_t kernel_cols() { return col_registers * register_elements(); }
+		using blocking = blocking_policy<T, S, inverse_kernel>;
+	};
 }
 #endif //__DAMM_KERNELS_H__
\ No newline at end of file
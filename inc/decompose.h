@@ -40,6 +40,7 @@
 #include <transpose.h>
 #include <householder.h>
 #include <broadcast.h>
+#include <blas.h>
 
 namespace damm
 {
@@ -63,12 +64,14 @@ namespace lu
 	size_t
 	_find_pivot(T** A, const size_t k, const size_t N)
 	{
+		using R = typename base<T>::type;
+
 		size_t pivot_row = k;
-		T max_val = std::abs(A[k][k]);
+		R max_val = std::abs(A[k][k]);
 		
 		for (size_t i = k + 1; i < N; ++i) 
 		{
-			T abs_val = std::abs(A[i][k]);
+			R abs_val = std::abs(A[i][k]);
 			if (abs_val > max_val) 
 			{
 				max_val = abs_val;
@@ -107,7 +110,7 @@ namespace lu
 	 * elimination steps via fused_union operations. Optimized multiplier computation using
 	 * scalar broadcasting for better memory efficiency.
 	 *
-	 * \tparam T        Scalar type (float or double)
+	 * \tparam T        Scalar type (float, double, or complex variants)
 	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
 	 *
 	 * \param A         Input matrix A (N×N), overwritten with L and U
@@ -122,7 +125,8 @@ namespace lu
 	{		
 		right<T>("decompose:", std::make_tuple(A, N, N));
 			
-		constexpr T tolerance = std::is_same_v<T, float> ? 1e-6f : 1e-12;
+		using R = typename base<T>::type;
+		constexpr R tolerance = std::is_same_v<R, float> ? 1e-6f : 1e-12;
 
 		std::ranges::iota(P, P + N, 0);
 		
@@ -190,10 +194,12 @@ namespace qr
 	 * \brief QR Decomposition using Householder Reflections with SIMD optimization.
 	 *
 	 * Performs QR decomposition of matrix A using Householder reflections.
-	 * Computes A = Q * R where Q is orthogonal and R is upper triangular.
-	 * Uses the optimized householder methods from householder.h.
+	 * Computes A = Q * R where Q is orthogonal (unitary for complex T) and R is
+	 * upper triangular. Uses the optimized householder methods from householder.h.
+	 * For complex T, R is updated with H^H and Q accumulates H, so the diagonal
+	 * of R is real.
 	 *
-	 * \tparam T        Scalar type (float or double)
+	 * \tparam T        Scalar type (float, double, or complex variants)
 	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
 	 *
 	 * \param A         Input matrix A (M×N), overwritten with R
@@ -240,7 +246,7 @@ namespace qr
 			T tau, beta;
 			make_householder<T, S>(column_k.get(), remaining_rows, householder_vector.get(), tau, beta);
 			
-			if (std::abs(tau) < std::numeric_limits<T>::epsilon())
+			if (std::abs(tau) < std::numeric_limits<typename base<T>::type>::epsilon())
 				continue; // Skip near-zero reflections
 			
 			// Update R[k][k] with beta, zero out below
@@ -256,7 +262,7 @@ namespace qr
 					std::copy(&R[k + i][k + 1], &R[k + i][N], R_sub[i]);
 				
 				apply_householder_left<T, S>(R_sub.get(), remaining_rows, N - k - 1, 
-											householder_vector.get(), tau);
+											householder_vector.get(), conjugate(tau));
 				
 				for (size_t i = 0; i < remaining_rows; ++i)
 					std::copy(R_sub[i], R_sub[i] + (N - k - 1), &R[k + i][k + 1]);
@@ -284,12 +290,11 @@ namespace cholesky
 	/**
 	 * \brief kernel for the row-segment dot product L[i][0..len) · L[j][0..len).
 	 *
-	 * Computes Σ_{p<len} A_row[p] * B_row[p] over two contiguous row segments.
+	 * Computes Σ_{p<len} A_row[p] * conj(B_row[p]) over two contiguous row segments
+	 * with the conjugating level 1 kernel, which reads B_row in place.
 	 * Both segments are accessed sequentially in memory (row-major friendly),
 	 * which is the key cache-locality property exploited by the Cholesky-Banachiewicz
-	 * algorithm. For short segments (len smaller than a SIMD lane) the call falls
-	 * through fused_reduce's scalar tail; for longer segments it engages the
-	 * SIMD-blocked kernels with FMA accumulation.
+	 * algorithm.
 	 *
 	 * Low level function not intended for the public API.
 	 */
@@ -298,36 +303,29 @@ namespace cholesky
 	T
 	_row_dot(T* A_row, T* B_row, const size_t len)
 	{
-		if (len == 0) return T(0);
-		
-		// Build 1×len views over the contiguous row segments. No data copies;
-		// view_as_2D just allocates a one-element pointer array per side.
-		auto A_view = view_as_2D(A_row, 1, len);
-		auto B_view = view_as_2D(B_row, 1, len);
-		
-		return fused_reduce<T, std::multiplies<>, std::plus<>, S>(
-			A_view.get(), B_view.get(), T(0), 1, len);
+		return blas::_dot<T, S, true>(B_row, A_row, len);
 	}
 
 	/**
 	 * \brief Cholesky Decomposition (LL^T) using SIMD-optimized operations.
 	 *
 	 * Performs in-place Cholesky decomposition of a symmetric positive-definite
-	 * matrix A such that A = L * L^T, where L is lower triangular. Only the
+	 * matrix A such that A = L * L^T, where L is lower triangular. For complex T,
+	 * A must be Hermitian positive-definite and A = L * L^H with a real diagonal. Only the
 	 * lower triangular part of A is read; the strict upper triangular part is
 	 * overwritten with zeros on output.
 	 *
 	 * Uses the row-oriented Cholesky-Banachiewicz algorithm. For each row i,
-	 *   L[i][j]  = ( A[i][j] - Σ_{p<j} L[i][p] * L[j][p] ) / L[j][j],   j < i
-	 *   L[i][i]  = sqrt( A[i][i] - Σ_{p<i} L[i][p]^2 )
+	 *   L[i][j]  = ( A[i][j] - Σ_{p<j} L[i][p] * conj(L[j][p]) ) / L[j][j],   j < i
+	 *   L[i][i]  = sqrt( A[i][i] - Σ_{p<i} |L[i][p]|^2 )
 	 * Both terms inside the sums walk row i and row j (or row i twice) in the
 	 * forward direction. Since damm stores matrices row-major, every memory
 	 * read in the hot loop is sequential — engaging the SIMD-FMA kernels of
-	 * fused_reduce on data that arrives in cache lines naturally, and avoiding
+	 * the level 1 dot on data that arrives in cache lines naturally, and avoiding
 	 * the strided gathers a column-oriented algorithm would force on row-major
 	 * storage.
 	 *
-	 * \tparam T        Scalar type (float or double)
+	 * \tparam T        Scalar type (float, double, or complex variants)
 	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
 	 *
 	 * \param A         Input matrix A (N×N), overwritten with L (lower triangle).
@@ -356,13 +354,14 @@ namespace cholesky
 			// Diagonal entry: L[i][i] = sqrt(A[i][i] - ||L[i][0..i)||^2).
 			// The squared-norm is the row segment dotted with itself —
 			// same contiguous-row access pattern as the off-diagonal step.
+			// For Hermitian A the imaginary part of the diagonal is dropped.
 			const T diag_sum = _row_dot<T, S>(A[i], A[i], i);
-			const T x = A[i][i] - diag_sum;
+			const typename base<T>::type x = std::real(A[i][i] - diag_sum);
 			
-			if (x <= T(0))
+			if (x <= 0)
 				return false; // Matrix is not positive definite
 			
-			A[i][i] = std::sqrt(x);
+			A[i][i] = T(std::sqrt(x));
 		}
 		
 		// Zero the strict upper triangle so A becomes a clean L.
@@ -0,0 +1,334 @@
+#ifndef __DETERMINANT_H__
+#define __DETERMINANT_H__
+/**
+ * \file determinant.h
+ * \brief definitions for determinant utilities
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <algorithm>
+#include <vector>
+#include <common.h>
+#include <simd.h>
+#include <damm_memory.h>
+#include <decompose.h>
+
+namespace damm
+{
+	/**
+	 * \brief Determinants from existing factorizations.
+	 *
+	 * The determinant is accumulated as Σ log|d_i| over the diagonal of the
+	 * triangular factor rather than as Π d_i, so it does not overflow or
+	 * underflow for large N. The sign (a unit phase for complex types) is
+	 * tracked separately. The functions in lu:: and cholesky:: take a matrix
+	 * that is already factored, so a factorization used for solving can be
+	 * reused without factoring twice.
+	 */
+
+	/** 
+	 * \brief kernel for Σ log(x[i]) over a contiguous vector of positive values.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	T
+	_log_sum(const T* x, const size_t N)
+	{
+		T sum = T(0);
+		size_t i = 0;
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+
+			register_t acc = _set1<T, S>(T(0));
+			for (; i + W <= N; i += W)
+				acc = _add<T, S>(acc, _log<T, S>(_load<T, S>(&x[i])));
+
+			sum = _reduce_add<T, S>(acc);
+		}
+
+		for (; i < N; ++i)
+			sum += std::log(x[i]);
+
+		return sum;
+	}
+
+	/** 
+	 * \brief kernel for the log-magnitude and phase of a triangular factor's diagonal.
+	 *
+	 * Gathers |A[i][i]| into an aligned buffer so the log-sum runs on contiguous
+	 * data, while the phase Π A[i][i]/|A[i][i]| is accumulated in the same pass.
+	 *
+	 * \return Σ log|A[i][i]|, or -inf (with sign = 0) if a diagonal entry is zero
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	typename base<T>::type
+	_log_abs_diagonal(T** A, const size_t N, T& sign)
+	{
+		using R = typename base<T>::type;
+
+		auto d = aligned_alloc_1D<R, S::bytes>(1, N);
+		sign = T(1);
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			d[i] = std::abs(A[i][i]);
+
+			if (d[i] == R(0))
+			{
+				sign = T(0);
+				return -std::numeric_limits<R>::infinity();
+			}
+
+			sign *= A[i][i] / d[i];
+		}
+
+		return _log_sum<R, S>(d.get(), N);
+	}
+
+	/** 
+	 * \brief kernel for the parity of a permutation vector.
+	 * \return true if the permutation is odd
+	 * Low level function not intended for the public API.
+	 */
+	inline bool
+	_permutation_parity(const size_t* P, const size_t N)
+	{
+		std::vector<bool> visited(N, false);
+		size_t cycles = 0;
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			if (visited[i])
+				continue;
+
+			++cycles;
+			for (size_t j = i; !visited[j]; j = P[j])
+				visited[j] = true;
+		}
+
+		return (N - cycles) % 2;
+	}
+
+	namespace lu
+	{
+		/**
+		 * \brief Sign and log-magnitude of the determinant from LU factors.
+		 *
+		 * det(A) = sign · exp(logabsdet), where sign includes the parity of P.
+		 *
+		 * \tparam T        Scalar type (float, double, or complex variants)
+		 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+		 *
+		 * \param LU        LU factors from lu::decompose (N×N)
+		 * \param P         Permutation vector from lu::decompose (size N)
+		 * \param N         Matrix dimension
+		 * \param sign      Output sign: ±1 for real T, a unit phase for complex T,
+		 *                  0 if the matrix is singular
+		 *
+		 * \return log|det(A)|, -inf if the matrix is singular
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		inline typename base<T>::type
+		slogdet(T** LU, const size_t* P, const size_t N, T& sign)
+		{
+			// Only the row pointers are checked: lu::decompose interchanges them,
+			// so the rows of LU need not be contiguous in order.
+			right<T*>("slogdet:", std::make_tuple(LU, size_t(1), N));
+			right<size_t>("slogdet:", std::make_tuple(const_cast<size_t*>(P), size_t(1), N));
+
+			const auto logabsdet = _log_abs_diagonal<T, S>(LU, N, sign);
+
+			if (_permutation_parity(P, N))
+				sign = -sign;
+
+			return logabsdet;
+		}
+
+		/**
+		 * \brief Log-magnitude of the determinant from LU factors, log|det(A)|.
+		 *
+		 * \param LU        LU factors from lu::decompose (N×N)
+		 * \param P         Permutation vector from lu::decompose (size N)
+		 * \param N         Matrix dimension
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		inline typename base<T>::type
+		logdet(T** LU, const size_t* P, const size_t N)
+		{
+			T sign;
+			return slogdet<T, S>(LU, P, N, sign);
+		}
+
+		/**
+		 * \brief Determinant from LU factors.
+		 *
+		 * \param LU        LU factors from lu::decompose (N×N)
+		 * \param P         Permutation vector from lu::decompose (size N)
+		 * \param N         Matrix dimension
+		 *
+		 * \note Overflows for large N; prefer slogdet.
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		inline T
+		det(T** LU, const size_t* P, const size_t N)
+		{
+			T sign;
+			const auto logabsdet = slogdet<T, S>(LU, P, N, sign);
+			return sign * std::exp(logabsdet);
+		}
+
+	} // namespace lu
+
+	namespace cholesky
+	{
+		/**
+		 * \brief Log-determinant from a Cholesky factor, log det(A) = 2 Σ log L[i][i].
+		 *
+		 * The determinant of a (Hermitian) positive-definite matrix is positive,
+		 * so no sign is returned.
+		 *
+		 * \tparam T        Scalar type (float, double, or complex variants)
+		 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+		 *
+		 * \param L         Cholesky factor from cholesky::decompose (N×N)
+		 * \param N         Matrix dimension
+		 *
+		 * \return log det(A)
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		inline typename base<T>::type
+		logdet(T** L, const size_t N)
+		{
+			right<T>("logdet:", std::make_tuple(L, N, N));
+
+			T sign;
+			return 2 * _log_abs_diagonal<T, S>(L, N, sign);
+		}
+
+		/**
+		 * \brief Determinant from a Cholesky factor.
+		 *
+		 * \param L         Cholesky factor from cholesky::decompose (N×N)
+		 * \param N         Matrix dimension
+		 *
+		 * \note Overflows for large N; prefer logdet.
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		inline typename base<T>::type
+		det(T** L, const size_t N)
+		{
+			return std::exp(logdet<T, S>(L, N));
+		}
+
+	} // namespace cholesky
+
+	/**
+	 * \brief Sign and log-magnitude of the determinant of a general matrix.
+	 *
+	 * Factors a copy of A with lu::decompose; A is not modified. The copy is
+	 * scaled by a power of two so that max|a_ij| lies in [1, 2), which makes the
+	 * pivot tolerance of lu::decompose relative to A and keeps well-conditioned
+	 * matrices of very small or very large scale from being reported singular.
+	 * The scaling is exact and is added back as N·e·log 2. Use lu::slogdet
+	 * directly when the factors are already available.
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (N×N)
+	 * \param N         Matrix dimension
+	 * \param sign      Output sign, 0 if the matrix is singular
+	 *
+	 * \return log|det(A)|, -inf if the matrix is singular
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline typename base<T>::type
+	slogdet(T** A, const size_t N, T& sign)
+	{
+		right<T>("slogdet:", std::make_tuple(A, N, N));
+
+		using R = typename base<T>::type;
+
+		R amax = R(0);
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+				amax = std::max(amax, std::abs(A[i][j]));
+
+		if (amax == R(0))
+		{
+			sign = T(0);
+			return -std::numeric_limits<R>::infinity();
+		}
+
+		const int e = std::ilogb(amax);
+
+		auto LU = aligned_alloc_2D<T, S::bytes>(N, N);
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+				if constexpr (is_complex_v<T>)
+					LU[i][j] = T(std::scalbn(A[i][j].real(), -e), std::scalbn(A[i][j].imag(), -e));
+				else
+					LU[i][j] = std::scalbn(A[i][j], -e);
+
+		auto P = aligned_alloc_1D<size_t, S::bytes>(1, N);
+
+		if (!lu::decompose<T, S>(LU.get(), P.get(), N))
+		{
+			sign = T(0);
+			return -std::numeric_limits<R>::infinity();
+		}
+
+		return lu::slogdet<T, S>(LU.get(), P.get(), N, sign) + R(N) * R(e) * std::numbers::ln2_v<R>;
+	}
+
+	/**
+	 * \brief Determinant of a general matrix.
+	 *
+	 * Factors a copy of A with lu::decompose; A is not modified.
+	 *
+	 * \param A         Input matrix A (N×N)
+	 * \param N         Matrix dimension
+	 *
+	 * \note Overflows for large N; prefer slogdet.
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline T
+	det(T** A, const size_t N)
+	{
+		T sign;
+		const auto logabsdet = slogdet<T, S>(A, N, sign);
+		return sign * std::exp(logabsdet);
+	}
+
+} //namespace damm
+
+#endif //__DETERMINANT_H__
@@ -0,0 +1,496 @@
+#ifndef __DISTRIBUTED_H__
+#define __DISTRIBUTED_H__
+/**
+ * \file distributed.h
+ * \brief definitions for distributed-memory matrices and SUMMA multiply over MPI
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <common.h>
+#include <simd.h>
+#include <damm_kernels.h>
+#include <multiply.h>
+#include <mpi.h>
+
+#include <vector>
+#include <stdexcept>
+
+/**
+ * \brief Distributed-memory matrices and operations over MPI.
+ *
+ * A distributed::grid arranges the ranks of a communicator as a P_r × P_c process
+ * grid, with rank = row·P_c + col and one sub-communicator per grid row and column.
+ * A distributed::matrix stores an M×N matrix in the 2D block-cyclic layout: block
+ * (I, J) of size mb×nb lives on process (I mod P_r, J mod P_c), and each process
+ * keeps its blocks packed in a contiguous local matrix with the usual row pointers.
+ *
+ * multiply is SUMMA: for each block column t of A (block row t of B), the owning
+ * process column broadcasts its A panel along the grid rows and the owning process
+ * row broadcasts its B panel along the grid columns, and every process adds the
+ * product of the two panels into its local C with the shared-memory multiply.
+ * The broadcasts of step t + 1 are posted before the multiply of step t, so
+ * communication overlaps the local GEMM where the MPI library progresses
+ * nonblocking collectives asynchronously.
+ *
+ * This header is not included by damm.h. Compile with mpic++ and run under mpirun.
+ * Grids and matrices must be destroyed before MPI_Finalize.
+ */
+namespace damm
+{
+	namespace distributed
+	{
+		/** 
+		 * \brief MPI datatype of T.
+		 * Low level function not intended for the public API.
+		 */
+		template<typename T>
+		inline MPI_Datatype
+		_mpi_type()
+		{
+			if constexpr (std::is_same_v<T, float>)
+				return MPI_FLOAT;
+			else if constexpr (std::is_same_v<T, double>)
+				return MPI_DOUBLE;
+			else if constexpr (std::is_same_v<T, std::complex<float>>)
+				return MPI_C_FLOAT_COMPLEX;
+			else if constexpr (std::is_same_v<T, std::complex<double>>)
+				return MPI_C_DOUBLE_COMPLEX;
+			else
+				static_assert(always_false<T>, "Unsupported MPI element type");
+		}
+
+		/**
+		 * \brief Number of indices of an n-long dimension, split in blocks of nb, held by
+		 * process p of P in the block-cyclic layout.
+		 */
+		inline size_t
+		local_extent(const size_t n, const size_t nb, const int p, const int P)
+		{
+			const size_t blocks = (n + nb - 1) / nb;
+			size_t extent = (blocks / P + (size_t(p) < blocks % P)) * nb;
+
+			// the last, possibly partial, block
+			if (blocks != 0 && int((blocks - 1) % P) == p)
+				extent -= blocks * nb - n;
+			return extent;
+		}
+
+		/**
+		 * \brief Global index of local index l of process p of P, block size nb.
+		 */
+		inline size_t
+		global_index(const size_t l, const size_t nb, const int p, const int P)
+		{
+			return ((l / nb) * P + p) * nb + l % nb;
+		}
+
+		/**
+		 * \brief A P_r × P_c process grid over an MPI communicator.
+		 */
+		class grid
+		{
+		public:
+			MPI_Comm comm;      ///< all ranks of the grid
+			MPI_Comm row_comm;  ///< ranks in my grid row, ranked by column
+			MPI_Comm col_comm;  ///< ranks in my grid column, ranked by row
+			int rows;           ///< P_r
+			int cols;           ///< P_c
+			int row;            ///< my grid row
+			int col;            ///< my grid column
+			int rank;           ///< my rank in comm
+
+			/**
+			 * \param parent    Communicator to arrange
+			 * \param P_r       Grid rows, or 0 to choose with MPI_Dims_create
+			 * \param P_c       Grid columns, or 0 to choose with MPI_Dims_create
+			 *
+			 * \throws std::invalid_argument if P_r·P_c differs from the communicator size
+			 */
+			explicit grid(MPI_Comm parent = MPI_COMM_WORLD, int P_r = 0, int P_c = 0)
+			{
+				int size;
+				MPI_Comm_size(parent, &size);
+
+				int dims[2] = {P_r, P_c};
+				MPI_Dims_create(size, 2, dims);
+				if (dims[0] * dims[1] != size)
+					throw std::invalid_argument("distributed::grid: P_r·P_c must equal the communicator size");
+
+				MPI_Comm_dup(parent, &comm);
+				MPI_Comm_rank(comm, &rank);
+				rows = dims[0];
+				cols = dims[1];
+				row = rank / cols;
+				col = rank % cols;
+				MPI_Comm_split(comm, row, col, &row_comm);
+				MPI_Comm_split(comm, col, row, &col_comm);
+			}
+
+			grid(const grid&) = delete;
+			grid& operator=(const grid&) = delete;
+
+			~grid()
+			{
+				MPI_Comm_free(&row_comm);
+				MPI_Comm_free(&col_comm);
+				MPI_Comm_free(&comm);
+			}
+
+			/** \brief Rank in comm of grid process (r, c) */
+			int owner(const int r, const int c) const { return r * cols + c; }
+		};
+
+		/**
+		 * \brief An M×N matrix distributed block-cyclically over a process grid.
+		 *
+		 * \tparam T	Element type (float, double, complex<float>, complex<double>)
+		 */
+		template<typename T>
+		class matrix
+		{
+			using storage_t = decltype(aligned_alloc_2D<T, 64>(1, 1));
+
+			const grid* g;
+			size_t M, N, mb, nb;
+			size_t lm, ln;
+			storage_t data;
+
+			/** \brief Check the block sizes before local_extent divides by them */
+			static void
+			_check_blocks(const size_t mb, const size_t nb)
+			{
+				if (mb == 0 || nb == 0)
+					throw std::invalid_argument("distributed::matrix: block sizes must be positive");
+			}
+
+			/** \brief Pack the local part of process (r, c) from the global matrix A */
+			void
+			_pack(T** A, T* buffer, const int r, const int c) const
+			{
+				const size_t rm = local_extent(M, mb, r, g->rows);
+				const size_t rn = local_extent(N, nb, c, g->cols);
+				for (size_t i = 0; i < rm; ++i)
+				{
+					const T* src = A[global_index(i, mb, r, g->rows)];
+					for (size_t j = 0; j < rn; ++j)
+						buffer[i * rn + j] = src[global_index(j, nb, c, g->cols)];
+				}
+			}
+
+			/** \brief Unpack the local part of process (r, c) into the global matrix A */
+			void
+			_unpack(const T* buffer, T** A, const int r, const int c) const
+			{
+				const size_t rm = local_extent(M, mb, r, g->rows);
+				const size_t rn = local_extent(N, nb, c, g->cols);
+				for (size_t i = 0; i < rm; ++i)
+				{
+					T* dst = A[global_index(i, mb, r, g->rows)];
+					for (size_t j = 0; j < rn; ++j)
+						dst[global_index(j, nb, c, g->cols)] = buffer[i * rn + j];
+				}
+			}
+
+		public:
+			/**
+			 * \param grid  Process grid, which must outlive the matrix
+			 * \param M     Global rows
+			 * \param N     Global columns
+			 * \param mb    Row block size
+			 * \param nb    Column block size
+			 */
+			matrix(const grid& grid, const size_t M, const size_t N, const size_t mb = 64, const size_t nb = 64)
+				: g((_check_blocks(mb, nb), &grid)), M(M), N(N), mb(mb), nb(nb),
+				  lm(local_extent(M, mb, grid.row, grid.rows)),
+				  ln(local_extent(N, nb, grid.col, grid.cols)),
+				  data(aligned_alloc_2D<T, 64>(std::max<size_t>(lm, 1), std::max<size_t>(ln, 1)))
+			{
+				std::fill(data[0], data[0] + std::max<size_t>(lm, 1) * std::max<size_t>(ln, 1), T(0));
+			}
+
+			const grid& process_grid() const { return *g; }
+			size_t rows() const { return M; }
+			size_t cols() const { return N; }
+			size_t row_block() const { return mb; }
+			size_t col_block() const { return nb; }
+			size_t local_rows() const { return lm; }
+			size_t local_cols() const { return ln; }
+
+			/** \brief Local blocks, local_rows() × local_cols(), contiguous */
+			T** local() const { return data.get(); }
+
+			/** \brief Global row of local row i */
+			size_t global_row(const size_t i) const { return global_index(i, mb, g->row, g->rows); }
+
+			/** \brief Global column of local column j */
+			size_t global_col(const size_t j) const { return global_index(j, nb, g->col, g->cols); }
+
+			/**
+			 * \brief Distribute the global M×N matrix A, significant on root only.
+			 */
+			void
+			scatter(T** A, const int root = 0)
+			{
+				if (g->rank == root)
+				{
+					right<T>("distributed::scatter:", std::make_tuple(A, M, N));
+					std::vector<T> buffer;
+					for (int r = 0; r < g->rows; ++r)
+						for (int c = 0; c < g->cols; ++c)
+						{
+							const size_t count = local_extent(M, mb, r, g->rows) * local_extent(N, nb, c, g->cols);
+							if (g->owner(r, c) == root)
+							{
+								_pack(A, data[0], r, c);
+								continue;
+							}
+							buffer.resize(count);
+							_pack(A, buffer.data(), r, c);
+							MPI_Send(buffer.data(), int(count), _mpi_type<T>(), g->owner(r, c), 0, g->comm);
+						}
+				}
+				else
+					MPI_Recv(data[0], int(lm * ln), _mpi_type<T>(), root, 0, g->comm, MPI_STATUS_IGNORE);
+			}
+
+			/**
+			 * \brief Collect the matrix into the global M×N matrix A, significant on root only.
+			 */
+			void
+			gather(T** A, const int root = 0) const
+			{
+				if (g->rank == root)
+				{
+					right<T>("distributed::gather:", std::make_tuple(A, M, N));
+					std::vector<T> buffer;
+					for (int r = 0; r < g->rows; ++r)
+						for (int c = 0; c < g->cols; ++c)
+						{
+							const size_t count = local_extent(M, mb, r, g->rows) * local_extent(N, nb, c, g->cols);
+							if (g->owner(r, c) == root)
+							{
+								_unpack(data[0], A, r, c);
+								continue;
+							}
+							buffer.resize(count);
+							MPI_Recv(buffer.data(), int(count), _mpi_type<T>(), g->owner(r, c), 1, g->comm, MPI_STATUS_IGNORE);
+							_unpack(buffer.data(), A, r, c);
+						}
+				}
+				else
+					MPI_Send(data[0], int(lm * ln), _mpi_type<T>(), root, 1, g->comm);
+			}
+		};
+
+		/**
+		 * \brief Distributed matrix multiplication C += A × B (SUMMA).
+		 *
+		 * \tparam T	Element type
+		 * \tparam S	SIMD instruction set for the local multiply
+		 * \tparam K	Kernel policy for the local multiply
+		 *
+		 * \param A		M×K, row blocks equal to those of C
+		 * \param B		K×N, row blocks equal to the column blocks of A, column blocks equal to those of C
+		 * \param C		M×N, accumulated into like multiply
+		 *
+		 * \throws std::invalid_argument if the shapes, blocks or grids do not conform
+		 */
+		template<typename T, typename S = decltype(detect_simd()), template<typename, typename> class K = multiply_kernel>
+		inline void
+		multiply(const matrix<T>& A, const matrix<T>& B, matrix<T>& C)
+		{
+			const grid& g = C.process_grid();
+			if (&A.process_grid() != &g || &B.process_grid() != &g)
+				throw std::invalid_argument("distributed::multiply: matrices must share a grid");
+			if (A.cols() != B.rows() || A.rows() != C.rows() || B.cols() != C.cols())
+				throw std::invalid_argument("distributed::multiply: shapes do not conform");
+			if (A.col_block() != B.row_block() || A.row_block() != C.row_block() || B.col_block() != C.col_block())
+				throw std::invalid_argument("distributed::multiply: block sizes do not conform");
+
+			const size_t kb = A.col_block();
+			const size_t Kdim = A.cols();
+			const size_t steps = (Kdim + kb - 1) / kb;
+			const size_t lm = C.local_rows();
+			const size_t ln = C.local_cols();
+
+			// Double-buffered panels: step t + 1 is in flight while step t is multiplied
+			std::vector<T> a_panel[2], b_panel[2];
+			for (int s = 0; s < 2; ++s)
+			{
+				a_panel[s].resize(std::max<size_t>(lm * kb, 1));
+				b_panel[s].resize(std::max<size_t>(kb * ln, 1));
+			}
+			MPI_Request requests[2][2];
+
+			auto post = [&](const size_t t)
+			{
+				const int s = t & 1;
+				const size_t w = std::min(kb, Kdim - t * kb);
+				const int a_root = t % g.cols;
+				const int b_root = t % g.rows;
+
+				if (g.col == a_root)
+				{
+					const size_t j0 = (t / g.cols) * kb;
+					for (size_t i = 0; i < lm; ++i)
+						std::copy(A.local()[i] + j0, A.local()[i] + j0 + w, a_panel[s].data() + i * w);
+				}
+				if (g.row == b_root)
+				{
+					const size_t i0 = (t / g.rows) * kb;
+					for (size_t i = 0; i < w; ++i)
+						std::copy(B.local()[i0 + i], B.local()[i0 + i] + ln, b_panel[s].data() + i * ln);
+				}
+
+				MPI_Ibcast(a_panel[s].data(), int(lm * w), _mpi_type<T>(), a_root, g.row_comm, &requests[s][0]);
+				MPI_Ibcast(b_panel[s].data(), int(w * ln), _mpi_type<T>(), b_root, g.col_comm, &requests[s][1]);
+			};
+
+			std::vector<T*> a_rows(std::max<size_t>(lm, 1)), b_rows(kb);
+
+			if (steps != 0)
+				post(0);
+
+			for (size_t t = 0; t < steps; ++t)
+			{
+				const int s = t & 1;
+				const size_t w = std::min(kb, Kdim - t * kb);
+
+				MPI_Waitall(2, requests[s], MPI_STATUSES_IGNORE);
+				if (t + 1 < steps)
+					post(t + 1);
+
+				if (lm == 0 || ln == 0)
+					continue;
+
+				for (size_t i = 0; i < lm; ++i)
+					a_rows[i] = a_panel[s].data() + i * w;
+				for (size_t i = 0; i < w; ++i)
+					b_rows[i] = b_panel[s].data() + i * ln;
+
+				damm::multiply<T, S, K>(a_rows.data(), b_rows.data(), C.local(), lm, w, ln);
+			}
+		}
+
+		/**
+		 * \brief Distributed transpose B = Aᵀ.
+		 *
+		 * Every block of A is transposed locally and sent to the owner of the matching
+		 * block of B in a single MPI_Alltoallv.
+		 *
+		 * \param A		M×N with blocks mb×nb
+		 * \param B		N×M with blocks nb×mb, on the same grid
+		 *
+		 * \throws std::invalid_argument if the shapes, blocks or grids do not conform
+		 */
+		template<typename T>
+		inline void
+		transpose(const matrix<T>& A, matrix<T>& B)
+		{
+			const grid& g = A.process_grid();
+			if (&B.process_grid() != &g)
+				throw std::invalid_argument("distributed::transpose: matrices must share a grid");
+			if (A.rows() != B.cols() || A.cols() != B.rows())
+				throw std::invalid_argument("distributed::transpose: shapes do not conform");
+			if (A.row_block() != B.col_block() || A.col_block() != B.row_block())
+				throw std::invalid_argument("distributed::transpose: block sizes do not conform");
+
+			const size_t mb = A.row_block();
+			const size_t nb = A.col_block();
+			const size_t a_rows = (A.local_rows() + mb - 1) / mb;
+			const size_t a_cols = (A.local_cols() + nb - 1) / nb;
+			const size_t b_rows = (B.local_rows() + nb - 1) / nb;
+			const size_t b_cols = (B.local_cols() + mb - 1) / mb;
+			const int P = g.rows * g.cols;
+
+			// Block (I, J) of A becomes block (J, I) of B, owned by (J mod P_r, I mod P_c)
+			auto destination = [&](const size_t I, const size_t J) { return g.owner(J % g.rows, I % g.cols); };
+			auto extent = [](const size_t l, const size_t b, const size_t local) { return std::min(b, local - l * b); };
+
+			std::vector<int> send_counts(P, 0), recv_counts(P, 0), send_offsets(P, 0), recv_offsets(P, 0);
+
+			for (size_t bi = 0; bi < a_rows; ++bi)
+				for (size_t bj = 0; bj < a_cols; ++bj)
+				{
+					const size_t I = bi * g.rows + g.row;
+					const size_t J = bj * g.cols + g.col;
+					send_counts[destination(I, J)] += extent(bi, mb, A.local_rows()) * extent(bj, nb, A.local_cols());
+				}
+
+			// Block (I', J') of B is block (J', I') of A, owned by (I' mod P_r, J' mod P_c)
+			for (size_t bi = 0; bi < b_rows; ++bi)
+				for (size_t bj = 0; bj < b_cols; ++bj)
+				{
+					const size_t I = bi * g.rows + g.row;
+					const size_t J = bj * g.cols + g.col;
+					recv_counts[g.owner(J % g.rows, I % g.cols)] += extent(bi, nb, B.local_rows()) * extent(bj, mb, B.local_cols());
+				}
+
+			for (int p = 1; p < P; ++p)
+			{
+				send_offsets[p] = send_offsets[p - 1] + send_counts[p - 1];
+				recv_offsets[p] = recv_offsets[p - 1] + recv_counts[p - 1];
+			}
+
+			std::vector<T> send(std::max(send_offsets[P - 1] + send_counts[P - 1], 1));
+			std::vector<T> recv(std::max(recv_offsets[P - 1] + recv_counts[P - 1], 1));
+
+			// Blocks travel in ascending (I, J) order of A on both sides
+			std::vector<int> cursor(send_offsets);
+			for (size_t bi = 0; bi < a_rows; ++bi)
+				for (size_t bj = 0; bj < a_cols; ++bj)
+				{
+					const size_t h = extent(bi, mb, A.local_rows());
+					const size_t w = extent(bj, nb, A.local_cols());
+					T* dst = send.data() + cursor[destination(bi * g.rows + g.row, bj * g.cols + g.col)];
+					for (size_t j = 0; j < w; ++j)
+						for (size_t i = 0; i < h; ++i)
+							dst[j * h + i] = A.local()[bi * mb + i][bj * nb + j];
+					cursor[destination(bi * g.rows + g.row, bj * g.cols + g.col)] += h * w;
+				}
+
+			MPI_Alltoallv(send.data(), send_counts.data(), send_offsets.data(), _mpi_type<T>(),
+				recv.data(), recv_counts.data(), recv_offsets.data(), _mpi_type<T>(), g.comm);
+
+			// Ascending (I, J) of A is ascending (J', I') of B: columns of blocks outermost
+			cursor = recv_offsets;
+			for (size_t bj = 0; bj < b_cols; ++bj)
+				for (size_t bi = 0; bi < b_rows; ++bi)
+				{
+					const size_t I = bi * g.rows + g.row;
+					const size_t J = bj * g.cols + g.col;
+					const int src = g.owner(J % g.rows, I % g.cols);
+					const size_t h = extent(bi, nb, B.local_rows());
+					const size_t w = extent(bj, mb, B.local_cols());
+					const T* from = recv.data() + cursor[src];
+					for (size_t i = 0; i < h; ++i)
+						std::copy(from + i * w, from + (i + 1) * w, B.local()[bi * nb + i] + bj * mb);
+					cursor[src] += h * w;
+				}
+		}
+
+	} // namespace distributed
+
+} //namespace damm
+
+#endif //__DISTRIBUTED_H__
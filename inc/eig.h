@@ -0,0 +1,911 @@
+#ifndef __EIG_H__
+#define __EIG_H__
+/**
+ * \file eig.h
+ * \brief definitions for nonsymmetric eigenvalue problems
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <common.h>
+#include <damm_memory.h>
+#include <broadcast.h>
+#include <multiply.h>
+#include <householder.h>
+
+/**
+ * \brief Eigenvalues and Schur vectors of general (nonsymmetric) matrices.
+ *
+ * eig::general computes A = Z·T·Zᴴ with Z unitary and T upper triangular for
+ * complex A, or quasi upper triangular for real A, where each complex conjugate
+ * pair of eigenvalues stays in a 2×2 diagonal block. It runs in two phases.
+ *
+ * hessenberg reduces A to upper Hessenberg form H = Qᴴ·A·Q with Householder
+ * reflectors generated by make_householder's convention. Columns are reduced
+ * in panels of nb: inside a panel each column is brought up to date with
+ * matrix-vector products against the panel's reflectors and the accumulated
+ * Y = A·V·T, and the trailing matrix is then updated once per panel with
+ * three multiplies, A ← (I - V·Tᴴ·Vᴴ)·(A - Y·Vᴴ). Almost all the flops of the
+ * reduction land in multiply. The last columns are reduced one reflector at a
+ * time.
+ *
+ * schur runs the implicitly shifted QR algorithm on H. Small active blocks use
+ * Francis double shift sweeps with 3×3 bulges. Large ones first try aggressive
+ * early deflation: the trailing window of H is reduced to Schur form on its
+ * own, eigenvalues whose entries of the spike coupling the window to the rest
+ * of H are negligible are deflated at once, and the remaining window
+ * eigenvalues become the shifts of a multishift sweep, applied as consecutive
+ * double shift sweeps. The window transformation reaches the rest of H and Z
+ * through multiply.
+ */
+namespace damm
+{
+namespace eig
+{
+	/**
+	 * \brief Reflector for x (length n), in place: x becomes v with v[0] = 1.
+	 * Returns beta with (I - tau·v·vᴴ)ᴴ·x = beta·e1, following make_householder.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T>
+	inline T
+	_householder(T* x, const size_t n, T& tau)
+	{
+		using R = typename base<T>::type;
+
+		const T x0 = x[0];
+		R norm2 = 0;
+		for (size_t i = 1; i < n; ++i)
+			norm2 += std::norm(x[i]);
+
+		if (n <= 1 || (norm2 == R(0) && std::imag(x0) == R(0)))
+		{
+			tau = T(0);
+			x[0] = T(1);
+			return x0;
+		}
+
+		R beta = std::sqrt(std::norm(x0) + norm2);
+		if (std::real(x0) >= R(0))
+			beta = -beta;
+
+		tau = (T(beta) - x0) / T(beta);
+		const T scale = T(1) / (x0 - T(beta));
+		x[0] = T(1);
+		for (size_t i = 1; i < n; ++i)
+			x[i] *= scale;
+
+		return T(beta);
+	}
+
+	/**
+	 * \brief A[r0 + i][j] ← (I - tau·v·vᴴ)ᴴ·A over rows [r0, r0 + n), columns [c0, c1).
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T>
+	inline void
+	_reflect_left(T** A, const T* v, const T tau, const size_t r0, const size_t n, const size_t c0, const size_t c1)
+	{
+		if (tau == T(0) || c0 >= c1)
+			return;
+
+		std::vector<T> s(c1 - c0, T(0));
+		for (size_t i = 0; i < n; ++i)
+		{
+			const T vi = conjugate(v[i]);
+			for (size_t j = c0; j < c1; ++j)
+				s[j - c0] += vi * A[r0 + i][j];
+		}
+
+		const T ct = conjugate(tau);
+		for (size_t i = 0; i < n; ++i)
+		{
+			const T f = ct * v[i];
+			for (size_t j = c0; j < c1; ++j)
+				A[r0 + i][j] -= f * s[j - c0];
+		}
+	}
+
+	/**
+	 * \brief A[i][c0 + j] ← A·(I - tau·v·vᴴ) over rows [r0, r1), columns [c0, c0 + n).
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T>
+	inline void
+	_reflect_right(T** A, const T* v, const T tau, const size_t r0, const size_t r1, const size_t c0, const size_t n)
+	{
+		if (tau == T(0))
+			return;
+
+		for (size_t i = r0; i < r1; ++i)
+		{
+			T s = T(0);
+			for (size_t j = 0; j < n; ++j)
+				s += A[i][c0 + j] * v[j];
+			s *= tau;
+			for (size_t j = 0; j < n; ++j)
+				A[i][c0 + j] -= s * conjugate(v[j]);
+		}
+	}
+
+	/**
+	 * \brief Unblocked Hessenberg reduction of columns [c0, ihi - 1) of A.
+	 *
+	 * Reflectors act on rows and columns up to ihi, are applied from the left to
+	 * columns up to cols and from the right to rows up to ihi, and accumulate
+	 * into the first qrows rows of Q when it is given.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T>
+	inline void
+	_hessenberg_unblocked(T** A, T** Q, const size_t cols, const size_t c0, const size_t ihi, const size_t qrows)
+	{
+		std::vector<T> v(ihi + 1);
+
+		for (size_t c = c0; c + 1 < ihi; ++c)
+		{
+			const size_t len = ihi - c;
+			for (size_t i = 0; i < len; ++i)
+				v[i] = A[c + 1 + i][c];
+
+			T tau;
+			const T beta = _householder(v.data(), len, tau);
+			A[c + 1][c] = beta;
+			for (size_t i = c + 2; i <= ihi; ++i)
+				A[i][c] = T(0);
+
+			_reflect_left(A, v.data(), tau, c + 1, len, c + 1, cols);
+			_reflect_right(A, v.data(), tau, 0, ihi + 1, c + 1, len);
+			if (Q)
+				_reflect_right(Q, v.data(), tau, 0, qrows, c + 1, len);
+		}
+	}
+
+	/**
+	 * \brief Copy the rows × cols block of A at (r0, c0) into a contiguous buffer.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline auto
+	_block(T** A, const size_t r0, const size_t c0, const size_t rows, const size_t cols)
+	{
+		auto B = aligned_alloc_2D<T, S::bytes>(rows, cols);
+		for (size_t i = 0; i < rows; ++i)
+			std::copy(A[r0 + i] + c0, A[r0 + i] + c0 + cols, B[i]);
+		return B;
+	}
+
+	/**
+	 * \brief A block at (r0, c0) ← A block · X, with X a k × k contiguous matrix.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline void
+	_multiply_right(T** A, T** X, const size_t r0, const size_t c0, const size_t rows, const size_t k)
+	{
+		if (rows == 0 || k == 0)
+			return;
+
+		auto B = _block<T, S>(A, r0, c0, rows, k);
+		auto C = aligned_alloc_2D<T, S::bytes>(rows, k);
+		zeros<T, S>(C.get(), rows, k);
+		multiply<T, S>(B.get(), X, C.get(), rows, k, k);
+		for (size_t i = 0; i < rows; ++i)
+			std::copy(C[i], C[i] + k, A[r0 + i] + c0);
+	}
+
+	/**
+	 * \brief A block at (r0, c0) ← Xᴴ · A block, with X a k × k contiguous matrix.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline void
+	_multiply_left_adjoint(T** A, T** X, const size_t r0, const size_t c0, const size_t k, const size_t cols)
+	{
+		if (cols == 0 || k == 0)
+			return;
+
+		auto XH = aligned_alloc_2D<T, S::bytes>(k, k);
+		for (size_t i = 0; i < k; ++i)
+			for (size_t j = 0; j < k; ++j)
+				XH[i][j] = conjugate(X[j][i]);
+
+		auto B = _block<T, S>(A, r0, c0, k, cols);
+		auto C = aligned_alloc_2D<T, S::bytes>(k, cols);
+		zeros<T, S>(C.get(), k, cols);
+		multiply<T, S>(XH.get(), B.get(), C.get(), k, k, cols);
+		for (size_t i = 0; i < k; ++i)
+			std::copy(C[i], C[i] + cols, A[r0 + i] + c0);
+	}
+
+	/**
+	 * \brief Reduce one panel of ib columns starting at column c.
+	 *
+	 * On return the panel columns hold their Hessenberg form below row c, V
+	 * ((N - c - 1) × ib, unit lower trapezoidal) holds the reflectors, T (ib × ib,
+	 * upper triangular) their compact WY factor with H_0···H_{ib-1} = I - V·T·Vᴴ,
+	 * and Y (N × ib) = A·V·T for the matrix A as it was on entry.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline void
+	_hessenberg_panel(T** A, T** V, T** Tf, T** Y, const size_t N, const size_t c, const size_t ib)
+	{
+		const size_t r0 = c + 1;      // first row touched by the reflectors
+		const size_t nr = N - r0;     // rows of V
+		std::vector<T> b(nr), w(ib), t(ib);
+
+		for (size_t p = 0; p < ib; ++p)
+		{
+			const size_t j = c + p;
+
+			for (size_t r = 0; r < nr; ++r)
+				b[r] = A[r0 + r][j];
+
+			if (p > 0)
+			{
+				// Right update: b -= Y·(row j of V)ᴴ; row j of V is V[p - 1]
+				for (size_t r = 0; r < nr; ++r)
+				{
+					T s = T(0);
+					for (size_t q = 0; q < p; ++q)
+						s += Y[r0 + r][q] * conjugate(V[p - 1][q]);
+					b[r] -= s;
+				}
+
+				// Left update: b -= V·Tᴴ·Vᴴ·b
+				std::fill(w.begin(), w.begin() + p, T(0));
+				for (size_t r = 0; r < nr; ++r)
+					for (size_t q = 0; q < p; ++q)
+						w[q] += conjugate(V[r][q]) * b[r];
+
+				for (size_t q = p; q-- > 0; )
+				{
+					T s = T(0);
+					for (size_t l = 0; l <= q; ++l)
+						s += conjugate(Tf[l][q]) * w[l];
+					w[q] = s;
+				}
+
+				for (size_t r = 0; r < nr; ++r)
+				{
+					T s = T(0);
+					for (size_t q = 0; q < p; ++q)
+						s += V[r][q] * w[q];
+					b[r] -= s;
+				}
+			}
+
+			// Reflector for rows r0 + p onward
+			T tau;
+			const T beta = _householder(b.data() + p, nr - p, tau);
+
+			for (size_t r = 0; r < p; ++r)
+				A[r0 + r][j] = b[r];
+			A[r0 + p][j] = beta;
+			for (size_t r = p + 1; r < nr; ++r)
+				A[r0 + r][j] = T(0);
+
+			for (size_t r = 0; r < nr; ++r)
+				V[r][p] = r < p ? T(0) : b[r];
+
+			// Y[r0:, p] = tau·(A[r0:, r0 + p:]·v - Y[r0:, :p]·(Vᴴ·v))
+			std::fill(t.begin(), t.begin() + p, T(0));
+			for (size_t r = p; r < nr; ++r)
+				for (size_t q = 0; q < p; ++q)
+					t[q] += conjugate(V[r][q]) * V[r][p];
+
+			#pragma omp parallel for schedule(static) if(nr * nr > 65536)
+			for (size_t r = 0; r < nr; ++r)
+			{
+				T s = T(0);
+				const T* row = A[r0 + r] + r0;
+				for (size_t l = p; l < nr; ++l)
+					s += row[l] * V[l][p];
+				for (size_t q = 0; q < p; ++q)
+					s -= Y[r0 + r][q] * t[q];
+				Y[r0 + r][p] = tau * s;
+			}
+
+			// T[:p, p] = -tau·T[:p, :p]·t
+			for (size_t q = 0; q < p; ++q)
+			{
+				T s = T(0);
+				for (size_t l = q; l < p; ++l)
+					s += Tf[q][l] * t[l];
+				Tf[q][p] = -tau * s;
+			}
+			for (size_t q = p + 1; q < ib; ++q)
+				Tf[q][p] = T(0);
+			Tf[p][p] = tau;
+		}
+
+		// Top rows of Y: A[:r0, r0:]·V·T
+		auto top = _block<T, S>(A, 0, r0, r0, nr);
+		auto AV = aligned_alloc_2D<T, S::bytes>(r0, ib);
+		zeros<T, S>(AV.get(), r0, ib);
+		multiply<T, S>(top.get(), V, AV.get(), r0, nr, ib);
+
+		auto Yt = aligned_alloc_2D<T, S::bytes>(r0, ib);
+		zeros<T, S>(Yt.get(), r0, ib);
+		multiply<T, S>(AV.get(), Tf, Yt.get(), r0, ib, ib);
+		for (size_t i = 0; i < r0; ++i)
+			std::copy(Yt[i], Yt[i] + ib, Y[i]);
+	}
+
+	/**
+	 * \brief Reduce A to upper Hessenberg form H = Qᴴ·A·Q.
+	 *
+	 * \tparam T	Scalar type (float, double, or complex variants)
+	 * \tparam S	SIMD instruction set for the multiplies
+	 *
+	 * \param A		Input matrix (N×N), overwritten with H, zeros below the subdiagonal
+	 * \param N		Matrix dimension
+	 * \param Q		Optional (N×N), overwritten with the unitary Q
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	hessenberg(T** A, const size_t N, T** Q = nullptr)
+	{
+		right<T>("hessenberg:", std::make_tuple(A, N, N));
+		if (Q)
+		{
+			right<T>("hessenberg:", std::make_tuple(Q, N, N));
+			identity<T, S>(Q, N, N);
+		}
+
+		// Panel width, and the size below which the rest is reduced unblocked
+		constexpr size_t nb = 32;
+		constexpr size_t nx = 128;
+
+		size_t c = 0;
+		if (N > nx)
+		{
+			auto Tf = aligned_alloc_2D<T, S::bytes>(nb, nb);
+
+			for (; c + nx < N; c += nb)
+			{
+				const size_t ib = nb;
+				const size_t r0 = c + 1;
+				const size_t nr = N - r0;
+
+				auto V = aligned_alloc_2D<T, S::bytes>(nr, ib);
+				auto Y = aligned_alloc_2D<T, S::bytes>(N, ib);
+				_hessenberg_panel<T, S>(A, V.get(), Tf.get(), Y.get(), N, c, ib);
+
+				// Vᴴ, ib × nr
+				auto VH = aligned_alloc_2D<T, S::bytes>(ib, nr);
+				for (size_t r = 0; r < nr; ++r)
+					for (size_t q = 0; q < ib; ++q)
+						VH[q][r] = conjugate(V[r][q]);
+
+				// Right: A[:, c + ib:] -= Y·Vᴴ[:, ib - 1:]
+				{
+					const size_t cols = N - c - ib;
+					auto Vt = _block<T, S>(VH.get(), 0, ib - 1, ib, cols);
+					auto D = aligned_alloc_2D<T, S::bytes>(N, cols);
+					zeros<T, S>(D.get(), N, cols);
+					multiply<T, S>(Y.get(), Vt.get(), D.get(), N, ib, cols);
+					#pragma omp parallel for schedule(static)
+					for (size_t i = 0; i < N; ++i)
+						for (size_t j = 0; j < cols; ++j)
+							A[i][c + ib + j] -= D[i][j];
+				}
+
+				// Right: A[:r0, r0:c + ib] -= Y[:r0]·Vᴴ[:, :ib - 1]
+				for (size_t i = 0; i < r0; ++i)
+					for (size_t j = 0; j + 1 < ib; ++j)
+					{
+						T s = T(0);
+						for (size_t q = 0; q <= j; ++q)
+							s += Y[i][q] * VH[q][j];
+						A[i][r0 + j] -= s;
+					}
+
+				// Left: A[r0:, c + ib:] -= V·Tᴴ·Vᴴ·A[r0:, c + ib:]
+				{
+					const size_t cols = N - c - ib;
+					auto B = _block<T, S>(A, r0, c + ib, nr, cols);
+					auto W = aligned_alloc_2D<T, S::bytes>(ib, cols);
+					zeros<T, S>(W.get(), ib, cols);
+					multiply<T, S>(VH.get(), B.get(), W.get(), ib, nr, cols);
+
+					auto TH = aligned_alloc_2D<T, S::bytes>(ib, ib);
+					for (size_t i = 0; i < ib; ++i)
+						for (size_t j = 0; j < ib; ++j)
+							TH[i][j] = conjugate(Tf[j][i]);
+					auto W2 = aligned_alloc_2D<T, S::bytes>(ib, cols);
+					zeros<T, S>(W2.get(), ib, cols);
+					multiply<T, S>(TH.get(), W.get(), W2.get(), ib, ib, cols);
+
+					zeros<T, S>(B.get(), nr, cols);
+					multiply<T, S>(V.get(), W2.get(), B.get(), nr, ib, cols);
+					#pragma omp parallel for schedule(static)
+					for (size_t i = 0; i < nr; ++i)
+						for (size_t j = 0; j < cols; ++j)
+							A[r0 + i][c + ib + j] -= B[i][j];
+				}
+
+				// Q[:, r0:] -= Q[:, r0:]·V·T·Vᴴ
+				if (Q)
+				{
+					auto Qs = _block<T, S>(Q, 0, r0, N, nr);
+					auto QV = aligned_alloc_2D<T, S::bytes>(N, ib);
+					zeros<T, S>(QV.get(), N, ib);
+					multiply<T, S>(Qs.get(), V.get(), QV.get(), N, nr, ib);
+					auto QVT = aligned_alloc_2D<T, S::bytes>(N, ib);
+					zeros<T, S>(QVT.get(), N, ib);
+					multiply<T, S>(QV.get(), Tf.get(), QVT.get(), N, ib, ib);
+					zeros<T, S>(Qs.get(), N, nr);
+					multiply<T, S>(QVT.get(), VH.get(), Qs.get(), N, ib, nr);
+					#pragma omp parallel for schedule(static)
+					for (size_t i = 0; i < N; ++i)
+						for (size_t j = 0; j < nr; ++j)
+							Q[i][r0 + j] -= Qs[i][j];
+				}
+			}
+		}
+
+		if (N > 0)
+			_hessenberg_unblocked(A, Q, N, c, N - 1, N);
+	}
+
+	/**
+	 * \brief Eigenvalues of the diagonal blocks of the quasi triangular T[lo:hi, lo:hi].
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T>
+	inline void
+	_block_eigenvalues(T** H, const size_t lo, const size_t hi, std::complex<typename base<T>::type>* w)
+	{
+		using R = typename base<T>::type;
+		using C = std::complex<R>;
+
+		for (size_t i = lo; i < hi; )
+		{
+			if (i + 1 < hi && H[i + 1][i] != T(0))
+			{
+				const C a = H[i][i], b = H[i][i + 1], c = H[i + 1][i], d = H[i + 1][i + 1];
+				const C m = (a + d) / R(2);
+				const C r = std::sqrt((a - d) * (a - d) / R(4) + b * c);
+				w[i - lo] = m + r;
+				w[i + 1 - lo] = m - r;
+				if constexpr (!is_complex_v<T>)
+				{
+					// A real pair is conjugate; keep the positive imaginary part first
+					w[i - lo] = C(m.real(), std::abs(r.imag()));
+					w[i + 1 - lo] = C(m.real(), -std::abs(r.imag()));
+				}
+				i += 2;
+			}
+			else
+			{
+				w[i - lo] = C(H[i][i]);
+				i += 1;
+			}
+		}
+	}
+
+	/**
+	 * \brief Triangularize the 2×2 block at rows and columns p, p + 1 when its
+	 * eigenvalues allow, with a rotation applied across H (N×N) and Z.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T>
+	inline void
+	_standardize(T** H, T** Z, const size_t N, const size_t nz, const size_t p)
+	{
+		using R = typename base<T>::type;
+
+		const T a = H[p][p], b = H[p][p + 1], c = H[p + 1][p], d = H[p + 1][p + 1];
+		if (c == T(0))
+			return;
+
+		const T half = (a - d) / R(2);
+		T root;
+		if constexpr (is_complex_v<T>)
+			root = std::sqrt(half * half + b * c);
+		else
+		{
+			const R disc = half * half + b * c;
+			if (disc < R(0))
+				return; // complex conjugate pair, stays a 2×2 block
+			root = std::sqrt(disc);
+		}
+
+		// Eigenvalue farther from d, to avoid cancellation in λ - d
+		const T lambda = (a + d) / R(2) + (std::abs(half + root) >= std::abs(half - root) ? root : -root);
+
+		// Eigenvector for λ: (b, λ - a) or (λ - d, c), the larger one
+		T q0 = b, q1 = lambda - a;
+		if (std::norm(lambda - d) + std::norm(c) > std::norm(q0) + std::norm(q1))
+		{
+			q0 = lambda - d;
+			q1 = c;
+		}
+		const R scale = std::sqrt(std::norm(q0) + std::norm(q1));
+		if (scale == R(0))
+			return;
+		q0 /= scale;
+		q1 /= scale;
+
+		// G = [q0 -conj(q1); q1 conj(q0)], Gᴴ·H·G is upper triangular in the block
+		for (size_t j = p; j < N; ++j)
+		{
+			const T x = H[p][j], y = H[p + 1][j];
+			H[p][j] = conjugate(q0) * x + conjugate(q1) * y;
+			H[p + 1][j] = -q1 * x + q0 * y;
+		}
+		for (size_t i = 0; i <= p + 1; ++i)
+		{
+			const T x = H[i][p], y = H[i][p + 1];
+			H[i][p] = x * q0 + y * q1;
+			H[i][p + 1] = -x * conjugate(q1) + y * conjugate(q0);
+		}
+		if (Z)
+			for (size_t i = 0; i < nz; ++i)
+			{
+				const T x = Z[i][p], y = Z[i][p + 1];
+				Z[i][p] = x * q0 + y * q1;
+				Z[i][p + 1] = -x * conjugate(q1) + y * conjugate(q0);
+			}
+
+		H[p + 1][p] = T(0);
+	}
+
+	/**
+	 * \brief One implicit double shift sweep over the active block [ktop, kbot],
+	 * with shifts given by their sum tr and product det.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T>
+	inline void
+	_sweep(T** H, T** Z, const size_t N, const size_t nz, const size_t ktop, const size_t kbot, const T tr, const T det)
+	{
+		T v[3];
+
+		for (size_t k = ktop; k < kbot; ++k)
+		{
+			const size_t nr = std::min<size_t>(3, kbot - k + 1);
+
+			if (k == ktop)
+			{
+				const T h00 = H[k][k], h01 = H[k][k + 1], h10 = H[k + 1][k], h11 = H[k + 1][k + 1];
+				v[0] = h00 * h00 + h01 * h10 - tr * h00 + det;
+				v[1] = h10 * (h00 + h11 - tr);
+				v[2] = nr == 3 ? h10 * H[k + 2][k + 1] : T(0);
+			}
+			else
+			{
+				v[0] = H[k][k - 1];
+				v[1] = H[k + 1][k - 1];
+				v[2] = nr == 3 ? H[k + 2][k - 1] : T(0);
+			}
+
+			T tau;
+			const T beta = _householder(v, nr, tau);
+
+			if (k > ktop)
+			{
+				H[k][k - 1] = beta;
+				H[k + 1][k - 1] = T(0);
+				if (nr == 3)
+					H[k + 2][k - 1] = T(0);
+			}
+
+			_reflect_left(H, v, tau, k, nr, k, N);
+			_reflect_right(H, v, tau, 0, std::min(k + 4, kbot + 1), k, nr);
+			if (Z)
+				_reflect_right(Z, v, tau, 0, nz, k, nr);
+		}
+	}
+
+	/**
+	 * \brief Whether H[k][k - 1] is negligible next to its diagonal neighbours.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T>
+	inline bool
+	_negligible(T** H, const size_t k)
+	{
+		using R = typename base<T>::type;
+		constexpr R ulp = std::numeric_limits<R>::epsilon();
+		constexpr R small = std::numeric_limits<R>::min() / ulp;
+
+		const R sub = std::abs(H[k][k - 1]);
+		const R diag = std::abs(H[k - 1][k - 1]) + std::abs(H[k][k]);
+		return sub <= std::max(small, ulp * diag);
+	}
+
+	template<typename T, typename S>
+	inline bool _qr(T** H, T** Z, const size_t N, const size_t nz, const bool aed);
+
+	/**
+	 * \brief Aggressive early deflation on the window of nw rows ending at kbot.
+	 *
+	 * Returns the number of eigenvalues deflated, and appends the eigenvalues of
+	 * the undeflated part of the window, bottom last, to shifts.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline size_t
+	_aed(T** H, T** Z, const size_t N, const size_t nz, const size_t ktop, const size_t kbot, const size_t nw,
+		std::vector<std::complex<typename base<T>::type>>& shifts)
+	{
+		using R = typename base<T>::type;
+		constexpr R ulp = std::numeric_limits<R>::epsilon();
+		constexpr R small = std::numeric_limits<R>::min() / ulp;
+
+		const size_t kwtop = kbot + 1 - nw;
+		const T s = kwtop > ktop ? H[kwtop][kwtop - 1] : T(0);
+
+		auto Tw = _block<T, S>(H, kwtop, kwtop, nw, nw);
+		auto Vw = aligned_alloc_2D<T, S::bytes>(nw, nw);
+		identity<T, S>(Vw.get(), nw, nw);
+
+		for (size_t i = 2; i < nw; ++i)
+			for (size_t j = 0; j + 1 < i; ++j)
+				Tw[i][j] = T(0);
+
+		if (!_qr<T, S>(Tw.get(), Vw.get(), nw, nw, false))
+			return 0;
+
+		// Deflate from the bottom while the spike is negligible
+		size_t ns = nw;
+		while (ns > 0)
+		{
+			const bool pair = ns >= 2 && Tw[ns - 1][ns - 2] != T(0);
+			R foo = std::abs(Tw[ns - 1][ns - 1]);
+			R spike = std::abs(s * Vw[0][ns - 1]);
+			if (pair)
+			{
+				foo += std::sqrt(std::abs(Tw[ns - 1][ns - 2])) * std::sqrt(std::abs(Tw[ns - 2][ns - 1]));
+				spike = std::max(spike, std::abs(s * Vw[0][ns - 2]));
+			}
+			if (foo == R(0))
+				foo = std::abs(s);
+			if (spike > std::max(small, ulp * foo))
+				break;
+			ns -= pair ? 2 : 1;
+		}
+
+		const size_t nd = nw - ns;
+
+		std::vector<std::complex<R>> ev(ns);
+		_block_eigenvalues(Tw.get(), 0, ns, ev.data());
+		shifts.insert(shifts.end(), ev.begin(), ev.end());
+
+		if (nd == 0)
+			return 0;
+
+		// The spike Vwᴴ·(s·e1), cut to the undeflated rows, and H back to Hessenberg
+		std::vector<T> sp(nw, T(0));
+		for (size_t i = 0; i < ns; ++i)
+			sp[i] = s * conjugate(Vw[0][i]);
+
+		if (ns > 1 && s != T(0))
+		{
+			T tau;
+			const T beta = _householder(sp.data(), ns, tau);
+			_reflect_left(Tw.get(), sp.data(), tau, 0, ns, 0, nw);
+			_reflect_right(Tw.get(), sp.data(), tau, 0, nw, 0, ns);
+			_reflect_right(Vw.get(), sp.data(), tau, 0, nw, 0, ns);
+			std::fill(sp.begin(), sp.end(), T(0));
+			sp[0] = beta;
+
+			_hessenberg_unblocked(Tw.get(), Vw.get(), nw, 0, ns - 1, nw);
+		}
+
+		for (size_t i = 0; i < nw; ++i)
+			for (size_t j = 0; j < nw; ++j)
+				H[kwtop + i][kwtop + j] = j + 1 < i ? T(0) : Tw[i][j];
+		if (kwtop > ktop)
+			for (size_t i = 0; i < nw; ++i)
+				H[kwtop + i][kwtop - 1] = sp[i];
+
+		// The window transformation reaches the rest of H and Z
+		_multiply_right<T, S>(H, Vw.get(), 0, kwtop, kwtop, nw);
+		_multiply_left_adjoint<T, S>(H, Vw.get(), kwtop, kbot + 1, nw, N - kbot - 1);
+		if (Z)
+			_multiply_right<T, S>(Z, Vw.get(), 0, kwtop, nz, nw);
+
+		return nd;
+	}
+
+	/**
+	 * \brief Shifted QR iteration of the Hessenberg H (N×N) to Schur form.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline bool
+	_qr(T** H, T** Z, const size_t N, const size_t nz, const bool aed)
+	{
+		using R = typename base<T>::type;
+		using C = std::complex<R>;
+
+		constexpr size_t nmin = 75;         // smallest active block that uses early deflation
+		constexpr R nibble = R(0.14);       // deflated fraction that skips the sweep
+
+		if (N == 0)
+			return true;
+
+		const size_t limit = 30 * std::max<size_t>(10, N);
+		size_t its = 0, stalled = 0;
+		std::vector<C> shifts;
+
+		for (size_t kbot = N - 1; kbot != size_t(-1); )
+		{
+			size_t ktop = kbot;
+			while (ktop > 0 && !_negligible(H, ktop))
+				--ktop;
+			if (ktop > 0)
+				H[ktop][ktop - 1] = T(0);
+
+			if (ktop == kbot)
+			{
+				--kbot;
+				stalled = 0;
+				continue;
+			}
+			if (ktop + 1 == kbot)
+			{
+				_standardize(H, Z, N, nz, ktop);
+				kbot = ktop == 0 ? size_t(-1) : ktop - 1;
+				stalled = 0;
+				continue;
+			}
+
+			if (++its > limit)
+				return false;
+			++stalled;
+
+			const size_t active = kbot - ktop + 1;
+			shifts.clear();
+
+			if (aed && active >= nmin)
+			{
+				const size_t ns = active < 150 ? 10
+					: active < 590 ? std::max<size_t>(10, active / size_t(std::log2(double(active))))
+					: active < 3000 ? 64 : 128;
+				const size_t nw = std::min(active, ns + ns / 2);
+
+				const size_t nd = _aed<T, S>(H, Z, N, nz, ktop, kbot, nw, shifts);
+				if (nd > 0)
+				{
+					kbot -= nd;
+					stalled = 0;
+					if (R(nd) > nibble * R(nw))
+						continue;
+				}
+
+				// Keep the bottom ns shifts
+				if (shifts.size() > ns)
+					shifts.erase(shifts.begin(), shifts.end() - ns);
+			}
+
+			if (shifts.size() < 2 || stalled % 10 == 0)
+			{
+				shifts.clear();
+				// The active block keeps at least three rows here, so m - 2 ≥ ktop
+				const size_t m = kbot;
+				if (stalled % 10 == 0)
+				{
+					// Exceptional shift
+					const R e = std::abs(H[m][m - 1]) + std::abs(H[m - 1][m - 2]);
+					const T h = T(R(0.75) * e) + H[m][m];
+					const T tr = R(2) * h;
+					const T det = h * h + T(R(0.4375) * e * e);
+					_sweep(H, Z, N, nz, ktop, m, tr, det);
+					continue;
+				}
+				const T tr = H[m - 1][m - 1] + H[m][m];
+				const T det = H[m - 1][m - 1] * H[m][m] - H[m - 1][m] * H[m][m - 1];
+				_sweep(H, Z, N, nz, ktop, m, tr, det);
+				continue;
+			}
+
+			// Multishift: consecutive double shift sweeps, shifts taken in pairs
+			// from the bottom; real matrices pair conjugates and reals.
+			std::vector<std::pair<T, T>> pairs;
+			for (size_t i = shifts.size(); i >= 2; )
+			{
+				const C a = shifts[i - 1], b = shifts[i - 2];
+				if constexpr (!is_complex_v<T>)
+				{
+					if (a.imag() != R(0) && b != std::conj(a))
+					{
+						--i;
+						continue;
+					}
+				}
+				if constexpr (is_complex_v<T>)
+					pairs.emplace_back(a + b, a * b);
+				else
+					pairs.emplace_back((a + b).real(), (a * b).real());
+				i -= 2;
+			}
+
+			for (const auto& [tr, det] : pairs)
+				_sweep(H, Z, N, nz, ktop, kbot, tr, det);
+		}
+
+		return true;
+	}
+
+	/**
+	 * \brief Schur decomposition of an upper Hessenberg matrix.
+	 *
+	 * H is overwritten with T, triangular for complex types and quasi triangular
+	 * for real ones. When Z is given it is multiplied from the right by the
+	 * accumulated unitary transformation, so passing the Q of hessenberg yields
+	 * the Schur vectors of the original matrix.
+	 *
+	 * \param H		Upper Hessenberg input (N×N), overwritten with T
+	 * \param w		Output eigenvalues (N), in the order of the diagonal of T
+	 * \param N		Matrix dimension
+	 * \param Z		Optional (N×N), updated in place
+	 *
+	 * \return true on convergence, false if the iteration limit was reached
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline bool
+	schur(T** H, std::complex<typename base<T>::type>* w, const size_t N, T** Z = nullptr)
+	{
+		right<T>("schur:", std::make_tuple(H, N, N));
+		if (Z)
+			right<T>("schur:", std::make_tuple(Z, N, N));
+
+		if (!_qr<T, S>(H, Z, N, N, true))
+			return false;
+
+		_block_eigenvalues(H, 0, N, w);
+		return true;
+	}
+
+	/**
+	 * \brief Eigenvalues and Schur vectors of a general square matrix.
+	 *
+	 * \tparam T	Scalar type (float, double, or complex variants)
+	 * \tparam S	SIMD instruction set for the multiplies
+	 *
+	 * \param A		Input matrix (N×N), overwritten with the Schur form T
+	 * \param w		Output eigenvalues (N); a real matrix lists each complex
+	 *				conjugate pair with the positive imaginary part first
+	 * \param N		Matrix dimension
+	 * \param Z		Optional (N×N) output Schur vectors, A = Z·T·Zᴴ
+	 *
+	 * \return true on convergence, false if the QR iteration did not converge
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline bool
+	general(T** A, std::complex<typename base<T>::type>* w, const size_t N, T** Z = nullptr)
+	{
+		hessenberg<T, S>(A, N, Z);
+		return schur<T, S>(A, w, N, Z);
+	}
+} // namespace eig
+} // namespace damm
+#endif //__EIG_H__
@@ -0,0 +1,750 @@
+#ifndef __FFT_H__
+#define __FFT_H__
+/**
+ * \file fft.h
+ * \brief definitions for fast Fourier transforms
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <common.h>
+#include <simd.h>
+#include <damm_memory.h>
+#include <omp.h>
+#include <transpose.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+/**
+ * \brief Fast Fourier transforms of complex and real matrices.
+ *
+ * The forward transform of a length n sequence is X[q] = Σ_t x[t]·exp(-2πi·qt/n)
+ * and the inverse uses exp(+2πi·qt/n) and divides by n, so the inverse of the
+ * forward transform returns the input.
+ *
+ * A plan factors n into radix 8, 4 and 2 stages, then 3, 5 and 7, then any
+ * remaining prime, and precomputes the twiddle factors of every stage. The
+ * transform is the Stockham autosort algorithm: stage s, of radix R, after
+ * stages whose radices multiply to Ns, reads
+ *   v[r] = x[j + r·n/R] · ω^(r·k),  k = j mod Ns,  ω = exp(∓2πi/(Ns·R))
+ * applies a length R DFT to v, and writes v[r] to y[(j - k)·R + k + r·Ns].
+ * Buffers alternate between stages and the output is in natural order, so no
+ * bit reversal pass is needed. Once Ns is a multiple of the register width,
+ * consecutive j read consecutive inputs and twiddles and write consecutive
+ * outputs, and the whole butterfly runs on complex SIMD registers.
+ *
+ * Matrices are transformed row by row in parallel. Column and 2D transforms
+ * transpose, transform rows, and transpose back. Real transforms of even length
+ * n run a complex transform of length n/2 on the even and odd samples packed as
+ * real and imaginary parts, and keep the n/2 + 1 nonredundant frequencies.
+ */
+namespace damm
+{
+namespace fft
+{
+	/**
+	 * \brief Sign of the exponent of the transform.
+	 */
+	enum class Direction
+	{
+		FORWARD,    ///< exp(-2πi·qt/n)
+		INVERSE     ///< exp(+2πi·qt/n) / n
+	};
+
+	/**
+	 * \brief Precomputed factorization and twiddle factors for length n transforms.
+	 *
+	 * \tparam T	Complex element type (std::complex<float> or std::complex<double>)
+	 */
+	template<typename T>
+	class plan
+	{
+		static_assert(is_complex_v<T>, "fft::plan requires a complex element type");
+
+	public:
+		/** \brief One Stockham pass */
+		struct stage
+		{
+			size_t radix;       ///< R
+			size_t span;        ///< Ns, product of the radices of earlier stages
+			size_t twiddle;     ///< offset of the (R - 1)·Ns twiddles of this stage
+			size_t root;        ///< offset of the R roots of unity of this stage
+		};
+
+	private:
+		size_t n;
+		std::vector<stage> stages;
+		std::vector<T> twiddles[2];
+		std::vector<T> roots[2];
+
+		/** \brief exp(sign·2πi·a/b), with a reduced mod b before the division */
+		static T
+		_unit(const int sign, const size_t a, const size_t b)
+		{
+			const long double angle = sign * 2 * std::numbers::pi_v<long double> * (a % b) / b;
+			return T(std::cos(angle), std::sin(angle));
+		}
+
+	public:
+		/**
+		 * \param n     Transform length
+		 *
+		 * \throws std::invalid_argument if n is zero
+		 */
+		explicit plan(const size_t n) : n(n)
+		{
+			if (n == 0)
+				throw std::invalid_argument("fft::plan: length must be positive");
+
+			std::vector<size_t> radices;
+			size_t rest = n;
+
+			size_t twos = 0;
+			while (rest % 2 == 0)
+			{
+				rest /= 2;
+				++twos;
+			}
+			// Prefer radix 8, then radix 4, using at most one radix 2 stage
+			for (; twos >= 3 && twos != 4; twos -= 3)
+				radices.push_back(8);
+			for (; twos >= 2; twos -= 2)
+				radices.push_back(4);
+			if (twos == 1)
+				radices.push_back(2);
+
+			for (size_t p = 3; rest > 1; p += 2)
+			{
+				if (p * p > rest)
+					p = rest;
+				while (rest % p == 0)
+				{
+					radices.push_back(p);
+					rest /= p;
+				}
+			}
+
+			size_t span = 1;
+			for (const size_t R : radices)
+			{
+				stages.push_back({R, span, twiddles[0].size(), roots[0].size()});
+
+				for (int d = 0; d < 2; ++d)
+				{
+					const int sign = d == 0 ? -1 : 1;
+					for (size_t r = 1; r < R; ++r)
+						for (size_t k = 0; k < span; ++k)
+							twiddles[d].push_back(_unit(sign, r * k, span * R));
+					for (size_t t = 0; t < R; ++t)
+						roots[d].push_back(_unit(sign, t, R));
+				}
+				span *= R;
+			}
+		}
+
+		size_t size() const { return n; }
+		const std::vector<stage>& passes() const { return stages; }
+
+		/** \brief Twiddles of stage s: element (r - 1)·Ns + k is ω^(r·k) */
+		const T* twiddle(const stage& s, const Direction dir) const { return twiddles[dir == Direction::INVERSE].data() + s.twiddle; }
+
+		/** \brief Roots of stage s: element t is exp(∓2πi·t/R) */
+		const T* root(const stage& s, const Direction dir) const { return roots[dir == Direction::INVERSE].data() + s.root; }
+	};
+
+	/**
+	 * \brief Butterfly arithmetic on complex SIMD registers.
+	 * Low level type not intended for the public API.
+	 */
+	template<typename T, typename S, bool INV>
+	struct _simd_ops
+	{
+		using real_t = typename base<T>::type;
+		using V = typename S::template register_t<real_t>;
+
+		static V load(const T* p) { return _loadu<real_t, S>(reinterpret_cast<const real_t*>(p)); }
+		static void store(T* p, const V v) { _storeu<real_t, S>(reinterpret_cast<real_t*>(p), v); }
+		static V set1(const T c) { return _set1<T, S>(c); }
+		static V add(const V a, const V b) { return _add<real_t, S>(a, b); }
+		static V sub(const V a, const V b) { return _sub<real_t, S>(a, b); }
+		static V mul(const V a, const V b) { return _mul<T, S>(a, b); }
+		static V fmadd(const V a, const V b, const V c) { return _fmadd<T, S>(a, b, c); }
+		static V scale(const V a, const real_t c) { return _mul<real_t, S>(a, _set1<real_t, S>(c)); }
+
+		/** \brief a · (∓i): (x, y) → (y, -x) forward, (-y, x) inverse */
+		static V rot(const V a)
+		{
+			const V swapped = swap_adjacent_pairs<real_t, S>(a);
+			if constexpr (INV)
+				return _mul<real_t, S>(swapped, alternating_sign_mask_odd<real_t, S>());
+			else
+				return _mul<real_t, S>(swapped, alternating_sign_mask_even<real_t, S>());
+		}
+	};
+
+	/**
+	 * \brief Butterfly arithmetic on single complex values.
+	 * Low level type not intended for the public API.
+	 */
+	template<typename T, bool INV>
+	struct _scalar_ops
+	{
+		using real_t = typename base<T>::type;
+		using V = T;
+
+		static V load(const T* p) { return *p; }
+		static void store(T* p, const V v) { *p = v; }
+		static V set1(const T c) { return c; }
+		static V add(const V a, const V b) { return a + b; }
+		static V sub(const V a, const V b) { return a - b; }
+		static V mul(const V a, const V b) { return a * b; }
+		static V fmadd(const V a, const V b, const V c) { return a * b + c; }
+		static V scale(const V a, const real_t c) { return a * c; }
+		static V rot(const V a) { return INV ? V(-a.imag(), a.real()) : V(a.imag(), -a.real()); }
+	};
+
+	/**
+	 * \brief In-register length R DFT of v, with roots exp(∓2πi·t/R).
+	 * Low level function not intended for the public API.
+	 */
+	template<size_t R, typename O, typename T>
+	inline __attribute__((always_inline))
+	void
+	_butterfly(typename O::V* v, const T* roots)
+	{
+		using V = typename O::V;
+
+		if constexpr (R == 2)
+		{
+			const V a = v[0];
+			v[0] = O::add(a, v[1]);
+			v[1] = O::sub(a, v[1]);
+		}
+		else if constexpr (R == 4)
+		{
+			const V a0 = O::add(v[0], v[2]);
+			const V a1 = O::sub(v[0], v[2]);
+			const V a2 = O::add(v[1], v[3]);
+			const V a3 = O::rot(O::sub(v[1], v[3]));
+			v[0] = O::add(a0, a2);
+			v[1] = O::add(a1, a3);
+			v[2] = O::sub(a0, a2);
+			v[3] = O::sub(a1, a3);
+		}
+		else if constexpr (R == 8)
+		{
+			// Two length 4 DFTs of the even and odd inputs, joined by ω8^q
+			V e[4] = {v[0], v[2], v[4], v[6]};
+			V o[4] = {v[1], v[3], v[5], v[7]};
+			_butterfly<4, O>(e, roots);
+			_butterfly<4, O>(o, roots);
+
+			constexpr typename O::real_t c = std::numbers::sqrt2_v<typename O::real_t> / 2;
+			o[1] = O::scale(O::add(o[1], O::rot(o[1])), c);
+			o[2] = O::rot(o[2]);
+			o[3] = O::scale(O::sub(O::rot(o[3]), o[3]), c);
+
+			static_for<4>([&]<auto q>()
+			{
+				v[q] = O::add(e[q], o[q]);
+				v[q + 4] = O::sub(e[q], o[q]);
+			});
+		}
+		else
+		{
+			V out[R];
+			static_for<R>([&]<auto q>()
+			{
+				V acc = v[0];
+				static_for<R - 1>([&]<auto r>()
+				{
+					acc = O::fmadd(v[r + 1], O::set1(roots[((r + 1) * q) % R]), acc);
+				});
+				out[q] = acc;
+			});
+			std::copy(out, out + R, v);
+		}
+	}
+
+	/**
+	 * \brief One Stockham pass of compile time radix R over the j range [j0, j1).
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S, size_t R, bool INV>
+	inline
+	void
+	_pass(const T* x, T* y, const size_t n, const size_t Ns,
+		const T* tw, const T* roots, size_t j0, const size_t j1)
+	{
+		const size_t m = n / R;
+
+		auto body = [&]<typename O>(const size_t j)
+		{
+			using V = typename O::V;
+			const size_t k = j % Ns;
+
+			V v[R];
+			v[0] = O::load(x + j);
+			static_for<R - 1>([&]<auto r>()
+			{
+				v[r + 1] = O::mul(O::load(x + j + (r + 1) * m), O::load(tw + r * Ns + k));
+			});
+
+			_butterfly<R, O>(v, roots);
+
+			T* out = y + (j - k) * R + k;
+			static_for<R>([&]<auto r>()
+			{
+				O::store(out + r * Ns, v[r]);
+			});
+		};
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			constexpr size_t W = S::template elements<T>();
+
+			// W consecutive j share j / Ns and stay contiguous when W divides Ns
+			if (Ns % W == 0)
+				for (; j0 + W <= j1; j0 += W)
+					body.template operator()<_simd_ops<T, S, INV>>(j0);
+		}
+
+		for (; j0 < j1; ++j0)
+			body.template operator()<_scalar_ops<T, INV>>(j0);
+	}
+
+	/**
+	 * \brief One Stockham pass of a radix known only at run time, scalar.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T>
+	inline
+	void
+	_pass_generic(const T* x, T* y, const size_t n, const size_t Ns, const size_t R,
+		const T* tw, const T* roots, const size_t j0, const size_t j1)
+	{
+		const size_t m = n / R;
+		std::vector<T> v(R);
+
+		for (size_t j = j0; j < j1; ++j)
+		{
+			const size_t k = j % Ns;
+
+			v[0] = x[j];
+			for (size_t r = 1; r < R; ++r)
+				v[r] = x[j + r * m] * tw[(r - 1) * Ns + k];
+
+			T* out = y + (j - k) * R + k;
+			for (size_t q = 0; q < R; ++q)
+			{
+				T acc = v[0];
+				for (size_t r = 1; r < R; ++r)
+					acc += v[r] * roots[(r * q) % R];
+				out[q * Ns] = acc;
+			}
+		}
+	}
+
+	/**
+	 * \brief Dispatch one stage to its pass, splitting j across threads when PAR.
+	 *
+	 * PAR is fixed by the caller so the row-parallel path compiles a plain loop
+	 * and opens no nested region per stage.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S, bool INV, bool PAR>
+	inline
+	void
+	_stage(const plan<T>& p, const typename plan<T>::stage& s, const T* x, T* y)
+	{
+		constexpr Direction dir = INV ? Direction::INVERSE : Direction::FORWARD;
+		const size_t n = p.size();
+		const size_t m = n / s.radix;
+		const T* tw = p.twiddle(s, dir);
+		const T* roots = p.root(s, dir);
+
+		// Chunks are a multiple of every register width
+		constexpr size_t chunk = 4096;
+		const size_t chunks = (m + chunk - 1) / chunk;
+
+		auto run = [&](const size_t c)
+		{
+			const size_t j0 = c * chunk;
+			const size_t j1 = std::min(m, j0 + chunk);
+
+			switch (s.radix)
+			{
+				case 2: _pass<T, S, 2, INV>(x, y, n, s.span, tw, roots, j0, j1); break;
+				case 3: _pass<T, S, 3, INV>(x, y, n, s.span, tw, roots, j0, j1); break;
+				case 4: _pass<T, S, 4, INV>(x, y, n, s.span, tw, roots, j0, j1); break;
+				case 5: _pass<T, S, 5, INV>(x, y, n, s.span, tw, roots, j0, j1); break;
+				case 7: _pass<T, S, 7, INV>(x, y, n, s.span, tw, roots, j0, j1); break;
+				case 8: _pass<T, S, 8, INV>(x, y, n, s.span, tw, roots, j0, j1); break;
+				default: _pass_generic<T>(x, y, n, s.span, s.radix, tw, roots, j0, j1); break;
+			}
+		};
+
+		if constexpr (PAR)
+		{
+			#pragma omp parallel for schedule(static)
+			for (size_t c = 0; c < chunks; ++c)
+				run(c);
+		}
+		else
+		{
+			for (size_t c = 0; c < chunks; ++c)
+				run(c);
+		}
+	}
+
+	/**
+	 * \brief Transform one sequence from in to out, using work (length n) as the
+	 * other Stockham buffer. in may equal out. PAR splits each stage across
+	 * threads and must only be set outside a parallel region.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S, bool PAR = false>
+	inline
+	void
+	_execute(const plan<T>& p, const T* in, T* out, T* work, const Direction dir)
+	{
+		const size_t n = p.size();
+		const auto& stages = p.passes();
+		const size_t count = stages.size();
+
+		if (count == 0)
+		{
+			out[0] = in[0];
+			return;
+		}
+
+		// The last stage must write out, so the first writes out when the count is odd
+		const T* src = in;
+		if (in == out && count % 2 == 1)
+		{
+			std::copy(in, in + n, work);
+			src = work;
+		}
+
+		for (size_t s = 0; s < count; ++s)
+		{
+			T* dst = (count - 1 - s) % 2 == 0 ? out : work;
+
+			if (dir == Direction::INVERSE)
+				_stage<T, S, true, PAR>(p, stages[s], src, dst);
+			else
+				_stage<T, S, false, PAR>(p, stages[s], src, dst);
+
+			src = dst;
+		}
+
+		if (dir == Direction::INVERSE)
+		{
+			const typename base<T>::type scale = typename base<T>::type(1) / n;
+
+			if constexpr (PAR)
+			{
+				#pragma omp parallel for schedule(static)
+				for (size_t t = 0; t < n; ++t)
+					out[t] *= scale;
+			}
+			else
+			{
+				for (size_t t = 0; t < n; ++t)
+					out[t] *= scale;
+			}
+		}
+	}
+
+	/**
+	 * \brief Transform every row of A into the matching row of B.
+	 *
+	 * Rows are distributed across threads, each with its own work buffer. When
+	 * there are fewer rows than threads and the rows are long, the rows are taken
+	 * one at a time and the passes of each are split across threads instead.
+	 *
+	 * \tparam T	Complex element type
+	 * \tparam S	SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param p		Plan of the row length N
+	 * \param A		Input, M×N
+	 * \param B		Output, M×N, may be A
+	 * \param M		Number of rows
+	 * \param dir	Forward or inverse transform
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	fft(const plan<T>& p, T** A, T** B, const size_t M, const Direction dir = Direction::FORWARD)
+	{
+		const size_t N = p.size();
+		right<T>("fft:", std::make_tuple(A, M, N), std::make_tuple(B, M, N));
+
+		if (M < size_t(omp_get_max_threads()) && N >= (size_t(1) << 15))
+		{
+			auto work = aligned_alloc_1D<T, S::bytes>(1, N);
+			for (size_t i = 0; i < M; ++i)
+				_execute<T, S, true>(p, A[i], B[i], work.get(), dir);
+			return;
+		}
+
+		#pragma omp parallel
+		{
+			auto work = aligned_alloc_1D<T, S::bytes>(1, N);
+
+			#pragma omp for schedule(static)
+			for (size_t i = 0; i < M; ++i)
+				_execute<T, S>(p, A[i], B[i], work.get(), dir);
+		}
+	}
+
+	/**
+	 * \brief Transform every row of A (M×N) into B, planning for length N.
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	fft(T** A, T** B, const size_t M, const size_t N, const Direction dir = Direction::FORWARD)
+	{
+		const plan<T> p(N);
+		fft<T, S>(p, A, B, M, dir);
+	}
+
+	/**
+	 * \brief Transform every column of A (M×N) into B.
+	 *
+	 * A is transposed so the columns become rows, transformed with fft, and
+	 * transposed back into B.
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	fft_columns(T** A, T** B, const size_t M, const size_t N, const Direction dir = Direction::FORWARD)
+	{
+		right<T>("fft_columns:", std::make_tuple(A, M, N), std::make_tuple(B, M, N));
+
+		auto At = aligned_alloc_2D<T, S::bytes>(N, M);
+		transpose<T, S>(A, At.get(), M, N);
+		fft<T, S>(At.get(), At.get(), N, M, dir);
+		transpose<T, S>(At.get(), B, N, M);
+	}
+
+	/**
+	 * \brief 2D transform of A (M×N) into B: rows, then columns.
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	fft2(T** A, T** B, const size_t M, const size_t N, const Direction dir = Direction::FORWARD)
+	{
+		fft<T, S>(A, B, M, N, dir);
+		fft_columns<T, S>(B, B, M, N, dir);
+	}
+
+	/**
+	 * \brief exp(-2πi·k/N) for k ≤ N/2, the twiddles of the real transform split.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T>
+	inline std::vector<T>
+	_real_twiddles(const size_t N)
+	{
+		std::vector<T> w(N / 2 + 1);
+		for (size_t k = 0; k <= N / 2; ++k)
+		{
+			const long double angle = -2 * std::numbers::pi_v<long double> * k / N;
+			w[k] = T(std::cos(angle), std::sin(angle));
+		}
+		return w;
+	}
+
+	/**
+	 * \brief Real to complex transform of every row.
+	 *
+	 * For even N the samples of a row are read in place as N/2 complex values
+	 * z[t] = x[2t] + i·x[2t+1]. With Z their transform and h = N/2,
+	 *   X[k] = (Z[k] + conj(Z[h-k]))/2 - i·exp(-2πi·k/N)·(Z[k] - conj(Z[h-k]))/2.
+	 * Odd N falls back to a complex transform of length N.
+	 *
+	 * \tparam R	Real element type (float or double)
+	 *
+	 * \param A		Real input, M×N
+	 * \param B		Complex output, M×(N/2 + 1)
+	 * \param M		Number of rows
+	 * \param N		Row length of A
+	 */
+	template<typename R, typename S = decltype(detect_simd())>
+	inline void
+	rfft(R** A, std::complex<R>** B, const size_t M, const size_t N)
+	{
+		using T = std::complex<R>;
+		const size_t H = N / 2 + 1;
+		right<R>("rfft:", std::make_tuple(A, M, N));
+		right<T>("rfft:", std::make_tuple(B, M, H));
+
+		if (N % 2 == 1)
+		{
+			const plan<T> p(N);
+			#pragma omp parallel
+			{
+				auto row = aligned_alloc_1D<T, S::bytes>(1, N);
+				auto work = aligned_alloc_1D<T, S::bytes>(1, N);
+
+				#pragma omp for schedule(static)
+				for (size_t i = 0; i < M; ++i)
+				{
+					std::copy(A[i], A[i] + N, row.get());
+					_execute<T, S>(p, row.get(), row.get(), work.get(), Direction::FORWARD);
+					std::copy(row.get(), row.get() + H, B[i]);
+				}
+			}
+			return;
+		}
+
+		const size_t h = N / 2;
+		const plan<T> p(h);
+		const std::vector<T> w = _real_twiddles<T>(N);
+
+		#pragma omp parallel
+		{
+			auto Z = aligned_alloc_1D<T, S::bytes>(1, h);
+			auto work = aligned_alloc_1D<T, S::bytes>(1, h);
+
+			#pragma omp for schedule(static)
+			for (size_t i = 0; i < M; ++i)
+			{
+				_execute<T, S>(p, reinterpret_cast<const T*>(A[i]), Z.get(), work.get(), Direction::FORWARD);
+
+				for (size_t k = 0; k <= h; ++k)
+				{
+					const T a = Z[k % h];
+					const T b = std::conj(Z[(h - k) % h]);
+					const T odd = (a - b) * T(0, -0.5);
+					B[i][k] = (a + b) * R(0.5) + w[k] * odd;
+				}
+			}
+		}
+	}
+
+	/**
+	 * \brief Complex to real transform of every row, the inverse of rfft.
+	 *
+	 * For even N the half spectrum is folded back into the N/2 complex values
+	 *   Z[k] = (X[k] + conj(X[h-k]))/2 + i·exp(+2πi·k/N)·(X[k] - conj(X[h-k]))/2,
+	 * whose inverse transform is written in place over the real output row.
+	 * The imaginary parts of X[0] and, for even N, X[N/2] are ignored.
+	 *
+	 * \param A		Complex input, M×(N/2 + 1)
+	 * \param B		Real output, M×N
+	 * \param M		Number of rows
+	 * \param N		Row length of B
+	 */
+	template<typename R, typename S = decltype(detect_simd())>
+	inline void
+	irfft(std::complex<R>** A, R** B, const size_t M, const size_t N)
+	{
+		using T = std::complex<R>;
+		const size_t H = N / 2 + 1;
+		right<T>("irfft:", std::make_tuple(A, M, H));
+		right<R>("irfft:", std::make_tuple(B, M, N));
+
+		if (N % 2 == 1)
+		{
+			const plan<T> p(N);
+			#pragma omp parallel
+			{
+				auto row = aligned_alloc_1D<T, S::bytes>(1, N);
+				auto work = aligned_alloc_1D<T, S::bytes>(1, N);
+
+				#pragma omp for schedule(static)
+				for (size_t i = 0; i < M; ++i)
+				{
+					row[0] = T(A[i][0].real());
+					for (size_t k = 1; k < H; ++k)
+					{
+						row[k] = A[i][k];
+						row[N - k] = std::conj(A[i][k]);
+					}
+					_execute<T, S>(p, row.get(), row.get(), work.get(), Direction::INVERSE);
+					for (size_t t = 0; t < N; ++t)
+						B[i][t] = row[t].real();
+				}
+			}
+			return;
+		}
+
+		const size_t h = N / 2;
+		const plan<T> p(h);
+		const std::vector<T> w = _real_twiddles<T>(N);
+
+		#pragma omp parallel
+		{
+			auto Z = aligned_alloc_1D<T, S::bytes>(1, h);
+			auto work = aligned_alloc_1D<T, S::bytes>(1, h);
+
+			#pragma omp for schedule(static)
+			for (size_t i = 0; i < M; ++i)
+			{
+				auto X = [&](const size_t k)
+				{
+					return k == 0 || k == h ? T(A[i][k].real()) : A[i][k];
+				};
+
+				for (size_t k = 0; k < h; ++k)
+				{
+					const T a = X(k);
+					const T b = std::conj(X(h - k));
+					Z[k] = (a + b) * R(0.5) + std::conj(w[k]) * (a - b) * T(0, 0.5);
+				}
+
+				_execute<T, S>(p, Z.get(), reinterpret_cast<T*>(B[i]), work.get(), Direction::INVERSE);
+			}
+		}
+	}
+
+	/**
+	 * \brief 2D real to complex transform of A (M×N) into B (M×(N/2 + 1)).
+	 */
+	template<typename R, typename S = decltype(detect_simd())>
+	inline void
+	rfft2(R** A, std::complex<R>** B, const size_t M, const size_t N)
+	{
+		rfft<R, S>(A, B, M, N);
+		fft_columns<std::complex<R>, S>(B, B, M, N / 2 + 1);
+	}
+
+	/**
+	 * \brief 2D complex to real transform of A (M×(N/2 + 1)) into B (M×N), the inverse of rfft2.
+	 */
+	template<typename R, typename S = decltype(detect_simd())>
+	inline void
+	irfft2(std::complex<R>** A, R** B, const size_t M, const size_t N)
+	{
+		using T = std::complex<R>;
+		const size_t H = N / 2 + 1;
+
+		auto C = aligned_alloc_2D<T, S::bytes>(M, H);
+		fft_columns<T, S>(A, C.get(), M, H, Direction::INVERSE);
+		irfft<R, S>(C.get(), B, M, N);
+	}
+} // namespace fft
+} // namespace damm
+#endif //__FFT_H__
@@ -920,7 +920,7 @@ namespace damm
 				std::make_tuple(B, M, N),
 				std::make_tuple(D, M, N));
 			
-			if constexpr (std::is_same_v<S, NONE>)
+			if constexpr (std::is_same_v<S, NONE> || !has_simd_op_v<T, O1> || !has_simd_op_v<T, O2>)
 				_fused_union<P, T, O1, O2, K>(A, B, C, D, M, N);
 			else
 				_fused_union_simd<P, T, O1, O2, S, K>(A, B, C, D, M, N);
@@ -981,7 +981,7 @@ namespace damm
 				std::make_tuple(C, M, N),
 				std::make_tuple(D, M, N));
 
-			if constexpr (std::is_same_v<S, NONE>)
+			if constexpr (std::is_same_v<S, NONE> || !has_simd_op_v<T, O1> || !has_simd_op_v<T, O2>)
 				_fused_union<P, T, O1, O2, K>(A, B, C, D, M, N);
 			else
 				_fused_union_simd<P, T, O1, O2, S, K>(A, B, C, D, M, N);
@@ -1439,7 +1439,7 @@ namespace damm
 				std::make_tuple(C, M, N),
 				std::make_tuple(D, M, N));
 
-			if constexpr (std::is_same_v<S, NONE>)
+			if constexpr (std::is_same_v<S, NONE> || !has_simd_op_v<T, O1> || !has_simd_op_v<T, O2>)
 				_fused_union<P, T, O1, O2, K>(A, B, C, D, M, N);
 			else
 				_fused_union_simd<P, T, O1, O2, S, K>(A, B, C, D, M, N);
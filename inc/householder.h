@@ -53,6 +53,10 @@
  * In numerical implementations, the normalized vector is avoided. Instead, define:
  *     H = I - tau * v * v^T
  * where \p tau = 2 / (v^T v), and \p v is chosen such that v[0] = 1.
+ *
+ * For complex types the reflector is H = I - tau * v * v^H with a complex tau,
+ * following the LAPACK convention: H^H * x = beta * e_1 with beta real. H is then
+ * unitary but not Hermitian, so QR applies H^H (i.e. conj(tau)) from the left.
  */
 namespace damm
 {
@@ -63,8 +67,8 @@ namespace damm
 	 * \param n The size (dimension) of the vector x
 	 * \param v The output Householder vector (length n), caller-allocated
 	 *           Convention: v[0] = 1, rest filled in this function
-	 * \param tau The output scalar tau such that H = I - tau * v * v^T
-	 * \param beta The scalar that replaces x[0] in H * x
+	 * \param tau The output scalar tau such that H = I - tau * v * v^H
+	 * \param beta The scalar that replaces x[0] in H^H * x (real valued for complex T)
 	 */
 	template<typename T, typename S>
 	void make_householder(T* x, size_t N, T* v, T& tau, T& beta) 
@@ -92,10 +96,28 @@ namespace damm
 		for (size_t i = 1; i < N; ++i)
 			x_tail[0][i - 1] = x[i];
 
-		T norm2 = fused_reduce<T, std::multiplies<>, std::plus<>, S>(
-			x_tail.get(), x_tail.get(), T(0), 1, N - 1);
+		using R = typename base<T>::type;
+
+		// ||x_tail||^2 = x_tail^H * x_tail
+		R norm2;
+		if constexpr (is_complex_v<T>)
+		{
+			auto x_conj_data = aligned_alloc_1D<T, S::bytes>(1, N - 1);
+			auto x_conj = view_as_2D(x_conj_data.get(), 1, N - 1);
+			for (size_t i = 0; i < N - 1; ++i)
+				x_conj[0][i] = std::conj(x_tail[0][i]);
+
+			norm2 = fused_reduce<T, std::multiplies<>, std::plus<>, S>(
+				x_conj.get(), x_tail.get(), T(0), 1, N - 1).real();
+		}
+		else
+			norm2 = fused_reduce<T, std::multiplies<>, std::plus<>, S>(
+				x_tail.get(), x_tail.get(), T(0), 1, N - 1);
+
+		const R x0_re = std::real(x0);
+		const R x0_im = std::imag(x0);
 
-		if (norm2 == T(0) && x0 >= T(0)) 
+		if (norm2 == R(0) && x0_im == R(0) && x0_re >= R(0)) 
 		{
 			tau = T(0);
 			beta = x0;
@@ -104,13 +126,15 @@ namespace damm
 			return;
 		}
 
-		beta = std::sqrt(x0 * x0 + norm2);
-		if (x0 >= T(0))
-			beta = -beta;
+		R b = std::sqrt(x0_re * x0_re + x0_im * x0_im + norm2);
+		if (x0_re >= R(0))
+			b = -b;
 
+		beta = T(b);
+
+		// tau = (beta - x0) / beta, which reduces to 2 u0^2 / (u0^2 + norm2) for real x
 		const T u0 = x0 - beta;
-		const T u_norm_sq = u0 * u0 + norm2;
-		tau = T(2) * u0 * u0 / u_norm_sq;
+		tau = (beta - x0) / beta;
 
 		v[0] = T(1);
 
@@ -126,6 +150,8 @@ namespace damm
 	/**
 	 * \brief Apply the Householder reflector from the left
 	 *
+	 * Computes A <- (I - tau * v * v^H) * A. For real T, v^H = v^T.
+	 *
 	 * \param A       The input matrix (modified in-place), size M × N, stored row-major
 	 * \param M       Rows of A
 	 * \param N       Columns of A
@@ -138,7 +164,10 @@ namespace damm
 		auto v_data = aligned_alloc_1D<T, S::bytes>(1, M);
 		std::copy(v, v + M, v_data.get());
 		auto v_col = view_as_2D(v_data.get(), M, 1);
-		auto vT_row = view_as_2D(v_data.get(), 1, M);
+
+		auto vH_data = aligned_alloc_1D<T, S::bytes>(1, M);
+		std::transform(v, v + M, vH_data.get(), conjugate<T>);
+		auto vT_row = view_as_2D(vH_data.get(), 1, M);
 		auto w = aligned_alloc_2D<T, S::bytes>(1, N);
 		auto outer_prod = aligned_alloc_2D<T, S::bytes>(M, N);
 
@@ -154,6 +183,8 @@ namespace damm
 	/**
 	 * \brief Apply the Householder reflector from the right.
 	 *
+	 * Computes A <- A * (I - tau * v * v^H). For real T, v^H = v^T.
+	 *
 	 * \param A       The input matrix (modified in-place), size M × N, stored row-major
 	 * \param M       Number of rows of A
 	 * \param N       Number of columns of A
@@ -166,7 +197,10 @@ namespace damm
 		auto v_data = aligned_alloc_1D<T, S::bytes>(1, N);
 		std::copy(v, v + N, v_data.get());
 		auto v_col = view_as_2D(v_data.get(), N, 1);
-		auto v_row = view_as_2D(v_data.get(), 1, N);
+
+		auto vH_data = aligned_alloc_1D<T, S::bytes>(1, N);
+		std::transform(v, v + N, vH_data.get(), conjugate<T>);
+		auto v_row = view_as_2D(vH_data.get(), 1, N);
 		auto w_col = aligned_alloc_2D<T, S::bytes>(M, 1);
 		auto outer_prod = aligned_alloc_2D<T, S::bytes>(M, N);
 		
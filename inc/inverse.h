@@ -36,9 +36,43 @@
 #include <broadcast.h>
 #include <multiply.h>
 #include <transpose.h>
+#include <permute.h>
+#include <damm_kernels.h>
+#include <omp.h>
 
 namespace damm
 {	
+	/** 
+	 * \brief kernel for y[0..N) += a * x[0..N) over contiguous row segments.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_axpy(const T a, const T* x, T* y, const size_t N)
+	{
+		size_t i = 0;
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using R = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+			constexpr size_t stride = is_complex_v<T> ? 2 : 1;
+
+			const R* xr = reinterpret_cast<const R*>(x);
+			R* yr = reinterpret_cast<R*>(y);
+			const register_t va = _set1<T, S>(a);
+
+			for (; i + W <= N; i += W)
+				_storeu<T, S>(&yr[i * stride], 
+					_fmadd<T, S>(va, _loadu<T, S>(&xr[i * stride]), _loadu<T, S>(&yr[i * stride])));
+		}
+
+		for (; i < N; ++i)
+			y[i] += a * x[i];
+	}
+
 	namespace tri
 	{
 		/**
@@ -123,6 +157,12 @@ namespace damm
 			
 			if (!lu::decompose<T, S>(A, P, N))
 				return false; // Matrix is singular
+
+			// P A = L U, so column col of A^(-1) solves L U x = P e_col, whose
+			// single nonzero sits at row P^(-1)[col]
+			auto P_inv_mat = aligned_alloc_2D<size_t, S::bytes>(1, N);
+			size_t* P_inv = P_inv_mat[0];
+			invert_permutation(P, P_inv, N);
 	
 			// Column-wise inversion by solving A x = e_col
 			for (size_t col = 0; col < N; col++)
@@ -138,7 +178,7 @@ namespace damm
 				std::fill(b, b + N, T(0));
 				
 				// Set up RHS with permutation
-				b[P[col]] = T(1);
+				b[P_inv[col]] = T(1);
 
 				// Solve L * y = b (L has unit diagonal from LU decomposition)
 				tri::forward_substitution<T, S>(A, b, y, N, true);
@@ -264,6 +304,225 @@ namespace damm
 
 	} // namespace qr
 
+	namespace cholesky
+	{
+		/**
+		 * \brief Cholesky-based inverse of a symmetric (Hermitian) positive-definite matrix.
+		 *
+		 * Follows LAPACK POTRI: factor A = L * L^H, invert L in place, then form
+		 * A^(-1) = L^(-H) * L^(-1). Both steps are row oriented so every inner loop
+		 * is a contiguous axpy:
+		 *   - L^(-1) row i is -L[i][i]^(-1) Σ_{k<i} L[i][k] * (row k of L^(-1)), a TRMM-style sweep.
+		 *   - A^(-1) row i is Σ_{k>=i} conj(L^(-1)[k][i]) * (row k of L^(-1)), a SYRK-style
+		 *     sum over the rows of L^(-1). Only the lower triangle is computed; the upper
+		 *     triangle is filled by (conjugate) symmetry.
+		 *
+		 * \tparam T        Scalar type (float, double, or complex variants)
+		 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+		 *
+		 * \param A         Input matrix A (N×N), overwritten with L^(-1)
+		 * \param A_inv     Output inverse matrix A^(-1) (N×N)
+		 * \param N         Matrix dimension
+		 * 
+		 * \return true if inversion successful, false if matrix is not positive definite
+		 *
+		 * \note About a third of the work of lu::inverse and no per-column allocations.
+		 */
+		template<typename T, typename S = decltype(detect_simd())>
+		inline bool
+		inverse(T** A, T** A_inv, const size_t N)
+		{
+			right<T>("inverse:", std::make_tuple(A, N, N), std::make_tuple(A_inv, N, N));
+
+			if (!cholesky::decompose<T, S>(A, N))
+				return false; // Matrix is not positive definite
+
+			// L^(-1) in place. Row i of L is only read before it is overwritten.
+			auto row = aligned_alloc_1D<T, S::bytes>(1, N);
+
+			for (size_t i = 0; i < N; ++i)
+			{
+				std::fill(row.get(), row.get() + i, T(0));
+
+				for (size_t k = 0; k < i; ++k)
+					_axpy<T, S>(A[i][k], A[k], row.get(), k + 1);
+
+				const T d = T(1) / A[i][i];
+				for (size_t j = 0; j < i; ++j)
+					A[i][j] = -d * row[j];
+				A[i][i] = d;
+			}
+
+			// Lower triangle of L^(-H) * L^(-1). Row i of the output is independent
+			// of every other row; the work per row shrinks with i.
+			#pragma omp parallel for schedule(dynamic)
+			for (size_t i = 0; i < N; ++i)
+			{
+				std::fill(A_inv[i], A_inv[i] + i + 1, T(0));
+
+				for (size_t k = i; k < N; ++k)
+					_axpy<T, S>(conjugate(A[k][i]), A[k], A_inv[i], i + 1);
+			}
+
+			for (size_t i = 0; i < N; ++i)
+				for (size_t j = 0; j < i; ++j)
+					A_inv[j][i] = conjugate(A_inv[i][j]);
+
+			return true;
+		}
+
+	} // namespace cholesky
+
+	namespace gauss_jordan
+	{
+		/**
+		 * \brief Gauss-Jordan inverse on caller-provided workspace, also returning
+		 * log|det A| as the sum of log|pivot|.
+		 *
+		 * pivots holds N entries, Z is N×kernel_cols(), B is kernel_cols()×N and g
+		 * holds N entries, so a caller inverting repeatedly allocates them once.
+		 * Low level function not intended for the public API.
+		 */
+		template<typename T, typename S, template<typename, typename> class K = inverse_kernel>
+		inline bool
+		_inverse(T** A, const size_t N, size_t* pivots, T** Z, T** B, T* g,
+			typename base<T>::type& logabsdet)
+		{
+			using R = typename base<T>::type;
+			constexpr R tolerance = std::is_same_v<R, float> ? 1e-6f : 1e-12;
+			constexpr size_t panel = K<T, S>::kernel_cols();
+
+			logabsdet = R(0);
+
+			for (size_t k0 = 0; k0 < N; k0 += panel)
+			{
+				const size_t k1 = std::min(k0 + panel, N);
+				const size_t nb = k1 - k0;
+
+				// Z accumulates the panel transform applied to the identity columns e_k0..e_k1
+				for (size_t i = 0; i < N; ++i)
+					std::fill(Z[i], Z[i] + nb, T(0));
+				for (size_t t = 0; t < nb; ++t)
+					Z[k0 + t][t] = T(1);
+
+				for (size_t k = k0; k < k1; ++k)
+				{
+					const size_t t = k - k0;
+					const size_t p = lu::_find_pivot(A, k, N);
+
+					if (std::abs(A[p][k]) < tolerance)
+						return false; // Matrix is singular
+
+					pivots[k] = p;
+					logabsdet += std::log(std::abs(A[p][k]));
+
+					if (p != k)
+					{
+						std::swap_ranges(A[k], A[k] + N, A[p]);
+						// The columns of Z already holding transforms follow the interchange.
+						std::swap_ranges(Z[k], Z[k] + t, Z[p]);
+					}
+
+					const T pivot = A[k][k];
+					const T pivot_inv = T(1) / pivot;
+					for (size_t i = 0; i < N; ++i)
+						g[i] = -A[i][k] * pivot_inv;
+					g[k] = pivot_inv - T(1);
+
+					// c <- c + g * c[k] on the panel columns of A and on Z, row k last.
+					// Row k is scaled directly: 1/pivot - 1 cancels when |pivot| >> 1.
+					for (size_t i = 0; i < N; ++i)
+					{
+						if (i == k) continue;
+						_axpy<T, S>(g[i], &A[k][k0], &A[i][k0], nb);
+						_axpy<T, S>(g[i], Z[k], Z[i], nb);
+					}
+					for (size_t j = k0; j < k1; ++j)
+						A[k][j] *= pivot_inv;
+					for (size_t j = 0; j < nb; ++j)
+						Z[k][j] *= pivot_inv;
+
+					for (size_t i = 0; i < N; ++i)
+						A[i][k] = g[i];
+					A[k][k] = pivot_inv;
+				}
+
+				// Outside the panel A has only seen row interchanges, so rows k0..k1
+				// are copied before the update overwrites them.
+				for (size_t t = 0; t < nb; ++t)
+					std::copy(A[k0 + t], A[k0 + t] + N, B[t]);
+
+				// Deferred rank-nb update of the columns outside the panel: rows off the
+				// panel accumulate (Z - E) * B, panel rows are replaced by Z * B so that
+				// the diagonal of Z - E is never formed.
+				#pragma omp parallel for schedule(static)
+				for (size_t i = 0; i < N; ++i)
+				{
+					if (i >= k0 && i < k1)
+					{
+						std::fill(A[i], A[i] + k0, T(0));
+						std::fill(A[i] + k1, A[i] + N, T(0));
+					}
+					for (size_t t = 0; t < nb; ++t)
+					{
+						const T w = Z[i][t];
+						if (w == T(0)) continue;
+						_axpy<T, S>(w, B[t], A[i], k0);
+						_axpy<T, S>(w, &B[t][k1], &A[i][k1], N - k1);
+					}
+				}
+			}
+
+			for (size_t k = N; k-- > 0; )
+				if (pivots[k] != k)
+					for (size_t i = 0; i < N; ++i)
+						std::swap(A[i][k], A[i][pivots[k]]);
+
+			return true;
+		}
+
+		/**
+		 * \brief Blocked in-place Gauss-Jordan inverse with partial pivoting.
+		 *
+		 * Overwrites A with A^(-1) without a second N×N buffer. Each Gauss-Jordan step k
+		 * transforms every column j != k as c <- c + g_k * c[k], so the steps of one panel
+		 * of columns [k0, k1) compose into c <- c + W * c[k0:k1) with W N×nb. The panel
+		 * columns are eliminated eagerly while W is accumulated; the columns outside
+		 * the panel then receive the whole panel in a single rank-nb update, which is
+		 * parallel over rows and streams each row once per panel instead of once per step.
+		 * Row interchanges are applied to full rows immediately and undone as column
+		 * interchanges at the end.
+		 *
+		 * \tparam T        Scalar type (float, double, or complex variants)
+		 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+		 * \tparam K        Kernel policy; kernel_cols() is the panel width
+		 *
+		 * \param A         Input matrix A (N×N), overwritten with A^(-1)
+		 * \param N         Matrix dimension
+		 * 
+		 * \return true if inversion successful, false if matrix is singular. 
+		 *         A is left partially transformed on failure.
+		 */
+		template<typename T, typename S = decltype(detect_simd()), 
+			template<typename, typename> class K = inverse_kernel>
+		inline bool
+		inverse(T** A, const size_t N)
+		{
+			right<T>("inverse:", std::make_tuple(A, N, N));
+
+			constexpr size_t panel = K<T, S>::kernel_cols();
+
+			std::vector<size_t> pivots(N);
+			auto Z = aligned_alloc_2D<T, S::bytes>(N, panel);
+			auto B = aligned_alloc_2D<T, S::bytes>(panel, N);
+			auto g = aligned_alloc_1D<T, S::bytes>(1, N);
+
+			typename base<T>::type logabsdet;
+			return _inverse<T, S, K>(A, N, pivots.data(), Z.get(), B.get(), g.get(), logabsdet);
+		}
+
+	} // namespace gauss_jordan
+
 } //namespace damm
 
 #endif //__INVERSE_H__
\ No newline at end of file
@@ -0,0 +1,239 @@
+#ifndef __KRON_H__
+#define __KRON_H__
+/**
+ * \file kron.h
+ * \brief definitions for Kronecker and Khatri-Rao products
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <common.h>
+#include <simd.h>
+#include <damm_kernels.h>
+#include <omp.h>
+#include <transpose.h>
+#include <multiply.h>
+
+#include <vector>
+
+/**
+ * \brief Kronecker and Khatri-Rao products, and the Kronecker matrix-vector product.
+ *
+ * For A (m×n) and B (p×q) the Kronecker product A⊗B is the mp×nq matrix with
+ * (A⊗B)[i·p + k][j·q + l] = A[i][j]·B[k][l]. Row i·p + k is the concatenation
+ * over j of A[i][j]·B[k], so kron streams each output row once as n scaled
+ * copies of a row of B.
+ *
+ * For A (m×n) and B (p×n) the Khatri-Rao (column-wise Kronecker) product is
+ * the mp×n matrix with row i·p + k equal to the elementwise product A[i] ∘ B[k].
+ *
+ * kron_multiply never forms A⊗B. With X (nq × r) read as an n × q × r tensor,
+ *   (A⊗B)·X = [B · (A·X)_i]_i,
+ * which is one m×n by n×qr multiply followed by B applied to each q×r slice,
+ * or for a single right hand side the m×q by q×p product (A·X)·Bᵀ. The cost is
+ * O(mnqr + mpqr) instead of O(mnpqr), and no mp×nq buffer is allocated.
+ */
+namespace damm
+{
+	/** 
+	 * \brief kernel for d[l] = a · b[l], l < q.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_scale_row(const T a, const T* b, T* d, const size_t q)
+	{
+		size_t l = 0;
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+			const register_t va = _set1<T, S>(a);
+
+			for (; l + W <= q; l += W)
+				_storeu<T, S>(reinterpret_cast<real_t*>(d + l), 
+					_mul<T, S>(va, _loadu<T, S>(reinterpret_cast<const real_t*>(b + l))));
+		}
+
+		for (; l < q; ++l)
+			d[l] = a * b[l];
+	}
+
+	/** 
+	 * \brief kernel for d[l] = a[l] · b[l], l < n.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_hadamard_row(const T* a, const T* b, T* d, const size_t n)
+	{
+		size_t l = 0;
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			constexpr size_t W = S::template elements<T>();
+
+			for (; l + W <= n; l += W)
+				_storeu<T, S>(reinterpret_cast<real_t*>(d + l), 
+					_mul<T, S>(_loadu<T, S>(reinterpret_cast<const real_t*>(a + l)), 
+						_loadu<T, S>(reinterpret_cast<const real_t*>(b + l))));
+		}
+
+		for (; l < n; ++l)
+			d[l] = a[l] * b[l];
+	}
+
+	/**
+	 * \brief Kronecker product C = A ⊗ B.
+	 *
+	 * \tparam T	Element type
+	 * \tparam S	SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param A		Left factor, m×n
+	 * \param B		Right factor, p×q
+	 * \param C		Output, mp×nq
+	 * \param m		Rows of A
+	 * \param n		Columns of A
+	 * \param p		Rows of B
+	 * \param q		Columns of B
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	kron(T** A, T** B, T** C, const size_t m, const size_t n, const size_t p, const size_t q)
+	{
+		right<T>("kron:", 
+			std::make_tuple(A, m, n), 
+			std::make_tuple(B, p, q), 
+			std::make_tuple(C, m * p, n * q));
+
+		#pragma omp parallel for schedule(static)
+		for (size_t r = 0; r < m * p; ++r)
+		{
+			const size_t i = r / p;
+			const size_t k = r % p;
+			for (size_t j = 0; j < n; ++j)
+				_scale_row<T, S>(A[i][j], B[k], C[r] + j * q, q);
+		}
+	}
+
+	/**
+	 * \brief Khatri-Rao (column-wise Kronecker) product C = A ⊙ B.
+	 *
+	 * Column j of C is the Kronecker product of column j of A and column j of B.
+	 *
+	 * \tparam T	Element type
+	 * \tparam S	SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param A		Left factor, m×n
+	 * \param B		Right factor, p×n
+	 * \param C		Output, mp×n
+	 * \param m		Rows of A
+	 * \param p		Rows of B
+	 * \param n		Columns of A, B and C
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	khatri_rao(T** A, T** B, T** C, const size_t m, const size_t p, const size_t n)
+	{
+		right<T>("khatri_rao:", 
+			std::make_tuple(A, m, n), 
+			std::make_tuple(B, p, n), 
+			std::make_tuple(C, m * p, n));
+
+		#pragma omp parallel for schedule(static)
+		for (size_t r = 0; r < m * p; ++r)
+			_hadamard_row<T, S>(A[r / p], B[r % p], C[r], n);
+	}
+
+	/**
+	 * \brief Structured product Y += (A ⊗ B) · X without forming A ⊗ B.
+	 *
+	 * Row j·q + l of X holds entry (j, l) of the n×q reshape of each right hand side,
+	 * and row i·p + k of Y likewise. Two multiply calls are made:
+	 * T = A · X (X read as n × qr), then Y_i += B · T_i for each q×r slice T_i,
+	 * fused into the single product T · Bᵀ when r = 1.
+	 *
+	 * \tparam T	Element type
+	 * \tparam S	SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 * \tparam K	Kernel policy passed to multiply
+	 *
+	 * \param A		Left factor, m×n
+	 * \param B		Right factor, p×q
+	 * \param X		Right hand sides, nq×r
+	 * \param Y		Result, mp×r
+	 * \param m		Rows of A
+	 * \param n		Columns of A
+	 * \param p		Rows of B
+	 * \param q		Columns of B
+	 * \param r		Number of right hand sides
+	 *
+	 * \note Like multiply, Y is accumulated into and should be zero-initialized.
+	 */
+	template<typename T, typename S = decltype(detect_simd()), template<typename, typename> class K = multiply_kernel>
+	inline void
+	kron_multiply(T** A, T** B, T** X, T** Y, 
+		const size_t m, const size_t n, const size_t p, const size_t q, const size_t r = 1)
+	{
+		right<T>("kron_multiply:", 
+			std::make_tuple(A, m, n), 
+			std::make_tuple(B, p, q), 
+			std::make_tuple(X, n * q, r), 
+			std::make_tuple(Y, m * p, r));
+
+		// Contiguous storage lets X and Y be re-viewed with other row lengths
+		std::vector<T*> Xv(n), Yv(m);
+		for (size_t j = 0; j < n; ++j)
+			Xv[j] = X[0] + j * q * r;
+
+		auto Tm = aligned_alloc_2D<T, S::bytes>(m, q * r);
+		std::fill(Tm[0], Tm[0] + m * q * r, T(0));
+		multiply<T, S, K>(A, Xv.data(), Tm.get(), m, n, q * r);
+
+		if (r == 1)
+		{
+			auto Bt = aligned_alloc_2D<T, S::bytes>(q, p);
+			transpose<T, S>(B, Bt.get(), p, q);
+
+			for (size_t i = 0; i < m; ++i)
+				Yv[i] = Y[0] + i * p;
+			multiply<T, S, K>(Tm.get(), Bt.get(), Yv.data(), m, q, p);
+		}
+		else
+		{
+			std::vector<T*> Tv(q);
+			for (size_t i = 0; i < m; ++i)
+			{
+				for (size_t l = 0; l < q; ++l)
+					Tv[l] = Tm[i] + l * r;
+				multiply<T, S, K>(B, Tv.data(), Y + i * p, p, q, r);
+			}
+		}
+	}
+
+} //namespace damm
+
+#endif //__KRON_H__
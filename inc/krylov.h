@@ -0,0 +1,749 @@
+#ifndef __KRYLOV_H__
+#define __KRYLOV_H__
+/**
+ * \file krylov.h
+ * \brief definitions for restarted Lanczos and Arnoldi eigensolvers
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <algorithm>
+#include <concepts>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <omp.h>
+#include <common.h>
+#include <damm_memory.h>
+#include <broadcast.h>
+#include <multiply.h>
+#include <decompose.h>
+#include <bsr.h>
+#include <eig.h>
+#include <blas.h>
+
+/**
+ * \brief Restarted Krylov eigensolvers for a few eigenpairs of large operators.
+ *
+ * eig::lanczos (Hermitian operators) and eig::arnoldi (general operators) only
+ * touch the operator through y = A·x, so A can be a dense matrix, a
+ * bsr::matrix, or any callable op(const T* x, T* y). Both build an orthonormal
+ * basis V of m vectors, stored as the rows of an (m + 1)×N matrix, with
+ * A·V = V·H + f·e_mᵀ for a small m×m H, and take the Ritz pairs of H.
+ *
+ * New basis vectors are orthogonalized by block classical Gram-Schmidt: the
+ * coefficients c = Vᴴ·w come from threaded SIMD dot products over slices of
+ * the vectors, and w ← w - Vᵀ·c from SIMD row axpys over the same slices.
+ * Partial sums are combined in thread order, so at a fixed thread count the
+ * iteration is reproducible. Arnoldi runs two passes. Lanczos first applies the three term
+ * recurrence, as level 1 axpy updates, and then one pass against the whole
+ * basis to keep it orthogonal in floating point.
+ *
+ * When the basis is full, the solver restarts thickly, in the manner of
+ * Krylov-Schur. An orthonormal basis Y of the wanted Ritz vectors of H, the
+ * eigenvectors for Lanczos and the qr::decompose of the Ritz vectors for
+ * Arnoldi, turns the relation into A·(V·Y) = (V·Y)·(Yᴴ·H·Y) + f·(e_mᵀ·Y), and
+ * expansion resumes from V·Y, formed with one multiply. The restart keeps the
+ * wanted pairs plus up to half the free space for pairs already converged.
+ *
+ * The small eigenproblems go through eig::general. For real general operators
+ * the Ritz vectors of a complex conjugate pair enter the restart basis as
+ * their real and imaginary parts, so the basis stays real.
+ */
+namespace damm
+{
+namespace eig
+{
+	/**
+	 * \brief Which end of the spectrum the Krylov solvers converge to.
+	 */
+	enum class Target
+	{
+		LARGEST_MAGNITUDE,	///< largest |λ|
+		LARGEST_REAL,		///< largest Re λ (largest algebraic for Lanczos)
+		SMALLEST_REAL		///< smallest Re λ (smallest algebraic for Lanczos)
+	};
+
+	/**
+	 * \brief Matrix-free operator: op(x, y) writes y = A·x for vectors of length N.
+	 */
+	template<typename Op, typename T>
+	concept linear_operator = std::invocable<Op&, const T*, T*>;
+
+	/**
+	 * \brief c[i] = Σ_k conj(V[i][k])·w[k] for i < rows, with threads over slices of k.
+	 * The per thread partial sums are added in thread order.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline void
+	_inner(T** V, const size_t rows, const T* w, const size_t N, T* c)
+	{
+		std::vector<T> partial(omp_get_max_threads() * rows);
+		size_t used = 1;
+
+		#pragma omp parallel if(N * rows >= 65536)
+		{
+			const size_t t = omp_get_thread_num();
+			const size_t nt = omp_get_num_threads();
+			const size_t k0 = std::min(N, (N * t) / nt);
+			const size_t k1 = std::min(N, (N * (t + 1)) / nt);
+
+			for (size_t i = 0; i < rows; ++i)
+				partial[t * rows + i] = blas::_dot<T, S, true>(V[i] + k0, w + k0, k1 - k0);
+
+			#pragma omp single
+			used = nt;
+		}
+
+		std::copy(partial.begin(), partial.begin() + rows, c);
+		for (size_t t = 1; t < used; ++t)
+			for (size_t i = 0; i < rows; ++i)
+				c[i] += partial[t * rows + i];
+	}
+
+	/**
+	 * \brief One block classical Gram-Schmidt pass of row V[j] against rows
+	 * [0, j) of V; the coefficients are added to c.
+	 *
+	 * The update V[j] -= Σ_i h_i·V[i] is a row axpy per basis vector, with
+	 * threads over slices of the columns as in _inner.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline void
+	_orthogonalize(T** V, const size_t j, const size_t N, T* c)
+	{
+		if (j == 0)
+			return;
+
+		std::vector<T> h(j);
+		_inner<T, S>(V, j, V[j], N, h.data());
+		for (size_t i = 0; i < j; ++i)
+			c[i] += h[i];
+
+		#pragma omp parallel if(N * j >= 65536)
+		{
+			const size_t t = omp_get_thread_num();
+			const size_t nt = omp_get_num_threads();
+			const size_t k0 = std::min(N, (N * t) / nt);
+			const size_t k1 = std::min(N, (N * (t + 1)) / nt);
+
+			for (size_t i = 0; i < j; ++i)
+				blas::_axpy<T, S>(-h[i], V[i] + k0, V[j] + k0, k1 - k0);
+		}
+	}
+
+	/**
+	 * \brief Fill row j of V with a random unit vector orthogonal to rows [0, j).
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline typename base<T>::type
+	_random_row(T** V, const size_t j, const size_t N, std::mt19937& gen)
+	{
+		using R = typename base<T>::type;
+		std::normal_distribution<R> dist(0, 1);
+
+		for (size_t k = 0; k < N; ++k)
+		{
+			if constexpr (is_complex_v<T>)
+				V[j][k] = T(dist(gen), dist(gen));
+			else
+				V[j][k] = dist(gen);
+		}
+
+		std::vector<T> scratch(j + 1, T(0));
+		_orthogonalize<T, S>(V, j, N, scratch.data());
+		_orthogonalize<T, S>(V, j, N, scratch.data());
+
+		const R beta = blas::nrm2<T, S>(V[j], N);
+		if (beta > R(0))
+			blas::scal<T, S>(T(R(1) / beta), V[j], N);
+		return beta;
+	}
+
+	/**
+	 * \brief Ordering key for target, larger is wanted first.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename R>
+	inline R
+	_priority(const std::complex<R>& z, const Target target)
+	{
+		switch (target)
+		{
+			case Target::LARGEST_REAL:	return z.real();
+			case Target::SMALLEST_REAL:	return -z.real();
+			default:					return std::abs(z);
+		}
+	}
+
+	/**
+	 * \brief Restarted Krylov iteration on op with an (m + 1)×N basis V.
+	 *
+	 * On return theta holds the k wanted Ritz values in target order and Y (k×m)
+	 * the coefficients of their unit Ritz vectors in rows [0, m) of V.
+	 * Returns the number of those pairs that converged.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S, bool HERMITIAN, typename Op>
+	inline size_t
+	_krylov(Op& op, const size_t N, const size_t k, const size_t m, const Target target,
+		const typename base<T>::type tol, const size_t restarts,
+		T** V, std::complex<typename base<T>::type>* theta, std::complex<typename base<T>::type>** Y)
+	{
+		using R = typename base<T>::type;
+		using C = std::complex<R>;
+
+		constexpr R eps = std::numeric_limits<R>::epsilon();
+		const R eps23 = std::pow(eps, R(2) / R(3));
+
+		auto H = aligned_alloc_2D<T, S::bytes>(m + 1, m);
+		zeros<T, S>(H.get(), m + 1, m);
+
+		std::mt19937 gen(42);
+		_random_row<T, S>(V, 0, N, gen);
+
+		size_t kept = 0;
+		R hnorm = 0;
+
+		auto Hs = aligned_alloc_2D<T, S::bytes>(m, m);
+		auto Zs = aligned_alloc_2D<T, S::bytes>(m, m);
+		auto Hc = aligned_alloc_2D<C, S::bytes>(m, m);
+		auto Zc = aligned_alloc_2D<C, S::bytes>(m, m);
+		auto Yr = aligned_alloc_2D<C, S::bytes>(m, m);		// Ritz vectors of H, column i for the ith wanted
+		auto Yb = aligned_alloc_2D<T, S::bytes>(m, m);		// restart basis, columns
+		auto Vt = aligned_alloc_2D<T, S::bytes>(m, N);
+		std::vector<C> ev(m);
+		std::vector<size_t> order(m);
+
+		for (size_t it = 0; ; ++it)
+		{
+			// Expand the basis from kept to m vectors
+			for (size_t j = kept; j < m; ++j)
+			{
+				op(const_cast<const T*>(V[j]), V[j + 1]);
+
+				if (HERMITIAN && j > kept)
+				{
+					// Three term recurrence, then one pass against the whole basis
+					T alpha;
+					_inner<T, S>(V + j, 1, V[j + 1], N, &alpha);
+					alpha = T(std::real(alpha));
+					blas::axpy<T, S>(-alpha, V[j], V[j + 1], N);
+					blas::axpy<T, S>(-H[j][j - 1], V[j - 1], V[j + 1], N);
+
+					std::vector<T> c(j + 1, T(0));
+					_orthogonalize<T, S>(V, j + 1, N, c.data());
+					H[j][j] = T(std::real(alpha + c[j]));
+				}
+				else
+				{
+					std::vector<T> c(j + 1, T(0));
+					_orthogonalize<T, S>(V, j + 1, N, c.data());
+					_orthogonalize<T, S>(V, j + 1, N, c.data());
+					for (size_t i = 0; i <= j; ++i)
+						H[i][j] = HERMITIAN && i == j ? T(std::real(c[i])) : c[i];
+					for (size_t i = 0; i <= j; ++i)
+						hnorm = std::max(hnorm, R(std::abs(c[i])));
+				}
+				hnorm = std::max(hnorm, R(std::abs(H[j][j])));
+
+				R beta = blas::nrm2<T, S>(V[j + 1], N);
+				if (beta <= eps * hnorm)
+				{
+					// Invariant subspace: continue with a fresh direction
+					beta = 0;
+					if (j + 1 < N)
+						_random_row<T, S>(V, j + 1, N, gen);
+					else
+						std::fill(V[j + 1], V[j + 1] + N, T(0));
+				}
+				else
+					blas::scal<T, S>(T(R(1) / beta), V[j + 1], N);
+
+				H[j + 1][j] = beta;
+				hnorm = std::max(hnorm, beta);
+			}
+
+			const R beta = std::real(H[m][m - 1]);
+
+			// Ritz pairs of the m×m H
+			if constexpr (HERMITIAN)
+			{
+				for (size_t i = 0; i < m; ++i)
+					for (size_t l = 0; l < m; ++l)
+						Hs[i][l] = i > l ? H[i][l] : i == l ? T(std::real(H[i][i])) : conjugate(H[l][i]);
+
+				eig::general<T, S>(Hs.get(), ev.data(), m, Zs.get());
+				for (size_t i = 0; i < m; ++i)
+				{
+					ev[i] = C(std::real(Hs[i][i]));
+					for (size_t l = 0; l < m; ++l)
+						Yr[l][i] = C(Zs[l][i]);
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < m; ++i)
+					for (size_t l = 0; l < m; ++l)
+						Hc[i][l] = C(H[i][l]);
+
+				eig::general<C, S>(Hc.get(), ev.data(), m, Zc.get());
+
+				// Eigenvectors of the triangular Schur form, back to the basis of H
+				const R small = std::max(eps * hnorm, std::numeric_limits<R>::min());
+				std::vector<C> yt(m);
+				for (size_t i = 0; i < m; ++i)
+				{
+					std::fill(yt.begin(), yt.end(), C(0));
+					yt[i] = C(1);
+					for (size_t l = i; l-- > 0; )
+					{
+						C s = 0;
+						for (size_t p = l + 1; p <= i; ++p)
+							s += Hc[l][p] * yt[p];
+						C d = Hc[l][l] - ev[i];
+						if (std::abs(d) < small)
+							d = small;
+						yt[l] = -s / d;
+					}
+
+					R norm = 0;
+					for (size_t l = 0; l < m; ++l)
+					{
+						C s = 0;
+						for (size_t p = 0; p <= i; ++p)
+							s += Zc[l][p] * yt[p];
+						Yr[l][i] = s;
+						norm += std::norm(s);
+					}
+					norm = std::sqrt(norm);
+					for (size_t l = 0; l < m; ++l)
+						Yr[l][i] /= norm;
+				}
+			}
+
+			std::iota(order.begin(), order.end(), size_t(0));
+			std::stable_sort(order.begin(), order.end(), [&](const size_t a, const size_t b)
+			{
+				const R pa = _priority(ev[a], target), pb = _priority(ev[b], target);
+				if (pa != pb)
+					return pa > pb;
+				return ev[a].imag() > ev[b].imag();
+			});
+
+			// The two members of a conjugate pair come out of the complex QR
+			// differing in the last bits, so their priorities need not tie;
+			// list the positive imaginary part first after the sort
+			if constexpr (!is_complex_v<T>)
+				for (size_t i = 0; i + 1 < m; ++i)
+				{
+					const C a = ev[order[i]], b = ev[order[i + 1]];
+					if (a.imag() * b.imag() < 0 && std::abs(a - std::conj(b)) <= 64 * eps * std::max(std::abs(a), hnorm))
+					{
+						if (a.imag() < 0)
+							std::swap(order[i], order[i + 1]);
+						++i;
+					}
+				}
+
+			size_t nconv = 0;
+			for (size_t i = 0; i < k; ++i)
+			{
+				const size_t q = order[i];
+				const R residual = beta * std::abs(Yr[m - 1][q]);
+				if (residual <= tol * std::max(eps23 * hnorm, std::abs(ev[q])))
+					++nconv;
+			}
+
+			if (nconv >= k || it + 1 >= restarts || m == N)
+			{
+				for (size_t i = 0; i < k; ++i)
+				{
+					theta[i] = ev[order[i]];
+					for (size_t l = 0; l < m; ++l)
+						Y[i][l] = Yr[l][order[i]];
+				}
+				return nconv;
+			}
+
+			// Restart basis: the wanted Ritz vectors plus room for converged ones
+			const size_t want = std::min(m - 1, k + std::min(nconv, (m - k) / 2));
+			size_t keep = 0;
+
+			if constexpr (HERMITIAN)
+			{
+				for (; keep < want; ++keep)
+					for (size_t l = 0; l < m; ++l)
+						Yb[l][keep] = Zs[l][order[keep]];
+			}
+			else
+			{
+				auto Ym = aligned_alloc_2D<T, S::bytes>(m, m);
+				std::vector<bool> used(m, false);
+				const R real_tol = R(1000) * eps * std::max(hnorm, std::numeric_limits<R>::min());
+
+				for (size_t i = 0; i < m && keep < want; ++i)
+				{
+					const size_t q = order[i];
+					if (used[q])
+						continue;
+					used[q] = true;
+
+					if constexpr (is_complex_v<T>)
+					{
+						for (size_t l = 0; l < m; ++l)
+							Ym[l][keep] = Yr[l][q];
+						++keep;
+					}
+					else if (std::abs(ev[q].imag()) <= real_tol)
+					{
+						// Real Ritz value: rotate the vector to real before taking its real part
+						size_t p = 0;
+						for (size_t l = 1; l < m; ++l)
+							if (std::abs(Yr[l][q]) > std::abs(Yr[p][q]))
+								p = l;
+						const C phase = std::conj(Yr[p][q]) / std::abs(Yr[p][q]);
+						for (size_t l = 0; l < m; ++l)
+							Ym[l][keep] = (Yr[l][q] * phase).real();
+						++keep;
+					}
+					else
+					{
+						// Conjugate pair: real and imaginary parts span both vectors
+						if (keep + 2 > m - 1)
+							break;
+						size_t partner = q;
+						R best = std::numeric_limits<R>::max();
+						for (size_t l = 0; l < m; ++l)
+							if (l != q && std::abs(ev[l] - std::conj(ev[q])) < best)
+							{
+								best = std::abs(ev[l] - std::conj(ev[q]));
+								partner = l;
+							}
+						used[partner] = true;
+						for (size_t l = 0; l < m; ++l)
+						{
+							Ym[l][keep] = Yr[l][q].real();
+							Ym[l][keep + 1] = Yr[l][q].imag();
+						}
+						keep += 2;
+					}
+				}
+
+				// Orthonormal columns spanning the chosen Ritz vectors
+				auto Ycols = aligned_alloc_2D<T, S::bytes>(m, keep);
+				auto Q = aligned_alloc_2D<T, S::bytes>(m, m);
+				auto Rf = aligned_alloc_2D<T, S::bytes>(m, keep);
+				for (size_t l = 0; l < m; ++l)
+					std::copy(Ym[l], Ym[l] + keep, Ycols[l]);
+				qr::decompose<T, S>(Ycols.get(), Q.get(), Rf.get(), m, keep);
+				for (size_t l = 0; l < m; ++l)
+					std::copy(Q[l], Q[l] + keep, Yb[l]);
+			}
+
+			// Projected matrix S = Ybᴴ·H·Yb and the coupling row β·e_mᵀ·Yb
+			std::vector<T> HY(m * keep, T(0));
+			for (size_t i = 0; i < m; ++i)
+				for (size_t l = 0; l < m; ++l)
+				{
+					const T hil = HERMITIAN ? (i >= l ? (i == l ? T(std::real(H[i][i])) : H[i][l]) : conjugate(H[l][i])) : H[i][l];
+					if (hil == T(0))
+						continue;
+					for (size_t q = 0; q < keep; ++q)
+						HY[i * keep + q] += hil * Yb[l][q];
+				}
+
+			zeros<T, S>(H.get(), m + 1, m);
+			for (size_t p = 0; p < keep; ++p)
+				for (size_t q = 0; q < keep; ++q)
+				{
+					T s = T(0);
+					for (size_t i = 0; i < m; ++i)
+						s += conjugate(Yb[i][p]) * HY[i * keep + q];
+					H[p][q] = s;
+				}
+			for (size_t q = 0; q < keep; ++q)
+				H[keep][q] = beta * Yb[m - 1][q];
+
+			// V ← Ybᵀ·V, and the residual direction moves up to row keep
+			auto YbT = aligned_alloc_2D<T, S::bytes>(keep, m);
+			for (size_t q = 0; q < keep; ++q)
+				for (size_t l = 0; l < m; ++l)
+					YbT[q][l] = Yb[l][q];
+			zeros<T, S>(Vt.get(), keep, N);
+			multiply<T, S>(YbT.get(), V, Vt.get(), keep, m, N);
+			for (size_t q = 0; q < keep; ++q)
+				std::copy(Vt[q], Vt[q] + N, V[q]);
+			std::copy(V[m], V[m] + N, V[keep]);
+
+			kept = keep;
+		}
+	}
+
+	/**
+	 * \brief Checks shared by the Krylov solvers; returns the basis size.
+	 * Low level function not intended for the public API.
+	 */
+	inline size_t
+	_basis_size(const char* id, const size_t N, const size_t k, const size_t m)
+	{
+		if (N == 0 || k == 0 || k > N)
+			throw std::invalid_argument(std::string(id) + " need 0 < k ≤ N");
+		if (m != 0 && m <= k && m < N)
+			throw std::invalid_argument(std::string(id) + " basis size must exceed k");
+
+		return std::min(N, m ? m : std::max(2 * k + 1, size_t(20)));
+	}
+
+	/**
+	 * \brief Dense operator y = A·x, rows in parallel.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline auto
+	_dense_operator(T** A, const size_t N)
+	{
+		return [A, N](const T* x, T* y)
+		{
+			#pragma omp parallel for schedule(static) if(N >= 256)
+			for (size_t i = 0; i < N; ++i)
+				y[i] = blas::_dot<T, S>(A[i], x, N);
+		};
+	}
+
+	/**
+	 * \brief Sparse operator y = A·x through bsr::multiply_vector.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S>
+	inline auto
+	_bsr_operator(const bsr::matrix<T>& A)
+	{
+		return [&A](const T* x, T* y)
+		{
+			std::fill(y, y + A.rows(), T(0));
+			bsr::multiply_vector<T, S>(A, x, y);
+		};
+	}
+
+	/**
+	 * \brief k eigenpairs of a Hermitian operator by thick restarted Lanczos.
+	 *
+	 * \tparam T		Scalar type (float, double, or complex variants)
+	 * \tparam S		SIMD instruction set for the vector kernels
+	 *
+	 * \param op		Operator, op(x, y) writes y = A·x; A must be Hermitian
+	 * \param N			Operator dimension
+	 * \param k			Number of eigenpairs wanted
+	 * \param w			Output eigenvalues (k), in target order
+	 * \param X			Optional output (k×N), row i the unit eigenvector of w[i]
+	 * \param target	End of the spectrum to converge to
+	 * \param m			Basis size, default max(2k + 1, 20), capped at N
+	 * \param tol		Relative residual ‖A·x - λ·x‖ ≤ tol·|λ| accepted as converged
+	 * \param restarts	Restart limit
+	 *
+	 * \return number of eigenpairs that converged, k on success
+	 *
+	 * \throws std::invalid_argument if k is 0 or exceeds N, or m ≤ k
+	 */
+	template<typename T, typename S = decltype(detect_simd()), typename Op>
+	requires linear_operator<Op, T>
+	inline size_t
+	lanczos(Op&& op, const size_t N, const size_t k, typename base<T>::type* w, T** X = nullptr,
+		const Target target = Target::LARGEST_MAGNITUDE, const size_t m = 0,
+		const typename base<T>::type tol = std::sqrt(std::numeric_limits<typename base<T>::type>::epsilon()),
+		const size_t restarts = 300)
+	{
+		using R = typename base<T>::type;
+		using C = std::complex<R>;
+
+		const size_t basis = _basis_size("lanczos:", N, k, m);
+		right<R>("lanczos:", std::make_tuple(w, size_t(1), k));
+		if (X)
+			right<T>("lanczos:", std::make_tuple(X, k, N));
+
+		auto V = aligned_alloc_2D<T, S::bytes>(basis + 1, N);
+		auto Y = aligned_alloc_2D<C, S::bytes>(k, basis);
+		std::vector<C> theta(k);
+
+		const size_t converged = _krylov<T, S, true>(op, N, k, basis, target, tol, restarts, V.get(), theta.data(), Y.get());
+
+		for (size_t i = 0; i < k; ++i)
+			w[i] = theta[i].real();
+
+		if (X)
+		{
+			// Eigenvectors of the real symmetric H are real, X = Y·V
+			auto Yt = aligned_alloc_2D<T, S::bytes>(k, basis);
+			for (size_t i = 0; i < k; ++i)
+				for (size_t l = 0; l < basis; ++l)
+				{
+					if constexpr (is_complex_v<T>)
+						Yt[i][l] = Y[i][l];
+					else
+						Yt[i][l] = Y[i][l].real();
+				}
+			zeros<T, S>(X, k, N);
+			multiply<T, S>(Yt.get(), V.get(), X, k, basis, N);
+		}
+
+		return converged;
+	}
+
+	/**
+	 * \brief Lanczos on a dense Hermitian matrix A (N×N).
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline size_t
+	lanczos(T** A, const size_t N, const size_t k, typename base<T>::type* w, T** X = nullptr,
+		const Target target = Target::LARGEST_MAGNITUDE, const size_t m = 0,
+		const typename base<T>::type tol = std::sqrt(std::numeric_limits<typename base<T>::type>::epsilon()),
+		const size_t restarts = 300)
+	{
+		right<T>("lanczos:", std::make_tuple(A, N, N));
+		return lanczos<T, S>(_dense_operator<T, S>(A, N), N, k, w, X, target, m, tol, restarts);
+	}
+
+	/**
+	 * \brief Lanczos on a square, Hermitian bsr::matrix.
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline size_t
+	lanczos(const bsr::matrix<T>& A, const size_t k, typename base<T>::type* w, T** X = nullptr,
+		const Target target = Target::LARGEST_MAGNITUDE, const size_t m = 0,
+		const typename base<T>::type tol = std::sqrt(std::numeric_limits<typename base<T>::type>::epsilon()),
+		const size_t restarts = 300)
+	{
+		if (A.rows() != A.cols())
+			throw std::invalid_argument("lanczos: matrix must be square");
+		return lanczos<T, S>(_bsr_operator<T, S>(A), A.rows(), k, w, X, target, m, tol, restarts);
+	}
+
+	/**
+	 * \brief k eigenpairs of a general operator by thick restarted Arnoldi.
+	 *
+	 * \tparam T		Scalar type (float, double, or complex variants)
+	 * \tparam S		SIMD instruction set for the vector kernels
+	 *
+	 * \param op		Operator, op(x, y) writes y = A·x
+	 * \param N			Operator dimension
+	 * \param k			Number of eigenpairs wanted
+	 * \param w			Output eigenvalues (k), in target order; for real operators
+	 *					a conjugate pair is listed positive imaginary part first
+	 * \param X			Optional output (k×N), row i the unit eigenvector of w[i]
+	 * \param target	End of the spectrum to converge to
+	 * \param m			Basis size, default max(2k + 1, 20), capped at N
+	 * \param tol		Relative residual ‖A·x - λ·x‖ ≤ tol·|λ| accepted as converged
+	 * \param restarts	Restart limit
+	 *
+	 * \return number of eigenpairs that converged, k on success
+	 *
+	 * \throws std::invalid_argument if k is 0 or exceeds N, or m ≤ k
+	 */
+	template<typename T, typename S = decltype(detect_simd()), typename Op>
+	requires linear_operator<Op, T>
+	inline size_t
+	arnoldi(Op&& op, const size_t N, const size_t k, std::complex<typename base<T>::type>* w,
+		std::complex<typename base<T>::type>** X = nullptr,
+		const Target target = Target::LARGEST_MAGNITUDE, const size_t m = 0,
+		const typename base<T>::type tol = std::sqrt(std::numeric_limits<typename base<T>::type>::epsilon()),
+		const size_t restarts = 300)
+	{
+		using R = typename base<T>::type;
+		using C = std::complex<R>;
+
+		const size_t basis = _basis_size("arnoldi:", N, k, m);
+		right<C>("arnoldi:", std::make_tuple(w, size_t(1), k));
+		if (X)
+			right<C>("arnoldi:", std::make_tuple(X, k, N));
+
+		auto V = aligned_alloc_2D<T, S::bytes>(basis + 1, N);
+		auto Y = aligned_alloc_2D<C, S::bytes>(k, basis);
+
+		const size_t converged = _krylov<T, S, false>(op, N, k, basis, target, tol, restarts, V.get(), w, Y.get());
+
+		if (X)
+		{
+			zeros<C, S>(X, k, N);
+			if constexpr (is_complex_v<T>)
+				multiply<C, S>(Y.get(), V.get(), X, k, basis, N);
+			else
+			{
+				// X = Re(Y)·V + i·Im(Y)·V
+				auto Yp = aligned_alloc_2D<R, S::bytes>(k, basis);
+				auto P = aligned_alloc_2D<R, S::bytes>(k, N);
+				for (const bool imaginary : {false, true})
+				{
+					for (size_t i = 0; i < k; ++i)
+						for (size_t l = 0; l < basis; ++l)
+							Yp[i][l] = imaginary ? Y[i][l].imag() : Y[i][l].real();
+					zeros<R, S>(P.get(), k, N);
+					multiply<R, S>(Yp.get(), V.get(), P.get(), k, basis, N);
+					for (size_t i = 0; i < k; ++i)
+						for (size_t j = 0; j < N; ++j)
+							X[i][j] += imaginary ? C(0, P[i][j]) : C(P[i][j]);
+				}
+			}
+		}
+
+		return converged;
+	}
+
+	/**
+	 * \brief Arnoldi on a dense matrix A (N×N).
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline size_t
+	arnoldi(T** A, const size_t N, const size_t k, std::complex<typename base<T>::type>* w,
+		std::complex<typename base<T>::type>** X = nullptr,
+		const Target target = Target::LARGEST_MAGNITUDE, const size_t m = 0,
+		const typename base<T>::type tol = std::sqrt(std::numeric_limits<typename base<T>::type>::epsilon()),
+		const size_t restarts = 300)
+	{
+		right<T>("arnoldi:", std::make_tuple(A, N, N));
+		return arnoldi<T, S>(_dense_operator<T, S>(A, N), N, k, w, X, target, m, tol, restarts);
+	}
+
+	/**
+	 * \brief Arnoldi on a square bsr::matrix.
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline size_t
+	arnoldi(const bsr::matrix<T>& A, const size_t k, std::complex<typename base<T>::type>* w,
+		std::complex<typename base<T>::type>** X = nullptr,
+		const Target target = Target::LARGEST_MAGNITUDE, const size_t m = 0,
+		const typename base<T>::type tol = std::sqrt(std::numeric_limits<typename base<T>::type>::epsilon()),
+		const size_t restarts = 300)
+	{
+		if (A.rows() != A.cols())
+			throw std::invalid_argument("arnoldi: matrix must be square");
+		return arnoldi<T, S>(_bsr_operator<T, S>(A), A.rows(), k, w, X, target, m, tol, restarts);
+	}
+} // namespace eig
+} // namespace damm
+#endif //__KRYLOV_H__
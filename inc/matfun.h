@@ -0,0 +1,407 @@
+#ifndef __MATFUN_H__
+#define __MATFUN_H__
+/**
+ * \file matfun.h
+ * \brief definitions for matrix functions
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <common.h>
+#include <damm_memory.h>
+#include <broadcast.h>
+#include <union.h>
+#include <fused_union.h>
+#include <multiply.h>
+#include <inverse.h>
+
+/**
+ * \brief Matrix functions - exponential, square root and integer power.
+ *
+ * \note
+ * All three are built from N×N matrix products and one inversion per step,
+ * so their cost is dominated by multiply. Every temporary is allocated once
+ * per call and reused across iterations; the iterations ping-pong between
+ * buffers instead of allocating.
+ */
+namespace damm
+{
+	/** 
+	 * \brief kernel for the matrix 1-norm, max_j Σ_i |A[i][j]|.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T>
+	inline typename base<T>::type
+	_norm1(T** A, const size_t N)
+	{
+		using R = typename base<T>::type;
+		std::vector<R> col(N, R(0));
+
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+				col[j] += std::abs(A[i][j]);
+
+		return *std::max_element(col.begin(), col.end());
+	}
+
+	/** 
+	 * \brief kernel for Y <- Y + a * X over N×N matrices.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_accumulate(T** Y, const T a, T** X, const size_t N)
+	{
+		scalar::fused_union<FusionPolicy::FUSION_FIRST, T, std::plus<>, std::multiplies<>, S>(
+			Y, X, a, Y, N, N);
+	}
+
+	/** 
+	 * \brief kernel for C <- A * B over N×N matrices.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_product(T** A, T** B, T** C, const size_t N)
+	{
+		zeros<T, S>(C, N, N);
+		multiply<T, S>(A, B, C, N, N, N);
+	}
+
+	/** 
+	 * \brief kernel for copying an N×N matrix.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T>
+	inline __attribute__((always_inline))
+	void
+	_copy(T** A, T** B, const size_t N)
+	{
+		for (size_t i = 0; i < N; ++i)
+			std::copy(A[i], A[i] + N, B[i]);
+	}
+
+	/**
+	 * \brief Padé numerator coefficients b_0..b_m of the [m/m] approximant to exp.
+	 */
+	inline constexpr double _pade3[] = {120., 60., 12., 1.};
+	inline constexpr double _pade5[] = {30240., 15120., 3360., 420., 30., 1.};
+	inline constexpr double _pade7[] = {17297280., 8648640., 1995840., 277200., 25200., 1512., 56., 1.};
+	inline constexpr double _pade9[] = {17643225600., 8821612800., 2075673600., 302702400., 30270240., 
+		2162160., 110880., 3960., 90., 1.};
+	inline constexpr double _pade13[] = {64764752532480000., 32382376266240000., 7771770303897600., 
+		1187353796428800., 129060195264000., 10559470521600., 670442572800., 33522128640., 
+		1323241920., 40840800., 960960., 16380., 182., 1.};
+
+	/**
+	 * \brief Matrix exponential by Padé approximation with scaling and squaring.
+	 *
+	 * Implements Higham (2005): the Padé degree m ∈ {3, 5, 7, 9, 13} is the lowest
+	 * whose backward error bound θ_m covers ||A||_1. Otherwise A is scaled by 2^-s so
+	 * that ||A||_1 / 2^s ≤ θ_13, the [13/13] approximant r(A/2^s) is formed from
+	 * A², A⁴, A⁶, and the result is squared s times. For float the degrees stop at 7
+	 * with single precision θ_m.
+	 *
+	 * r_m = Q⁻¹P with P = V + U, Q = V - U, where U holds the odd and V the even
+	 * terms of the numerator. Q is inverted in place with gauss_jordan::inverse.
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (N×N), not modified
+	 * \param E         Output matrix exp(A) (N×N)
+	 * \param N         Matrix dimension
+	 *
+	 * \return true if successful, false if the Padé denominator is singular
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline bool
+	expm(T** A, T** E, const size_t N)
+	{
+		right<T>("expm:", std::make_tuple(A, N, N), std::make_tuple(E, N, N));
+
+		using R = typename base<T>::type;
+
+		// Degree selection: the lowest m whose θ_m bounds ||A||_1, else the top degree with scaling
+		const R norm = _norm1(A, N);
+		size_t m;
+		const double* b;
+		double theta_max;
+
+		if constexpr (std::is_same_v<R, float>)
+		{
+			theta_max = 3.925724783138660e0;
+			if (norm <= 4.258730016922831e-1) { m = 3; b = _pade3; }
+			else if (norm <= 1.880152677804762e0) { m = 5; b = _pade5; }
+			else { m = 7; b = _pade7; }
+		}
+		else
+		{
+			theta_max = 5.371920351148152e0;
+			if (norm <= 1.495585217958292e-2) { m = 3; b = _pade3; }
+			else if (norm <= 2.539398330063230e-1) { m = 5; b = _pade5; }
+			else if (norm <= 9.504178996162932e-1) { m = 7; b = _pade7; }
+			else if (norm <= 2.097847961257068e0) { m = 9; b = _pade9; }
+			else { m = 13; b = _pade13; }
+		}
+
+		int s = 0;
+		if (norm > theta_max)
+			s = static_cast<int>(std::ceil(std::log2(norm / theta_max)));
+
+		// Workspace: scaled A, its even powers A², A⁴, A⁶, A⁸, the odd/even sums U, V and a product buffer
+		auto As = aligned_alloc_2D<T, S::bytes>(N, N);
+		auto U = aligned_alloc_2D<T, S::bytes>(N, N);
+		auto V = aligned_alloc_2D<T, S::bytes>(N, N);
+		auto W = aligned_alloc_2D<T, S::bytes>(N, N);
+		auto A2 = aligned_alloc_2D<T, S::bytes>(N, N);
+		auto A4 = aligned_alloc_2D<T, S::bytes>(N, N);
+		auto A6 = aligned_alloc_2D<T, S::bytes>(N, N);
+		auto A8 = aligned_alloc_2D<T, S::bytes>(N, N);
+		T** even[] = {A2.get(), A4.get(), A6.get(), A8.get()};
+
+		scalar::unite<T, std::multiplies<>, S>(A, T(std::ldexp(R(1), -s)), As.get(), N, N);
+
+		// A^(2k) for k = 1..(m-1)/2, except the [13/13] form which needs only A², A⁴, A⁶
+		const size_t powers = (m == 13) ? 3 : (m - 1) / 2;
+		_product<T, S>(As.get(), As.get(), even[0], N);
+		for (size_t k = 1; k < powers; ++k)
+			_product<T, S>(even[k - 1], even[0], even[k], N);
+
+		// D = b[c0]·I + Σ_k b[c0 + 2k]·A^(2k), over the even powers k = 1..count
+		auto combine = [&](T** D, const size_t c0, const size_t count)
+		{
+			zeros<T, S>(D, N, N);
+			for (size_t i = 0; i < N; ++i)
+				D[i][i] = T(b[c0]);
+			for (size_t k = 1; k <= count; ++k)
+				_accumulate<T, S>(D, T(b[c0 + 2 * k]), even[k - 1], N);
+		};
+
+		if (m == 13)
+		{
+			// U = A·[A⁶(b13·A⁶ + b11·A⁴ + b9·A²) + b7·A⁶ + b5·A⁴ + b3·A² + b1·I]
+			zeros<T, S>(V.get(), N, N);
+			for (size_t k = 1; k <= 3; ++k)
+				_accumulate<T, S>(V.get(), T(b[7 + 2 * k]), even[k - 1], N);
+			_product<T, S>(even[2], V.get(), W.get(), N);
+			combine(U.get(), 1, 3);
+			_accumulate<T, S>(W.get(), T(1), U.get(), N);
+			_product<T, S>(As.get(), W.get(), U.get(), N);
+
+			// V = A⁶(b12·A⁶ + b10·A⁴ + b8·A²) + b6·A⁶ + b4·A⁴ + b2·A² + b0·I
+			zeros<T, S>(W.get(), N, N);
+			for (size_t k = 1; k <= 3; ++k)
+				_accumulate<T, S>(W.get(), T(b[6 + 2 * k]), even[k - 1], N);
+			_product<T, S>(even[2], W.get(), V.get(), N);
+			combine(W.get(), 0, 3);
+			_accumulate<T, S>(V.get(), T(1), W.get(), N);
+		}
+		else
+		{
+			combine(W.get(), 1, powers);
+			_product<T, S>(As.get(), W.get(), U.get(), N);
+			combine(V.get(), 0, powers);
+		}
+
+		// Q = V - U, P = V + U = Q + 2U
+		_accumulate<T, S>(V.get(), T(-1), U.get(), N);
+		scalar::fused_union<FusionPolicy::FUSION_FIRST, T, std::plus<>, std::multiplies<>, S>(
+			V.get(), U.get(), T(2), U.get(), N, N);
+
+		if (!gauss_jordan::inverse<T, S>(V.get(), N))
+			return false;
+
+		// r_m = Q⁻¹P, squared s times between E and W
+		T** X = E;
+		T** Y = W.get();
+		_product<T, S>(V.get(), U.get(), X, N);
+
+		for (int k = 0; k < s; ++k)
+		{
+			_product<T, S>(X, X, Y, N);
+			std::swap(X, Y);
+		}
+
+		if (X != E)
+			_copy(X, E, N);
+
+		return true;
+	}
+
+	/**
+	 * \brief Principal matrix square root by the scaled product Denman–Beavers iteration.
+	 *
+	 * Iterates, from M_0 = Y_0 = A,
+	 *   Y_{k+1} = μ_k Y_k (I + μ_k⁻² M_k⁻¹) / 2
+	 *   M_{k+1} = I/2 + (μ_k² M_k + μ_k⁻² M_k⁻¹) / 4
+	 * so that M_k → I and Y_k → A^(1/2) quadratically. While far from convergence
+	 * the determinant scaling μ_k = |det M_k|^(-1/2N) balances the eigenvalues
+	 * and cuts the iteration count for badly scaled A; once ||M_k - I|| < 1e-2
+	 * the scaling is dropped. log|det M_k| is the sum of log|pivot| of the
+	 * Gauss-Jordan step, so each step costs one in-place inverse, on workspace
+	 * allocated once per call, and one product.
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (N×N), not modified. A must have no
+	 *                  eigenvalues on the closed negative real axis.
+	 * \param X         Output matrix A^(1/2) (N×N)
+	 * \param N         Matrix dimension
+	 * \param max_iter  Maximum number of iterations
+	 *
+	 * \return true if converged, false if an iterate is singular or max_iter is reached
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline bool
+	sqrtm(T** A, T** X, const size_t N, const size_t max_iter = 64)
+	{
+		right<T>("sqrtm:", std::make_tuple(A, N, N), std::make_tuple(X, N, N));
+
+		using R = typename base<T>::type;
+		const R tolerance = std::sqrt(R(N)) * std::numeric_limits<R>::epsilon() * R(10);
+
+		auto M = aligned_alloc_2D<T, S::bytes>(N, N);
+		auto M_inv = aligned_alloc_2D<T, S::bytes>(N, N);
+		auto Z = aligned_alloc_2D<T, S::bytes>(N, N);
+		auto W = aligned_alloc_2D<T, S::bytes>(N, N);
+
+		// Gauss-Jordan workspace
+		constexpr size_t panel = inverse_kernel<T, S>::kernel_cols();
+		std::vector<size_t> pivots(N);
+		auto GZ = aligned_alloc_2D<T, S::bytes>(N, panel);
+		auto GB = aligned_alloc_2D<T, S::bytes>(panel, N);
+		auto g = aligned_alloc_1D<T, S::bytes>(1, N);
+
+		_copy(A, M.get(), N);
+		_copy(A, X, N);
+
+		// Y ping-pongs between X and W
+		T** Y = X;
+		T** Y_next = W.get();
+		R error = std::numeric_limits<R>::infinity();
+
+		for (size_t iter = 0; iter < max_iter && error > tolerance; ++iter)
+		{
+			R logabsdet;
+			_copy(M.get(), M_inv.get(), N);
+			if (!gauss_jordan::_inverse<T, S>(M_inv.get(), N, pivots.data(), GZ.get(), GB.get(), g.get(), logabsdet))
+				return false;
+
+			const R mu = (error > R(1e-2)) ? std::exp(-logabsdet / R(2 * N)) : R(1);
+			const R mu2 = mu * mu;
+
+			// Y <- μ·Y·(I + μ⁻²M⁻¹)/2
+			scalar::unite<T, std::multiplies<>, S>(M_inv.get(), T(R(0.5) / mu2), Z.get(), N, N);
+			for (size_t i = 0; i < N; ++i)
+				Z[i][i] += T(0.5);
+
+			_product<T, S>(Y, Z.get(), Y_next, N);
+			scalar::unite<T, std::multiplies<>, S>(Y_next, T(mu), Y_next, N, N);
+			std::swap(Y, Y_next);
+
+			// M <- I/2 + (μ²M + μ⁻²M⁻¹)/4
+			scalar::unite<T, std::multiplies<>, S>(M.get(), T(mu2 / R(4)), M.get(), N, N);
+			_accumulate<T, S>(M.get(), T(R(0.25) / mu2), M_inv.get(), N);
+
+			error = R(0);
+			for (size_t i = 0; i < N; ++i)
+			{
+				M[i][i] += T(0.5);
+				for (size_t j = 0; j < N; ++j)
+					error = std::max(error, std::abs(M[i][j] - T(i == j)));
+			}
+		}
+
+		if (Y != X)
+			_copy(Y, X, N);
+
+		return error <= tolerance;
+	}
+
+	/**
+	 * \brief Integer matrix power A^p by binary exponentiation.
+	 *
+	 * Uses ⌊log2 |p|⌋ squarings and at most as many further products. A negative
+	 * p inverts A once with gauss_jordan::inverse; p = 0 gives the identity.
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (N×N), not modified
+	 * \param B         Output matrix A^p (N×N)
+	 * \param N         Matrix dimension
+	 * \param p         Exponent
+	 *
+	 * \return true if successful, false if p < 0 and A is singular
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline bool
+	matpow(T** A, T** B, const size_t N, const long p)
+	{
+		right<T>("matpow:", std::make_tuple(A, N, N), std::make_tuple(B, N, N));
+
+		auto P = aligned_alloc_2D<T, S::bytes>(N, N);
+		auto W = aligned_alloc_2D<T, S::bytes>(N, N);
+
+		_copy(A, P.get(), N);
+		if (p < 0 && !gauss_jordan::inverse<T, S>(P.get(), N))
+			return false;
+
+		identity<T, S>(B, N, N);
+
+		// The result ping-pongs between B and W, the running square between P and W
+		T** result = B;
+		T** square = P.get();
+		T** spare = W.get();
+
+		for (unsigned long e = (p < 0) ? -static_cast<unsigned long>(p) : p; e != 0; e >>= 1)
+		{
+			if (e & 1)
+			{
+				_product<T, S>(result, square, spare, N);
+				std::swap(result, spare);
+			}
+
+			if (e > 1)
+			{
+				_product<T, S>(square, square, spare, N);
+				std::swap(square, spare);
+			}
+		}
+
+		if (result != B)
+			_copy(result, B, N);
+
+		return true;
+	}
+
+} //namespace damm
+
+#endif //__MATFUN_H__
@@ -31,6 +31,7 @@
 #include <damm_kernels.h>
 #include <omp.h>
 #include <transpose.h>
+#include <semiring.h>
 
 namespace damm
 {
@@ -42,7 +43,7 @@ namespace damm
 	 * In other words, the transpose of the B matrix being multiplied with A is provided instead of B.
 	 * Providing the transpose of B in lieu of B preserves cache coherence with a more efficient memory access pattern.    
 	 * */
-	template <typename T, bool TR=false>
+	template <typename T, bool TR=false, typename SR=plus_times>
 	inline __attribute__((always_inline))
 	void
 	_multiply_block(T** A, T** B, T** C, 
@@ -53,10 +54,18 @@ namespace damm
 			for(size_t j = 0; j < P; j++)
 				for(size_t k = 0; k < N; ++k)
 				{
-					if constexpr (TR)
-						C[I + i][J + j] += A[I + i][K + k] * B[J + j][K + k];
-					else 
-						C[I + i][J + j] += A[I + i][K + k] * B[K + k][J + j];
+					if constexpr (std::same_as<SR, plus_times>)
+					{
+						if constexpr (TR)
+							C[I + i][J + j] += A[I + i][K + k] * B[J + j][K + k];
+						else 
+							C[I + i][J + j] += A[I + i][K + k] * B[K + k][J + j];
+					}
+					else
+					{
+						const T b = TR ? B[J + j][K + k] : B[K + k][J + j];
+						C[I + i][J + j] = SR::add(C[I + i][J + j], SR::mul(A[I + i][K + k], b));
+					}
 				}
 	}
 
@@ -80,7 +89,7 @@ namespace damm
 	 * \note	TR=true enables multiplication with a transposed matrix B for improved memory access patterns.
 	 * \note	Supports asymmetric dimensions.
 	 */
-	template <typename T, bool TR=false, template<typename, typename> class K>
+	template <typename T, bool TR=false, template<typename, typename> class K, typename SR=plus_times>
 	inline __attribute__((always_inline))
 	void
 	_multiply(T** A, T** B, T** C, const size_t M, const size_t N, const size_t P)
@@ -102,7 +111,7 @@ namespace damm
 					size_t m = std::min(l2_block, M - i);
 					size_t n = std::min(l1_block, N - k);
 					size_t p = std::min(l3_block, P - j);
-					_multiply_block<T, TR>(A, B, C, i, j, k, m, n, p);
+					_multiply_block<T, TR, SR>(A, B, C, i, j, k, m, n, p);
 				}
 			}
 		}
@@ -110,13 +119,15 @@ namespace damm
 
 	/**
 	 * \brief SIMD multiply kernel for real types
+	 * B is read from column b_col, which differs from col when B is a packed panel
 	 */
-	template<typename T, typename S, template<typename, typename> class K>
+	template<typename T, typename S, template<typename, typename> class K, typename SR = plus_times>
 	requires (!std::is_same_v<T, std::complex<float>> && !std::is_same_v<T, std::complex<double>>)
 	inline __attribute__((always_inline))
 	void _multiply_block_simd(T** At, T** B, T** C,
 		const size_t row, const size_t col, 
-		const size_t k_start, const size_t k_end)
+		const size_t k_start, const size_t k_end,
+		const size_t b_col)
 	{
 		using kernel_t = K<T, S>;
 		using register_t = typename S::template register_t<T>;
@@ -137,7 +148,7 @@ namespace damm
 			alignas(S::bytes) register_t b_vecs[col_regs];
 			static_for<col_regs>([&]<auto j>() 
 			{
-				b_vecs[j] = _loadu<T, S>(&B[k][col + j * SIMD_WIDTH]);
+				b_vecs[j] = _loadu<T, S>(&B[k][b_col + j * SIMD_WIDTH]);
 			});
 			
 			static_for<row_regs>([&]<auto i>() 
@@ -146,7 +157,7 @@ namespace damm
 				
 				static_for<col_regs>([&]<auto j>() 
 				{
-					c_accum[i][j] = _fmadd<T, S>(a_broadcast, b_vecs[j], c_accum[i][j]);
+					c_accum[i][j] = SR::template fma<T, S>(a_broadcast, b_vecs[j], c_accum[i][j]);
 				});
 			});
 		}
@@ -157,12 +168,13 @@ namespace damm
 	// /**
 	//  * \brief SIMD multiply kernel for complex types
 	//  */
-	template<typename T, typename S, template<typename, typename> class K>
-	requires (std::is_same_v<T, std::complex<float>> || std::is_same_v<T, std::complex<double>>)
+	template<typename T, typename S, template<typename, typename> class K, typename SR = plus_times>
+	requires ((std::is_same_v<T, std::complex<float>> || std::is_same_v<T, std::complex<double>>) && std::same_as<SR, plus_times>)
 	inline __attribute__((always_inline))
 	void _multiply_block_simd(T** packed_A, T** B, T** C,
 		const size_t row, const size_t col, 
-		const size_t k_start, const size_t k_end)
+		const size_t k_start, const size_t k_end,
+		const size_t b_col)
 	{
 		using kernel_t = K<T, S>;
 		using real_t = typename base<T>::type;
@@ -177,6 +189,7 @@ namespace damm
 		auto* C_real = reinterpret_cast<real_t**>(C);
 		
 		const size_t col_real = col * 2;
+		const size_t b_col_real = b_col * 2;
 		
 		register_t sign_mask = alternating_sign_mask_odd<real_t, S>();
 		
@@ -196,7 +209,7 @@ namespace damm
 			
 			static_for<col_regs>([&]<auto j>() 
 			{
-				b_vecs[j] = _loadu<real_t, S>(&B_real[k][col_real + j * SIMD_WIDTH]);
+				b_vecs[j] = _loadu<real_t, S>(&B_real[k][b_col_real + j * SIMD_WIDTH]);
 				b_swapped[j] = swap_adjacent_pairs<real_t, S>(b_vecs[j]);
 			});
 			
@@ -249,7 +262,7 @@ namespace damm
 	 * \note	Supports asymmetric dimensions and non-multiple block sizes.
 	 */
 
-	template<typename T, typename S, template<typename, typename> class K> 
+	template<typename T, typename S, template<typename, typename> class K, typename SR = plus_times> 
 	inline __attribute__((always_inline))
 	void
 	_multiply_simd(T** A, T** B, T** C, const size_t M, const size_t N, const size_t P)
@@ -294,11 +307,12 @@ namespace damm
 						{
 							for (size_t j = 0; j < (j_end - j_block); j += kernel_cols)
 							{
-								_multiply_block_simd<T, S, K>(
+								_multiply_block_simd<T, S, K, SR>(
 											At.get(), B, C,
 											i_block + i,      // row
 											j_block + j,      // col
-											k_block, k_end    // k_start, k_end
+											k_block, k_end,   // k_start, k_end
+											j_block + j       // b_col
 								);
 							}
 						}
@@ -315,22 +329,248 @@ namespace damm
 
 		if (rem_inner != 0 && simd_M > 0 && simd_P > 0)
 		{
-			_multiply_block<T, false>(A, B, C, 0, 0, simd_N, simd_M, rem_inner, simd_P);
+			_multiply_block<T, false, SR>(A, B, C, 0, 0, simd_N, simd_M, rem_inner, simd_P);
 		}
 
 		if (rem_cols != 0 && simd_M > 0)
 		{
-			_multiply_block<T, false>(A, B, C, 0, simd_P, 0, simd_M, N, rem_cols);
+			_multiply_block<T, false, SR>(A, B, C, 0, simd_P, 0, simd_M, N, rem_cols);
 		}
 
 		if (rem_rows != 0 && simd_P > 0)
 		{
-			_multiply_block<T, false>(A, B, C, simd_M, 0, 0, rem_rows, N, simd_P);
+			_multiply_block<T, false, SR>(A, B, C, simd_M, 0, 0, rem_rows, N, simd_P);
 		}
 		
 		if (rem_rows != 0 && rem_cols != 0)
 		{
-			_multiply_block<T, false>(A, B, C, simd_M, simd_P, 0, rem_rows, N, rem_cols);
+			_multiply_block<T, false, SR>(A, B, C, simd_M, simd_P, 0, rem_rows, N, rem_cols);
+		}
+	}
+
+	/**
+	 * \brief Multiply one output tile over an inner range, on the calling thread.
+	 *
+	 * D[i] addresses column j0 of row i of the destination, for i in [i0, i1),
+	 * so a tile can be accumulated either in place into C or into a partial
+	 * buffer. Full micro-tiles run on _multiply_block_simd, the ragged right and
+	 * bottom edges of the tile run scalar.
+	 */
+	template<typename T, typename S, template<typename, typename> class K, typename SR = plus_times>
+	inline
+	void
+	_multiply_tile(T** A, T** At, T** B, T** D,
+		const size_t i0, const size_t i1, const size_t j0, const size_t j1,
+		const size_t k0, const size_t k1)
+	{
+		using kernel_t = K<T, S>;
+		using blocking = typename kernel_t::blocking;
+
+		constexpr size_t l1_block = blocking::l1_block;
+		constexpr size_t kernel_rows = kernel_t::kernel_rows();
+		constexpr size_t kernel_cols = kernel_t::kernel_cols();
+
+		const size_t simd_i1 = i0 + (i1 - i0) - (i1 - i0) % kernel_rows;
+		const size_t simd_j1 = j0 + (j1 - j0) - (j1 - j0) % kernel_cols;
+
+		for (size_t k_block = k0; k_block < k1; k_block += l1_block)
+		{
+			const size_t k_end = std::min(k_block + l1_block, k1);
+
+			for (size_t i = i0; i < simd_i1; i += kernel_rows)
+				for (size_t j = j0; j < simd_j1; j += kernel_cols)
+					_multiply_block_simd<T, S, K, SR>(At, B, D, i, j - j0, k_block, k_end, j);
+		}
+
+		auto edge = [&](const size_t r0, const size_t r1, const size_t c0, const size_t c1)
+		{
+			for (size_t i = r0; i < r1; ++i)
+				for (size_t k = k0; k < k1; ++k)
+					for (size_t j = c0; j < c1; ++j)
+						D[i][j - j0] = SR::add(D[i][j - j0], SR::mul(A[i][k], B[k][j]));
+		};
+
+		edge(i0, simd_i1, simd_j1, j1);
+		edge(simd_i1, i1, j0, j1);
+	}
+
+	/**
+	 * \brief Combine a partial row into C, c[j] = c[j] ⊕ x[j].
+	 */
+	template<typename T, typename S, typename SR = plus_times>
+	inline __attribute__((always_inline))
+	void
+	_combine_row(T* c, const T* x, const size_t n)
+	{
+		using real_t = typename base<T>::type;
+		using register_t = typename S::template register_t<real_t>;
+
+		constexpr size_t SIMD_WIDTH = S::template elements<real_t>();
+		constexpr size_t lanes = is_complex_v<T> ? 2 : 1;
+
+		real_t* c_real = reinterpret_cast<real_t*>(c);
+		const real_t* x_real = reinterpret_cast<const real_t*>(x);
+		const size_t n_real = n * lanes;
+		const size_t simd_n = n_real - n_real % SIMD_WIDTH;
+
+		for (size_t j = 0; j < simd_n; j += SIMD_WIDTH)
+		{
+			register_t x_vec = _loadu<real_t, S>(&x_real[j]);
+			register_t c_vec = _loadu<real_t, S>(&c_real[j]);
+
+			// x ⊗ 1 = x exactly, so fma with the unit performs ⊕ alone
+			if constexpr (std::same_as<SR, plus_times>)
+				c_vec = _add<real_t, S>(c_vec, x_vec);
+			else
+				c_vec = SR::template fma<real_t, S>(x_vec, _set1<real_t, S>(SR::template one<real_t>()), c_vec);
+
+			_storeu<real_t, S>(&c_real[j], c_vec);
+		}
+
+		for (size_t j = simd_n / lanes; j < n; ++j)
+			c[j] = SR::add(c[j], x[j]);
+	}
+
+	/**
+	 * \brief Number of ways to split the tail tiles over the inner dimension.
+	 *
+	 * Output tiles are l2_block × l3_block, the same panels _multiply_simd walks.
+	 * When the tiles cannot keep every thread busy and N dominates M and P, the
+	 * tiles left over after the whole waves are split over k so all threads
+	 * finish together. Returns 0 when the data parallel path should be used.
+	 */
+	template<typename T, typename S, template<typename, typename> class K>
+	inline
+	size_t
+	_stream_k_splits(const size_t M, const size_t N, const size_t P)
+	{
+		using kernel_t = K<T, S>;
+		using blocking = typename kernel_t::blocking;
+
+		constexpr size_t kernel_rows = kernel_t::kernel_rows();
+		constexpr size_t kernel_cols = kernel_t::kernel_cols();
+		constexpr size_t tile_m = std::max(kernel_rows, blocking::l2_block - blocking::l2_block % kernel_rows);
+		constexpr size_t tile_n = std::max(kernel_cols, blocking::l3_block - blocking::l3_block % kernel_cols);
+
+		// upper bound on the elements held in partial tiles
+		constexpr size_t partial_budget = size_t(1) << 24;
+
+		const size_t threads = omp_get_max_threads();
+		const size_t tiles = ((M + tile_m - 1) / tile_m) * ((P + tile_n - 1) / tile_n);
+		const size_t tail = tiles % threads;
+
+		if (threads == 1 || tail == 0 || tiles >= 4 * threads || N < 2 * std::max(M, P))
+			return 0;
+
+		const size_t tile_elements = std::min(tile_m, M) * std::min(tile_n, P);
+		const size_t splits = std::min({
+			threads / tail,
+			N / blocking::l1_block,
+			partial_budget / (tail * tile_elements) + 1
+		});
+
+		return splits > 1 ? splits : 0;
+	}
+
+	/**
+	 * \brief Stream-K matrix multiplication for small outputs with a long inner dimension.
+	 *
+	 * The output is cut into l2_block × l3_block tiles. The whole waves of tiles,
+	 * ⌊tiles / threads⌋ · threads of them, run data parallel straight into C. Each
+	 * remaining tail tile is split into `splits` contiguous k ranges: the first
+	 * range accumulates into C, the others into private partial tiles. With a
+	 * single tile this is plain split-K. After all work units finish the partial
+	 * tiles are folded into C in split order, so no atomics are involved and the
+	 * result is bitwise reproducible for a given thread count.
+	 *
+	 * \param splits	Number of k ranges per tail tile, from _stream_k_splits
+	 */
+	template<typename T, typename S, template<typename, typename> class K, typename SR = plus_times>
+	inline
+	void
+	_multiply_stream_k(T** A, T** B, T** C, const size_t M, const size_t N, const size_t P, const size_t splits)
+	{
+		using kernel_t = K<T, S>;
+		using blocking = typename kernel_t::blocking;
+
+		constexpr size_t kernel_rows = kernel_t::kernel_rows();
+		constexpr size_t kernel_cols = kernel_t::kernel_cols();
+		constexpr size_t tile_m = std::max(kernel_rows, blocking::l2_block - blocking::l2_block % kernel_rows);
+		constexpr size_t tile_n = std::max(kernel_cols, blocking::l3_block - blocking::l3_block % kernel_cols);
+
+		const size_t threads = omp_get_max_threads();
+		const size_t tile_rows = (M + tile_m - 1) / tile_m;
+		const size_t tile_cols = (P + tile_n - 1) / tile_n;
+		const size_t tiles = tile_rows * tile_cols;
+		const size_t whole = tiles - tiles % threads;
+		const size_t tail = tiles - whole;
+
+		const size_t part_m = std::min(tile_m, M);
+		const size_t part_n = std::min(tile_n, P);
+		const size_t part_count = tail * (splits - 1);
+
+		auto At = aligned_alloc_2D<T, S::bytes>(N, M);
+		transpose<T, S>(A, At.get(), M, N);
+
+		auto partials = aligned_alloc_2D<T, S::bytes>(std::max<size_t>(part_count * part_m, 1), part_n);
+		std::fill_n(partials[0], part_count * part_m * part_n, SR::template zero<T>());
+
+		const size_t units = whole + tail * splits;
+
+		#pragma omp parallel
+		{
+			std::vector<T*> D(M);
+
+			#pragma omp for schedule(dynamic, 1)
+			for (size_t u = 0; u < units; ++u)
+			{
+				const size_t tile = u < whole ? u : whole + (u - whole) / splits;
+				const size_t split = u < whole ? 0 : (u - whole) % splits;
+
+				const size_t i0 = (tile / tile_cols) * tile_m;
+				const size_t j0 = (tile % tile_cols) * tile_n;
+				const size_t i1 = std::min(i0 + tile_m, M);
+				const size_t j1 = std::min(j0 + tile_n, P);
+
+				const size_t k0 = u < whole ? 0 : N * split / splits;
+				const size_t k1 = u < whole ? N : N * (split + 1) / splits;
+
+				if (split == 0)
+				{
+					for (size_t i = i0; i < i1; ++i)
+						D[i] = C[i] + j0;
+				}
+				else
+				{
+					const size_t part = (tile - whole) * (splits - 1) + (split - 1);
+					for (size_t i = i0; i < i1; ++i)
+						D[i] = partials[part * part_m + (i - i0)];
+				}
+
+				_multiply_tile<T, S, K, SR>(A, At.get(), B, D.data(), i0, i1, j0, j1, k0, k1);
+			}
+
+			// fold the partial tiles into C, row by row, in split order
+			#pragma omp for collapse(2) schedule(static)
+			for (size_t t = 0; t < tail; ++t)
+			{
+				for (size_t r = 0; r < part_m; ++r)
+				{
+					const size_t tile = whole + t;
+					const size_t i = (tile / tile_cols) * tile_m + r;
+					const size_t j0 = (tile % tile_cols) * tile_n;
+					const size_t j1 = std::min(j0 + tile_n, P);
+
+					if (i >= M)
+						continue;
+
+					for (size_t s = 1; s < splits; ++s)
+					{
+						const size_t part = t * (splits - 1) + (s - 1);
+						_combine_row<T, S, SR>(C[i] + j0, partials[part * part_m + r], j1 - j0);
+					}
+				}
+			}
 		}
 	}
 
@@ -352,6 +592,9 @@ namespace damm
 	 *
 	 * \note Matrix C should be zero-initialized before calling this function,
 	 *       as the implementation uses += operations internally (accumulation mode).
+	 * \note When N dominates M and P and the output has too few tiles for the
+	 *       available threads, the stream-K path splits the inner dimension
+	 *       (see _multiply_stream_k).
 	 */
 	template<typename T, typename S = decltype(detect_simd()), template<typename, typename> class K = multiply_kernel>
 	inline 
@@ -369,12 +612,65 @@ namespace damm
 			transpose<T, S>(B, Bt.get(), N, P);
 			_multiply<T, true, K>(A, Bt.get(), C, M, N, P);
 		} 
+		else if (const size_t splits = _stream_k_splits<T, S, K>(M, N, P))
+		{
+			_multiply_stream_k<T, S, K>(A, B, C, M, N, P, splits);
+		}
 		else
 		{
 			_multiply_simd<T, S, K>(A, B, C, M, N, P);
 		}
 	}
 
+	/**
+	 * \brief Matrix multiplication over a semiring, C = C ⊕ (A ⊗ B).
+	 *
+	 * Runs the blocking, register tiling and threading of multiply with the
+	 * micro-kernel's fmadd replaced by SR::fma. For example, with min_plus and a
+	 * distance matrix D whose diagonal is zero, D ← D ⊕ (D ⊗ D) doubles the path
+	 * lengths covered, so ⌈log₂(n − 1)⌉ products give all-pairs shortest paths.
+	 *
+	 * \tparam SR	Semiring policy (plus_times, min_plus, max_plus, max_times, or_and)
+	 * \tparam T	Real element type (float or double)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 * \tparam K	Kernel policy defining tile size
+	 *
+	 * \param A		Left operand, M×N
+	 * \param B		Right operand, N×P
+	 * \param C		Result, M×P, combined into with ⊕; must not alias A or B
+	 * \param M		Rows of A and C
+	 * \param N		Columns of A, rows of B
+	 * \param P		Columns of B and C
+	 *
+	 * \note Initialize C with SR::zero<T>() for the plain product A ⊗ B.
+	 */
+	template<typename SR, typename T, typename S = decltype(detect_simd()), template<typename, typename> class K = multiply_kernel>
+	requires (semiring<SR> && std::is_floating_point_v<T>)
+	inline 
+	void 
+	semiring_multiply(T** A, T** B, T** C, const size_t M, const size_t N, const size_t P)
+	{
+		right<T>("semiring_multiply:", 
+			std::make_tuple(A, M, N), 
+			std::make_tuple(B, N, P), 
+			std::make_tuple(C, M, P));
+
+		if constexpr (std::is_same_v<S, NONE>)
+		{
+			auto Bt = aligned_alloc_2D<T, S::bytes>(P, N);
+			transpose<T, S>(B, Bt.get(), N, P);
+			_multiply<T, true, K, SR>(A, Bt.get(), C, M, N, P);
+		} 
+		else if (const size_t splits = _stream_k_splits<T, S, K>(M, N, P))
+		{
+			_multiply_stream_k<T, S, K, SR>(A, B, C, M, N, P, splits);
+		}
+		else
+		{
+			_multiply_simd<T, S, K, SR>(A, B, C, M, N, P);
+		}
+	}
+
 }//namespace damm
 
 #endif //__MULTIPLY_H__
\ No newline at end of file
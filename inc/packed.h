@@ -0,0 +1,426 @@
+#ifndef __PACKED_H__
+#define __PACKED_H__
+/**
+ * \file packed.h
+ * \brief definitions for symmetric and triangular packed storage
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <common.h>
+#include <simd.h>
+#include <damm_kernels.h>
+#include <damm_memory.h>
+#include <omp.h>
+#include <multiply.h>
+#include <solve.h>
+#include <blas.h>
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * \brief Packed storage for symmetric (Hermitian) and triangular matrices.
+ *
+ * An N×N matrix whose information lives in one triangle is stored as the lower
+ * triangle packed row by row into a flat array of N(N+1)/2 elements:
+ *
+ *   AP = [ L00 | L10 L11 | L20 L21 L22 | ... ],   L[i][j] = AP[i(i+1)/2 + j],  j ≤ i
+ *
+ * Row i of the triangle is a contiguous run of i+1 elements, so every kernel
+ * below walks rows forward exactly like the dense Cholesky-Banachiewicz and
+ * substitution routines do, and engages the same SIMD loads. Half the memory of
+ * the dense layout is touched, which is what bounds matrix-vector work.
+ *
+ * A symmetric matrix stores its lower triangle; a Hermitian matrix stores its
+ * lower triangle with the upper triangle implied as the conjugate. A triangular
+ * matrix stores L; an upper triangular U is held as L = Uᴴ, and the substitution
+ * routines solve with either L or Lᴴ.
+ */
+namespace damm
+{
+namespace packed
+{
+	/** \brief number of elements held by the packed triangle of an N×N matrix */
+	constexpr size_t
+	elements(const size_t N)
+	{
+		return N * (N + 1) / 2;
+	}
+
+	/** \brief offset of row i within the packed triangle */
+	constexpr size_t
+	offset(const size_t i)
+	{
+		return i * (i + 1) / 2;
+	}
+
+	/**
+	 * \brief kernel for y[k] += a · x[k], k < n, conjugating x when C is set.
+	 *
+	 * Inner products go through blas::_dot; this stays because blas has no
+	 * axpy that conjugates x, which the Hermitian product and the solve with
+	 * Lᴴ need.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S, bool C = false>
+	inline __attribute__((always_inline))
+	void
+	_axpy_row(const T a, const T* x, T* y, const size_t n)
+	{
+		size_t k = 0;
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+
+			const register_t va = _set1<T, S>(a);
+
+			[[maybe_unused]] register_t conj;
+			if constexpr (C && is_complex_v<T>)
+				conj = _set1<T, S>(T(1, -1));
+
+			for (; k + W <= n; k += W)
+			{
+				register_t vx = _loadu<T, S>(reinterpret_cast<const real_t*>(x + k));
+				if constexpr (C && is_complex_v<T>)
+					vx = _mul<real_t, S>(vx, conj);
+
+				_storeu<T, S>(reinterpret_cast<real_t*>(y + k),
+					_fmadd<T, S>(va, vx, _loadu<T, S>(reinterpret_cast<const real_t*>(y + k))));
+			}
+		}
+
+		for (; k < n; ++k)
+			y[k] += a * (C ? conjugate(x[k]) : x[k]);
+	}
+
+	/**
+	 * \brief Pack one triangle of a dense matrix.
+	 *
+	 * With uplo = LOWER the lower triangle of A is copied. With uplo = UPPER the
+	 * upper triangle is read and stored as its conjugate transpose, so a
+	 * Hermitian matrix packs to the same array from either triangle and an
+	 * upper triangular U packs to L = Uᴴ.
+	 *
+	 * \param A		Dense input, N×N
+	 * \param AP	Packed output, elements(N)
+	 * \param N		Matrix dimension
+	 * \param uplo	Triangle of A to read
+	 */
+	template<typename T>
+	inline void
+	pack(T** A, T* AP, const size_t N, const TRIANGULAR uplo = LOWER)
+	{
+		right<T>("pack:", std::make_tuple(AP, size_t(1), elements(N)), std::make_tuple(A, N, N));
+
+		#pragma omp parallel for schedule(dynamic, 64)
+		for (size_t i = 0; i < N; ++i)
+		{
+			T* row = AP + offset(i);
+			if (uplo == LOWER)
+				std::copy(A[i], A[i] + i + 1, row);
+			else
+				for (size_t j = 0; j <= i; ++j)
+					row[j] = conjugate(A[j][i]);
+		}
+	}
+
+	/**
+	 * \brief Expand a packed triangle into a dense matrix.
+	 *
+	 * \param AP		Packed input, elements(N)
+	 * \param A			Dense output, N×N
+	 * \param N			Matrix dimension
+	 * \param symmetric	If true the upper triangle is filled with the conjugate
+	 *					of the lower, otherwise it is set to zero
+	 */
+	template<typename T>
+	inline void
+	unpack(const T* AP, T** A, const size_t N, const bool symmetric = true)
+	{
+		right<T>("unpack:", std::make_tuple(const_cast<T*>(AP), size_t(1), elements(N)), std::make_tuple(A, N, N));
+
+		#pragma omp parallel for schedule(dynamic, 64)
+		for (size_t i = 0; i < N; ++i)
+		{
+			std::copy(AP + offset(i), AP + offset(i) + i + 1, A[i]);
+			for (size_t j = i + 1; j < N; ++j)
+				A[i][j] = symmetric ? conjugate(AP[offset(j) + i]) : T(0);
+		}
+	}
+
+	/**
+	 * \brief Symmetric (Hermitian) matrix-vector product y += A · x.
+	 *
+	 * Each packed entry is read once and used twice: row i contributes its dot
+	 * product with x to y[i], and its conjugate scaled by x[i] to y[0..i). The
+	 * rows are split between threads in chunks of equal area; the scattered
+	 * updates go to a per-thread vector that is summed into y at the end, so no
+	 * two threads ever write the same element.
+	 *
+	 * \param AP	Packed lower triangle of A, elements(N)
+	 * \param x		Input vector, N
+	 * \param y		Output vector, N, accumulated into
+	 * \param N		Matrix dimension
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	multiply(const T* AP, const T* x, T* y, const size_t N)
+	{
+		right<T>("packed multiply:",
+			std::make_tuple(const_cast<T*>(AP), size_t(1), elements(N)),
+			std::make_tuple(const_cast<T*>(x), size_t(1), N),
+			std::make_tuple(y, size_t(1), N));
+
+		const size_t threads = std::max<size_t>(1, std::min<size_t>(omp_get_max_threads(), N / 64));
+		auto scatter = aligned_alloc_2D<T, S::bytes>(threads, N);
+
+		#pragma omp parallel num_threads(threads)
+		{
+			const size_t t = omp_get_thread_num();
+			const size_t nt = omp_get_num_threads();
+
+			// Row i carries i+1 elements, so equal work ends at N·sqrt(t/nt)
+			const size_t i0 = static_cast<size_t>(N * std::sqrt(double(t) / nt));
+			const size_t i1 = t + 1 == nt ? N : static_cast<size_t>(N * std::sqrt(double(t + 1) / nt));
+
+			T* z = scatter[t];
+			std::fill(z, z + N, T(0));
+
+			for (size_t i = i0; i < i1; ++i)
+			{
+				const T* row = AP + offset(i);
+				y[i] += blas::_dot<T, S>(row, x, i + 1);
+				_axpy_row<T, S, true>(x[i], row, z, i);
+			}
+
+			#pragma omp barrier
+
+			#pragma omp for schedule(static)
+			for (size_t j = 0; j < N; ++j)
+				for (size_t p = 0; p < nt; ++p)
+					y[j] += scatter[p][j];
+		}
+	}
+
+	/**
+	 * \brief Symmetric (Hermitian) matrix-matrix product C += A · B.
+	 *
+	 * The product is formed one row panel at a time: a panel of A is expanded
+	 * from the packed triangle into a dense scratch buffer and handed to the
+	 * blocked multiply, so the packed operand gets the same register-tiled
+	 * kernels as the dense one while only a panel of the dense form ever exists.
+	 *
+	 * \param AP	Packed lower triangle of A, elements(N)
+	 * \param B		Right operand, N×P
+	 * \param C		Output, N×P, accumulated into
+	 * \param N		Dimension of A
+	 * \param P		Columns of B and C
+	 */
+	template<typename T, typename S = decltype(detect_simd()), template<typename, typename> class K = multiply_kernel>
+	inline void
+	multiply(const T* AP, T** B, T** C, const size_t N, const size_t P)
+	{
+		right<T>("packed multiply:",
+			std::make_tuple(const_cast<T*>(AP), size_t(1), elements(N)),
+			std::make_tuple(B, N, P),
+			std::make_tuple(C, N, P));
+
+		using blocking = typename K<T, S>::blocking;
+
+		// A panel of about l2 rows per pass keeps the scratch buffer small
+		// relative to B while amortizing the packing of B inside multiply.
+		const size_t height = std::min(N, blocking::l2_block);
+		auto panel = aligned_alloc_2D<T, S::bytes>(height, N);
+
+		for (size_t i0 = 0; i0 < N; i0 += height)
+		{
+			const size_t h = std::min(height, N - i0);
+
+			#pragma omp parallel for schedule(static)
+			for (size_t r = 0; r < h; ++r)
+			{
+				const size_t i = i0 + r;
+				std::copy(AP + offset(i), AP + offset(i) + i + 1, panel[r]);
+				for (size_t j = i + 1; j < N; ++j)
+					panel[r][j] = conjugate(AP[offset(j) + i]);
+			}
+
+			::damm::multiply<T, S, K>(panel.get(), B, C + i0, h, N, P);
+		}
+	}
+
+	/**
+	 * \brief Cholesky decomposition A = L · Lᴴ in packed storage.
+	 *
+	 * The packed lower triangle of a symmetric (Hermitian) positive-definite A
+	 * is overwritten with L using the same row-oriented Cholesky-Banachiewicz
+	 * recurrence as cholesky::decompose,
+	 *   L[i][j]  = ( A[i][j] - Σ_{p<j} L[i][p] * conj(L[j][p]) ) / L[j][j],   j < i
+	 *   L[i][i]  = sqrt( A[i][i] - Σ_{p<i} |L[i][p]|^2 ),
+	 * where both sums walk two contiguous packed rows. Rows are processed in
+	 * blocks: every row of a block depends only on rows above the block for its
+	 * leading columns, so that part runs across threads, and the small trailing
+	 * triangle of the block is finished in row order.
+	 *
+	 * \param AP	Packed lower triangle of A, elements(N), overwritten with L
+	 * \param N		Matrix dimension
+	 *
+	 * \return true if decomposition successful, false if matrix is not positive definite
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline bool
+	decompose(T* AP, const size_t N)
+	{
+		right<T>("packed decompose:", std::make_tuple(AP, size_t(1), elements(N)));
+
+		constexpr size_t block = 64;
+
+		for (size_t i0 = 0; i0 < N; i0 += block)
+		{
+			const size_t i1 = std::min(N, i0 + block);
+
+			if (i0 > 0)
+			{
+				#pragma omp parallel for schedule(dynamic, 1)
+				for (size_t i = i0; i < i1; ++i)
+				{
+					T* Li = AP + offset(i);
+					for (size_t j = 0; j < i0; ++j)
+					{
+						const T* Lj = AP + offset(j);
+						Li[j] = (Li[j] - blas::_dot<T, S, true>(Lj, Li, j)) / Lj[j];
+					}
+				}
+			}
+
+			for (size_t i = i0; i < i1; ++i)
+			{
+				T* Li = AP + offset(i);
+				for (size_t j = i0; j < i; ++j)
+				{
+					const T* Lj = AP + offset(j);
+					Li[j] = (Li[j] - blas::_dot<T, S, true>(Lj, Li, j)) / Lj[j];
+				}
+
+				// For Hermitian A the imaginary part of the diagonal is dropped.
+				const typename base<T>::type x = std::real(Li[i] - blas::_dot<T, S, true>(Li, Li, i));
+
+				if (x <= 0)
+					return false; // Matrix is not positive definite
+
+				Li[i] = T(std::sqrt(x));
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * \brief Forward substitution with a packed lower triangular matrix.
+	 *        Solves L * y = b.
+	 *
+	 * \param LP        Packed lower triangular matrix, elements(N)
+	 * \param b         Right-hand side vector.
+	 * \param y         Output vector (solution).
+	 * \param N         Dimension.
+	 * \param unit_diag If true, assumes unit diagonal.
+	 */
+	template <typename T, typename S = decltype(detect_simd())>
+	inline void
+	forward_substitution(const T* LP, const T* b, T* y, const size_t N,
+		const bool unit_diag = false)
+	{
+		right<T>("packed forward_substitution:",
+			std::make_tuple(const_cast<T*>(LP), size_t(1), elements(N)),
+			std::make_tuple(const_cast<T*>(b), size_t(1), N),
+			std::make_tuple(y, size_t(1), N));
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			const T* Li = LP + offset(i);
+			const T sum = blas::_dot<T, S>(Li, y, i);
+
+			y[i] = unit_diag ? (b[i] - sum)
+							 : (b[i] - sum) / Li[i];
+		}
+	}
+
+	/**
+	 * \brief Backward substitution with the conjugate transpose of a packed
+	 *        lower triangular matrix. Solves Lᴴ * x = y.
+	 *
+	 * Column i of Lᴴ is row i of L, so the solve runs column oriented: once
+	 * x[i] is known its contribution is removed from x[0..i) with one contiguous
+	 * update along the packed row.
+	 *
+	 * \param LP        Packed lower triangular matrix, elements(N)
+	 * \param y         Right-hand side vector.
+	 * \param x         Output vector (solution), may alias y.
+	 * \param N         Dimension.
+	 * \param unit_diag If true, assumes unit diagonal.
+	 */
+	template <typename T, typename S = decltype(detect_simd())>
+	inline void
+	backward_substitution(const T* LP, const T* y, T* x, const size_t N,
+		const bool unit_diag = false)
+	{
+		right<T>("packed backward_substitution:",
+			std::make_tuple(const_cast<T*>(LP), size_t(1), elements(N)),
+			std::make_tuple(const_cast<T*>(y), size_t(1), N),
+			std::make_tuple(x, size_t(1), N));
+
+		if (x != y)
+			std::copy(y, y + N, x);
+
+		for (size_t i = N; i-- > 0; )
+		{
+			const T* Li = LP + offset(i);
+
+			if (!unit_diag)
+				x[i] /= conjugate(Li[i]);
+
+			_axpy_row<T, S, true>(-x[i], Li, x, i);
+		}
+	}
+
+	/**
+	 * \brief Solve A * x = b from the packed Cholesky factor of A.
+	 *
+	 * \param LP	Packed factor L from decompose, elements(N)
+	 * \param b		Right-hand side vector.
+	 * \param x		Output vector (solution).
+	 * \param N		Dimension.
+	 */
+	template <typename T, typename S = decltype(detect_simd())>
+	inline void
+	solve(const T* LP, const T* b, T* x, const size_t N)
+	{
+		forward_substitution<T, S>(LP, b, x, N);
+		backward_substitution<T, S>(LP, x, x, N);
+	}
+} // namespace packed
+} // namespace damm
+#endif //__PACKED_H__
@@ -0,0 +1,396 @@
+#ifndef __PERMUTE_H__
+#define __PERMUTE_H__
+/**
+ * \file permute.h
+ * \brief definitions for row and column permutations and gather/scatter
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <vector>
+#include <algorithm>
+#include <common.h>
+#include <simd.h>
+#include <damm_memory.h>
+#include <omp.h>
+
+namespace damm
+{
+	/**
+	 * \brief Row and column permutations, gathers and scatters.
+	 *
+	 * A permutation is a vector P of N distinct indices with gather semantics:
+	 * applying P to the rows of A gives B[i] = A[P[i]], which is the convention
+	 * of the P produced by lu::decompose (P A = L U). The inverse permutation
+	 * scatters, B[P[i]] = A[i].
+	 *
+	 * Rows are moved as contiguous copies, in parallel when out of place. Columns
+	 * are moved within each row with the hardware gather/scatter instructions:
+	 * gathers on AVX and AVX-512, scatters on AVX-512 only. Elements of 8 bytes or
+	 * less are gathered directly (complex<float> as one 64-bit lane); complex<double>
+	 * and the SSE and NONE paths use scalar copies.
+	 */
+
+	static_assert(sizeof(size_t) == sizeof(long long), "gather indices are 64-bit");
+
+	/** 
+	 * \brief kernel for dst[j] = src[idx[j]], j < n.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_gather(const T* src, const size_t* idx, T* dst, const size_t n)
+	{
+		size_t j = 0;
+
+		if constexpr (std::is_same_v<S, AVX512> && std::is_same_v<T, float>)
+		{
+			for (; j + 8 <= n; j += 8)
+			{
+				const __m512i v = _mm512_loadu_si512(idx + j);
+				_mm256_storeu_ps(dst + j, _mm512_i64gather_ps(v, src, sizeof(T)));
+			}
+		}
+		else if constexpr (std::is_same_v<S, AVX512> && sizeof(T) == sizeof(double))
+		{
+			auto* s = reinterpret_cast<const double*>(src);
+			auto* d = reinterpret_cast<double*>(dst);
+			for (; j + 8 <= n; j += 8)
+			{
+				const __m512i v = _mm512_loadu_si512(idx + j);
+				_mm512_storeu_pd(d + j, _mm512_i64gather_pd(v, s, sizeof(double)));
+			}
+		}
+		else if constexpr (std::is_same_v<S, AVX> && std::is_same_v<T, float>)
+		{
+			for (; j + 4 <= n; j += 4)
+			{
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + j));
+				_mm_storeu_ps(dst + j, _mm256_i64gather_ps(src, v, sizeof(T)));
+			}
+		}
+		else if constexpr (std::is_same_v<S, AVX> && sizeof(T) == sizeof(double))
+		{
+			auto* s = reinterpret_cast<const double*>(src);
+			auto* d = reinterpret_cast<double*>(dst);
+			for (; j + 4 <= n; j += 4)
+			{
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + j));
+				_mm256_storeu_pd(d + j, _mm256_i64gather_pd(s, v, sizeof(double)));
+			}
+		}
+
+		for (; j < n; ++j)
+			dst[j] = src[idx[j]];
+	}
+
+	/** 
+	 * \brief kernel for dst[idx[j]] = src[j], j < n. idx must not repeat.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_scatter(const T* src, const size_t* idx, T* dst, const size_t n)
+	{
+		size_t j = 0;
+
+		if constexpr (std::is_same_v<S, AVX512> && std::is_same_v<T, float>)
+		{
+			for (; j + 8 <= n; j += 8)
+			{
+				const __m512i v = _mm512_loadu_si512(idx + j);
+				_mm512_i64scatter_ps(dst, v, _mm256_loadu_ps(src + j), sizeof(T));
+			}
+		}
+		else if constexpr (std::is_same_v<S, AVX512> && sizeof(T) == sizeof(double))
+		{
+			auto* s = reinterpret_cast<const double*>(src);
+			auto* d = reinterpret_cast<double*>(dst);
+			for (; j + 8 <= n; j += 8)
+			{
+				const __m512i v = _mm512_loadu_si512(idx + j);
+				_mm512_i64scatter_pd(d, v, _mm512_loadu_pd(s + j), sizeof(double));
+			}
+		}
+
+		for (; j < n; ++j)
+			dst[idx[j]] = src[j];
+	}
+
+	/**
+	 * \brief Inverse of a permutation, P_inv[P[i]] = i.
+	 *
+	 * \param P         Permutation (size N)
+	 * \param P_inv     Output inverse permutation (size N)
+	 * \param N         Permutation length
+	 */
+	inline void
+	invert_permutation(const size_t* P, size_t* P_inv, const size_t N)
+	{
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0; i < N; ++i)
+			P_inv[P[i]] = i;
+	}
+
+	/**
+	 * \brief Gather rows, B[k] = A[idx[k]] for k < K.
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (M×N)
+	 * \param idx       Row indices into A (size K)
+	 * \param B         Output matrix B (K×N)
+	 * \param M         Rows of A
+	 * \param N         Columns of A and B
+	 * \param K         Rows of B
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	gather_rows(T** A, const size_t* idx, T** B, const size_t M, const size_t N, const size_t K)
+	{
+		right<T>("gather_rows:", std::make_tuple(A, M, N), std::make_tuple(B, K, N));
+
+		#pragma omp parallel for schedule(static)
+		for (size_t k = 0; k < K; ++k)
+			std::copy(A[idx[k]], A[idx[k]] + N, B[k]);
+	}
+
+	/**
+	 * \brief Scatter rows, B[idx[k]] = A[k] for k < K. idx must not repeat.
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (K×N)
+	 * \param idx       Row indices into B (size K)
+	 * \param B         Output matrix B (M×N); rows not in idx are unchanged
+	 * \param M         Rows of B
+	 * \param N         Columns of A and B
+	 * \param K         Rows of A
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	scatter_rows(T** A, const size_t* idx, T** B, const size_t M, const size_t N, const size_t K)
+	{
+		right<T>("scatter_rows:", std::make_tuple(A, K, N), std::make_tuple(B, M, N));
+
+		#pragma omp parallel for schedule(static)
+		for (size_t k = 0; k < K; ++k)
+			std::copy(A[k], A[k] + N, B[idx[k]]);
+	}
+
+	/**
+	 * \brief Gather columns, B[i][k] = A[i][idx[k]] for k < K.
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (M×N)
+	 * \param idx       Column indices into A (size K)
+	 * \param B         Output matrix B (M×K)
+	 * \param M         Rows of A and B
+	 * \param N         Columns of A
+	 * \param K         Columns of B
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	gather_columns(T** A, const size_t* idx, T** B, const size_t M, const size_t N, const size_t K)
+	{
+		right<T>("gather_columns:", std::make_tuple(A, M, N), std::make_tuple(B, M, K));
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0; i < M; ++i)
+			_gather<T, S>(A[i], idx, B[i], K);
+	}
+
+	/**
+	 * \brief Scatter columns, B[i][idx[k]] = A[i][k] for k < K. idx must not repeat.
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (M×K)
+	 * \param idx       Column indices into B (size K)
+	 * \param B         Output matrix B (M×N); columns not in idx are unchanged
+	 * \param M         Rows of A and B
+	 * \param N         Columns of B
+	 * \param K         Columns of A
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	scatter_columns(T** A, const size_t* idx, T** B, const size_t M, const size_t N, const size_t K)
+	{
+		right<T>("scatter_columns:", std::make_tuple(A, M, K), std::make_tuple(B, M, N));
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0; i < M; ++i)
+			_scatter<T, S>(A[i], idx, B[i], K);
+	}
+
+	/**
+	 * \brief Permute rows out of place, B[i] = A[P[i]].
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (M×N)
+	 * \param P         Row permutation (size M)
+	 * \param B         Output matrix B (M×N)
+	 * \param M         Number of rows
+	 * \param N         Number of columns
+	 * \param inverse   Apply P⁻¹ instead, B[P[i]] = A[i]
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	permute_rows(T** A, const size_t* P, T** B, const size_t M, const size_t N, const bool inverse = false)
+	{
+		if (inverse)
+			scatter_rows<T, S>(A, P, B, M, N, M);
+		else
+			gather_rows<T, S>(A, P, B, M, N, M);
+	}
+
+	/**
+	 * \brief Permute rows in place, A[i] <- A[P[i]].
+	 *
+	 * Follows the cycles of P, so each row is moved once through a single
+	 * row of workspace. The row pointers of A are not changed, so A stays a
+	 * view over its original contiguous storage.
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (M×N), permuted in place
+	 * \param P         Row permutation (size M)
+	 * \param M         Number of rows
+	 * \param N         Number of columns
+	 * \param inverse   Apply P⁻¹ instead, A[P[i]] <- A[i]
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	permute_rows(T** A, const size_t* P, const size_t M, const size_t N, const bool inverse = false)
+	{
+		right<T>("permute_rows:", std::make_tuple(A, M, N));
+
+		auto tmp = aligned_alloc_1D<T, S::bytes>(1, N);
+		std::vector<bool> visited(M, false);
+
+		for (size_t i = 0; i < M; ++i)
+		{
+			if (visited[i] || P[i] == i)
+				continue;
+
+			std::copy(A[i], A[i] + N, tmp.get());
+
+			if (inverse)
+			{
+				// Carry the displaced row forward along the cycle
+				for (size_t j = P[i]; j != i; j = P[j])
+				{
+					std::swap_ranges(A[j], A[j] + N, tmp.get());
+					visited[j] = true;
+				}
+				std::copy(tmp.get(), tmp.get() + N, A[i]);
+			}
+			else
+			{
+				// Pull each row back along the cycle
+				size_t j = i;
+				for (; P[j] != i; j = P[j])
+				{
+					std::copy(A[P[j]], A[P[j]] + N, A[j]);
+					visited[j] = true;
+				}
+				std::copy(tmp.get(), tmp.get() + N, A[j]);
+				visited[j] = true;
+			}
+			visited[i] = true;
+		}
+	}
+
+	/**
+	 * \brief Permute columns out of place, B[:, j] = A[:, P[j]].
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (M×N)
+	 * \param P         Column permutation (size N)
+	 * \param B         Output matrix B (M×N)
+	 * \param M         Number of rows
+	 * \param N         Number of columns
+	 * \param inverse   Apply P⁻¹ instead, B[:, P[j]] = A[:, j]
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	permute_columns(T** A, const size_t* P, T** B, const size_t M, const size_t N, const bool inverse = false)
+	{
+		if (inverse)
+			scatter_columns<T, S>(A, P, B, M, N, N);
+		else
+			gather_columns<T, S>(A, P, B, M, N, N);
+	}
+
+	/**
+	 * \brief Permute columns in place, A[:, j] <- A[:, P[j]].
+	 *
+	 * Each row is gathered (or scattered) into a per-thread row of workspace and
+	 * copied back, which keeps the access contiguous rather than following the
+	 * cycles down strided columns.
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512)
+	 *
+	 * \param A         Input matrix A (M×N), permuted in place
+	 * \param P         Column permutation (size N)
+	 * \param M         Number of rows
+	 * \param N         Number of columns
+	 * \param inverse   Apply P⁻¹ instead, A[:, P[j]] <- A[:, j]
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	permute_columns(T** A, const size_t* P, const size_t M, const size_t N, const bool inverse = false)
+	{
+		right<T>("permute_columns:", std::make_tuple(A, M, N));
+
+		#pragma omp parallel
+		{
+			auto tmp = aligned_alloc_1D<T, S::bytes>(1, N);
+
+			#pragma omp for schedule(static)
+			for (size_t i = 0; i < M; ++i)
+			{
+				if (inverse)
+					_scatter<T, S>(A[i], P, tmp.get(), N);
+				else
+					_gather<T, S>(A[i], P, tmp.get(), N);
+				std::copy(tmp.get(), tmp.get() + N, A[i]);
+			}
+		}
+	}
+
+} //namespace damm
+
+#endif //__PERMUTE_H__
@@ -0,0 +1,390 @@
+#ifndef __RANDOM_H__
+#define __RANDOM_H__
+/**
+ * \file random.h
+ * \brief definitions for counter-based random matrix generation
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <numbers>
+#include <common.h>
+#include <simd.h>
+#include <omp.h>
+
+/**
+ * \brief Counter-based random matrices.
+ *
+ * Values come from the Philox-4x32-10 generator (Salmon et al., 2011), which
+ * maps a 128-bit counter and a 64-bit key to four 32-bit words with ten rounds
+ * of multiply-xor. There is no state to carry between draws, so any block of
+ * the output can be produced independently of any other.
+ *
+ * The matrix storage is treated as one flat run of values, cut into blocks of
+ * 64 words. Block b evaluates the 16 counters (16b + lane, stream), lane < 16,
+ * which on AVX-512 are the 16 32-bit lanes of one register. Since every value
+ * is a fixed function of (seed, stream, position), the result is bitwise
+ * identical for any number of OpenMP threads.
+ *
+ * Uniforms take the top 24 (float) or 53 (double) bits of the words. Normals
+ * use the Box-Muller transform, pairing value i with value i + 16 in each run
+ * of 32, with a vectorized log and sin/cos on AVX-512. Complex matrices are
+ * filled as their real and imaginary components.
+ */
+namespace damm
+{
+	inline constexpr uint32_t _philox_m0 = 0xD2511F53;
+	inline constexpr uint32_t _philox_m1 = 0xCD9E8D57;
+	inline constexpr uint32_t _philox_w0 = 0x9E3779B9;
+	inline constexpr uint32_t _philox_w1 = 0xBB67AE85;
+	inline constexpr size_t _philox_rounds = 10;
+	inline constexpr size_t _philox_lanes = 16;
+	inline constexpr size_t _philox_words = 4 * _philox_lanes;
+
+	/** 
+	 * \brief kernel for the 64 words of Philox block b, stored as words[w * 16 + lane].
+	 * Low level function not intended for the public API.
+	 */
+	template <typename S>
+	inline __attribute__((always_inline))
+	void
+	_philox_block(const uint64_t block, const uint64_t seed, const uint64_t stream, uint32_t* words)
+	{
+		// block * 16 is a multiple of 16, so adding the lane never carries into the high word
+		const uint64_t base = block * _philox_lanes;
+
+		if constexpr (std::is_same_v<S, AVX512>)
+		{
+			const __m512i m0 = _mm512_set1_epi32(static_cast<int>(_philox_m0));
+			const __m512i m1 = _mm512_set1_epi32(static_cast<int>(_philox_m1));
+
+			__m512i c0 = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(static_cast<uint32_t>(base))), 
+				_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+			__m512i c1 = _mm512_set1_epi32(static_cast<int>(base >> 32));
+			__m512i c2 = _mm512_set1_epi32(static_cast<int>(static_cast<uint32_t>(stream)));
+			__m512i c3 = _mm512_set1_epi32(static_cast<int>(stream >> 32));
+			uint32_t k0 = static_cast<uint32_t>(seed);
+			uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+
+			// 32×32 -> 64 bit products of the even and odd lanes, split into hi and lo words
+			auto mulhilo = [](const __m512i a, const __m512i m, __m512i& hi, __m512i& lo)
+			{
+				const __m512i even = _mm512_mul_epu32(a, m);
+				const __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), m);
+				lo = _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+				hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+			};
+
+			for (size_t r = 0; r < _philox_rounds; ++r)
+			{
+				__m512i hi0, lo0, hi1, lo1;
+				mulhilo(c0, m0, hi0, lo0);
+				mulhilo(c2, m1, hi1, lo1);
+				c0 = _mm512_xor_si512(_mm512_xor_si512(hi1, c1), _mm512_set1_epi32(static_cast<int>(k0)));
+				c1 = lo1;
+				c2 = _mm512_xor_si512(_mm512_xor_si512(hi0, c3), _mm512_set1_epi32(static_cast<int>(k1)));
+				c3 = lo0;
+				k0 += _philox_w0;
+				k1 += _philox_w1;
+			}
+
+			_mm512_storeu_si512(words, c0);
+			_mm512_storeu_si512(words + 16, c1);
+			_mm512_storeu_si512(words + 32, c2);
+			_mm512_storeu_si512(words + 48, c3);
+		}
+		else
+		{
+			for (size_t lane = 0; lane < _philox_lanes; ++lane)
+			{
+				const uint64_t ctr = base + lane;
+				uint32_t c[4] = {static_cast<uint32_t>(ctr), static_cast<uint32_t>(ctr >> 32), 
+					static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)};
+				uint32_t k0 = static_cast<uint32_t>(seed);
+				uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+
+				for (size_t r = 0; r < _philox_rounds; ++r)
+				{
+					const uint64_t p0 = uint64_t(_philox_m0) * c[0];
+					const uint64_t p1 = uint64_t(_philox_m1) * c[2];
+					c[0] = static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k0;
+					c[1] = static_cast<uint32_t>(p1);
+					c[2] = static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k1;
+					c[3] = static_cast<uint32_t>(p0);
+					k0 += _philox_w0;
+					k1 += _philox_w1;
+				}
+
+				for (size_t w = 0; w < 4; ++w)
+					words[w * _philox_lanes + lane] = c[w];
+			}
+		}
+	}
+
+	/** 
+	 * \brief kernel for the uniforms [0, 1) of one Philox block: 64 floats or 32 doubles.
+	 * Double value 16g + l takes its high bits from words[32g + l] and its low bits
+	 * from words[32g + 16 + l].
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_uniform_block(const uint32_t* words, T* u)
+	{
+		if constexpr (std::is_same_v<T, float>)
+		{
+			constexpr float scale = 0x1.0p-24f;
+			if constexpr (std::is_same_v<S, AVX512>)
+			{
+				for (size_t i = 0; i < _philox_words; i += 16)
+				{
+					const __m512i w = _mm512_srli_epi32(_mm512_loadu_si512(words + i), 8);
+					_mm512_storeu_ps(u + i, _mm512_mul_ps(_mm512_cvtepi32_ps(w), _mm512_set1_ps(scale)));
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < _philox_words; ++i)
+					u[i] = float(words[i] >> 8) * scale;
+			}
+		}
+		else
+		{
+			constexpr double scale = 0x1.0p-53;
+			if constexpr (std::is_same_v<S, AVX512>)
+			{
+				for (size_t g = 0; g < 2; ++g)
+					for (size_t h = 0; h < 16; h += 8)
+					{
+						const __m512d hi = _mm512_cvtepu32_pd(_mm256_loadu_si256(
+							reinterpret_cast<const __m256i*>(words + 32 * g + h)));
+						const __m512d lo = _mm512_cvtepu32_pd(_mm256_srli_epi32(_mm256_loadu_si256(
+							reinterpret_cast<const __m256i*>(words + 32 * g + 16 + h)), 11));
+						_mm512_storeu_pd(u + 16 * g + h, 
+							_mm512_mul_pd(_mm512_fmadd_pd(hi, _mm512_set1_pd(0x1.0p21), lo), _mm512_set1_pd(scale)));
+					}
+			}
+			else
+			{
+				for (size_t g = 0; g < 2; ++g)
+					for (size_t l = 0; l < 16; ++l)
+						u[16 * g + l] = (double(words[32 * g + l]) * 0x1.0p21 + double(words[32 * g + 16 + l] >> 11)) * scale;
+			}
+		}
+	}
+
+	/** 
+	 * \brief kernel for sin(2πu) and cos(2πu), u ∈ [0, 1).
+	 * 4u is split into a quadrant q = round(4u) and φ = (4u - q)·π/2 ∈ [-π/4, π/4],
+	 * where Taylor polynomials of degree 9 (float) or 17 (double) are exact to
+	 * working precision. The quadrant swaps and negates the pair.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_sincos_2pi(const typename S::template register_t<T> u, 
+		typename S::template register_t<T>& sin, typename S::template register_t<T>& cos)
+	{
+		using register_t = typename S::template register_t<T>;
+		constexpr size_t terms = std::is_same_v<T, float> ? 5 : 9;
+
+		const register_t one = _set1<T, S>(T(1));
+		const register_t minus_one = _set1<T, S>(T(-1));
+
+		const register_t v = _mul<T, S>(u, _set1<T, S>(T(4)));
+		const register_t q = _round<T, S>(v);
+		const register_t phi = _mul<T, S>(_sub<T, S>(v, q), _set1<T, S>(std::numbers::pi_v<T> / T(2)));
+		const register_t phi2 = _mul<T, S>(phi, phi);
+
+		// sin φ = φ Σ (-φ²)^k / (2k+1)!,  cos φ = Σ (-φ²)^k / (2k)!
+		register_t ps = _set1<T, S>(T(0));
+		register_t pc = _set1<T, S>(T(0));
+		static_for<terms>([&]<auto j>()
+		{
+			constexpr size_t k = terms - 1 - j;
+			constexpr T sign = (k % 2) ? T(-1) : T(1);
+			T fs = T(1), fc = T(1);
+			for (size_t i = 2; i <= 2 * k + 1; ++i)
+			{
+				fs *= T(i);
+				if (i <= 2 * k) fc *= T(i);
+			}
+			ps = _fmadd<T, S>(ps, phi2, _set1<T, S>(sign / fs));
+			pc = _fmadd<T, S>(pc, phi2, _set1<T, S>(sign / fc));
+		});
+		const register_t s = _mul<T, S>(phi, ps);
+		const register_t c = pc;
+
+		// q ∈ {0, 1, 2, 3, 4}: odd quadrants swap, cos flips on {1, 2}, sin flips on {2, 3}
+		const register_t odd = _abs<T, S>(_sub<T, S>(q, _set1<T, S>(T(2))));
+		const register_t a = _select<T, S, _CMP_EQ_OQ>(odd, one, s, c);
+		const register_t b = _select<T, S, _CMP_EQ_OQ>(odd, one, c, s);
+		const register_t sc = _select<T, S, _CMP_LT_OQ>(_abs<T, S>(_sub<T, S>(q, _set1<T, S>(T(1.5)))), one, minus_one, one);
+		const register_t ss = _select<T, S, _CMP_LT_OQ>(_abs<T, S>(_sub<T, S>(q, _set1<T, S>(T(2.5)))), one, minus_one, one);
+
+		cos = _mul<T, S>(a, sc);
+		sin = _mul<T, S>(b, ss);
+	}
+
+	/** 
+	 * \brief kernel for Box-Muller over one block of uniforms, in place.
+	 * In each run of 32 values, u[i] and u[i + 16] become the pair
+	 * r·cos θ and r·sin θ with r = √(-2 log(1 - u[i])) and θ = 2π·u[i + 16].
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	inline __attribute__((always_inline))
+	void
+	_normal_block(T* u, const size_t count)
+	{
+		for (size_t g = 0; g < count; g += 32)
+		{
+			T* a = u + g;
+			T* b = u + g + 16;
+
+			if constexpr (std::is_same_v<S, AVX512>)
+			{
+				using register_t = typename S::template register_t<T>;
+				constexpr size_t W = S::template elements<T>();
+
+				for (size_t i = 0; i < 16; i += W)
+				{
+					const register_t u1 = _sub<T, S>(_set1<T, S>(T(1)), _loadu<T, S>(a + i));
+					const register_t r = _sqrt<T, S>(_mul<T, S>(_set1<T, S>(T(-2)), _log<T, S>(u1)));
+					register_t s, c;
+					_sincos_2pi<T, S>(_loadu<T, S>(b + i), s, c);
+					_storeu<T, S>(a + i, _mul<T, S>(r, c));
+					_storeu<T, S>(b + i, _mul<T, S>(r, s));
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < 16; ++i)
+				{
+					const T r = std::sqrt(T(-2) * std::log(T(1) - a[i]));
+					const T theta = T(2) * std::numbers::pi_v<T> * b[i];
+					a[i] = r * std::cos(theta);
+					b[i] = r * std::sin(theta);
+				}
+			}
+		}
+	}
+
+	/** 
+	 * \brief kernel filling a flat run of L values block by block.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S, bool Normal>
+	inline void
+	_random_fill(T* A, const size_t L, const uint64_t seed, const uint64_t stream, const T shift, const T scale)
+	{
+		constexpr size_t per_block = std::is_same_v<T, float> ? _philox_words : _philox_words / 2;
+		const size_t blocks = (L + per_block - 1) / per_block;
+
+		#pragma omp parallel
+		{
+			alignas(64) uint32_t words[_philox_words];
+			alignas(64) T values[per_block];
+
+			#pragma omp for schedule(static)
+			for (size_t b = 0; b < blocks; ++b)
+			{
+				_philox_block<S>(b, seed, stream, words);
+				_uniform_block<T, S>(words, values);
+				if constexpr (Normal)
+					_normal_block<T, S>(values, per_block);
+
+				const size_t offset = b * per_block;
+				const size_t count = std::min(per_block, L - offset);
+				for (size_t i = 0; i < count; ++i)
+					A[offset + i] = shift + scale * values[i];
+			}
+		}
+	}
+
+	/**
+	 * \brief Fill a matrix with uniform values in [lo, hi).
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants)
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512); Philox runs in AVX-512 lanes
+	 *                  and falls back to scalar code otherwise
+	 *
+	 * \param A         Output matrix A (M×N)
+	 * \param M         Number of rows
+	 * \param N         Number of columns
+	 * \param seed      Generator key
+	 * \param stream    Independent stream index; distinct streams never overlap
+	 * \param lo        Lower bound
+	 * \param hi        Upper bound
+	 *
+	 * \note The contents depend only on (seed, stream, M·N), not on the thread count.
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	random_uniform(T** A, const size_t M, const size_t N, const uint64_t seed, const uint64_t stream = 0,
+		const typename base<T>::type lo = 0, const typename base<T>::type hi = 1)
+	{
+		right<T>("random_uniform:", std::make_tuple(A, M, N));
+
+		using R = typename base<T>::type;
+		constexpr size_t parts = is_complex_v<T> ? 2 : 1;
+		_random_fill<R, S, false>(reinterpret_cast<R*>(A[0]), parts * M * N, seed, stream, lo, hi - lo);
+	}
+
+	/**
+	 * \brief Fill a matrix with normal values of the given mean and standard deviation.
+	 *
+	 * \tparam T        Scalar type (float, double, or complex variants); complex
+	 *                  components are independent draws
+	 * \tparam S        SIMD instruction set (SSE, AVX, AVX512); Philox, log and sin/cos
+	 *                  run in AVX-512 lanes and fall back to scalar code otherwise
+	 *
+	 * \param A         Output matrix A (M×N)
+	 * \param M         Number of rows
+	 * \param N         Number of columns
+	 * \param seed      Generator key
+	 * \param stream    Independent stream index; distinct streams never overlap
+	 * \param mean      Mean
+	 * \param stddev    Standard deviation
+	 *
+	 * \note The contents depend only on (seed, stream, M·N, S), not on the thread count.
+	 */
+	template<typename T, typename S = decltype(detect_simd())>
+	inline void
+	random_normal(T** A, const size_t M, const size_t N, const uint64_t seed, const uint64_t stream = 0,
+		const typename base<T>::type mean = 0, const typename base<T>::type stddev = 1)
+	{
+		right<T>("random_normal:", std::make_tuple(A, M, N));
+
+		using R = typename base<T>::type;
+		constexpr size_t parts = is_complex_v<T> ? 2 : 1;
+		_random_fill<R, S, true>(reinterpret_cast<R*>(A[0]), parts * M * N, seed, stream, mean, stddev);
+	}
+
+} //namespace damm
+
+#endif //__RANDOM_H__
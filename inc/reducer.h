@@ -0,0 +1,688 @@
+#ifndef __REDUCER_H__
+#define __REDUCER_H__
+/**
+ * \file reducer.h
+ * \brief definitions for streaming reduce and fused_reduce accumulators
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <common.h>
+#include <functional>
+#include <simd.h>
+#include <damm_kernels.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+/**
+ * \brief Streaming reductions over chunked input.
+ *
+ * reduce and fused_reduce need the whole matrix at once. The accumulators here
+ * ingest M×N chunks of any height, one after another, and finalize on demand.
+ *
+ * \note
+ * State is L = col_registers·W lane partials kept in cache-aligned storage
+ * between calls and in registers within a call. Element p of the stream always
+ * lands in lane p mod L, and each lane combines its elements in stream order.
+ * Chunks that end mid-block leave their remainder in a staging buffer until the
+ * block completes. The result is therefore bitwise independent of how the
+ * stream is split into chunks.
+ *
+ * \note
+ * update runs on the calling thread. For parallel ingestion each thread keeps
+ * its own accumulator, and they are combined with merge.
+ */
+namespace damm
+{
+	/** 
+	 * \brief Staging for stream elements that do not fill a whole lane block.
+	 * Low level type not intended for the public API.
+	 */
+	template<typename T, size_t Arity, size_t L>
+	struct _stream_stage
+	{
+		alignas(64) T buffer[Arity][L];
+		size_t staged = 0;
+		size_t count = 0;
+
+		/** 
+		 * \brief Append n elements of each source, calling absorb(sources, blocks) on whole blocks.
+		 */
+		template<typename F>
+		inline __attribute__((always_inline))
+		void
+		ingest(std::array<const T*, Arity> src, const size_t n, F&& absorb)
+		{
+			size_t i = 0;
+
+			if (staged != 0)
+			{
+				i = std::min(L - staged, n);
+				for (size_t s = 0; s < Arity; ++s)
+					std::copy(src[s], src[s] + i, buffer[s] + staged);
+				staged += i;
+
+				if (staged == L)
+				{
+					absorb(staged_sources(), 1);
+					staged = 0;
+				}
+			}
+
+			const size_t blocks = (n - i) / L;
+			if (blocks != 0)
+			{
+				std::array<const T*, Arity> at;
+				for (size_t s = 0; s < Arity; ++s)
+					at[s] = src[s] + i;
+				absorb(at, blocks);
+				i += blocks * L;
+			}
+
+			for (size_t s = 0; s < Arity; ++s)
+				std::copy(src[s] + i, src[s] + n, buffer[s] + staged);
+			staged += n - i;
+			count += n;
+		}
+
+		std::array<const T*, Arity>
+		staged_sources() const
+		{
+			std::array<const T*, Arity> p;
+			for (size_t s = 0; s < Arity; ++s)
+				p[s] = buffer[s];
+			return p;
+		}
+	};
+
+	/**
+	 * \brief Streaming reduction, the incremental form of reduce.
+	 *
+	 * \tparam T	Element type (float, double, or complex variants)
+	 * \tparam O	Reduction operator (std::plus<> or std::multiplies<>)
+	 * \tparam S	SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 * \tparam K	Kernel policy, col_registers sets the number of independent accumulators
+	 *
+	 * \code
+	 * reducer<double, std::plus<>> sum;
+	 * while (auto chunk = next())
+	 *     sum.update(chunk.data, chunk.rows, N);
+	 * double total = sum.result();
+	 * \endcode
+	 */
+	template<typename T, typename O, typename S = decltype(detect_simd()),
+		template<typename, typename> class K = reduce_kernel>
+	requires (
+		std::same_as<O, std::plus<>> ||
+		std::same_as<O, std::multiplies<>>
+	)
+	class reducer
+	{
+		using real_t = typename base<T>::type;
+		static constexpr size_t W = std::is_same_v<S, NONE> ? 1 : S::template elements<T>();
+		static constexpr size_t regs = K<T, S>::col_registers;
+		static constexpr size_t L = regs * W;
+
+		alignas(64) T lanes[L];
+		_stream_stage<T, 1, L> stage;
+		T seed;
+
+		static inline __attribute__((always_inline))
+		void
+		_absorb(T* lanes, const T* a, const size_t blocks)
+		{
+			if constexpr (std::is_same_v<S, NONE>)
+			{
+				for (size_t b = 0; b < blocks; ++b)
+					for (size_t l = 0; l < L; ++l)
+						lanes[l] = O{}(lanes[l], a[b * L + l]);
+			}
+			else
+			{
+				using register_t = typename S::template register_t<T>;
+				auto* lane_ptr = reinterpret_cast<real_t*>(lanes);
+				const auto* a_ptr = reinterpret_cast<const real_t*>(a);
+				constexpr size_t stride = is_complex_v<T> ? 2 : 1;
+
+				register_t acc[regs];
+				static_for<regs>([&]<auto r>() { acc[r] = _load<T, S>(lane_ptr + r * W * stride); });
+
+				for (size_t b = 0; b < blocks; ++b)
+					static_for<regs>([&]<auto r>() 
+					{
+						const register_t x = _loadu<T, S>(a_ptr + (b * L + r * W) * stride);
+						if constexpr (std::same_as<O, std::plus<>>)
+							acc[r] = _add<T, S>(acc[r], x);
+						else
+							acc[r] = _mul<T, S>(acc[r], x);
+					});
+
+				static_for<regs>([&]<auto r>() { _store<T, S>(lane_ptr + r * W * stride, acc[r]); });
+			}
+		}
+
+	public:
+		/**
+		 * \param seed  Initial value, combined with the result
+		 */
+		explicit reducer(const T seed = seed_left_fold<T, O>()) 
+		{ 
+			reset(seed); 
+		}
+
+		/**
+		 * \brief Discard all ingested elements and restart from seed.
+		 */
+		void
+		reset(const T seed = seed_left_fold<T, O>())
+		{
+			std::fill(lanes, lanes + L, seed_left_fold<T, O>());
+			stage.staged = 0;
+			stage.count = 0;
+			this->seed = seed;
+		}
+
+		/**
+		 * \brief Ingest the next M×N chunk of the stream in row-major order.
+		 */
+		void
+		update(T** A, const size_t M, const size_t N)
+		{
+			right<T>("reducer:", std::make_tuple(A, M, N));
+			update(A[0], M * N);
+		}
+
+		/**
+		 * \brief Ingest the next n contiguous elements of the stream.
+		 */
+		void
+		update(const T* a, const size_t n)
+		{
+			stage.ingest({a}, n, [&](const std::array<const T*, 1>& p, const size_t blocks) 
+			{
+				_absorb(lanes, p[0], blocks);
+			});
+		}
+
+		/**
+		 * \brief Combine another accumulator into this one.
+		 * Lanes are combined lane by lane, then the other's staged elements are appended.
+		 */
+		void
+		merge(const reducer& other)
+		{
+			for (size_t l = 0; l < L; ++l)
+				lanes[l] = O{}(lanes[l], other.lanes[l]);
+			stage.count += other.stage.count - other.stage.staged;
+			update(other.stage.buffer[0], other.stage.staged);
+			seed = O{}(seed, other.seed);
+		}
+
+		/**
+		 * \brief Number of elements ingested.
+		 */
+		size_t
+		count() const 
+		{ 
+			return stage.count; 
+		}
+
+		/**
+		 * \brief Reduction of the seed and every element ingested so far.
+		 * The accumulator is unchanged and can keep ingesting.
+		 */
+		T
+		result() const
+		{
+			alignas(64) T partial[L];
+			std::copy(lanes, lanes + L, partial);
+
+			if (stage.staged != 0)
+			{
+				alignas(64) T tail[L];
+				std::copy(stage.buffer[0], stage.buffer[0] + stage.staged, tail);
+				std::fill(tail + stage.staged, tail + L, seed_left_fold<T, O>());
+				_absorb(partial, tail, 1);
+			}
+
+			T r = seed;
+			for (size_t l = 0; l < L; ++l)
+				r = O{}(r, partial[l]);
+			return r;
+		}
+	};
+
+	/**
+	 * \brief Streaming fused union-reduce, the incremental form of fused_reduce.
+	 *
+	 * Ingests pairs of equally shaped chunks and accumulates R over U(A, B), e.g. a
+	 * dot product with U = std::multiplies<>, R = std::plus<>, which uses fmadd.
+	 *
+	 * \tparam T	Element type (float, double, or complex variants)
+	 * \tparam U	Union operator (std::plus<>, std::minus<>, std::multiplies<>, std::divides<>)
+	 * \tparam R	Reduction operator (std::plus<> or std::multiplies<>)
+	 * \tparam S	SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 * \tparam K	Kernel policy, col_registers sets the number of independent accumulators
+	 */
+	template<typename T, typename U, typename R, typename S = decltype(detect_simd()),
+		template<typename, typename> class K = fused_reduce_kernel>
+	requires (
+		(std::same_as<U, std::plus<>> ||
+		 std::same_as<U, std::minus<>> ||
+		 std::same_as<U, std::multiplies<>> ||
+		 std::same_as<U, std::divides<>>) &&
+		(std::same_as<R, std::plus<>> ||
+		 std::same_as<R, std::multiplies<>>)
+	)
+	class fused_reducer
+	{
+		using real_t = typename base<T>::type;
+		static constexpr size_t W = std::is_same_v<S, NONE> ? 1 : S::template elements<T>();
+		static constexpr size_t regs = K<T, S>::col_registers;
+		static constexpr size_t L = regs * W;
+
+		alignas(64) T lanes[L];
+		_stream_stage<T, 2, L> stage;
+		T seed;
+
+		static inline __attribute__((always_inline))
+		void
+		_absorb(T* lanes, const T* a, const T* b, const size_t blocks)
+		{
+			if constexpr (std::is_same_v<S, NONE>)
+			{
+				for (size_t k = 0; k < blocks; ++k)
+					for (size_t l = 0; l < L; ++l)
+						lanes[l] = R{}(lanes[l], U{}(a[k * L + l], b[k * L + l]));
+			}
+			else
+			{
+				using register_t = typename S::template register_t<T>;
+				auto* lane_ptr = reinterpret_cast<real_t*>(lanes);
+				const auto* a_ptr = reinterpret_cast<const real_t*>(a);
+				const auto* b_ptr = reinterpret_cast<const real_t*>(b);
+				constexpr size_t stride = is_complex_v<T> ? 2 : 1;
+
+				register_t acc[regs];
+				static_for<regs>([&]<auto r>() { acc[r] = _load<T, S>(lane_ptr + r * W * stride); });
+
+				for (size_t k = 0; k < blocks; ++k)
+					static_for<regs>([&]<auto r>() 
+					{
+						const size_t at = (k * L + r * W) * stride;
+						const register_t x = _loadu<T, S>(a_ptr + at);
+						const register_t y = _loadu<T, S>(b_ptr + at);
+
+						if constexpr (std::same_as<U, std::multiplies<>> && std::same_as<R, std::plus<>>)
+							acc[r] = _fmadd<T, S>(x, y, acc[r]);
+						else
+						{
+							register_t u;
+							if constexpr (std::same_as<U, std::plus<>>)
+								u = _add<T, S>(x, y);
+							else if constexpr (std::same_as<U, std::minus<>>)
+								u = _sub<T, S>(x, y);
+							else if constexpr (std::same_as<U, std::multiplies<>>)
+								u = _mul<T, S>(x, y);
+							else
+								u = _div<T, S>(x, y);
+
+							if constexpr (std::same_as<R, std::plus<>>)
+								acc[r] = _add<T, S>(acc[r], u);
+							else
+								acc[r] = _mul<T, S>(acc[r], u);
+						}
+					});
+
+				static_for<regs>([&]<auto r>() { _store<T, S>(lane_ptr + r * W * stride, acc[r]); });
+			}
+		}
+
+	public:
+		/**
+		 * \param seed  Initial value, combined with the result
+		 */
+		explicit fused_reducer(const T seed = seed_left_fold<T, R>()) 
+		{ 
+			reset(seed); 
+		}
+
+		/**
+		 * \brief Discard all ingested elements and restart from seed.
+		 */
+		void
+		reset(const T seed = seed_left_fold<T, R>())
+		{
+			std::fill(lanes, lanes + L, seed_left_fold<T, R>());
+			stage.staged = 0;
+			stage.count = 0;
+			this->seed = seed;
+		}
+
+		/**
+		 * \brief Ingest the next pair of M×N chunks in row-major order.
+		 */
+		void
+		update(T** A, T** B, const size_t M, const size_t N)
+		{
+			right<T>("fused_reducer:", std::make_tuple(A, M, N), std::make_tuple(B, M, N));
+			update(A[0], B[0], M * N);
+		}
+
+		/**
+		 * \brief Ingest the next n contiguous elements of each stream.
+		 */
+		void
+		update(const T* a, const T* b, const size_t n)
+		{
+			stage.ingest({a, b}, n, [&](const std::array<const T*, 2>& p, const size_t blocks) 
+			{
+				_absorb(lanes, p[0], p[1], blocks);
+			});
+		}
+
+		/**
+		 * \brief Combine another accumulator into this one.
+		 * Lanes are combined lane by lane, then the other's staged elements are appended.
+		 */
+		void
+		merge(const fused_reducer& other)
+		{
+			for (size_t l = 0; l < L; ++l)
+				lanes[l] = R{}(lanes[l], other.lanes[l]);
+			stage.count += other.stage.count - other.stage.staged;
+			update(other.stage.buffer[0], other.stage.buffer[1], other.stage.staged);
+			seed = R{}(seed, other.seed);
+		}
+
+		/**
+		 * \brief Number of element pairs ingested.
+		 */
+		size_t
+		count() const 
+		{ 
+			return stage.count; 
+		}
+
+		/**
+		 * \brief Reduction of the seed and U(a, b) over every pair ingested so far.
+		 * The accumulator is unchanged and can keep ingesting.
+		 */
+		T
+		result() const
+		{
+			alignas(64) T partial[L];
+			std::copy(lanes, lanes + L, partial);
+
+			if (stage.staged != 0)
+			{
+				// Padding pairs with U(a, b) equal to the identity of R leave the lanes unchanged
+				constexpr bool additive = std::same_as<U, std::plus<>> || std::same_as<U, std::minus<>>;
+				alignas(64) T a[L], b[L];
+				std::copy(stage.buffer[0], stage.buffer[0] + stage.staged, a);
+				std::copy(stage.buffer[1], stage.buffer[1] + stage.staged, b);
+				std::fill(a + stage.staged, a + L, seed_left_fold<T, R>());
+				std::fill(b + stage.staged, b + L, additive ? T(0) : T(1));
+				_absorb(partial, a, b, 1);
+			}
+
+			T r = seed;
+			for (size_t l = 0; l < L; ++l)
+				r = R{}(r, partial[l]);
+			return r;
+		}
+	};
+
+	/**
+	 * \brief Streaming count, sum, mean, variance, minimum and maximum of a real stream.
+	 *
+	 * Sums are accumulated relative to the first element of the stream (the shifted
+	 * data algorithm), which keeps the variance accurate when the mean is large
+	 * compared to the spread. Staged elements are padded with that same first
+	 * element, which contributes zero to the shifted sums and cannot change the
+	 * minimum or maximum.
+	 *
+	 * \tparam T	Element type (float or double)
+	 * \tparam S	SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 * \tparam K	Kernel policy, col_registers sets the number of independent accumulators
+	 */
+	template<typename T, typename S = decltype(detect_simd()),
+		template<typename, typename> class K = reduce_kernel>
+	requires (std::is_floating_point_v<T>)
+	class moments_reducer
+	{
+		static constexpr size_t W = std::is_same_v<S, NONE> ? 1 : S::template elements<T>();
+		static constexpr size_t regs = K<T, S>::col_registers;
+		static constexpr size_t L = regs * W;
+
+		struct lanes_t
+		{
+			alignas(64) T sum[L];
+			alignas(64) T sq[L];
+			alignas(64) T lo[L];
+			alignas(64) T hi[L];
+		};
+
+		/** \brief Folded statistics relative to shift */
+		struct totals_t
+		{
+			T sum = 0, sq = 0;
+			T lo = std::numeric_limits<T>::infinity();
+			T hi = -std::numeric_limits<T>::infinity();
+		};
+
+		lanes_t lanes;
+		_stream_stage<T, 1, L> stage;
+		T shift = 0;
+		totals_t merged;  ///< merged accumulators, relative to shift
+
+		static inline __attribute__((always_inline))
+		void
+		_absorb(lanes_t& lanes, const T* a, const size_t blocks, const T shift)
+		{
+			if constexpr (std::is_same_v<S, NONE>)
+			{
+				for (size_t b = 0; b < blocks; ++b)
+					for (size_t l = 0; l < L; ++l)
+					{
+						const T x = a[b * L + l];
+						const T d = x - shift;
+						lanes.sum[l] += d;
+						lanes.sq[l] = std::fma(d, d, lanes.sq[l]);
+						lanes.lo[l] = std::min(lanes.lo[l], x);
+						lanes.hi[l] = std::max(lanes.hi[l], x);
+					}
+			}
+			else
+			{
+				using register_t = typename S::template register_t<T>;
+				register_t sum[regs], sq[regs], lo[regs], hi[regs];
+				const register_t k = _set1<T, S>(shift);
+
+				static_for<regs>([&]<auto r>() 
+				{ 
+					sum[r] = _load<T, S>(lanes.sum + r * W);
+					sq[r] = _load<T, S>(lanes.sq + r * W);
+					lo[r] = _load<T, S>(lanes.lo + r * W);
+					hi[r] = _load<T, S>(lanes.hi + r * W);
+				});
+
+				for (size_t b = 0; b < blocks; ++b)
+					static_for<regs>([&]<auto r>() 
+					{
+						const register_t x = _loadu<T, S>(a + b * L + r * W);
+						const register_t d = _sub<T, S>(x, k);
+						sum[r] = _add<T, S>(sum[r], d);
+						sq[r] = _fmadd<T, S>(d, d, sq[r]);
+						lo[r] = _min<T, S>(lo[r], x);
+						hi[r] = _max<T, S>(hi[r], x);
+					});
+
+				static_for<regs>([&]<auto r>() 
+				{ 
+					_store<T, S>(lanes.sum + r * W, sum[r]);
+					_store<T, S>(lanes.sq + r * W, sq[r]);
+					_store<T, S>(lanes.lo + r * W, lo[r]);
+					_store<T, S>(lanes.hi + r * W, hi[r]);
+				});
+			}
+		}
+
+		/** \brief Fold lanes, staged elements and merged totals, relative to shift */
+		totals_t
+		_totals() const
+		{
+			lanes_t partial = lanes;
+			if (stage.staged != 0)
+			{
+				alignas(64) T tail[L];
+				std::copy(stage.buffer[0], stage.buffer[0] + stage.staged, tail);
+				std::fill(tail + stage.staged, tail + L, shift);
+				_absorb(partial, tail, 1, shift);
+			}
+
+			totals_t t = merged;
+			for (size_t l = 0; l < L; ++l)
+			{
+				t.sum += partial.sum[l];
+				t.sq += partial.sq[l];
+				t.lo = std::min(t.lo, partial.lo[l]);
+				t.hi = std::max(t.hi, partial.hi[l]);
+			}
+			return t;
+		}
+
+	public:
+		moments_reducer() 
+		{ 
+			reset(); 
+		}
+
+		/**
+		 * \brief Discard all ingested elements.
+		 */
+		void
+		reset()
+		{
+			std::fill(lanes.sum, lanes.sum + L, T(0));
+			std::fill(lanes.sq, lanes.sq + L, T(0));
+			std::fill(lanes.lo, lanes.lo + L, std::numeric_limits<T>::infinity());
+			std::fill(lanes.hi, lanes.hi + L, -std::numeric_limits<T>::infinity());
+			stage.staged = 0;
+			stage.count = 0;
+			shift = 0;
+			merged = totals_t{};
+		}
+
+		/**
+		 * \brief Ingest the next M×N chunk of the stream in row-major order.
+		 */
+		void
+		update(T** A, const size_t M, const size_t N)
+		{
+			right<T>("moments_reducer:", std::make_tuple(A, M, N));
+			update(A[0], M * N);
+		}
+
+		/**
+		 * \brief Ingest the next n contiguous elements of the stream.
+		 */
+		void
+		update(const T* a, const size_t n)
+		{
+			if (n == 0)
+				return;
+			if (stage.count == 0)
+				shift = a[0];
+
+			stage.ingest({a}, n, [&](const std::array<const T*, 1>& p, const size_t blocks) 
+			{
+				_absorb(lanes, p[0], blocks, shift);
+			});
+		}
+
+		/**
+		 * \brief Combine another accumulator into this one.
+		 * The other's sums are re-centred on this accumulator's shift.
+		 */
+		void
+		merge(const moments_reducer& other)
+		{
+			if (other.count() == 0)
+				return;
+			if (count() == 0)
+			{
+				*this = other;
+				return;
+			}
+
+			const totals_t t = other._totals();
+			const T n = T(other.count());
+			const T d = other.shift - shift;
+
+			merged.sum += t.sum + n * d;
+			merged.sq += t.sq + 2 * d * t.sum + n * d * d;
+			merged.lo = std::min(merged.lo, t.lo);
+			merged.hi = std::max(merged.hi, t.hi);
+			stage.count += other.count();
+		}
+
+		/** \brief Number of elements ingested */
+		size_t count() const { return stage.count; }
+
+		/** \brief Sum of the elements */
+		T sum() const { return T(count()) * shift + _totals().sum; }
+
+		/** \brief Arithmetic mean, NaN for an empty stream */
+		T 
+		mean() const 
+		{ 
+			return count() ? shift + _totals().sum / T(count()) : std::numeric_limits<T>::quiet_NaN(); 
+		}
+
+		/** 
+		 * \brief Variance with ddof delta degrees of freedom (0 population, 1 sample).
+		 * NaN when count() ≤ ddof.
+		 */
+		T
+		variance(const size_t ddof = 0) const
+		{
+			if (count() <= ddof)
+				return std::numeric_limits<T>::quiet_NaN();
+			const totals_t t = _totals();
+			const T n = T(count());
+			return std::max(T(0), (t.sq - t.sum * t.sum / n) / (n - T(ddof)));
+		}
+
+		/** \brief Smallest element, +inf for an empty stream */
+		T min() const { return _totals().lo; }
+
+		/** \brief Largest element, -inf for an empty stream */
+		T max() const { return _totals().hi; }
+	};
+
+}//namespace damm
+
+#endif //__REDUCER_H__
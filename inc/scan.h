@@ -0,0 +1,369 @@
+#ifndef __SCAN_H__
+#define __SCAN_H__
+/**
+ * \file scan.h
+ * \brief definitions for prefix scans
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <common.h>
+#include <functional>
+#include <simd.h>
+#include <damm_kernels.h>
+#include <omp.h>
+
+#include <bit>
+#include <vector>
+
+/**
+ * Scan (prefix reduction) operation.
+ *
+ * \note
+ * An inclusive scan replaces each element with the reduction of every element
+ * up to and including it, an exclusive scan with the reduction of every element
+ * before it (the operator identity for the first).
+ *
+ * \note
+ * Within a register the scan takes log₂(W) shift-and-combine steps (Hillis-Steele).
+ * Registers are chained by a broadcast carry. Long runs are split across threads
+ * with a two-pass block scan: each thread reduces its block, the block totals are
+ * scanned serially, and each thread then scans its block seeded with its prefix.
+ * Float results therefore depend on the thread count in the last bits, as for reduce.
+ */
+namespace damm
+{
+	/**
+	 * \brief Whether a scan includes the current element.
+	 */
+	enum class ScanMode 
+	{
+		INCLUSIVE,  ///< B[i] = A[0] ∘ … ∘ A[i]
+		EXCLUSIVE   ///< B[i] = A[0] ∘ … ∘ A[i-1], B[0] = identity
+	};
+
+	/** 
+	 * \brief Shift the register up by K real lanes, filling the low lanes from fill.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename R, typename S, size_t K>
+	inline __attribute__((always_inline))
+	typename S::template register_t<R>
+	_shift_lanes(const typename S::template register_t<R> x, const typename S::template register_t<R> fill)
+	{
+		if constexpr (std::is_same_v<S, AVX512> && std::is_same_v<R, float>)
+			return _mm512_castsi512_ps(_mm512_alignr_epi32(_mm512_castps_si512(x), _mm512_castps_si512(fill), 16 - K));
+		else if constexpr (std::is_same_v<S, AVX512>)
+			return _mm512_castsi512_pd(_mm512_alignr_epi64(_mm512_castpd_si512(x), _mm512_castpd_si512(fill), 8 - K));
+		else if constexpr (std::is_same_v<S, AVX> && std::is_same_v<R, float>)
+		{
+			const __m256i idx = _mm256_setr_epi32((0 - K) & 7, (1 - K) & 7, (2 - K) & 7, (3 - K) & 7, 
+				(4 - K) & 7, (5 - K) & 7, (6 - K) & 7, (7 - K) & 7);
+			return _mm256_blend_ps(_mm256_permutevar8x32_ps(x, idx), fill, (1 << K) - 1);
+		}
+		else if constexpr (std::is_same_v<S, AVX>)
+		{
+			constexpr int imm = ((3 - K) & 3) << 6 | ((2 - K) & 3) << 4 | ((1 - K) & 3) << 2 | ((0 - K) & 3);
+			return _mm256_blend_pd(_mm256_permute4x64_pd(x, imm), fill, (1 << K) - 1);
+		}
+		else if constexpr (std::is_same_v<R, float>)
+			return _mm_blend_ps(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4 * K)), fill, (1 << K) - 1);
+		else
+			return _mm_blend_pd(_mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8 * K)), fill, (1 << K) - 1);
+	}
+
+	/** 
+	 * \brief Inclusive scan of the elements of one register.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename O, typename S>
+	inline __attribute__((always_inline))
+	typename S::template register_t<T>
+	_scan_register(typename S::template register_t<T> x, const typename S::template register_t<T> identity)
+	{
+		using real_t = typename base<T>::type;
+		constexpr size_t W = S::template elements<T>();
+		constexpr size_t stride = is_complex_v<T> ? 2 : 1;
+		constexpr size_t steps = std::bit_width(W) - 1;
+
+		static_for<steps>([&]<auto s>() 
+		{
+			const auto shifted = _shift_lanes<real_t, S, (size_t(1) << s) * stride>(x, identity);
+			if constexpr (std::same_as<O, std::plus<>>)
+				x = _add<T, S>(x, shifted);
+			else
+				x = _mul<T, S>(x, shifted);
+		});
+		return x;
+	}
+
+	/** 
+	 * \brief kernel for the scan of a contiguous run seeded with carry.
+	 * Returns the reduction of carry and the whole run.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename O, ScanMode Mode, typename S>
+	inline __attribute__((always_inline))
+	T
+	_scan_run(const T* a, T* b, const size_t n, T carry)
+	{
+		size_t i = 0;
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+			constexpr size_t stride = is_complex_v<T> ? 2 : 1;
+
+			const register_t identity = _set1<T, S>(seed_left_fold<T, O>());
+			register_t c = _set1<T, S>(carry);
+			alignas(S::bytes) T last[W];
+
+			for (; i + W <= n; i += W)
+			{
+				const register_t s = _scan_register<T, O, S>(_loadu<T, S>(reinterpret_cast<const real_t*>(a + i)), identity);
+				const register_t inclusive = std::same_as<O, std::plus<>> ? _add<T, S>(c, s) : _mul<T, S>(c, s);
+
+				if constexpr (Mode == ScanMode::INCLUSIVE)
+					_storeu<T, S>(reinterpret_cast<real_t*>(b + i), inclusive);
+				else
+				{
+					const register_t shifted = _shift_lanes<real_t, S, stride>(s, identity);
+					_storeu<T, S>(reinterpret_cast<real_t*>(b + i), 
+						std::same_as<O, std::plus<>> ? _add<T, S>(c, shifted) : _mul<T, S>(c, shifted));
+				}
+
+				_store<T, S>(reinterpret_cast<real_t*>(last), inclusive);
+				carry = last[W - 1];
+				c = _set1<T, S>(carry);
+			}
+		}
+
+		for (; i < n; ++i)
+		{
+			const T x = a[i];
+			if constexpr (Mode == ScanMode::EXCLUSIVE)
+				b[i] = carry;
+			carry = O{}(carry, x);
+			if constexpr (Mode == ScanMode::INCLUSIVE)
+				b[i] = carry;
+		}
+
+		return carry;
+	}
+
+	/** 
+	 * \brief kernel for the reduction of a contiguous run, the first pass of the block scan.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename O, typename S>
+	inline __attribute__((always_inline))
+	T
+	_fold_run(const T* a, const size_t n)
+	{
+		T r = seed_left_fold<T, O>();
+		size_t i = 0;
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+
+			register_t acc = _set1<T, S>(r);
+			for (; i + W <= n; i += W)
+			{
+				const register_t x = _loadu<T, S>(reinterpret_cast<const real_t*>(a + i));
+				acc = std::same_as<O, std::plus<>> ? _add<T, S>(acc, x) : _mul<T, S>(acc, x);
+			}
+
+			alignas(S::bytes) T lanes[W];
+			_store<T, S>(reinterpret_cast<real_t*>(lanes), acc);
+			for (size_t l = 0; l < W; ++l)
+				r = O{}(r, lanes[l]);
+		}
+
+		for (; i < n; ++i)
+			r = O{}(r, a[i]);
+
+		return r;
+	}
+
+	/**
+	 * \brief Scan over all elements of A in row-major order, B = scan(A).
+	 *
+	 * \tparam T		Element type (float, double, or complex variants)
+	 * \tparam O		Binary operator (std::plus<> or std::multiplies<>)
+	 * \tparam Mode		INCLUSIVE or EXCLUSIVE
+	 * \tparam S		SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param A		Input matrix, M×N
+	 * \param B		Output matrix, M×N, may alias A
+	 * \param M		Number of rows
+	 * \param N		Number of columns
+	 * 
+	 * \return The reduction of all elements of A
+	 */
+	template<typename T, typename O, ScanMode Mode = ScanMode::INCLUSIVE, typename S = decltype(detect_simd())>
+	requires (
+		std::same_as<O, std::plus<>> ||
+		std::same_as<O, std::multiplies<>>
+	)
+	inline T
+	scan(T** A, T** B, const size_t M, const size_t N)
+	{
+		right<T>("scan:", std::make_tuple(A, M, N), std::make_tuple(B, M, N));
+
+		const T* a = A[0];
+		T* b = B[0];
+		const size_t L = M * N;
+
+		std::vector<T> prefix(omp_get_max_threads() + 1, seed_left_fold<T, O>());
+		T total = seed_left_fold<T, O>();
+
+		#pragma omp parallel
+		{
+			const size_t threads = omp_get_num_threads();
+			const size_t tid = omp_get_thread_num();
+			const size_t block = (L + threads - 1) / threads;
+			const size_t begin = std::min(tid * block, L);
+			const size_t end = std::min(begin + block, L);
+
+			prefix[tid + 1] = _fold_run<T, O, S>(a + begin, end - begin);
+
+			#pragma omp barrier
+			#pragma omp single
+			{
+				for (size_t t = 1; t <= threads; ++t)
+					prefix[t] = O{}(prefix[t - 1], prefix[t]);
+				total = prefix[threads];
+			}
+
+			_scan_run<T, O, Mode, S>(a + begin, b + begin, end - begin, prefix[tid]);
+		}
+
+		return total;
+	}
+
+	/**
+	 * \brief Scan along each row of A independently.
+	 *
+	 * \tparam T		Element type (float, double, or complex variants)
+	 * \tparam O		Binary operator (std::plus<> or std::multiplies<>)
+	 * \tparam Mode		INCLUSIVE or EXCLUSIVE
+	 * \tparam S		SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param A		Input matrix, M×N
+	 * \param B		Output matrix, M×N, may alias A
+	 * \param M		Number of rows
+	 * \param N		Number of columns
+	 */
+	template<typename T, typename O, ScanMode Mode = ScanMode::INCLUSIVE, typename S = decltype(detect_simd())>
+	requires (
+		std::same_as<O, std::plus<>> ||
+		std::same_as<O, std::multiplies<>>
+	)
+	inline void
+	scan_rows(T** A, T** B, const size_t M, const size_t N)
+	{
+		right<T>("scan_rows:", std::make_tuple(A, M, N), std::make_tuple(B, M, N));
+
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0; i < M; ++i)
+			_scan_run<T, O, Mode, S>(A[i], B[i], N, seed_left_fold<T, O>());
+	}
+
+	/**
+	 * \brief Scan down each column of A independently.
+	 *
+	 * Columns are scanned a strip of registers at a time, carrying one register per
+	 * column group down the rows, so no in-register shuffles are needed.
+	 *
+	 * \tparam T		Element type (float, double, or complex variants)
+	 * \tparam O		Binary operator (std::plus<> or std::multiplies<>)
+	 * \tparam Mode		INCLUSIVE or EXCLUSIVE
+	 * \tparam S		SIMD instruction set (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param A		Input matrix, M×N
+	 * \param B		Output matrix, M×N, may alias A
+	 * \param M		Number of rows
+	 * \param N		Number of columns
+	 */
+	template<typename T, typename O, ScanMode Mode = ScanMode::INCLUSIVE, typename S = decltype(detect_simd()),
+		template<typename, typename> class K = reduce_kernel>
+	requires (
+		std::same_as<O, std::plus<>> ||
+		std::same_as<O, std::multiplies<>>
+	)
+	inline void
+	scan_columns(T** A, T** B, const size_t M, const size_t N)
+	{
+		right<T>("scan_columns:", std::make_tuple(A, M, N), std::make_tuple(B, M, N));
+
+		constexpr size_t regs = K<T, S>::col_registers;
+		constexpr size_t W = std::is_same_v<S, NONE> ? 1 : S::template elements<T>();
+		constexpr size_t strip = regs * W;
+		const size_t simd_N = std::is_same_v<S, NONE> ? 0 : N - N % strip;
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+
+			#pragma omp parallel for schedule(static)
+			for (size_t j = 0; j < simd_N; j += strip)
+			{
+				register_t c[regs];
+				static_for<regs>([&]<auto r>() { c[r] = _set1<T, S>(seed_left_fold<T, O>()); });
+
+				for (size_t i = 0; i < M; ++i)
+					static_for<regs>([&]<auto r>() 
+					{
+						const register_t x = _loadu<T, S>(reinterpret_cast<const real_t*>(A[i] + j + r * W));
+						if constexpr (Mode == ScanMode::EXCLUSIVE)
+							_storeu<T, S>(reinterpret_cast<real_t*>(B[i] + j + r * W), c[r]);
+						c[r] = std::same_as<O, std::plus<>> ? _add<T, S>(c[r], x) : _mul<T, S>(c[r], x);
+						if constexpr (Mode == ScanMode::INCLUSIVE)
+							_storeu<T, S>(reinterpret_cast<real_t*>(B[i] + j + r * W), c[r]);
+					});
+			}
+		}
+
+		for (size_t j = simd_N; j < N; ++j)
+		{
+			T carry = seed_left_fold<T, O>();
+			for (size_t i = 0; i < M; ++i)
+			{
+				const T x = A[i][j];
+				if constexpr (Mode == ScanMode::EXCLUSIVE)
+					B[i][j] = carry;
+				carry = O{}(carry, x);
+				if constexpr (Mode == ScanMode::INCLUSIVE)
+					B[i][j] = carry;
+			}
+		}
+	}
+
+}//namespace damm
+
+#endif //__SCAN_H__
@@ -0,0 +1,476 @@
+#ifndef __SEGMENTED_H__
+#define __SEGMENTED_H__
+/**
+ * \file segmented.h
+ * \brief definitions for segmented reductions over a flat buffer
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <common.h>
+#include <functional>
+#include <simd.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Segmented reduction.
+ *
+ * \note
+ * A segmented reduction folds each of many variable length segments of one
+ * flat buffer. Segment s covers A[offsets[s]] … A[offsets[s+1] - 1], so
+ * offsets holds segments + 1 nondecreasing positions, and an empty segment
+ * reduces to the seed. One call replaces a reduce per segment, with its
+ * argument checks, views and parallel region, by a single pass.
+ *
+ * \note
+ * Threads split the elements, not the segments, into equal ranges, so a few
+ * long segments among many short ones do not unbalance the work. A thread
+ * owns the segments that start in its range, and a segment that runs past
+ * the range end is finished by the following threads. Their partial folds
+ * are combined after the parallel region in thread order. As for reduce,
+ * float results of those segments can depend on the thread count in the
+ * last bits.
+ *
+ * \note
+ * A segment of at least two registers is folded inside the segment, with two
+ * SIMD accumulators over pairs of registers and one over a leftover register.
+ * Shorter segments are collected as a thread meets them and folded W at a
+ * time, one segment per lane: they are copied down the lanes of a tile
+ * padded with the identity of the fold, so lanes whose segment has ended
+ * keep their value without a mask.
+ */
+namespace damm
+{
+	/**
+	 * \brief Combine two registers with O.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename O, typename S>
+	inline __attribute__((always_inline))
+	typename S::template register_t<T>
+	_combine_registers(const typename S::template register_t<T> a, const typename S::template register_t<T> b)
+	{
+		if constexpr (std::same_as<O, std::plus<>>)
+			return _add<T, S>(a, b);
+		else if constexpr (std::same_as<O, std::minus<>>)
+			return _sub<T, S>(a, b);
+		else if constexpr (std::same_as<O, std::multiplies<>>)
+			return _mul<T, S>(a, b);
+		else
+			return _div<T, S>(a, b);
+	}
+
+	/**
+	 * \brief kernel for the O fold of a[0..n) without seed.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename O, typename S>
+	inline __attribute__((always_inline))
+	T
+	_segment_reduce(const T* a, const size_t n)
+	{
+		T r = seed_left_fold<T, O>();
+		size_t i = 0;
+
+		if constexpr (!std::is_same_v<S, NONE>)
+		{
+			using real_t = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+
+			if (n >= W)
+			{
+				register_t acc0 = _set1<T, S>(r);
+				register_t acc1 = acc0;
+
+				for (; i + 2 * W <= n; i += 2 * W)
+				{
+					acc0 = _combine_registers<T, O, S>(acc0, _loadu<T, S>(reinterpret_cast<const real_t*>(a + i)));
+					acc1 = _combine_registers<T, O, S>(acc1, _loadu<T, S>(reinterpret_cast<const real_t*>(a + i + W)));
+				}
+				for (; i + W <= n; i += W)
+					acc0 = _combine_registers<T, O, S>(acc0, _loadu<T, S>(reinterpret_cast<const real_t*>(a + i)));
+
+				alignas(S::bytes) T lanes[W];
+				_store<T, S>(reinterpret_cast<real_t*>(lanes), _combine_registers<T, O, S>(acc0, acc1));
+				for (size_t l = 0; l < W; ++l)
+					r = O{}(r, lanes[l]);
+			}
+		}
+
+		for (; i < n; ++i)
+			r = O{}(r, a[i]);
+
+		return r;
+	}
+
+	/**
+	 * \brief kernel for the R fold of U(a[k], b[k]), k < n, without seed.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename U, typename R, typename S>
+	inline __attribute__((always_inline))
+	T
+	_segment_fused_reduce(const T* a, const T* b, const size_t n)
+	{
+		T r = seed_left_fold<T, R>();
+		size_t i = 0;
+
+		if constexpr (!std::is_same_v<S, NONE> && has_simd_op_v<T, U>)
+		{
+			using real_t = typename base<T>::type;
+			using register_t = typename S::template register_t<T>;
+			constexpr size_t W = S::template elements<T>();
+
+			auto fused = [&](const size_t k)
+			{
+				return _combine_registers<T, U, S>(
+					_loadu<T, S>(reinterpret_cast<const real_t*>(a + k)),
+					_loadu<T, S>(reinterpret_cast<const real_t*>(b + k)));
+			};
+
+			if (n >= W)
+			{
+				register_t acc0 = _set1<T, S>(r);
+				register_t acc1 = acc0;
+
+				for (; i + 2 * W <= n; i += 2 * W)
+				{
+					acc0 = _combine_registers<T, R, S>(acc0, fused(i));
+					acc1 = _combine_registers<T, R, S>(acc1, fused(i + W));
+				}
+				for (; i + W <= n; i += W)
+					acc0 = _combine_registers<T, R, S>(acc0, fused(i));
+
+				alignas(S::bytes) T lanes[W];
+				_store<T, S>(reinterpret_cast<real_t*>(lanes), _combine_registers<T, R, S>(acc0, acc1));
+				for (size_t l = 0; l < W; ++l)
+					r = R{}(r, lanes[l]);
+			}
+		}
+
+		for (; i < n; ++i)
+			r = R{}(r, U{}(a[i], b[i]));
+
+		return r;
+	}
+
+	/**
+	 * \brief Number of lanes the short segment kernels fold at once, zero when
+	 * the segments are folded one at a time.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename S>
+	consteval size_t
+	_segment_lanes()
+	{
+		if constexpr (std::is_same_v<S, NONE>)
+			return 0;
+		else
+			return S::template elements<T>();
+	}
+
+	/**
+	 * \brief kernel for the O fold of W short segments at once, one per lane:
+	 * r[l] is the fold of a[lo[l]..lo[l] + n[l]) without seed, n[l] < 2 * W.
+	 * Segment l is laid out down lane l of a tile whose unused entries hold
+	 * the identity of O, so every lane takes the same steps.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename O, typename S>
+	inline __attribute__((always_inline))
+	void
+	_segment_reduce_lanes(const T* a, const size_t* lo, const size_t* n, T* r)
+	{
+		using real_t = typename base<T>::type;
+		using register_t = typename S::template register_t<T>;
+		constexpr size_t W = S::template elements<T>();
+		const T identity = seed_left_fold<T, O>();
+
+		const size_t steps = *std::max_element(n, n + W);
+
+		alignas(S::bytes) T tile[2 * W * W];
+		std::fill(tile, tile + steps * W, identity);
+		for (size_t l = 0; l < W; ++l)
+			for (size_t k = 0; k < n[l]; ++k)
+				tile[k * W + l] = a[lo[l] + k];
+
+		register_t acc = _set1<T, S>(identity);
+		for (size_t k = 0; k < steps; ++k)
+			acc = _combine_registers<T, O, S>(acc, _load<T, S>(reinterpret_cast<const real_t*>(tile + k * W)));
+
+		_store<T, S>(reinterpret_cast<real_t*>(r), acc);
+	}
+
+	/**
+	 * \brief kernel for the R fold of U(a[k], b[k]) over W short segments at
+	 * once, one per lane, as _segment_reduce_lanes. Unused entries hold the
+	 * identity of R in a and the right identity of U in b.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename U, typename R, typename S>
+	inline __attribute__((always_inline))
+	void
+	_segment_fused_reduce_lanes(const T* a, const T* b, const size_t* lo, const size_t* n, T* r)
+	{
+		using real_t = typename base<T>::type;
+		using register_t = typename S::template register_t<T>;
+		constexpr size_t W = S::template elements<T>();
+		const T identity = seed_left_fold<T, R>();
+		const T pad = std::same_as<U, std::plus<>> || std::same_as<U, std::minus<>> ? T(0) : T(1);
+
+		const size_t steps = *std::max_element(n, n + W);
+
+		alignas(S::bytes) T tile_a[2 * W * W];
+		alignas(S::bytes) T tile_b[2 * W * W];
+		std::fill(tile_a, tile_a + steps * W, identity);
+		std::fill(tile_b, tile_b + steps * W, pad);
+		for (size_t l = 0; l < W; ++l)
+			for (size_t k = 0; k < n[l]; ++k)
+			{
+				tile_a[k * W + l] = a[lo[l] + k];
+				tile_b[k * W + l] = b[lo[l] + k];
+			}
+
+		register_t acc = _set1<T, S>(identity);
+		for (size_t k = 0; k < steps; ++k)
+			acc = _combine_registers<T, R, S>(acc, _combine_registers<T, U, S>(
+				_load<T, S>(reinterpret_cast<const real_t*>(tile_a + k * W)),
+				_load<T, S>(reinterpret_cast<const real_t*>(tile_b + k * W))));
+
+		_store<T, S>(reinterpret_cast<real_t*>(r), acc);
+	}
+
+	/**
+	 * \brief Check offsets and the flat buffers of a segmented operation.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T>
+	inline void
+	_segmented_right(const char* id, const T* A, const size_t* offsets, const size_t segments, T* out)
+	{
+		right<size_t>(id, std::make_tuple(const_cast<size_t*>(offsets), size_t(1), segments + 1));
+		right<T>(id, std::make_tuple(out, size_t(1), segments));
+
+		bool ordered = true;
+		#pragma omp parallel for reduction(&&:ordered) if(segments >= 65536)
+		for (size_t s = 0; s < segments; ++s)
+			ordered = ordered && offsets[s] <= offsets[s + 1];
+
+		if (!ordered)
+			throw std::invalid_argument(std::string(id) + "offsets must be nondecreasing");
+
+		if (offsets[segments] > offsets[0])
+			right<T>(id, std::make_tuple(const_cast<T*>(A + offsets[0]), size_t(1), offsets[segments] - offsets[0]));
+	}
+
+	/**
+	 * \brief Element balanced driver: out[s] = seed R fold(offsets[s], offsets[s+1]),
+	 * where fold(lo, hi) folds the elements [lo, hi) without seed. Segments
+	 * shorter than 2 * W are gathered W at a time and handed to
+	 * lanes(lo, n, r), which folds them one per lane into r; W = 0 folds every
+	 * segment with fold.
+	 * Low level function not intended for the public API.
+	 */
+	template <typename T, typename R, size_t W, typename F, typename G>
+	inline void
+	_segmented(const size_t* offsets, const size_t segments, T* out, const T seed, F&& fold, G&& lanes)
+	{
+		// Below this many elements the pass runs on the calling thread
+		constexpr size_t parallel_elements = 32768;
+
+		const size_t first = offsets[0];
+		const size_t total = offsets[segments] - first;
+
+		// Partial fold of a segment started by an earlier thread, one per thread
+		std::vector<std::pair<size_t, T>> pieces(omp_get_max_threads(), {segments, seed});
+
+		#pragma omp parallel if(total >= parallel_elements)
+		{
+			const size_t t = omp_get_thread_num();
+			const size_t nt = omp_get_num_threads();
+			const size_t e0 = first + total * t / nt;
+			const size_t e1 = first + total * (t + 1) / nt;
+
+			// Segments starting in [e0, e1); the last thread also takes empty ones at the end
+			const size_t lo = std::lower_bound(offsets, offsets + segments, e0) - offsets;
+			const size_t hi = t + 1 == nt ? segments : size_t(std::lower_bound(offsets, offsets + segments, e1) - offsets);
+
+			const size_t piece_end = std::min(e1, offsets[lo]);
+			if (e0 < piece_end)
+				pieces[t] = {lo - 1, fold(e0, piece_end)};
+
+			if constexpr (W == 0)
+			{
+				for (size_t s = lo; s < hi; ++s)
+					out[s] = R{}(seed, fold(offsets[s], std::min(offsets[s + 1], e1)));
+			}
+			else
+			{
+				// Short segments waiting for a lane, and their output slots
+				size_t lane_lo[W], lane_n[W], lane_out[W];
+				size_t filled = 0;
+				alignas(64) T part[W];
+
+				auto flush = [&]()
+				{
+					std::fill(lane_n + filled, lane_n + W, size_t(0));
+					std::fill(lane_lo + filled, lane_lo + W, size_t(0));
+					lanes(lane_lo, lane_n, part);
+					for (size_t l = 0; l < filled; ++l)
+						out[lane_out[l]] = R{}(seed, part[l]);
+					filled = 0;
+				};
+
+				for (size_t s = lo; s < hi; ++s)
+				{
+					const size_t end = std::min(offsets[s + 1], e1);
+					if (end - offsets[s] >= 2 * W)
+					{
+						out[s] = R{}(seed, fold(offsets[s], end));
+						continue;
+					}
+
+					lane_lo[filled] = offsets[s];
+					lane_n[filled] = end - offsets[s];
+					lane_out[filled] = s;
+					if (++filled == W)
+						flush();
+				}
+				if (filled)
+					flush();
+			}
+		}
+
+		for (const auto& [s, partial] : pieces)
+			if (s < segments)
+				out[s] = R{}(out[s], partial);
+	}
+
+	/**
+	 * \brief Reduce each segment of a flat buffer, out[s] = seed ∘ A[offsets[s]] ∘ … ∘ A[offsets[s+1] - 1].
+	 *
+	 * Supported Operations
+	 * | Operation | Associative | Commutative | Parallel |
+	 * |-----------|-------------|-------------|----------|
+	 * | Add       | Yes         | Yes         | Yes      |
+	 * | Multiply  | Yes         | Yes         | Yes      |
+	 *
+	 * \tparam T	Element type (float, double, complex variants, int16_t, int32_t or int64_t)
+	 * \tparam O	Binary reduction operator (std::plus<> or std::multiplies<>)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param A			Flat buffer holding the segments
+	 * \param offsets	Segment boundaries, segments + 1 nondecreasing positions in A
+	 * \param segments	Number of segments
+	 * \param out		Output, one value per segment
+	 * \param seed		Initial value of every segment's reduction
+	 *
+	 * \throws std::invalid_argument if offsets decrease
+	 */
+	template<typename T, typename O, typename S = decltype(detect_simd())>
+	requires (
+		std::same_as<O, std::plus<>> ||
+		std::same_as<O, std::multiplies<>>
+	)
+	inline void
+	segmented_reduce(const T* A, const size_t* offsets, const size_t segments, T* out,
+		const T seed = seed_left_fold<T, O>())
+	{
+		if (segments == 0)
+			return;
+
+		_segmented_right<T>("segmented reduce:", A, offsets, segments, out);
+
+		constexpr size_t W = _segment_lanes<T, S>();
+
+		_segmented<T, O, W>(offsets, segments, out, seed, [A](const size_t lo, const size_t hi)
+		{
+			return _segment_reduce<T, O, S>(A + lo, hi - lo);
+		}, [A](const size_t* lo, const size_t* n, T* r)
+		{
+			if constexpr (W != 0)
+				_segment_reduce_lanes<T, O, S>(A, lo, n, r);
+		});
+	}
+
+	/**
+	 * \brief Fused union-reduce of each segment of two flat buffers,
+	 * out[s] = seed R U(A[k], B[k]) R … over offsets[s] ≤ k < offsets[s+1].
+	 *
+	 * With U = std::multiplies<> and R = std::plus<> this is a dot product per
+	 * segment.
+	 *
+	 * \tparam T	Element type (float, double, complex variants, int16_t, int32_t or int64_t)
+	 * \tparam U	Binary union operator (std::plus<>, std::minus<>, std::multiplies<> or std::divides<>)
+	 * \tparam R	Binary reduction operator (std::plus<> or std::multiplies<>)
+	 * \tparam S	SIMD instruction set to use (SSE, AVX, AVX512, or NONE)
+	 *
+	 * \param A			First flat buffer
+	 * \param B			Second flat buffer, indexed like A
+	 * \param offsets	Segment boundaries, segments + 1 nondecreasing positions
+	 * \param segments	Number of segments
+	 * \param out		Output, one value per segment
+	 * \param seed		Initial value of every segment's reduction
+	 *
+	 * \throws std::invalid_argument if offsets decrease
+	 */
+	template<typename T, typename U, typename R, typename S = decltype(detect_simd())>
+	requires (
+		(std::same_as<U, std::plus<>> ||
+		 std::same_as<U, std::minus<>> ||
+		 std::same_as<U, std::multiplies<>> ||
+		 std::same_as<U, std::divides<>>) &&
+		(std::same_as<R, std::plus<>> ||
+		 std::same_as<R, std::multiplies<>>)
+	)
+	inline void
+	segmented_fused_reduce(const T* A, const T* B, const size_t* offsets, const size_t segments, T* out,
+		const T seed = seed_left_fold<T, R>())
+	{
+		if (segments == 0)
+			return;
+
+		_segmented_right<T>("segmented fused reduce:", A, offsets, segments, out);
+		if (offsets[segments] > offsets[0])
+			right<T>("segmented fused reduce:", std::make_tuple(const_cast<T*>(B + offsets[0]), size_t(1), offsets[segments] - offsets[0]));
+
+		constexpr size_t W = has_simd_op_v<T, U> ? _segment_lanes<T, S>() : 0;
+
+		_segmented<T, R, W>(offsets, segments, out, seed, [A, B](const size_t lo, const size_t hi)
+		{
+			return _segment_fused_reduce<T, U, R, S>(A + lo, B + lo, hi - lo);
+		}, [A, B](const size_t* lo, const size_t* n, T* r)
+		{
+			if constexpr (W != 0)
+				_segment_fused_reduce_lanes<T, U, R, S>(A, B, lo, n, r);
+		});
+	}
+
+}//namespace damm
+
+#endif //__SEGMENTED_H__
@@ -0,0 +1,158 @@
+#ifndef __SEMIRING_H__
+#define __SEMIRING_H__
+/**
+ * \file semiring.h
+ * \brief definitions of semiring policies for generalized matrix multiply
+ * \author cpapakonstantinou
+ * \date 2025
+ **/
+// Copyright (c) 2025  Constantine Papakonstantinou
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <common.h>
+#include <simd.h>
+
+#include <limits>
+#include <algorithm>
+
+/**
+ * \brief Semiring policies (⊕, ⊗, 0, 1) for multiply.
+ *
+ * A semiring policy supplies the identities zero<T>() and one<T>(), the scalar
+ * operations add and mul, and the register form fma<T, S>(a, b, c) = c ⊕ (a ⊗ b)
+ * used by the multiply micro-kernel. C ⊕= A ⊗ B then reads
+ *   C[i][j] = C[i][j] ⊕ ⨁_k A[i][k] ⊗ B[k][j].
+ *
+ * | Policy     | ⊕   | ⊗   | zero | one | Typical use                      |
+ * |------------|-----|-----|------|-----|----------------------------------|
+ * | plus_times | +   | ×   | 0    | 1   | linear algebra                   |
+ * | min_plus   | min | +   | +∞   | 0   | shortest paths                   |
+ * | max_plus   | max | +   | −∞   | 0   | scheduling, Viterbi (log domain) |
+ * | max_times  | max | ×   | 0    | 1   | most reliable path, on [0, ∞)    |
+ * | or_and     | max | min | 0    | 1   | reachability, on {0, 1}          |
+ */
+namespace damm
+{
+	/**
+	 * \brief The ordinary (+, ×) semiring.
+	 */
+	struct plus_times
+	{
+		template<typename T> static constexpr T zero() { return T(0); }
+		template<typename T> static constexpr T one() { return T(1); }
+		template<typename T> static constexpr T add(const T a, const T b) { return a + b; }
+		template<typename T> static constexpr T mul(const T a, const T b) { return a * b; }
+
+		template<typename T, typename S>
+		static inline __attribute__((always_inline))
+		typename S::template register_t<T>
+		fma(const typename S::template register_t<T> a, const typename S::template register_t<T> b, const typename S::template register_t<T> c)
+		{
+			return _fmadd<T, S>(a, b, c);
+		}
+	};
+
+	/**
+	 * \brief The tropical (min, +) semiring.
+	 */
+	struct min_plus
+	{
+		template<typename T> static constexpr T zero() { return std::numeric_limits<T>::infinity(); }
+		template<typename T> static constexpr T one() { return T(0); }
+		template<typename T> static constexpr T add(const T a, const T b) { return std::min(a, b); }
+		template<typename T> static constexpr T mul(const T a, const T b) { return a + b; }
+
+		template<typename T, typename S>
+		static inline __attribute__((always_inline))
+		typename S::template register_t<T>
+		fma(const typename S::template register_t<T> a, const typename S::template register_t<T> b, const typename S::template register_t<T> c)
+		{
+			return _min<T, S>(c, _add<T, S>(a, b));
+		}
+	};
+
+	/**
+	 * \brief The (max, +) semiring.
+	 */
+	struct max_plus
+	{
+		template<typename T> static constexpr T zero() { return -std::numeric_limits<T>::infinity(); }
+		template<typename T> static constexpr T one() { return T(0); }
+		template<typename T> static constexpr T add(const T a, const T b) { return std::max(a, b); }
+		template<typename T> static constexpr T mul(const T a, const T b) { return a + b; }
+
+		template<typename T, typename S>
+		static inline __attribute__((always_inline))
+		typename S::template register_t<T>
+		fma(const typename S::template register_t<T> a, const typename S::template register_t<T> b, const typename S::template register_t<T> c)
+		{
+			return _max<T, S>(c, _add<T, S>(a, b));
+		}
+	};
+
+	/**
+	 * \brief The (max, ×) semiring over non-negative values.
+	 */
+	struct max_times
+	{
+		template<typename T> static constexpr T zero() { return T(0); }
+		template<typename T> static constexpr T one() { return T(1); }
+		template<typename T> static constexpr T add(const T a, const T b) { return std::max(a, b); }
+		template<typename T> static constexpr T mul(const T a, const T b) { return a * b; }
+
+		template<typename T, typename S>
+		static inline __attribute__((always_inline))
+		typename S::template register_t<T>
+		fma(const typename S::template register_t<T> a, const typename S::template register_t<T> b, const typename S::template register_t<T> c)
+		{
+			return _max<T, S>(c, _mul<T, S>(a, b));
+		}
+	};
+
+	/**
+	 * \brief The Boolean (∨, ∧) semiring over {0, 1}, as (max, min).
+	 */
+	struct or_and
+	{
+		template<typename T> static constexpr T zero() { return T(0); }
+		template<typename T> static constexpr T one() { return T(1); }
+		template<typename T> static constexpr T add(const T a, const T b) { return std::max(a, b); }
+		template<typename T> static constexpr T mul(const T a, const T b) { return std::min(a, b); }
+
+		template<typename T, typename S>
+		static inline __attribute__((always_inline))
+		typename S::template register_t<T>
+		fma(const typename S::template register_t<T> a, const typename S::template register_t<T> b, const typename S::template register_t<T> c)
+		{
+			return _max<T, S>(c, _min<T, S>(a, b));
+		}
+	};
+
+	template<typename SR>
+	concept semiring = 
+		std::same_as<SR, plus_times> ||
+		std::same_as<SR, min_plus> ||
+		std::same_as<SR, max_plus> ||
+		std::same_as<SR, max_times> ||
+		std::same_as<SR, or_and>;
+
+} //namespace damm
+
+#endif //__SEMIRING_H__
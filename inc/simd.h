@@ -28,6 +28,10 @@
 
 #include <immintrin.h>
 #include <common.h>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
 
 namespace damm
 {
@@ -49,6 +53,11 @@ namespace damm
 		static consteval size_t elements() { return N / sizeof(T); } ///< the number of elements of type T that can occupy the register
 		template<typename T>
 		using register_t = std::conditional_t< \
+			std::is_integral_v<T>,
+			// integer:
+			std::conditional_t<N == 16, __m128i,
+			std::conditional_t<N == 32, __m256i, __m512i>>,
+			std::conditional_t< \
 			std::is_same_v<typename base<T>::type, float>,
 			// float:
 			std::conditional_t<N == 16, __m128,
@@ -56,15 +65,15 @@ namespace damm
 			// double:
 			std::conditional_t<N == 16, __m128d,
 			std::conditional_t<N == 32, __m256d, __m512d>>
-		>; ///< The variable type of the register
+		>>; ///< The variable type of the register
 		template<typename T>
 		static consteval size_t registers() ///< The number of registers available for the given architecture 
 		{
-			if constexpr (std::is_same_v<register_t<T>, __m128> || std::is_same_v<register_t<T>, __m128d>)
+			if constexpr (std::is_same_v<register_t<T>, __m128> || std::is_same_v<register_t<T>, __m128d> || std::is_same_v<register_t<T>, __m128i>)
 				return 16; // SSE
-			else if constexpr (std::is_same_v<register_t<T>, __m256> || std::is_same_v<register_t<T>, __m256d>)
+			else if constexpr (std::is_same_v<register_t<T>, __m256> || std::is_same_v<register_t<T>, __m256d> || std::is_same_v<register_t<T>, __m256i>)
 				return 16; // AVX
-			else if constexpr (std::is_same_v<register_t<T>, __m512> || std::is_same_v<register_t<T>, __m512d>)
+			else if constexpr (std::is_same_v<register_t<T>, __m512> || std::is_same_v<register_t<T>, __m512d> || std::is_same_v<register_t<T>, __m512i>)
 				return 32; // AVX-512
 			else
 				return 0; // Unknown
@@ -93,6 +102,12 @@ namespace damm
 
 	/* LOAD */
 	
+	// integer loads take the element pointer, the si intrinsics take a register pointer
+	inline __m128i _mm_load_epi(const void* p) { return _mm_load_si128(static_cast<const __m128i*>(p)); }
+	inline __m128i _mm_loadu_epi(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+	inline __m256i _mm256_load_epi(const void* p) { return _mm256_load_si256(static_cast<const __m256i*>(p)); }
+	inline __m256i _mm256_loadu_epi(const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+
 	template<typename T, typename S>
 	inline constexpr auto _load = nullptr;
 
@@ -126,6 +141,27 @@ namespace damm
 	template<> inline constexpr auto _load<std::complex<double>, AVX512> = _mm512_load_pd;
 	template<> inline constexpr auto _loadu<std::complex<double>, AVX512> = _mm512_loadu_pd;
 
+	template<> inline constexpr auto _load<int16_t, SSE> = _mm_load_epi;
+	template<> inline constexpr auto _loadu<int16_t, SSE> = _mm_loadu_epi;
+	template<> inline constexpr auto _load<int32_t, SSE> = _mm_load_epi;
+	template<> inline constexpr auto _loadu<int32_t, SSE> = _mm_loadu_epi;
+	template<> inline constexpr auto _load<int64_t, SSE> = _mm_load_epi;
+	template<> inline constexpr auto _loadu<int64_t, SSE> = _mm_loadu_epi;
+
+	template<> inline constexpr auto _load<int16_t, AVX> = _mm256_load_epi;
+	template<> inline constexpr auto _loadu<int16_t, AVX> = _mm256_loadu_epi;
+	template<> inline constexpr auto _load<int32_t, AVX> = _mm256_load_epi;
+	template<> inline constexpr auto _loadu<int32_t, AVX> = _mm256_loadu_epi;
+	template<> inline constexpr auto _load<int64_t, AVX> = _mm256_load_epi;
+	template<> inline constexpr auto _loadu<int64_t, AVX> = _mm256_loadu_epi;
+
+	template<> inline constexpr auto _load<int16_t, AVX512> = _mm512_load_si512;
+	template<> inline constexpr auto _loadu<int16_t, AVX512> = _mm512_loadu_si512;
+	template<> inline constexpr auto _load<int32_t, AVX512> = _mm512_load_si512;
+	template<> inline constexpr auto _loadu<int32_t, AVX512> = _mm512_loadu_si512;
+	template<> inline constexpr auto _load<int64_t, AVX512> = _mm512_load_si512;
+	template<> inline constexpr auto _loadu<int64_t, AVX512> = _mm512_loadu_si512;
+
 	template<typename T, typename S, template<typename, typename> class K> 
 	void load(T** ptr, typename S::template register_t<T>** registers, const size_t row_offset, const size_t col_offset)
 	{
@@ -159,6 +195,11 @@ namespace damm
 
 	/* STORE */
 
+	inline void _mm_store_epi(void* p, __m128i a) { _mm_store_si128(static_cast<__m128i*>(p), a); }
+	inline void _mm_storeu_epi(void* p, __m128i a) { _mm_storeu_si128(static_cast<__m128i*>(p), a); }
+	inline void _mm256_store_epi(void* p, __m256i a) { _mm256_store_si256(static_cast<__m256i*>(p), a); }
+	inline void _mm256_storeu_epi(void* p, __m256i a) { _mm256_storeu_si256(static_cast<__m256i*>(p), a); }
+
 	template<typename T, typename S>
 	inline constexpr auto _store = nullptr;
 
@@ -191,6 +232,27 @@ namespace damm
 	template<> inline constexpr auto _storeu<std::complex<float>, AVX512> = _mm512_storeu_ps;
 	template<> inline constexpr auto _store<std::complex<double>, AVX512> = _mm512_store_pd;
 	template<> inline constexpr auto _storeu<std::complex<double>, AVX512> = _mm512_storeu_pd;
+
+	template<> inline constexpr auto _store<int16_t, SSE> = _mm_store_epi;
+	template<> inline constexpr auto _storeu<int16_t, SSE> = _mm_storeu_epi;
+	template<> inline constexpr auto _store<int32_t, SSE> = _mm_store_epi;
+	template<> inline constexpr auto _storeu<int32_t, SSE> = _mm_storeu_epi;
+	template<> inline constexpr auto _store<int64_t, SSE> = _mm_store_epi;
+	template<> inline constexpr auto _storeu<int64_t, SSE> = _mm_storeu_epi;
+
+	template<> inline constexpr auto _store<int16_t, AVX> = _mm256_store_epi;
+	template<> inline constexpr auto _storeu<int16_t, AVX> = _mm256_storeu_epi;
+	template<> inline constexpr auto _store<int32_t, AVX> = _mm256_store_epi;
+	template<> inline constexpr auto _storeu<int32_t, AVX> = _mm256_storeu_epi;
+	template<> inline constexpr auto _store<int64_t, AVX> = _mm256_store_epi;
+	template<> inline constexpr auto _storeu<int64_t, AVX> = _mm256_storeu_epi;
+
+	template<> inline constexpr auto _store<int16_t, AVX512> = _mm512_store_si512;
+	template<> inline constexpr auto _storeu<int16_t, AVX512> = _mm512_storeu_si512;
+	template<> inline constexpr auto _store<int32_t, AVX512> = _mm512_store_si512;
+	template<> inline constexpr auto _storeu<int32_t, AVX512> = _mm512_storeu_si512;
+	template<> inline constexpr auto _store<int64_t, AVX512> = _mm512_store_si512;
+	template<> inline constexpr auto _storeu<int64_t, AVX512> = _mm512_storeu_si512;
 	
 	template<typename T, typename S, template<typename, typename> class K> 
 	void store(T** ptr, typename S::template register_t<T>** registers, const size_t row_offset, const size_t col_offset)
@@ -286,6 +348,18 @@ namespace damm
 	template<> inline constexpr auto _set1<std::complex<float>, AVX512> = _mm512_set1c_ps;
 	template<> inline constexpr auto _set1<std::complex<double>, AVX512> = _mm512_set1c_pd;
 
+	template<> inline constexpr auto _set1<int16_t, SSE> = _mm_set1_epi16;
+	template<> inline constexpr auto _set1<int32_t, SSE> = _mm_set1_epi32;
+	template<> inline constexpr auto _set1<int64_t, SSE> = _mm_set1_epi64x;
+
+	template<> inline constexpr auto _set1<int16_t, AVX> = _mm256_set1_epi16;
+	template<> inline constexpr auto _set1<int32_t, AVX> = _mm256_set1_epi32;
+	template<> inline constexpr auto _set1<int64_t, AVX> = _mm256_set1_epi64x;
+
+	template<> inline constexpr auto _set1<int16_t, AVX512> = _mm512_set1_epi16;
+	template<> inline constexpr auto _set1<int32_t, AVX512> = _mm512_set1_epi32;
+	template<> inline constexpr auto _set1<int64_t, AVX512> = _mm512_set1_epi64;
+
 	/* CAST */
 
 	template<typename T, typename S>
@@ -344,6 +418,18 @@ namespace damm
 	template<> inline constexpr auto _add<std::complex<float>, AVX512> = _mm512_add_ps;
 	template<> inline constexpr auto _add<std::complex<double>, AVX512> = _mm512_add_pd;
 
+	template<> inline constexpr auto _add<int16_t, SSE> = _mm_add_epi16;
+	template<> inline constexpr auto _add<int32_t, SSE> = _mm_add_epi32;
+	template<> inline constexpr auto _add<int64_t, SSE> = _mm_add_epi64;
+
+	template<> inline constexpr auto _add<int16_t, AVX> = _mm256_add_epi16;
+	template<> inline constexpr auto _add<int32_t, AVX> = _mm256_add_epi32;
+	template<> inline constexpr auto _add<int64_t, AVX> = _mm256_add_epi64;
+
+	template<> inline constexpr auto _add<int16_t, AVX512> = _mm512_add_epi16;
+	template<> inline constexpr auto _add<int32_t, AVX512> = _mm512_add_epi32;
+	template<> inline constexpr auto _add<int64_t, AVX512> = _mm512_add_epi64;
+
 	/* SUB */ 
 
 	template<typename T, typename S>
@@ -364,6 +450,18 @@ namespace damm
 	template<> inline constexpr auto _sub<std::complex<float>, AVX512> = _mm512_sub_ps;
 	template<> inline constexpr auto _sub<std::complex<double>, AVX512> = _mm512_sub_pd;
 
+	template<> inline constexpr auto _sub<int16_t, SSE> = _mm_sub_epi16;
+	template<> inline constexpr auto _sub<int32_t, SSE> = _mm_sub_epi32;
+	template<> inline constexpr auto _sub<int64_t, SSE> = _mm_sub_epi64;
+
+	template<> inline constexpr auto _sub<int16_t, AVX> = _mm256_sub_epi16;
+	template<> inline constexpr auto _sub<int32_t, AVX> = _mm256_sub_epi32;
+	template<> inline constexpr auto _sub<int64_t, AVX> = _mm256_sub_epi64;
+
+	template<> inline constexpr auto _sub<int16_t, AVX512> = _mm512_sub_epi16;
+	template<> inline constexpr auto _sub<int32_t, AVX512> = _mm512_sub_epi32;
+	template<> inline constexpr auto _sub<int64_t, AVX512> = _mm512_sub_epi64;
+
 	/* MULTIPLY */
 
 	inline __m128 
@@ -430,6 +528,27 @@ namespace damm
 		return _mm512_mask_blend_pd(0xAA, real, imag);
 	}
 
+	// low 64 bits of a 64-bit product: lo·lo + ((hi·lo + lo·hi) << 32)
+	inline __m128i 
+	_mm_mullo_epi64x(const __m128i& a, const __m128i& b)
+	{
+		const __m128i lo = _mm_mul_epu32(a, b);
+		const __m128i cross = _mm_add_epi64(
+			_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+			_mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+		return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+	}
+
+	inline __m256i 
+	_mm256_mullo_epi64x(const __m256i& a, const __m256i& b)
+	{
+		const __m256i lo = _mm256_mul_epu32(a, b);
+		const __m256i cross = _mm256_add_epi64(
+			_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+			_mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+		return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+	}
+
 	template<typename T, typename S>
 	inline constexpr auto _mul = nullptr;
 
@@ -448,6 +567,18 @@ namespace damm
 	template<> inline constexpr auto _mul<std::complex<float>, AVX512> = _mm512_mulc_ps;
 	template<> inline constexpr auto _mul<std::complex<double>, AVX512> = _mm512_mulc_pd;
 
+	template<> inline constexpr auto _mul<int16_t, SSE> = _mm_mullo_epi16;
+	template<> inline constexpr auto _mul<int32_t, SSE> = _mm_mullo_epi32;
+	template<> inline constexpr auto _mul<int64_t, SSE> = _mm_mullo_epi64x;
+
+	template<> inline constexpr auto _mul<int16_t, AVX> = _mm256_mullo_epi16;
+	template<> inline constexpr auto _mul<int32_t, AVX> = _mm256_mullo_epi32;
+	template<> inline constexpr auto _mul<int64_t, AVX> = _mm256_mullo_epi64x;
+
+	template<> inline constexpr auto _mul<int16_t, AVX512> = _mm512_mullo_epi16;
+	template<> inline constexpr auto _mul<int32_t, AVX512> = _mm512_mullo_epi32;
+	template<> inline constexpr auto _mul<int64_t, AVX512> = _mm512_mullox_epi64;
+
 
 	/* DIVIDE */
 
@@ -559,6 +690,13 @@ namespace damm
 	template<> inline constexpr auto _div<std::complex<float>, AVX512> = _mm512_divc_ps;
 	template<> inline constexpr auto _div<std::complex<double>, AVX512> = _mm512_divc_pd;
 
+	/**
+	 * \brief Whether operator O has a register form for T.
+	 * x86 has no packed integer divide, so integer division stays scalar.
+	 */
+	template<typename T, typename O>
+	inline constexpr bool has_simd_op_v = !(std::is_integral_v<T> && std::same_as<O, std::divides<>>);
+
 	/* REDUCE ADD (horizontal) */
 
 	inline float 
@@ -670,6 +808,20 @@ namespace damm
 	}
 
 
+	// integer lanes wrap on overflow, so fold them as unsigned, promoted past int
+	template<typename T, typename R>
+	inline T
+	_reduce_add_epi(const R& a)
+	{
+		using U = std::common_type_t<unsigned, std::make_unsigned_t<T>>;
+		std::make_unsigned_t<T> lanes[sizeof(R) / sizeof(T)];
+		std::memcpy(lanes, &a, sizeof(R));
+		U sum = 0;
+		for (const U x : lanes)
+			sum += x;
+		return static_cast<T>(sum);
+	}
+
 	template<typename T, typename S>
 	inline constexpr auto _reduce_add = nullptr;
 
@@ -688,6 +840,18 @@ namespace damm
 	template<> inline constexpr auto _reduce_add<std::complex<float>, AVX512> = _mm512_reduce_addc_ps;
 	template<> inline constexpr auto _reduce_add<std::complex<double>, AVX512> = _mm512_reduce_addc_pd;
 
+	template<> inline constexpr auto _reduce_add<int16_t, SSE> = _reduce_add_epi<int16_t, __m128i>;
+	template<> inline constexpr auto _reduce_add<int32_t, SSE> = _reduce_add_epi<int32_t, __m128i>;
+	template<> inline constexpr auto _reduce_add<int64_t, SSE> = _reduce_add_epi<int64_t, __m128i>;
+
+	template<> inline constexpr auto _reduce_add<int16_t, AVX> = _reduce_add_epi<int16_t, __m256i>;
+	template<> inline constexpr auto _reduce_add<int32_t, AVX> = _reduce_add_epi<int32_t, __m256i>;
+	template<> inline constexpr auto _reduce_add<int64_t, AVX> = _reduce_add_epi<int64_t, __m256i>;
+
+	template<> inline constexpr auto _reduce_add<int16_t, AVX512> = _reduce_add_epi<int16_t, __m512i>;
+	template<> inline constexpr auto _reduce_add<int32_t, AVX512> = _reduce_add_epi<int32_t, __m512i>;
+	template<> inline constexpr auto _reduce_add<int64_t, AVX512> = _reduce_add_epi<int64_t, __m512i>;
+
 	/* REDUCE MUL */
 
 	inline float 
@@ -803,6 +967,19 @@ namespace damm
 	}
 
 
+	template<typename T, typename R>
+	inline T
+	_reduce_mul_epi(const R& a)
+	{
+		using U = std::common_type_t<unsigned, std::make_unsigned_t<T>>;
+		std::make_unsigned_t<T> lanes[sizeof(R) / sizeof(T)];
+		std::memcpy(lanes, &a, sizeof(R));
+		U prod = 1;
+		for (const U x : lanes)
+			prod *= x;
+		return static_cast<T>(prod);
+	}
+
 	template<typename T, typename S>
 	inline constexpr auto _reduce_mul = nullptr;
 
@@ -821,6 +998,18 @@ namespace damm
 	template<> inline constexpr auto _reduce_mul<std::complex<float>, AVX512> = _mm512_reduce_mulc_ps;
 	template<> inline constexpr auto _reduce_mul<std::complex<double>, AVX512> = _mm512_reduce_mulc_pd;
 
+	template<> inline constexpr auto _reduce_mul<int16_t, SSE> = _reduce_mul_epi<int16_t, __m128i>;
+	template<> inline constexpr auto _reduce_mul<int32_t, SSE> = _reduce_mul_epi<int32_t, __m128i>;
+	template<> inline constexpr auto _reduce_mul<int64_t, SSE> = _reduce_mul_epi<int64_t, __m128i>;
+
+	template<> inline constexpr auto _reduce_mul<int16_t, AVX> = _reduce_mul_epi<int16_t, __m256i>;
+	template<> inline constexpr auto _reduce_mul<int32_t, AVX> = _reduce_mul_epi<int32_t, __m256i>;
+	template<> inline constexpr auto _reduce_mul<int64_t, AVX> = _reduce_mul_epi<int64_t, __m256i>;
+
+	template<> inline constexpr auto _reduce_mul<int16_t, AVX512> = _reduce_mul_epi<int16_t, __m512i>;
+	template<> inline constexpr auto _reduce_mul<int32_t, AVX512> = _reduce_mul_epi<int32_t, __m512i>;
+	template<> inline constexpr auto _reduce_mul<int64_t, AVX512> = _reduce_mul_epi<int64_t, __m512i>;
+
 
 
 	/* FMA */
@@ -861,6 +1050,14 @@ namespace damm
 		return _mm512_add_pd(_mm512_mulc_pd(a, b), c);
 	}
 
+	// integer fmadd = a·b + c, there is no fused integer form
+	template<typename T, typename S>
+	inline typename S::template register_t<T>
+	_fmadd_epi(const typename S::template register_t<T>& a, const typename S::template register_t<T>& b, const typename S::template register_t<T>& c)
+	{
+		return _add<T, S>(_mul<T, S>(a, b), c);
+	}
+
 	template<typename T, typename S>
 	inline constexpr auto _fmadd = nullptr;
 
@@ -879,6 +1076,18 @@ namespace damm
 	template<> inline constexpr auto _fmadd<std::complex<float>, AVX512> = _mm512_fmaddc_ps;
 	template<> inline constexpr auto _fmadd<std::complex<double>, AVX512> = _mm512_fmaddc_pd;
 
+	template<> inline constexpr auto _fmadd<int16_t, SSE> = _fmadd_epi<int16_t, SSE>;
+	template<> inline constexpr auto _fmadd<int32_t, SSE> = _fmadd_epi<int32_t, SSE>;
+	template<> inline constexpr auto _fmadd<int64_t, SSE> = _fmadd_epi<int64_t, SSE>;
+
+	template<> inline constexpr auto _fmadd<int16_t, AVX> = _fmadd_epi<int16_t, AVX>;
+	template<> inline constexpr auto _fmadd<int32_t, AVX> = _fmadd_epi<int32_t, AVX>;
+	template<> inline constexpr auto _fmadd<int64_t, AVX> = _fmadd_epi<int64_t, AVX>;
+
+	template<> inline constexpr auto _fmadd<int16_t, AVX512> = _fmadd_epi<int16_t, AVX512>;
+	template<> inline constexpr auto _fmadd<int32_t, AVX512> = _fmadd_epi<int32_t, AVX512>;
+	template<> inline constexpr auto _fmadd<int64_t, AVX512> = _fmadd_epi<int64_t, AVX512>;
+
 
 	/* FMS - Fused Multiply-Subtract*/
 
@@ -919,6 +1128,14 @@ namespace damm
 	}
 
 
+	// integer fmsub = a·b − c, there is no fused integer form
+	template<typename T, typename S>
+	inline typename S::template register_t<T>
+	_fmsub_epi(const typename S::template register_t<T>& a, const typename S::template register_t<T>& b, const typename S::template register_t<T>& c)
+	{
+		return _sub<T, S>(_mul<T, S>(a, b), c);
+	}
+
 	template<typename T, typename S>
 	inline constexpr auto _fmsub = nullptr;
 
@@ -937,6 +1154,18 @@ namespace damm
 	template<> inline constexpr auto _fmsub<std::complex<float>, AVX512> = _mm512_fmsubc_ps;
 	template<> inline constexpr auto _fmsub<std::complex<double>, AVX512> = _mm512_fmsubc_pd;
 
+	template<> inline constexpr auto _fmsub<int16_t, SSE> = _fmsub_epi<int16_t, SSE>;
+	template<> inline constexpr auto _fmsub<int32_t, SSE> = _fmsub_epi<int32_t, SSE>;
+	template<> inline constexpr auto _fmsub<int64_t, SSE> = _fmsub_epi<int64_t, SSE>;
+
+	template<> inline constexpr auto _fmsub<int16_t, AVX> = _fmsub_epi<int16_t, AVX>;
+	template<> inline constexpr auto _fmsub<int32_t, AVX> = _fmsub_epi<int32_t, AVX>;
+	template<> inline constexpr auto _fmsub<int64_t, AVX> = _fmsub_epi<int64_t, AVX>;
+
+	template<> inline constexpr auto _fmsub<int16_t, AVX512> = _fmsub_epi<int16_t, AVX512>;
+	template<> inline constexpr auto _fmsub<int32_t, AVX512> = _fmsub_epi<int32_t, AVX512>;
+	template<> inline constexpr auto _fmsub<int64_t, AVX512> = _fmsub_epi<int64_t, AVX512>;
+
 
 	/* FMADDSUB */
 
@@ -1005,6 +1234,14 @@ namespace damm
 			return _mm512_sub_pd(c, _mm512_mulc_pd(a, b));
 	}
 
+	// integer fnmadd = c − a·b, there is no fused integer form
+	template<typename T, typename S>
+	inline typename S::template register_t<T>
+	_fnmadd_epi(const typename S::template register_t<T>& a, const typename S::template register_t<T>& b, const typename S::template register_t<T>& c)
+	{
+		return _sub<T, S>(c, _mul<T, S>(a, b));
+	}
+
 	template<typename T, typename S>
 	inline constexpr auto _fnmadd = nullptr;
 
@@ -1023,6 +1260,18 @@ namespace damm
 	template<> inline constexpr auto _fnmadd<std::complex<float>, AVX512> = _mm512_fnmaddc_ps;
 	template<> inline constexpr auto _fnmadd<std::complex<double>, AVX512> = _mm512_fnmaddc_pd;
 
+	template<> inline constexpr auto _fnmadd<int16_t, SSE> = _fnmadd_epi<int16_t, SSE>;
+	template<> inline constexpr auto _fnmadd<int32_t, SSE> = _fnmadd_epi<int32_t, SSE>;
+	template<> inline constexpr auto _fnmadd<int64_t, SSE> = _fnmadd_epi<int64_t, SSE>;
+
+	template<> inline constexpr auto _fnmadd<int16_t, AVX> = _fnmadd_epi<int16_t, AVX>;
+	template<> inline constexpr auto _fnmadd<int32_t, AVX> = _fnmadd_epi<int32_t, AVX>;
+	template<> inline constexpr auto _fnmadd<int64_t, AVX> = _fnmadd_epi<int64_t, AVX>;
+
+	template<> inline constexpr auto _fnmadd<int16_t, AVX512> = _fnmadd_epi<int16_t, AVX512>;
+	template<> inline constexpr auto _fnmadd<int32_t, AVX512> = _fnmadd_epi<int32_t, AVX512>;
+	template<> inline constexpr auto _fnmadd<int64_t, AVX512> = _fnmadd_epi<int64_t, AVX512>;
+
 	/* FNMSUB - Fused Negated Multiply-Subtract: -(a*b) - c = -(a*b + c) */
 
 	template<typename T, typename S>
@@ -1139,6 +1388,248 @@ namespace damm
 	template<> inline constexpr auto _xor<float, AVX512> = _mm512_xor_ps;
 	template<> inline constexpr auto _xor<double, AVX512> = _mm512_xor_pd;
 
+/* MIN / MAX */
+
+	template<typename T, typename S>
+	inline constexpr auto _min = nullptr;
+
+	template<> inline constexpr auto _min<float, SSE> = _mm_min_ps;
+	template<> inline constexpr auto _min<double, SSE> = _mm_min_pd;
+
+	template<> inline constexpr auto _min<float, AVX> = _mm256_min_ps;
+	template<> inline constexpr auto _min<double, AVX> = _mm256_min_pd;
+
+	template<> inline constexpr auto _min<float, AVX512> = _mm512_min_ps;
+	template<> inline constexpr auto _min<double, AVX512> = _mm512_min_pd;
+
+	template<typename T, typename S>
+	inline constexpr auto _max = nullptr;
+
+	template<> inline constexpr auto _max<float, SSE> = _mm_max_ps;
+	template<> inline constexpr auto _max<double, SSE> = _mm_max_pd;
+
+	template<> inline constexpr auto _max<float, AVX> = _mm256_max_ps;
+	template<> inline constexpr auto _max<double, AVX> = _mm256_max_pd;
+
+	template<> inline constexpr auto _max<float, AVX512> = _mm512_max_ps;
+	template<> inline constexpr auto _max<double, AVX512> = _mm512_max_pd;
+
+/* SQRT */
+
+	template<typename T, typename S>
+	inline constexpr auto _sqrt = nullptr;
+
+	template<> inline constexpr auto _sqrt<float, SSE> = _mm_sqrt_ps;
+	template<> inline constexpr auto _sqrt<double, SSE> = _mm_sqrt_pd;
+
+	template<> inline constexpr auto _sqrt<float, AVX> = _mm256_sqrt_ps;
+	template<> inline constexpr auto _sqrt<double, AVX> = _mm256_sqrt_pd;
+
+	template<> inline constexpr auto _sqrt<float, AVX512> = _mm512_sqrt_ps;
+	template<> inline constexpr auto _sqrt<double, AVX512> = _mm512_sqrt_pd;
+
+/* ROUND */
+
+	inline __m128 _mm_round_nearest_ps(__m128 a) { return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+	inline __m128d _mm_round_nearest_pd(__m128d a) { return _mm_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+	inline __m256 _mm256_round_nearest_ps(__m256 a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+	inline __m256d _mm256_round_nearest_pd(__m256d a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+	inline __m512 _mm512_round_nearest_ps(__m512 a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+	inline __m512d _mm512_round_nearest_pd(__m512d a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+	template<typename T, typename S>
+	inline constexpr auto _round = nullptr;
+
+	template<> inline constexpr auto _round<float, SSE> = _mm_round_nearest_ps;
+	template<> inline constexpr auto _round<double, SSE> = _mm_round_nearest_pd;
+
+	template<> inline constexpr auto _round<float, AVX> = _mm256_round_nearest_ps;
+	template<> inline constexpr auto _round<double, AVX> = _mm256_round_nearest_pd;
+
+	template<> inline constexpr auto _round<float, AVX512> = _mm512_round_nearest_ps;
+	template<> inline constexpr auto _round<double, AVX512> = _mm512_round_nearest_pd;
+
+/* ABS */
+
+	inline __m128 _mm_abs_ps(__m128 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+	inline __m128d _mm_abs_pd(__m128d a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+	inline __m256 _mm256_abs_ps(__m256 a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+	inline __m256d _mm256_abs_pd(__m256d a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+
+	template<typename T, typename S>
+	inline constexpr auto _abs = nullptr;
+
+	template<> inline constexpr auto _abs<float, SSE> = _mm_abs_ps;
+	template<> inline constexpr auto _abs<double, SSE> = _mm_abs_pd;
+
+	template<> inline constexpr auto _abs<float, AVX> = _mm256_abs_ps;
+	template<> inline constexpr auto _abs<double, AVX> = _mm256_abs_pd;
+
+	template<> inline constexpr auto _abs<float, AVX512> = _mm512_abs_ps;
+	template<> inline constexpr auto _abs<double, AVX512> = _mm512_abs_pd;
+
+/* COMPARE-SELECT */
+
+	/**
+	 * \brief Lane-wise select: r[i] = (a[i] P b[i]) ? x[i] : y[i]
+	 *
+	 * P is one of the _CMP_* predicates (e.g. _CMP_GT_OQ). The select hides the
+	 * difference between the vector masks of SSE/AVX and the k-masks of AVX-512.
+	 */
+	template<int P> inline __m128 _mm_select_ps(__m128 a, __m128 b, __m128 x, __m128 y) { return _mm_blendv_ps(y, x, _mm_cmp_ps(a, b, P)); }
+	template<int P> inline __m128d _mm_select_pd(__m128d a, __m128d b, __m128d x, __m128d y) { return _mm_blendv_pd(y, x, _mm_cmp_pd(a, b, P)); }
+	template<int P> inline __m256 _mm256_select_ps(__m256 a, __m256 b, __m256 x, __m256 y) { return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, P)); }
+	template<int P> inline __m256d _mm256_select_pd(__m256d a, __m256d b, __m256d x, __m256d y) { return _mm256_blendv_pd(y, x, _mm256_cmp_pd(a, b, P)); }
+	template<int P> inline __m512 _mm512_select_ps(__m512 a, __m512 b, __m512 x, __m512 y) { return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, P), y, x); }
+	template<int P> inline __m512d _mm512_select_pd(__m512d a, __m512d b, __m512d x, __m512d y) { return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, P), y, x); }
+
+	template<typename T, typename S, int P>
+	inline constexpr auto _select = nullptr;
+
+	template<int P> inline constexpr auto _select<float, SSE, P> = _mm_select_ps<P>;
+	template<int P> inline constexpr auto _select<double, SSE, P> = _mm_select_pd<P>;
+
+	template<int P> inline constexpr auto _select<float, AVX, P> = _mm256_select_ps<P>;
+	template<int P> inline constexpr auto _select<double, AVX, P> = _mm256_select_pd<P>;
+
+	template<int P> inline constexpr auto _select<float, AVX512, P> = _mm512_select_ps<P>;
+	template<int P> inline constexpr auto _select<double, AVX512, P> = _mm512_select_pd<P>;
+
+/* EXPONENT / MANTISSA */
+
+	/**
+	 * \brief Split x = m·2^e into e and m ∈ [1, 2), for positive normal x.
+	 *
+	 * AVX-512 provides getexp/getmant natively. SSE and AVX extract the
+	 * IEEE-754 fields with integer shifts and masks; the double exponent is
+	 * converted with the 2^52 magic-number trick since there is no 64-bit
+	 * integer conversion below AVX-512DQ.
+	 */
+	inline __m128 _mm_exponent_ps(__m128 a) 
+	{ 
+		return _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(a), 23), _mm_set1_epi32(127))); 
+	}
+
+	inline __m128d _mm_exponent_pd(__m128d a) 
+	{ 
+		const __m128i e = _mm_or_si128(_mm_srli_epi64(_mm_castpd_si128(a), 52), _mm_set1_epi64x(0x4330000000000000));
+		return _mm_sub_pd(_mm_castsi128_pd(e), _mm_set1_pd(4503599627370496.0 + 1023.0)); 
+	}
+
+	inline __m256 _mm256_exponent_ps(__m256 a) 
+	{ 
+		return _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(a), 23), _mm256_set1_epi32(127))); 
+	}
+
+	inline __m256d _mm256_exponent_pd(__m256d a) 
+	{ 
+		const __m256i e = _mm256_or_si256(_mm256_srli_epi64(_mm256_castpd_si256(a), 52), _mm256_set1_epi64x(0x4330000000000000));
+		return _mm256_sub_pd(_mm256_castsi256_pd(e), _mm256_set1_pd(4503599627370496.0 + 1023.0)); 
+	}
+
+	inline __m128 _mm_mantissa_ps(__m128 a) 
+	{ 
+		return _mm_or_ps(_mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x007FFFFF))), _mm_set1_ps(1.0f)); 
+	}
+
+	inline __m128d _mm_mantissa_pd(__m128d a) 
+	{ 
+		return _mm_or_pd(_mm_and_pd(a, _mm_castsi128_pd(_mm_set1_epi64x(0x000FFFFFFFFFFFFF))), _mm_set1_pd(1.0)); 
+	}
+
+	inline __m256 _mm256_mantissa_ps(__m256 a) 
+	{ 
+		return _mm256_or_ps(_mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x007FFFFF))), _mm256_set1_ps(1.0f)); 
+	}
+
+	inline __m256d _mm256_mantissa_pd(__m256d a) 
+	{ 
+		return _mm256_or_pd(_mm256_and_pd(a, _mm256_castsi256_pd(_mm256_set1_epi64x(0x000FFFFFFFFFFFFF))), _mm256_set1_pd(1.0)); 
+	}
+
+	inline __m512 _mm512_mantissa_ps(__m512 a) { return _mm512_getmant_ps(a, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero); }
+	inline __m512d _mm512_mantissa_pd(__m512d a) { return _mm512_getmant_pd(a, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero); }
+
+	template<typename T, typename S>
+	inline constexpr auto _exponent = nullptr;
+
+	template<> inline constexpr auto _exponent<float, SSE> = _mm_exponent_ps;
+	template<> inline constexpr auto _exponent<double, SSE> = _mm_exponent_pd;
+
+	template<> inline constexpr auto _exponent<float, AVX> = _mm256_exponent_ps;
+	template<> inline constexpr auto _exponent<double, AVX> = _mm256_exponent_pd;
+
+	template<> inline constexpr auto _exponent<float, AVX512> = _mm512_getexp_ps;
+	template<> inline constexpr auto _exponent<double, AVX512> = _mm512_getexp_pd;
+
+	template<typename T, typename S>
+	inline constexpr auto _mantissa = nullptr;
+
+	template<> inline constexpr auto _mantissa<float, SSE> = _mm_mantissa_ps;
+	template<> inline constexpr auto _mantissa<double, SSE> = _mm_mantissa_pd;
+
+	template<> inline constexpr auto _mantissa<float, AVX> = _mm256_mantissa_ps;
+	template<> inline constexpr auto _mantissa<double, AVX> = _mm256_mantissa_pd;
+
+	template<> inline constexpr auto _mantissa<float, AVX512> = _mm512_mantissa_ps;
+	template<> inline constexpr auto _mantissa<double, AVX512> = _mm512_mantissa_pd;
+
+/* LOG */
+
+	/**
+	 * \brief Lane-wise natural logarithm for positive inputs.
+	 *
+	 * x = m·2^e is folded so that m ∈ [√½, √2), then log m = 2·atanh(f) with
+	 * f = (m - 1)/(m + 1) is evaluated as the odd series 2·Σ f^(2k+1)/(2k+1).
+	 * Since |f| < 0.172, 5 terms reach float precision and 11 terms double precision.
+	 * The SSE and AVX exponent and mantissa are read from the bit pattern, so
+	 * subnormal x is first scaled by 2^digits and the exponent corrected after.
+	 */
+	template<typename T, typename S>
+	requires (std::is_floating_point_v<T>)
+	inline __attribute__((always_inline))
+	typename S::template register_t<T>
+	_log(const typename S::template register_t<T> x)
+	{
+		using register_t = typename S::template register_t<T>;
+		constexpr size_t terms = std::is_same_v<T, float> ? 5 : 11;
+
+		const register_t one = _set1<T, S>(T(1));
+		const register_t sqrt2 = _set1<T, S>(T(1.41421356237309504880));
+
+		register_t e, m;
+		if constexpr (std::is_same_v<S, AVX512>)
+		{
+			// getexp and getmant normalize subnormals themselves
+			e = _exponent<T, S>(x);
+			m = _mantissa<T, S>(x);
+		}
+		else
+		{
+			constexpr int K = std::numeric_limits<T>::digits;
+			const register_t tiny = _set1<T, S>(std::numeric_limits<T>::min());
+			const register_t zero = _set1<T, S>(T(0));
+			const register_t xs = _select<T, S, _CMP_LT_OQ>(x, tiny, _mul<T, S>(x, _set1<T, S>(T(uint64_t(1) << K))), x);
+			e = _sub<T, S>(_exponent<T, S>(xs), _select<T, S, _CMP_LT_OQ>(x, tiny, _set1<T, S>(T(K)), zero));
+			m = _mantissa<T, S>(xs);
+		}
+
+		e = _select<T, S, _CMP_GT_OQ>(m, sqrt2, _add<T, S>(e, one), e);
+		m = _select<T, S, _CMP_GT_OQ>(m, sqrt2, _mul<T, S>(m, _set1<T, S>(T(0.5))), m);
+
+		const register_t f = _div<T, S>(_sub<T, S>(m, one), _add<T, S>(m, one));
+		const register_t f2 = _mul<T, S>(f, f);
+
+		register_t p = _set1<T, S>(T(1) / T(2 * terms - 1));
+		static_for<terms - 1>([&]<auto k>()
+		{
+			p = _fmadd<T, S>(p, f2, _set1<T, S>(T(1) / T(2 * (terms - 2 - k) + 1)));
+		});
+
+		const register_t log_m = _mul<T, S>(_add<T, S>(f, f), p);
+		return _fmadd<T, S>(e, _set1<T, S>(T(0.69314718055994530942)), log_m);
+	}
+
 /* ETC */
 
 	/**
@@ -28,7 +28,7 @@
 
 #include <common.h>
 #include <damm_memory.h>
-#include <fused_reduce.h>
+#include <blas.h>
 
 namespace damm
 {
@@ -58,18 +58,8 @@ namespace damm
 		{
 			for (size_t i = 0; i < N; ++i)
 			{
-				T sum = T(0);
-				
-				if (i > 0)
-				{
-					// Need to compute dot product: L[i][0:i] · y[0:i]
-					// Wrap L[i] and y as T** (1D views)
-					auto L_row = view_as_2D(&L[i][0], 1, i);
-					auto y_vec = view_as_2D(const_cast<T*>(y), 1, i);
-					
-					sum = fused_reduce<T, std::multiplies<>, std::plus<>, S>(
-						L_row.get(), y_vec.get(), T(0), 1, i);
-				}
+				// L[i][0:i] · y[0:i]
+				const T sum = blas::_dot<T, S>(L[i], y, i);
 				
 				y[i] = unit_diag ? (b[i] - sum)
 								 : (b[i] - sum) / L[i][i];
@@ -94,19 +84,8 @@ namespace damm
 		{
 			for (size_t i = N; i-- > 0; )
 			{
-				size_t len = N - i - 1;
-				T sum = T(0);
-				
-				if (len > 0)
-				{
-					// Need to compute dot product: U[i][i+1:N] · x[i+1:N]
-					// Wrap &U[i][i+1] and &x[i+1] as T** (1D views)
-					auto U_row = view_as_2D(&U[i][i + 1], 1, len);
-					auto x_vec = view_as_2D(&x[i + 1], 1, len);
-					
-					sum = fused_reduce<T, std::multiplies<>, std::plus<>, S>(
-						U_row.get(), x_vec.get(), T(0), 1, len);
-				}
+				// U[i][i+1:N] · x[i+1:N]
+				const T sum = blas::_dot<T, S>(&U[i][i + 1], &x[i + 1], N - i - 1);
 				
 				x[i] = unit_diag ? (y[i] - sum)
 								 : (y[i] - sum) / U[i][i];
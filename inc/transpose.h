@@ -35,14 +35,21 @@
 namespace damm
 {
 	/** \brief kernal for transpose_block. Low level function not intended for the public API*/
-	template <typename T>
+	template <typename T, bool Conjugate = false, bool Fused = false>
 	inline __attribute__((always_inline))
 	void
-	_transpose_block(T** A, T** B, const size_t I, const size_t J, const size_t M, const size_t N)
+	_transpose_block(T** A, T** B, const size_t I, const size_t J, const size_t M, const size_t N, 
+		const T alpha = T(1), const T beta = T(0))
 	{
 		for(size_t i=0; i < M; i++) 
 			for(size_t j=0; j < N; j++) 
-				 B[J + j][I + i] = A[I + i][J + j];
+			{
+				const T a = Conjugate ? conjugate(A[I + i][J + j]) : A[I + i][J + j];
+				if constexpr (Fused)
+					B[J + j][I + i] = (beta == T(0)) ? alpha * a : alpha * a + beta * B[J + j][I + i];
+				else
+					B[J + j][I + i] = a;
+			}
 	}
 	
 	/**
@@ -66,10 +73,10 @@ namespace damm
 	 * \note The transpose supports asymmetric matrices (M != N) and dimensions
 	 *       that are not multiples of the block size.
 	 */
-	template <typename T, template<typename, typename> class K>
+	template <typename T, template<typename, typename> class K, bool Conjugate = false, bool Fused = false>
 	inline __attribute__((always_inline))
 	void
-	_transpose(T** A, T** B, const size_t M, const size_t N)
+	_transpose(T** A, T** B, const size_t M, const size_t N, const T alpha = T(1), const T beta = T(0))
 	{
 		using kernel = K<T, NONE>;
 		using blocking = typename kernel::blocking;
@@ -90,7 +97,7 @@ namespace damm
 				{
 					size_t m = std::min(l2_block, M - i);
 					size_t n = std::min(l1_block, std::min(l3_block, N - j) - k);
-					_transpose_block(A, B, i, j + k, m, n);
+					_transpose_block<T, Conjugate, Fused>(A, B, i, j + k, m, n, alpha, beta);
 				}
 			}
 		}
@@ -441,13 +448,16 @@ namespace damm
 	 * \note Using strides not aligned to SIMD register sizes may cause unaligned memory
 	 *       accesses, potentially incurring performance penalties.
 	 */
-	template<typename T, typename S, template<typename, typename> class K>
+	template<typename T, typename S, template<typename, typename> class K, 
+		bool Conjugate = false, bool Fused = false>
 	inline __attribute__((always_inline))
 	void
-	_transpose_block_simd(T** A, T** B, const size_t row, const size_t col)
+	_transpose_block_simd(T** A, T** B, const size_t row, const size_t col, 
+		const T alpha = T(1), const T beta = T(0))
 	{
 		using kernel = K<T, S>;
 		using register_t = typename S::template register_t<T>;
+		using real_t = typename base<T>::type;
 		constexpr size_t rows = kernel::row_registers;
 		constexpr size_t cols = kernel::col_registers;
 		
@@ -460,6 +470,53 @@ namespace damm
 		
 		load<T, S, K>(A, reg_ptrs, row, col);
 		transpose<T, S, K>(reg_ptrs);
+
+		// Epilogue on the transposed registers: conjugate, scale by alpha, accumulate beta * B
+		if constexpr (Conjugate && is_complex_v<T>)
+		{
+			const register_t sign = alternating_sign_mask_even<real_t, S>();
+			static_for<rows>([&]<auto i>()
+			{
+				static_for<cols>([&]<auto j>()
+				{
+					reg_ptrs[i][j] = _mul<real_t, S>(reg_ptrs[i][j], sign);
+				});
+			});
+		}
+
+		if constexpr (Fused)
+		{
+			const register_t a = _set1<T, S>(alpha);
+			static_for<rows>([&]<auto i>()
+			{
+				static_for<cols>([&]<auto j>()
+				{
+					reg_ptrs[i][j] = _mul<T, S>(reg_ptrs[i][j], a);
+				});
+			});
+
+			// beta = 0 does not read B, so B may be uninitialized
+			if (beta != T(0))
+			{
+				alignas(S::bytes) register_t b_registers[rows][cols];
+				register_t* b_ptrs[rows];
+
+				for (size_t i = 0; i < rows; ++i)
+					b_ptrs[i] = b_registers[i];
+
+				load<T, S, K>(B, b_ptrs, col, row);
+				
+				const register_t b = _set1<T, S>(beta);
+				static_for<rows>([&]<auto i>()
+				{
+					static_for<cols>([&]<auto j>()
+					{
+						reg_ptrs[i][j] = _add<T, S>(reg_ptrs[i][j], _mul<T, S>(b_ptrs[i][j], b));
+					});
+				});
+			}
+		}
+
 		store<T, S, K>(B, reg_ptrs, col, row);
 	}
 
@@ -488,10 +545,11 @@ namespace damm
 	 * \note Using strides not aligned to SIMD register sizes may cause unaligned memory
 	 *       accesses, potentially incurring performance penalties.
 	 */
-	template<typename T, typename S, template<typename, typename> class K> 
+	template<typename T, typename S, template<typename, typename> class K, 
+		bool Conjugate = false, bool Fused = false> 
 	inline __attribute__((always_inline))
 	void
-	_transpose_simd(T** A, T** B, const size_t M, const size_t N)
+	_transpose_simd(T** A, T** B, const size_t M, const size_t N, const T alpha = T(1), const T beta = T(0))
 	{
 		using kernel = K<T, S>;
 		using blocking = typename kernel::blocking;
@@ -534,7 +592,7 @@ namespace damm
 						{
 							for (size_t j = j_l1; j < j_l1_end; j += tile_cols)
 							{
-								_transpose_block_simd<T, S, K>(A, B, i, j);
+								_transpose_block_simd<T, S, K, Conjugate, Fused>(A, B, i, j, alpha, beta);
 							}
 						}
 					}
@@ -549,19 +607,117 @@ namespace damm
 		// Region A: Bottom strip (remaining rows, SIMD-processed columns)
 		if (rem_rows != 0 && simd_N > 0)
 		{
-			_transpose_block(A, B, simd_M, 0, rem_rows, simd_N);
+			_transpose_block<T, Conjugate, Fused>(A, B, simd_M, 0, rem_rows, simd_N, alpha, beta);
 		}
 		
 		// Region B: Right strip (SIMD-processed rows, remaining columns)
 		if (rem_cols != 0 && simd_M > 0)
 		{
-			_transpose_block(A, B, 0, simd_N, simd_M, rem_cols);
+			_transpose_block<T, Conjugate, Fused>(A, B, 0, simd_N, simd_M, rem_cols, alpha, beta);
 		}
 		
 		// Region C: Corner (remaining rows and columns)
 		if (rem_rows != 0 && rem_cols != 0)
 		{
-			_transpose_block(A, B, simd_M, simd_N, rem_rows, rem_cols);
+			_transpose_block<T, Conjugate, Fused>(A, B, simd_M, simd_N, rem_rows, rem_cols, alpha, beta);
+		}
+	}
+
+	/**
+	 * \brief Leaf of the cache-oblivious transpose: the register tiles of the
+	 * block [i0, i1) × [j0, j1) of A, with scalar edges.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S, template<typename, typename> class K, 
+		bool Conjugate = false, bool Fused = false>
+	inline __attribute__((always_inline))
+	void
+	_transpose_leaf(T** A, T** B, const size_t i0, const size_t i1, const size_t j0, const size_t j1,
+		const T alpha, const T beta)
+	{
+		if constexpr (std::is_same_v<S, NONE>)
+		{
+			_transpose_block<T, Conjugate, Fused>(A, B, i0, j0, i1 - i0, j1 - j0, alpha, beta);
+		}
+		else
+		{
+			using kernel = K<T, S>;
+			constexpr size_t tile_rows = kernel::kernel_rows();
+			constexpr size_t tile_cols = kernel::kernel_cols();
+
+			const size_t simd_i1 = i0 + (i1 - i0) - (i1 - i0) % tile_rows;
+			const size_t simd_j1 = j0 + (j1 - j0) - (j1 - j0) % tile_cols;
+
+			for (size_t i = i0; i < simd_i1; i += tile_rows)
+				for (size_t j = j0; j < simd_j1; j += tile_cols)
+					_transpose_block_simd<T, S, K, Conjugate, Fused>(A, B, i, j, alpha, beta);
+
+			if (simd_i1 != i1)
+				_transpose_block<T, Conjugate, Fused>(A, B, simd_i1, j0, i1 - simd_i1, j1 - j0, alpha, beta);
+			if (simd_j1 != j1)
+				_transpose_block<T, Conjugate, Fused>(A, B, i0, simd_j1, simd_i1 - i0, j1 - simd_j1, alpha, beta);
+		}
+	}
+
+	/**
+	 * \brief Recursive step of the cache-oblivious transpose.
+	 *
+	 * Bisects the larger side of the block [i0, i1) × [j0, j1), keeping the split
+	 * on a register tile boundary, until the block fits in a leaf of a few register
+	 * tiles per side. Blocks of at least task_grain elements run their halves as
+	 * OpenMP tasks; the halves write disjoint parts of B.
+	 * Low level function not intended for the public API.
+	 */
+	template<typename T, typename S, template<typename, typename> class K, 
+		bool Conjugate = false, bool Fused = false>
+	void
+	_transpose_recursive(T** A, T** B, const size_t i0, const size_t i1, const size_t j0, const size_t j1,
+		const T alpha, const T beta)
+	{
+		using kernel = K<T, S>;
+		constexpr size_t tile_rows = std::is_same_v<S, NONE> ? 1 : kernel::kernel_rows();
+		constexpr size_t tile_cols = std::is_same_v<S, NONE> ? 1 : kernel::kernel_cols();
+		constexpr size_t leaf_rows = std::max<size_t>(4 * tile_rows, 16);
+		constexpr size_t leaf_cols = std::max<size_t>(4 * tile_cols, 16);
+		constexpr size_t task_grain = size_t(1) << 16;
+
+		const size_t m = i1 - i0;
+		const size_t n = j1 - j0;
+
+		if (m <= leaf_rows && n <= leaf_cols)
+		{
+			_transpose_leaf<T, S, K, Conjugate, Fused>(A, B, i0, i1, j0, j1, alpha, beta);
+			return;
+		}
+
+		// Split the larger side; a side at or below its leaf size is never split
+		const bool split_rows = (n <= leaf_cols) || (m > leaf_rows && m >= n);
+		const size_t tile = split_rows ? tile_rows : tile_cols;
+		const size_t half = std::max(((split_rows ? m : n) / 2) / tile * tile, tile);
+
+		const size_t i_mid = split_rows ? i0 + half : i1;
+		const size_t j_mid = split_rows ? j1 : j0 + half;
+
+		if (m * n >= task_grain)
+		{
+			#pragma omp task default(shared) firstprivate(i0, i_mid, j0, j_mid)
+			_transpose_recursive<T, S, K, Conjugate, Fused>(A, B, i0, i_mid, j0, j_mid, alpha, beta);
+			
+			if (split_rows)
+				_transpose_recursive<T, S, K, Conjugate, Fused>(A, B, i_mid, i1, j0, j1, alpha, beta);
+			else
+				_transpose_recursive<T, S, K, Conjugate, Fused>(A, B, i0, i1, j_mid, j1, alpha, beta);
+
+			#pragma omp taskwait
+		}
+		else
+		{
+			_transpose_recursive<T, S, K, Conjugate, Fused>(A, B, i0, i_mid, j0, j_mid, alpha, beta);
+			
+			if (split_rows)
+				_transpose_recursive<T, S, K, Conjugate, Fused>(A, B, i_mid, i1, j0, j1, alpha, beta);
+			else
+				_transpose_recursive<T, S, K, Conjugate, Fused>(A, B, i0, i1, j_mid, j1, alpha, beta);
 		}
 	}
 
@@ -608,5 +764,170 @@ namespace damm
 			_transpose_simd<T, S, K>(A, B, M, N);
 	}
 
+	/**
+	 * \brief Scaled and accumulating transpose, B = alpha * Aᵀ + beta * B.
+	 *
+	 * The scale and the accumulation are applied to the transposed registers before
+	 * the store, so the result costs a single pass over A and B. With beta = 0 the
+	 * prior contents of B are not read. The symmetric part (A + Aᵀ)/2 of a square
+	 * A takes two passes: copy A into B, then transpose(A, B, N, N, 0.5, 0.5)
+	 * adds the scaled transposed tiles of A to B without a separate addition.
+	 *
+	 * \tparam T			Element type of the matrices (e.g., float, double).
+	 * \tparam S			SIMD instruction set to use (SSE, AVX, AVX512, or NONE).
+	 * \tparam K			Kernel policy defining tile size (default: transpose_kernel from simd.h).
+	 *
+	 * \param A		Source matrix of dimensions M×N in row-major layout.
+	 * \param B		Destination matrix of dimensions N×M in row-major layout.
+	 * \param M		Number of rows in matrix A (becomes number of columns in B).
+	 * \param N		Number of columns in matrix A (becomes number of rows in B).
+	 * \param alpha	Scale applied to Aᵀ.
+	 * \param beta	Scale applied to the prior contents of B.
+	 *
+	 * \note A and B must not alias.
+	 *
+	 * \throws std::runtime_error if memory layout validation fails.
+	 */
+	template<typename T,  typename S = decltype(detect_simd()), 
+		template<typename, typename> class K = transpose_kernel>
+	inline 
+	void transpose(T** A, T** B, const size_t M, const size_t N, const T alpha, const T beta)
+	{
+		right<T>("transpose:", std::make_tuple(A, M, N), std::make_tuple(B, N, M));
+		
+		if constexpr (std::is_same_v<S, NONE>)
+			_transpose<T, K, false, true>(A, B, M, N, alpha, beta);
+		else
+			_transpose_simd<T, S, K, false, true>(A, B, M, N, alpha, beta);
+	}
+
+	/**
+	 * \brief Conjugate (Hermitian) transpose, B = Aᴴ.
+	 *
+	 * The imaginary lanes of the transposed registers are negated with
+	 * alternating_sign_mask_even before the store, so no separate conjugation
+	 * pass is made. For real T this is identical to transpose.
+	 *
+	 * \tparam T			Element type of the matrices (e.g., float, double, or complex variants).
+	 * \tparam S			SIMD instruction set to use (SSE, AVX, AVX512, or NONE).
+	 * \tparam K			Kernel policy defining tile size (default: transpose_kernel from simd.h).
+	 *
+	 * \param A		Source matrix of dimensions M×N in row-major layout.
+	 * \param B		Destination matrix of dimensions N×M in row-major layout.
+	 * \param M		Number of rows in matrix A (becomes number of columns in B).
+	 * \param N		Number of columns in matrix A (becomes number of rows in B).
+	 *
+	 * \throws std::runtime_error if memory layout validation fails.
+	 */
+	template<typename T,  typename S = decltype(detect_simd()), 
+		template<typename, typename> class K = transpose_kernel>
+	inline 
+	void conjugate_transpose(T** A, T** B, const size_t M, const size_t N)
+	{
+		right<T>("conjugate_transpose:", std::make_tuple(A, M, N), std::make_tuple(B, N, M));
+		
+		if constexpr (std::is_same_v<S, NONE>)
+			_transpose<T, K, true>(A, B, M, N);
+		else
+			_transpose_simd<T, S, K, true>(A, B, M, N);
+	}
+
+	/**
+	 * \brief Scaled and accumulating conjugate transpose, B = alpha * Aᴴ + beta * B.
+	 *
+	 * Fuses conjugation, scaling and accumulation into the register transpose.
+	 * The Hermitian part (A + Aᴴ)/2 of a square A takes two passes: copy A into
+	 * B, then conjugate_transpose(A, B, N, N, 0.5, 0.5).
+	 *
+	 * \tparam T			Element type of the matrices (e.g., float, double, or complex variants).
+	 * \tparam S			SIMD instruction set to use (SSE, AVX, AVX512, or NONE).
+	 * \tparam K			Kernel policy defining tile size (default: transpose_kernel from simd.h).
+	 *
+	 * \param A		Source matrix of dimensions M×N in row-major layout.
+	 * \param B		Destination matrix of dimensions N×M in row-major layout.
+	 * \param M		Number of rows in matrix A (becomes number of columns in B).
+	 * \param N		Number of columns in matrix A (becomes number of rows in B).
+	 * \param alpha	Scale applied to Aᴴ.
+	 * \param beta	Scale applied to the prior contents of B.
+	 *
+	 * \note A and B must not alias.
+	 *
+	 * \throws std::runtime_error if memory layout validation fails.
+	 */
+	template<typename T,  typename S = decltype(detect_simd()), 
+		template<typename, typename> class K = transpose_kernel>
+	inline 
+	void conjugate_transpose(T** A, T** B, const size_t M, const size_t N, const T alpha, const T beta)
+	{
+		right<T>("conjugate_transpose:", std::make_tuple(A, M, N), std::make_tuple(B, N, M));
+		
+		if constexpr (std::is_same_v<S, NONE>)
+			_transpose<T, K, true, true>(A, B, M, N, alpha, beta);
+		else
+			_transpose_simd<T, S, K, true, true>(A, B, M, N, alpha, beta);
+	}
+
+	namespace cache_oblivious
+	{
+		/**
+		 * \brief Cache-oblivious transpose by recursive bisection.
+		 *
+		 * Recursively halves the larger dimension of A down to a leaf of a few SIMD
+		 * register tiles, so every level of the cache hierarchy is used without the
+		 * fixed l1/l2/l3 blocks of transpose_kernel. This keeps throughput stable on
+		 * tall, thin and power-of-two shapes where a static blocking thrashes. The
+		 * upper levels of the recursion run as OpenMP tasks.
+		 *
+		 * \tparam T			Element type of the matrices (e.g., float, double, or complex variants).
+		 * \tparam S			SIMD instruction set to use (SSE, AVX, AVX512, or NONE).
+		 * \tparam K			Kernel policy defining the register tile (default: transpose_kernel).
+		 *
+		 * \param A		Source matrix of dimensions M×N in row-major layout.
+		 * \param B		Destination matrix of dimensions N×M in row-major layout.
+		 * \param M		Number of rows in matrix A (becomes number of columns in B).
+		 * \param N		Number of columns in matrix A (becomes number of rows in B).
+		 *
+		 * \throws std::runtime_error if memory layout validation fails.
+		 */
+		template<typename T,  typename S = decltype(detect_simd()), 
+			template<typename, typename> class K = transpose_kernel>
+		inline 
+		void transpose(T** A, T** B, const size_t M, const size_t N)
+		{
+			right<T>("transpose:", std::make_tuple(A, M, N), std::make_tuple(B, N, M));
+			
+			#pragma omp parallel
+			#pragma omp single nowait
+			_transpose_recursive<T, S, K>(A, B, 0, M, 0, N, T(1), T(0));
+		}
+
+		/**
+		 * \brief Cache-oblivious conjugate (Hermitian) transpose, B = Aᴴ.
+		 *
+		 * \tparam T			Element type of the matrices (e.g., float, double, or complex variants).
+		 * \tparam S			SIMD instruction set to use (SSE, AVX, AVX512, or NONE).
+		 * \tparam K			Kernel policy defining the register tile (default: transpose_kernel).
+		 *
+		 * \param A		Source matrix of dimensions M×N in row-major layout.
+		 * \param B		Destination matrix of dimensions N×M in row-major layout.
+		 * \param M		Number of rows in matrix A (becomes number of columns in B).
+		 * \param N		Number of columns in matrix A (becomes number of rows in B).
+		 *
+		 * \throws std::runtime_error if memory layout validation fails.
+		 */
+		template<typename T,  typename S = decltype(detect_simd()), 
+			template<typename, typename> class K = transpose_kernel>
+		inline 
+		void conjugate_transpose(T** A, T** B, const size_t M, const size_t N)
+		{
+			right<T>("conjugate_transpose:", std::make_tuple(A, M, N), std::make_tuple(B, N, M));
+			
+			#pragma omp parallel
+			#pragma omp single nowait
+			_transpose_recursive<T, S, K, true>(A, B, 0, M, 0, N, T(1), T(0));
+		}
+
+	} // namespace cache_oblivious
+
 }//namespace damm
 #endif //__TRANSPOSE_H__
\ No newline at end of file
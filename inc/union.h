@@ -281,7 +281,7 @@ namespace damm
 		{
 			right<T>("union: ", std::make_tuple(A, M, N), std::make_tuple(C, M, N));
 
-			if constexpr (std::is_same_v<S, NONE>) 
+			if constexpr (std::is_same_v<S, NONE> || !has_simd_op_v<T, O>) 
 				_union<T, O, K>(A, B, C, M, N);
 			else
 				_union_simd<T, O, S, K>(A, B, C, M, N);
@@ -523,7 +523,7 @@ namespace damm
 		{
 			right<T>("union:", std::make_tuple(A, M, N), std::make_tuple(B, M, N), std::make_tuple(C, M, N));
 
-			if constexpr (std::is_same_v<S, NONE>) 
+			if constexpr (std::is_same_v<S, NONE> || !has_simd_op_v<T, O>) 
 				_union<T, O, K>(A, B, C, M, N);
 			else
 				_union_simd<T, O, S, K>(A, B, C, M, N);
@@ -0,0 +1,200 @@
+/**
+ * \file batched_test.cc
+ * \brief unit test for batched.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+
+#include "test_utils.h"
+#include "broadcast.h"
+#include "decompose.h"
+#include "batched.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+// Odd batch size so that the padded tail group is exercised
+constexpr size_t COUNT = 37;
+
+template<typename T, typename S, size_t N>
+std::expected<E, U> 
+batch_lu(void* instructions) 
+{
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-4f : 1e-10;
+
+	// COUNT matrices stacked in one allocation, A[b] is rows [b·N, (b+1)·N)
+	auto storage = carray<T, 2, S::bytes>(COUNT * N, N);
+	fill_rand(storage.get(), COUNT * N, N);
+	T** A[COUNT];
+	for (size_t b = 0; b < COUNT; ++b)
+		A[b] = &storage.get()[b * N];
+
+	auto X = carray<T, 2, S::bytes>(N * N, COUNT);
+	auto P = carray<size_t, 2, S::bytes>(N, COUNT);
+	auto B = carray<T, 2, S::bytes>(N, COUNT);
+	auto Y = carray<T, 2, S::bytes>(N, COUNT);
+
+	batch::interleave<T>(A, X.get(), N, N, COUNT);
+	fill_rand(B.get(), N, COUNT, 7);
+
+	if (!batch::lu::decompose<T, S>(X.get(), P.get(), N, COUNT))
+		return std::unexpected{"batch decomposition reported a singular matrix"};
+
+	batch::lu::solve<T, S>(X.get(), P.get(), B.get(), Y.get(), N, COUNT);
+
+	size_t p[N];
+
+	for (size_t b = 0; b < COUNT; ++b)
+	{
+		// Factors and pivots must match the single-matrix decomposition.
+		// lu::decompose permutes the row pointers, so each matrix gets a fresh view.
+		auto LU = carray<T, 2, S::bytes>(N, N);
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+				LU[i][j] = A[b][i][j];
+
+		lu::decompose<T, S>(LU.get(), p, N);
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			if (p[i] != P[i][b])
+			{
+				std::string response = std::format("pivot mismatch in matrix {} row {}: {} != {}", b, i, P[i][b], p[i]);
+				return std::unexpected{response};
+			}
+
+			for (size_t j = 0; j < N; ++j)
+				if (std::abs(LU[i][j] - X[i * N + j][b]) > tolerance)
+				{
+					std::string response = std::format("factor mismatch in matrix {} at [{}][{}]", b, i, j);
+					return std::unexpected{response};
+				}
+		}
+
+		// Residual ||A·x - b||_max
+		for (size_t i = 0; i < N; ++i)
+		{
+			T r = -B[i][b];
+			for (size_t j = 0; j < N; ++j)
+				r += A[b][i][j] * Y[j][b];
+
+			if (std::abs(r) > tolerance * N)
+			{
+				std::string response = std::format("residual {} in matrix {} row {}", std::abs(r), b, i);
+				return std::unexpected{response};
+			}
+		}
+	}
+
+	return 0;
+}
+
+template<typename T, typename S, size_t N>
+std::expected<E, U> 
+batch_cholesky(void* instructions) 
+{
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-4f : 1e-10;
+
+	// SPD batch: A_b = G·G^T + N·I
+	auto storage = carray<T, 2, S::bytes>(COUNT * N, N);
+	auto G = carray<T, 2, S::bytes>(N, N);
+	T** A[COUNT];
+	for (size_t b = 0; b < COUNT; ++b)
+	{
+		A[b] = &storage.get()[b * N];
+		fill_rand(G.get(), N, N, 42 + b);
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+			{
+				T s = (i == j) ? T(N) : T(0);
+				for (size_t k = 0; k < N; ++k)
+					s += G[i][k] * G[j][k];
+				A[b][i][j] = s;
+			}
+	}
+
+	auto X = carray<T, 2, S::bytes>(N * N, COUNT);
+	auto B = carray<T, 2, S::bytes>(N, COUNT);
+	auto Y = carray<T, 2, S::bytes>(N, COUNT);
+
+	batch::interleave<T>(A, X.get(), N, N, COUNT);
+	fill_rand(B.get(), N, COUNT, 7);
+
+	if (!batch::cholesky::decompose<T, S>(X.get(), N, COUNT))
+		return std::unexpected{"batch decomposition reported an indefinite matrix"};
+
+	batch::cholesky::solve<T, S>(X.get(), B.get(), Y.get(), N, COUNT);
+
+	auto L = carray<T, 2, S::bytes>(N, N);
+
+	for (size_t b = 0; b < COUNT; ++b)
+	{
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+				L[i][j] = A[b][i][j];
+
+		cholesky::decompose<T, S>(L.get(), N);
+
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+				if (std::abs(L[i][j] - X[i * N + j][b]) > tolerance)
+				{
+					std::string response = std::format("factor mismatch in matrix {} at [{}][{}]", b, i, j);
+					return std::unexpected{response};
+				}
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			T r = -B[i][b];
+			for (size_t j = 0; j < N; ++j)
+				r += A[b][i][j] * Y[j][b];
+
+			if (std::abs(r) > tolerance * N)
+			{
+				std::string response = std::format("residual {} in matrix {} row {}", std::abs(r), b, i);
+				return std::unexpected{response};
+			}
+		}
+	}
+
+	// A non-SPD lane must be reported
+	X[0][COUNT - 1] = T(-1);
+	if (batch::cholesky::decompose<T, S>(X.get(), N, COUNT))
+		return std::unexpected{"indefinite matrix was not detected"};
+
+	return 0;
+}
+
+
+int main(int argc, char* argv[]) 
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "batch::lu<double, 8>", &batch_lu<double, AVX512, 8>, nullptr);
+	heracles.add_labor(1, "batch::lu<float, 5>", &batch_lu<float, AVX, 5>, nullptr);
+	heracles.add_labor(2, "batch::cholesky<double, 8>", &batch_cholesky<double, AVX512, 8>, nullptr);
+	heracles.add_labor(3, "batch::cholesky<float, 5>", &batch_cholesky<float, SSE, 5>, nullptr);
+
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] batched_test: " << e.what() << "\n";
+		return -1;
+	}
+	
+	return 0;
+}
@@ -0,0 +1,286 @@
+/**
+ * \file blas_test.cc
+ * \brief unit test for blas.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include "test_utils.h"
+#include "blas.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+template<typename T>
+static std::vector<T>
+random_vector(const size_t n, const unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::vector<T> x(n);
+	for (auto& v : x)
+	{
+		if constexpr (std::is_integral_v<T>)
+			v = T(int(gen() % 21) - 10);
+		else
+		{
+			std::uniform_real_distribution<typename base<T>::type> dist(-1, 1);
+			if constexpr (is_complex_v<T>)
+				v = T(dist(gen), dist(gen));
+			else
+				v = dist(gen);
+		}
+	}
+	return x;
+}
+
+/** \brief re + i·im, or re for real T */
+template<typename T>
+static T
+number(const double re, const double im)
+{
+	if constexpr (is_complex_v<T>)
+		return T(re, im);
+	else
+		return T(re);
+}
+
+template<typename T>
+static bool
+close(const T a, const T b, const double scale)
+{
+	if constexpr (std::is_integral_v<T>)
+		return a == b;
+	else
+	{
+		const double tol = std::is_same_v<typename base<T>::type, float> ? 1e-5 : 1e-13;
+		return std::abs(a - b) <= tol * std::max(1.0, scale);
+	}
+}
+
+template<typename T>
+static bool
+same(const std::vector<T>& a, const std::vector<T>& b)
+{
+	for (size_t k = 0; k < a.size(); ++k)
+		if (!close(a[k], b[k], double(std::abs(b[k]))))
+			return false;
+	return true;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+level1(void* instructions)
+{
+	using R = typename base<T>::type;
+
+	const T a = number<T>(0.5, 0.25);
+	const T b = number<T>(-1.5, 0.5);
+
+	for (const size_t N : {0, 1, 7, 33, 1000, 100003})
+		for (const auto& [incx, incy] : {std::pair<size_t, size_t>{1, 1}, {2, 3}})
+		{
+			const auto x0 = random_vector<T>(std::max<size_t>(N * incx, 1), unsigned(N) + 1);
+			const auto y0 = random_vector<T>(std::max<size_t>(N * incy, 1), unsigned(N) + 2);
+			auto X = [&](const auto& v, const size_t k) { return v[k * incx]; };
+			auto Y = [&](const auto& v, const size_t k) { return v[k * incy]; };
+
+			// dot and dotc
+			T d = T(0), dc = T(0);
+			double scale = 0;
+			for (size_t k = 0; k < N; ++k)
+			{
+				d += X(x0, k) * Y(y0, k);
+				dc += conjugate(X(x0, k)) * Y(y0, k);
+				scale += double(std::abs(X(x0, k) * Y(y0, k)));
+			}
+			if (!close(blas::dot<T, S>(x0.data(), y0.data(), N, incx, incy), d, scale))
+				return std::unexpected{"dot"};
+			if (!close(blas::dotc<T, S>(x0.data(), y0.data(), N, incx, incy), dc, scale))
+				return std::unexpected{"dotc"};
+
+			// axpy, axpby
+			auto y = y0, expect = y0;
+			for (size_t k = 0; k < N; ++k)
+				expect[k * incy] += a * X(x0, k);
+			blas::axpy<T, S>(a, x0.data(), y.data(), N, incx, incy);
+			if (!same(y, expect))
+				return std::unexpected{"axpy"};
+
+			y = y0; expect = y0;
+			for (size_t k = 0; k < N; ++k)
+				expect[k * incy] = a * X(x0, k) + b * Y(y0, k);
+			blas::axpby<T, S>(a, x0.data(), b, y.data(), N, incx, incy);
+			if (!same(y, expect))
+				return std::unexpected{"axpby"};
+
+			// scal leaves the elements between strides alone
+			auto x = x0; expect = x0;
+			for (size_t k = 0; k < N; ++k)
+				expect[k * incx] *= a;
+			blas::scal<T, S>(a, x.data(), N, incx);
+			if (!same(x, expect))
+				return std::unexpected{"scal"};
+
+			// nrm2, asum, iamax
+			double ss = 0, sa = 0, best = -1;
+			size_t arg = 0;
+			for (size_t k = 0; k < N; ++k)
+			{
+				const double m = std::abs(double(std::real(X(x0, k)))) + std::abs(double(std::imag(X(x0, k))));
+				ss += double(std::norm(X(x0, k)));
+				sa += m;
+				if (m > best)
+				{
+					best = m;
+					arg = k;
+				}
+			}
+			if (!close<R>(blas::nrm2<T, S>(x0.data(), N, incx), R(std::sqrt(ss)), std::sqrt(ss)))
+				return std::unexpected{"nrm2"};
+			if (!close<R>(blas::asum<T, S>(x0.data(), N, incx), R(sa), sa))
+				return std::unexpected{"asum"};
+			if (blas::iamax<T, S>(x0.data(), N, incx) != arg)
+				return std::unexpected{"iamax"};
+
+			// rot
+			const R c = R(0.6);
+			const T s = is_complex_v<T> ? number<T>(0.48, 0.64) : T(0.8);
+			x = x0; y = y0;
+			auto ex = x0, ey = y0;
+			for (size_t k = 0; k < N; ++k)
+			{
+				ex[k * incx] = c * X(x0, k) + s * Y(y0, k);
+				ey[k * incy] = c * Y(y0, k) - conjugate(s) * X(x0, k);
+			}
+			blas::rot<T, S>(x.data(), y.data(), c, s, N, incx, incy);
+			if (!same(x, ex) || !same(y, ey))
+				return std::unexpected{"rot"};
+
+			// copy and swap
+			std::vector<T> z(y0.size(), T(0)), ez(y0.size(), T(0));
+			for (size_t k = 0; k < N; ++k)
+				ez[k * incy] = X(x0, k);
+			blas::copy<T, S>(x0.data(), z.data(), N, incx, incy);
+			if (z != ez)
+				return std::unexpected{"copy"};
+
+			x = x0; y = y0;
+			blas::swap<T, S>(x.data(), y.data(), N, incx, incy);
+			for (size_t k = 0; k < N; ++k)
+				if (X(x, k) != Y(y0, k) || Y(y, k) != X(x0, k))
+					return std::unexpected{"swap"};
+		}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+integers(void* instructions)
+{
+	for (const size_t N : {5, 64, 70001})
+	{
+		const auto x = random_vector<T>(N, unsigned(N));
+		auto y = random_vector<T>(N, unsigned(N) + 1);
+		auto expect = y;
+
+		T d = T(0);
+		for (size_t k = 0; k < N; ++k)
+		{
+			d += x[k] * y[k];
+			expect[k] = T(3) * x[k] + T(-2) * y[k];
+		}
+		if (blas::dot<T, S>(x.data(), y.data(), N) != d)
+			return std::unexpected{"dot"};
+
+		blas::axpby<T, S>(T(3), x.data(), T(-2), y.data(), N);
+		if (y != expect)
+			return std::unexpected{"axpby"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+nrm2_range(void* instructions)
+{
+	using R = typename base<T>::type;
+
+	// Squares that overflow, squares below the normal range, and zeros
+	for (const R v : {std::numeric_limits<R>::max() / R(64), std::numeric_limits<R>::min() * R(8), R(0)})
+	{
+		const size_t N = 1000;
+		std::vector<T> x(N, T(v));
+		x[17] = T(2 * v);
+
+		const R expect = v * std::sqrt(R(N + 3));
+		const R got = blas::nrm2<T, S>(x.data(), N);
+		if (!(std::abs(got - expect) <= R(1e-5) * expect) && !(v == R(0) && got == R(0)))
+			return std::unexpected{"nrm2 lost range"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+invalid(void* instructions)
+{
+	std::vector<T> x(8, T(1));
+
+	try
+	{
+		blas::dot<T, S>(x.data(), x.data(), 4, 0, 1);
+		return std::unexpected{"zero stride accepted"};
+	}
+	catch (const std::invalid_argument&) {}
+
+	try
+	{
+		blas::axpy<T, S>(T(1), static_cast<const T*>(nullptr), x.data(), 4);
+		return std::unexpected{"null vector accepted"};
+	}
+	catch (const std::runtime_error&) {}
+
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "blas<double>", &level1<double, AVX512>, nullptr);
+	heracles.add_labor(1, "blas<float, AVX>", &level1<float, AVX>, nullptr);
+	heracles.add_labor(2, "blas<double, SSE>", &level1<double, SSE>, nullptr);
+	heracles.add_labor(3, "blas<complex<double>>", &level1<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(4, "blas<complex<float>, AVX>", &level1<std::complex<float>, AVX>, nullptr);
+	heracles.add_labor(5, "blas<double, NONE>", &level1<double, NONE>, nullptr);
+	heracles.add_labor(6, "blas<int32_t>", &integers<int32_t, AVX512>, nullptr);
+	heracles.add_labor(7, "blas<int64_t, SSE>", &integers<int64_t, SSE>, nullptr);
+	heracles.add_labor(8, "blas::nrm2<double> range", &nrm2_range<double, AVX512>, nullptr);
+	heracles.add_labor(9, "blas::nrm2<complex<float>, AVX> range", &nrm2_range<std::complex<float>, AVX>, nullptr);
+	heracles.add_labor(10, "blas<double> invalid", &invalid<double, AVX512>, nullptr);
+
+	try
+	{
+		heracles.perform_labors();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "[EXCEPT] blas_test: " << e.what() << "\n";
+		return -1;
+	}
+
+	return 0;
+}
@@ -112,5 +112,22 @@ int main(int argc, char* argv[])
 	set_identity(I.get(), M, N);
 	is_identity<T>("set_identity:", I.get(), M, N);
 
+	using Ti = int32_t;
+	const Ti Bi = -7;
+
+	carray<Ti, 2, ALIGN> Ai_naive(M, N);
+	carray<Ti, 2, ALIGN> Ai_sse(M, N);
+	carray<Ti, 2, ALIGN> Ai_avx(M, N);
+	carray<Ti, 2, ALIGN> Ai_avx512(M, N);
+
+	broadcast_naive<Ti>(Ai_naive.get(), Bi, M, N);
+	broadcast<Ti, SSE>(Ai_sse.get(), Bi, M, N);
+	broadcast<Ti, AVX>(Ai_avx.get(), Bi, M, N);
+	broadcast<Ti, AVX512>(Ai_avx512.get(), Bi, M, N);
+
+	is_same<Ti>(std::format("broadcast<{}, SSE>:",typeid(Ti).name()).c_str(), Ai_sse.get(), Ai_naive.get(), M, N);
+	is_same<Ti>(std::format("broadcast<{}, AVX>:",typeid(Ti).name()).c_str(), Ai_avx.get(), Ai_naive.get(), M, N);
+	is_same<Ti>(std::format("broadcast<{}, AVX512>:",typeid(Ti).name()).c_str(), Ai_avx512.get(), Ai_naive.get(), M, N);
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,197 @@
+/**
+ * \file bsr_test.cc
+ * \brief unit test for bsr.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include "test_utils.h"
+#include "bsr.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+/** \brief Zero a random subset of the br×bc blocks of A, and every block of block row 1 */
+template<typename T>
+static void
+sparsify(T** A, const size_t M, const size_t N, const size_t br, const size_t bc, const unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::bernoulli_distribution keep(0.3);
+
+	for (size_t I = 0; I < M / br; ++I)
+		for (size_t J = 0; J < N / bc; ++J)
+			if (I == 1 || !keep(gen))
+				for (size_t i = 0; i < br; ++i)
+					std::fill(A[I * br + i] + J * bc, A[I * br + i] + (J + 1) * bc, T(0));
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+block_multiply(void* instructions)
+{
+	const double tol = std::is_same_v<typename base<T>::type, float> ? 1e-3 : 1e-9;
+
+	struct shape { size_t M, N, P, br, bc; };
+	for (const shape s : {shape{128, 192, 96, 16, 16}, shape{96, 64, 37, 32, 16}, shape{60, 90, 5, 6, 9}, shape{256, 256, 130, 64, 64}})
+	{
+		auto A = carray<T, 2, S::bytes>(s.M, s.N);
+		auto B = carray<T, 2, S::bytes>(s.N, s.P);
+		auto C = carray<T, 2, S::bytes>(s.M, s.P);
+		auto R = carray<T, 2, S::bytes>(s.M, s.P);
+		fill_rand<T>(A.get(), s.M, s.N, 1);
+		fill_rand<T>(B.get(), s.N, s.P, 2);
+		fill_rand<T>(C.get(), s.M, s.P, 3);
+		sparsify<T>(A.get(), s.M, s.N, s.br, s.bc, 4);
+
+		for (size_t i = 0; i < s.M; ++i)
+			for (size_t j = 0; j < s.P; ++j)
+			{
+				R[i][j] = C[i][j];
+				for (size_t k = 0; k < s.N; ++k)
+					R[i][j] += A[i][k] * B[k][j];
+			}
+
+		bsr::matrix<T> As(A.get(), s.M, s.N, s.br, s.bc);
+		if (As.row_ptr()[2] != As.row_ptr()[1])
+			return std::unexpected{"zero block row stored"};
+		if (As.nonzero_blocks() == 0 || As.nonzero_blocks() == (s.M / s.br) * (s.N / s.bc))
+			return std::unexpected{"pattern not sparse"};
+
+		auto D = carray<T, 2, S::bytes>(s.M, s.N);
+		As.to_dense(D.get());
+		for (size_t i = 0; i < s.M; ++i)
+			for (size_t k = 0; k < s.N; ++k)
+				if (D[i][k] != A[i][k])
+					return std::unexpected{"dense round trip"};
+
+		bsr::multiply<T, S>(As, B.get(), C.get(), s.P);
+
+		for (size_t i = 0; i < s.M; ++i)
+			for (size_t j = 0; j < s.P; ++j)
+				if (!approx_equal(C[i][j], R[i][j], tol, tol))
+					return std::unexpected{"product differs from dense"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+vector_multiply(void* instructions)
+{
+	const double tol = std::is_same_v<typename base<T>::type, float> ? 1e-3 : 1e-9;
+
+	// The last shape stores enough elements to take the threaded path
+	struct shape { size_t M, N, br, bc; };
+	for (const shape s : {shape{128, 192, 16, 16}, shape{60, 90, 6, 9}, shape{96, 64, 3, 16}, shape{1024, 1024, 32, 32}})
+	{
+		auto A = carray<T, 2, S::bytes>(s.M, s.N);
+		auto X = carray<T, 2, S::bytes>(1, s.N);
+		auto Y = carray<T, 2, S::bytes>(1, s.M);
+		fill_rand<T>(A.get(), s.M, s.N, 5);
+		fill_rand<T>(X.get(), 1, s.N, 6);
+		fill_rand<T>(Y.get(), 1, s.M, 7);
+		sparsify<T>(A.get(), s.M, s.N, s.br, s.bc, 8);
+
+		std::vector<T> R(s.M);
+		for (size_t i = 0; i < s.M; ++i)
+		{
+			R[i] = Y[0][i];
+			for (size_t k = 0; k < s.N; ++k)
+				R[i] += A[i][k] * X[0][k];
+		}
+
+		bsr::matrix<T> As(A.get(), s.M, s.N, s.br, s.bc);
+		bsr::multiply_vector<T, S>(As, X[0], Y[0]);
+
+		for (size_t i = 0; i < s.M; ++i)
+			if (!approx_equal(Y[0][i], R[i], tol, tol))
+				return std::unexpected{"matrix-vector product differs from dense"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+pattern(void* instructions)
+{
+	// 3×4 blocks of 8×8, a skewed pattern that puts every block in block row 0
+	bsr::matrix<T> A(24, 32, 8, 8, {0, 4, 4, 4}, {0, 1, 2, 3});
+	for (size_t b = 0; b < A.nonzero_blocks(); ++b)
+		for (size_t k = 0; k < 8; ++k)
+			for (size_t i = 0; i < 8; ++i)
+				A.block(b)[k][i] = T(b + 1);
+
+	auto B = carray<T, 2, S::bytes>(32, 40);
+	auto C = carray<T, 2, S::bytes>(24, 40);
+	for (size_t k = 0; k < 32; ++k)
+		std::fill(B[k], B[k] + 40, T(1));
+	for (size_t i = 0; i < 24; ++i)
+		std::fill(C[i], C[i] + 40, T(0));
+
+	bsr::multiply<T, S>(A, B.get(), C.get(), 40);
+
+	// Row i < 8 sums 8·(1 + 2 + 3 + 4); the rest stay zero
+	for (size_t i = 0; i < 24; ++i)
+		for (size_t j = 0; j < 40; ++j)
+			if (C[i][j] != (i < 8 ? T(80) : T(0)))
+				return std::unexpected{"skewed pattern"};
+
+	auto expect_throw = [](auto&& make)
+	{
+		try { make(); } catch (const std::invalid_argument&) { return true; }
+		return false;
+	};
+
+	if (!expect_throw([] { bsr::matrix<T>(24, 30, 8, 8, {0, 0, 0, 0}, {}); }))
+		return std::unexpected{"shape not a multiple of the blocks"};
+	if (!expect_throw([] { bsr::matrix<T>(24, 32, 8, 8, {0, 1, 2}, {0, 1}); }))
+		return std::unexpected{"short row_ptr"};
+	if (!expect_throw([] { bsr::matrix<T>(24, 32, 8, 8, {0, 1, 1, 1}, {4}); }))
+		return std::unexpected{"block column out of range"};
+
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "bsr::multiply<double>", &block_multiply<double, AVX512>, nullptr);
+	heracles.add_labor(1, "bsr::multiply<float, AVX>", &block_multiply<float, AVX>, nullptr);
+	heracles.add_labor(2, "bsr::multiply<double, SSE>", &block_multiply<double, SSE>, nullptr);
+	heracles.add_labor(3, "bsr::multiply<complex<double>>", &block_multiply<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(4, "bsr::multiply<complex<float>, AVX>", &block_multiply<std::complex<float>, AVX>, nullptr);
+	heracles.add_labor(5, "bsr::multiply<double, NONE>", &block_multiply<double, NONE>, nullptr);
+	heracles.add_labor(6, "bsr::matrix<double> pattern", &pattern<double, AVX512>, nullptr);
+	heracles.add_labor(7, "bsr::matrix<float, AVX> pattern", &pattern<float, AVX>, nullptr);
+	heracles.add_labor(8, "bsr::multiply_vector<double>", &vector_multiply<double, AVX512>, nullptr);
+	heracles.add_labor(9, "bsr::multiply_vector<float, SSE>", &vector_multiply<float, SSE>, nullptr);
+	heracles.add_labor(10, "bsr::multiply_vector<complex<double>, AVX>", &vector_multiply<std::complex<double>, AVX>, nullptr);
+	heracles.add_labor(11, "bsr::multiply_vector<double, NONE>", &vector_multiply<double, NONE>, nullptr);
+
+	try
+	{
+		heracles.perform_labors();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "[EXCEPT] bsr_test: " << e.what() << "\n";
+		return -1;
+	}
+
+	return 0;
+}
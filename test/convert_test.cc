@@ -0,0 +1,198 @@
+/**
+ * \file convert_test.cc
+ * \brief unit test for convert.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+
+#include "test_utils.h"
+#include "convert.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+// Odd shapes exercise the scalar tail, the large one spans several chunks
+static constexpr std::pair<size_t, size_t> shapes[] = {{37, 41}, {1, 3}, {300, 211}};
+
+template<typename Ts, typename Td, typename S>
+std::expected<E, U> 
+precision(void* instructions) 
+{
+	using R = typename base<Td>::type;
+	const R scale = R(0.5);
+
+	for (auto [M, N] : shapes)
+	{
+		auto A = carray<Ts, 2, S::bytes>(M, N);
+		auto B = carray<Td, 2, S::bytes>(M, N);
+		fill_rand<Ts>(A.get(), M, N);
+
+		convert<Ts, Td, S>(A.get(), B.get(), M, N, scale);
+
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < N; ++j)
+			{
+				// the reference applies the scale at the source precision and rounds once
+				Td ref;
+				if constexpr (is_complex_v<Ts> && is_complex_v<Td>)
+					ref = Td(R(A[i][j].real() * scale), R(A[i][j].imag() * scale));
+				else if constexpr (is_complex_v<Td>)
+					ref = Td(A[i][j] * scale, 0);
+				else if constexpr (std::is_same_v<Ts, double>)
+					ref = Td(A[i][j] * double(scale));
+				else
+					ref = Td(float(A[i][j]) * float(scale));
+
+				if (B[i][j] != ref)
+					return std::unexpected{"converted element differs from reference"};
+			}
+	}
+
+	return 0;
+}
+
+template<typename S>
+std::expected<E, U> 
+half_round_trip(void* instructions) 
+{
+	for (auto [M, N] : shapes)
+	{
+		auto A = carray<float, 2, S::bytes>(M, N);
+		auto H = carray<half, 2, S::bytes>(M, N);
+		auto B = carray<float, 2, S::bytes>(M, N);
+		fill_rand<float>(A.get(), M, N);
+
+		convert<float, half, S>(A.get(), H.get(), M, N, 2.0f);
+		convert<half, float, S>(H.get(), B.get(), M, N, 0.5f);
+
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < N; ++j)
+			{
+				if (H[i][j] != half(2.0f * A[i][j]))
+					return std::unexpected{"float → half rounding"};
+				if (std::abs(B[i][j] - A[i][j]) > std::abs(A[i][j]) * 0x1p-11f)
+					return std::unexpected{"half round trip"};
+			}
+	}
+
+	return 0;
+}
+
+template<typename Ts, typename Td, typename S>
+std::expected<E, U> 
+overflow_scale(void* instructions) 
+{
+	// A overflows Td before scaling but not after; N % W != 0 puts some in the tail
+	const Ts big = std::is_same_v<Td, half> ? Ts(1e5) : Ts(1e39);
+	const Ts scale = Ts(0.0009987);
+
+	for (auto [M, N] : {std::pair<size_t, size_t>{1, 17}, {3, 37}})
+	{
+		auto A = carray<Ts, 2, S::bytes>(M, N);
+		auto B = carray<Td, 2, S::bytes>(M, N);
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < N; ++j)
+				A[i][j] = big * Ts(1 + j % 5);
+
+		convert<Ts, Td, S>(A.get(), B.get(), M, N, scale);
+
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < N; ++j)
+			{
+				if (!std::isfinite(float(B[i][j])))
+					return std::unexpected{"overflow before scaling"};
+				if (B[i][j] != Td(scale * A[i][j]))
+					return std::unexpected{"scaled element differs from reference"};
+			}
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+complex_parts(void* instructions) 
+{
+	const T scale = T(3);
+
+	for (auto [M, N] : shapes)
+	{
+		auto A = carray<std::complex<T>, 2, S::bytes>(M, N);
+		auto R = carray<T, 2, S::bytes>(M, N);
+		auto I = carray<T, 2, S::bytes>(M, N);
+		auto B = carray<T, 2, S::bytes>(M, N);
+		fill_rand<std::complex<T>>(A.get(), M, N);
+
+		convert_part<ComplexPart::REAL, T, S>(A.get(), R.get(), M, N, scale);
+		convert_part<ComplexPart::IMAG, T, S>(A.get(), I.get(), M, N, scale);
+		convert_part<ComplexPart::ABS, T, S>(A.get(), B.get(), M, N, scale);
+
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < N; ++j)
+			{
+				if (R[i][j] != scale * A[i][j].real())
+					return std::unexpected{"real part"};
+				if (I[i][j] != scale * A[i][j].imag())
+					return std::unexpected{"imaginary part"};
+				const T ref = scale * std::abs(A[i][j]);
+				if (std::abs(B[i][j] - ref) > 4 * std::numeric_limits<T>::epsilon() * ref)
+					return std::unexpected{"modulus"};
+			}
+	}
+
+	return 0;
+}
+
+int main(int argc, char* argv[]) 
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "convert<double, float>", &precision<double, float, AVX512>, nullptr);
+	heracles.add_labor(1, "convert<double, float, AVX>", &precision<double, float, AVX>, nullptr);
+	heracles.add_labor(2, "convert<double, float, SSE>", &precision<double, float, SSE>, nullptr);
+	heracles.add_labor(3, "convert<float, double>", &precision<float, double, AVX512>, nullptr);
+	heracles.add_labor(4, "convert<float, double, SSE>", &precision<float, double, SSE>, nullptr);
+	heracles.add_labor(5, "convert<float, complex<float>>", &precision<float, std::complex<float>, AVX512>, nullptr);
+	heracles.add_labor(6, "convert<float, complex<float>, AVX>", &precision<float, std::complex<float>, AVX>, nullptr);
+	heracles.add_labor(7, "convert<double, complex<double>, SSE>", &precision<double, std::complex<double>, SSE>, nullptr);
+	heracles.add_labor(8, "convert<double, complex<double>>", &precision<double, std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(9, "convert<complex<double>, complex<float>>", &precision<std::complex<double>, std::complex<float>, AVX>, nullptr);
+	heracles.add_labor(10, "convert<complex<float>, complex<double>>", &precision<std::complex<float>, std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(11, "convert<float, float, NONE>", &precision<float, float, NONE>, nullptr);
+	heracles.add_labor(12, "convert<double, float, NONE>", &precision<double, float, NONE>, nullptr);
+	heracles.add_labor(13, "convert<float, half>", &half_round_trip<AVX512>, nullptr);
+	heracles.add_labor(14, "convert<float, half, AVX>", &half_round_trip<AVX>, nullptr);
+	heracles.add_labor(15, "convert<float, half, SSE>", &half_round_trip<SSE>, nullptr);
+	heracles.add_labor(16, "convert<float, half> scale", &overflow_scale<float, half, AVX512>, nullptr);
+	heracles.add_labor(17, "convert<float, half, SSE> scale", &overflow_scale<float, half, SSE>, nullptr);
+	heracles.add_labor(18, "convert<double, float> scale", &overflow_scale<double, float, AVX512>, nullptr);
+	heracles.add_labor(19, "convert<double, float, AVX> scale", &overflow_scale<double, float, AVX>, nullptr);
+	heracles.add_labor(20, "convert_part<float>", &complex_parts<float, AVX512>, nullptr);
+	heracles.add_labor(21, "convert_part<double>", &complex_parts<double, AVX512>, nullptr);
+	heracles.add_labor(22, "convert_part<float, AVX>", &complex_parts<float, AVX>, nullptr);
+	heracles.add_labor(23, "convert_part<double, AVX>", &complex_parts<double, AVX>, nullptr);
+	heracles.add_labor(24, "convert_part<float, SSE>", &complex_parts<float, SSE>, nullptr);
+	heracles.add_labor(25, "convert_part<double, SSE>", &complex_parts<double, SSE>, nullptr);
+
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] convert_test: " << e.what() << "\n";
+		return -1;
+	}
+	
+	return 0;
+}
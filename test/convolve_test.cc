@@ -0,0 +1,178 @@
+/**
+ * \file convolve_test.cc
+ * \brief unit test for convolve.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+
+#include "test_utils.h"
+#include "convolve.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+struct geometry
+{
+	size_t C_in, H, W, C_out, KH, KW;
+	conv_params p;
+};
+
+// Channel counts and output sizes are chosen off the kernel tile to exercise the edge strips
+static const geometry geometries[] = 
+{
+	{3, 32, 32, 16, 3, 3, {}},
+	{3, 17, 23, 5, 3, 3, {.pad_h = 1, .pad_w = 1}},
+	{4, 29, 31, 7, 5, 3, {.stride_h = 2, .stride_w = 2, .pad_h = 2, .pad_w = 1}},
+	{2, 20, 26, 9, 3, 3, {.pad_h = 2, .pad_w = 2, .dilation_h = 2, .dilation_w = 2}},
+	{8, 12, 40, 33, 1, 1, {}},
+	{1, 9, 9, 2, 9, 9, {.pad_h = 4, .pad_w = 4}},
+	{70, 10, 10, 12, 3, 3, {.pad_h = 1, .pad_w = 1}},
+};
+
+template<typename T>
+void
+naive_conv2d(T** X, T** Wk, T** Y, const geometry& g, const size_t OH, const size_t OW)
+{
+	for (size_t o = 0; o < g.C_out; ++o)
+		for (size_t oh = 0; oh < OH; ++oh)
+			for (size_t ow = 0; ow < OW; ++ow)
+			{
+				T acc = Y[o][oh * OW + ow];
+				for (size_t c = 0; c < g.C_in; ++c)
+					for (size_t kh = 0; kh < g.KH; ++kh)
+						for (size_t kw = 0; kw < g.KW; ++kw)
+						{
+							const long ih = long(oh * g.p.stride_h + kh * g.p.dilation_h) - long(g.p.pad_h);
+							const long iw = long(ow * g.p.stride_w + kw * g.p.dilation_w) - long(g.p.pad_w);
+							if (ih < 0 || iw < 0 || ih >= long(g.H) || iw >= long(g.W))
+								continue;
+							acc += Wk[o][(c * g.KH + kh) * g.KW + kw] * X[c][ih * g.W + iw];
+						}
+				Y[o][oh * OW + ow] = acc;
+			}
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+convolution(void* instructions) 
+{
+	for (const auto& g : geometries)
+	{
+		const size_t OH = conv_output_size(g.H, g.KH, g.p.stride_h, g.p.pad_h, g.p.dilation_h);
+		const size_t OW = conv_output_size(g.W, g.KW, g.p.stride_w, g.p.pad_w, g.p.dilation_w);
+
+		auto X = carray<T, 2, S::bytes>(g.C_in, g.H * g.W);
+		auto Wk = carray<T, 2, S::bytes>(g.C_out, g.C_in * g.KH * g.KW);
+		auto Y = carray<T, 2, S::bytes>(g.C_out, OH * OW);
+		auto R = carray<T, 2, S::bytes>(g.C_out, OH * OW);
+		fill_rand<T>(X.get(), g.C_in, g.H * g.W);
+		fill_rand<T>(Wk.get(), g.C_out, g.C_in * g.KH * g.KW);
+
+		// a nonzero Y checks that the result accumulates
+		fill_rand<T>(Y.get(), g.C_out, OH * OW);
+		for (size_t i = 0; i < g.C_out; ++i)
+			std::copy(Y[i], Y[i] + OH * OW, R[i]);
+
+		conv2d<T, S>(X.get(), Wk.get(), Y.get(), g.C_in, g.H, g.W, g.C_out, g.KH, g.KW, g.p);
+		naive_conv2d<T>(X.get(), Wk.get(), R.get(), g, OH, OW);
+
+		if (!is_same<T, 1e-3>("conv2d", Y.get(), R.get(), g.C_out, OH * OW, false))
+			return std::unexpected{"conv2d differs from direct convolution"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+convolution_1d(void* instructions) 
+{
+	constexpr size_t C_in = 5, L = 301, C_out = 6, KL = 7;
+
+	for (auto [stride, pad, dilation] : {std::tuple{1, 0, 1}, {2, 3, 1}, {3, 6, 2}})
+	{
+		const size_t OL = conv_output_size(L, KL, stride, pad, dilation);
+
+		auto X = carray<T, 2, S::bytes>(C_in, L);
+		auto Wk = carray<T, 2, S::bytes>(C_out, C_in * KL);
+		auto Y = carray<T, 2, S::bytes>(C_out, OL);
+		auto R = carray<T, 2, S::bytes>(C_out, OL);
+		fill_rand<T>(X.get(), C_in, L);
+		fill_rand<T>(Wk.get(), C_out, C_in * KL);
+		for (size_t i = 0; i < C_out; ++i)
+		{
+			std::fill(Y[i], Y[i] + OL, T(0));
+			std::fill(R[i], R[i] + OL, T(0));
+		}
+
+		conv1d<T, S>(X.get(), Wk.get(), Y.get(), C_in, L, C_out, KL, stride, pad, dilation);
+
+		const geometry g{C_in, 1, L, C_out, 1, KL, {.stride_w = size_t(stride), .pad_w = size_t(pad), .dilation_w = size_t(dilation)}};
+		naive_conv2d<T>(X.get(), Wk.get(), R.get(), g, 1, OL);
+
+		if (!is_same<T, 1e-3>("conv1d", Y.get(), R.get(), C_out, OL, false))
+			return std::unexpected{"conv1d differs from direct convolution"};
+	}
+
+	return 0;
+}
+
+std::expected<E, U> 
+invalid_geometry(void* instructions) 
+{
+	try
+	{
+		conv_output_size(4, 7, 1, 1, 1);
+		return std::unexpected{"kernel larger than padded input accepted"};
+	}
+	catch (const std::invalid_argument&) {}
+
+	try
+	{
+		conv_output_size(16, 3, 0, 0, 1);
+		return std::unexpected{"zero stride accepted"};
+	}
+	catch (const std::invalid_argument&) {}
+
+	if (conv_output_size(224, 7, 2, 3, 1) != 112)
+		return std::unexpected{"output size"};
+
+	return 0;
+}
+
+int main(int argc, char* argv[]) 
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "conv2d<float>", &convolution<float, AVX512>, nullptr);
+	heracles.add_labor(1, "conv2d<double>", &convolution<double, AVX512>, nullptr);
+	heracles.add_labor(2, "conv2d<float, AVX>", &convolution<float, AVX>, nullptr);
+	heracles.add_labor(3, "conv2d<double, SSE>", &convolution<double, SSE>, nullptr);
+	heracles.add_labor(4, "conv2d<complex<float>>", &convolution<std::complex<float>, AVX512>, nullptr);
+	heracles.add_labor(5, "conv2d<complex<double>, AVX>", &convolution<std::complex<double>, AVX>, nullptr);
+	heracles.add_labor(6, "conv2d<float, NONE>", &convolution<float, NONE>, nullptr);
+	heracles.add_labor(7, "conv1d<float>", &convolution_1d<float, AVX512>, nullptr);
+	heracles.add_labor(8, "conv1d<double, AVX>", &convolution_1d<double, AVX>, nullptr);
+	heracles.add_labor(9, "conv_output_size", &invalid_geometry, nullptr);
+
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] convolve_test: " << e.what() << "\n";
+		return -1;
+	}
+	
+	return 0;
+}
@@ -257,6 +257,169 @@ cholesky_decomposition(void* instructions)
 }
 
 
+template<typename T>
+typename base<T>::type
+complex_max_error(T** A, T** B, const size_t M, const size_t N)
+{
+	typename base<T>::type max_error = 0;
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+			max_error = std::max(max_error, std::abs(A[i][j] - B[i][j]));
+	return max_error;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+complex_lu_decomposition(void* instructions) 
+{
+	constexpr size_t N = 6;
+	using R = typename base<T>::type;
+	constexpr R tolerance = std::is_same_v<R, float> ? 1e-5f : 1e-12;
+	
+	auto A = carray<T, 2, S::bytes>(N, N);
+	auto LU = carray<T, 2, S::bytes>(N, N);
+	auto L = carray<T, 2, S::bytes>(N, N);
+	auto U = carray<T, 2, S::bytes>(N, N);
+	auto PA = carray<T, 2, S::bytes>(N, N);
+	auto LU_result = carray<T, 2, S::bytes>(N, N);
+
+	fill_rand(A.get(), N, N);
+	for (size_t i = 0; i < N; ++i)
+		std::copy(A[i], A[i] + N, LU[i]);
+
+	size_t P[N];
+
+	if (!lu::decompose<T, S>(LU.get(), P, N))
+		return std::unexpected{"matrix may be singular"};
+
+	zeros<T, S>(L.get(), N, N);
+	zeros<T, S>(U.get(), N, N);
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			if (i > j)
+				L[i][j] = LU[i][j];
+			else
+				U[i][j] = LU[i][j];
+		}
+	set_identity(L.get(), N, N);
+
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+			PA[i][j] = A[P[i]][j];
+
+	zeros<T, S>(LU_result.get(), N, N);
+	multiply<T, S>(L.get(), U.get(), LU_result.get(), N, N, N);
+
+	R max_error = complex_max_error(PA.get(), LU_result.get(), N, N);
+
+	if (max_error > tolerance)
+	{
+		std::string response = std::format("Reconstruction error ||PA - L*U||_max = {}", max_error);
+		return std::unexpected{response};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+complex_qr_decomposition(void* instructions) 
+{	
+	constexpr size_t M = 6, N = 4;
+	using R = typename base<T>::type;
+	constexpr R tolerance = std::is_same_v<R, float> ? 1e-5f : 1e-12;
+	
+	auto A = carray<T, 2, S::bytes>(M, N);
+	auto Q = carray<T, 2, S::bytes>(M, M);
+	auto Rm = carray<T, 2, S::bytes>(M, N);
+	auto QH = carray<T, 2, S::bytes>(M, M);
+	auto QHQ = carray<T, 2, S::bytes>(M, M);
+	auto QR = carray<T, 2, S::bytes>(M, N);
+	auto I = carray<T, 2, S::bytes>(M, M);
+
+	fill_rand(A.get(), M, N);
+
+	if (!qr::decompose<T, S>(A.get(), Q.get(), Rm.get(), M, N))
+		return std::unexpected{"decomposition failed"};
+
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < std::min(i, N); ++j)
+			if (std::abs(Rm[i][j]) > tolerance)
+				return std::unexpected{"R is not upper triangular"};
+
+	conjugate_transpose<T, S>(Q.get(), QH.get(), M, M);
+	zeros<T, S>(QHQ.get(), M, M);
+	multiply<T, S>(QH.get(), Q.get(), QHQ.get(), M, M, M);
+	identity<T, S>(I.get(), M, M);
+
+	R unitarity_error = complex_max_error(QHQ.get(), I.get(), M, M);
+	if (unitarity_error > tolerance)
+	{
+		std::string response = std::format("Unitarity error ||Q^H*Q - I||_max = {}", unitarity_error);
+		return std::unexpected{response};
+	}
+
+	zeros<T, S>(QR.get(), M, N);
+	multiply<T, S>(Q.get(), Rm.get(), QR.get(), M, M, N);
+
+	R reconstruction_error = complex_max_error(A.get(), QR.get(), M, N);
+	if (reconstruction_error > tolerance)
+	{
+		std::string response = std::format("Reconstruction error ||A - Q*R||_max = {}", reconstruction_error);
+		return std::unexpected{response};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+hermitian_cholesky_decomposition(void* instructions)
+{
+	constexpr size_t N = 6;
+	using R = typename base<T>::type;
+	constexpr R tolerance = std::is_same_v<R, float> ? 1e-5f : 1e-12;
+
+	auto G = carray<T, 2, S::bytes>(N, N);
+	auto GH = carray<T, 2, S::bytes>(N, N);
+	auto A = carray<T, 2, S::bytes>(N, N);
+	auto L = carray<T, 2, S::bytes>(N, N);
+	auto LH = carray<T, 2, S::bytes>(N, N);
+	auto LLH = carray<T, 2, S::bytes>(N, N);
+
+	// Hermitian positive-definite: A = G*G^H + N*I
+	fill_rand(G.get(), N, N);
+	conjugate_transpose<T, S>(G.get(), GH.get(), N, N);
+	identity<T, S>(A.get(), N, N);
+	scalar::unite<T, std::multiplies<>, S>(A.get(), T(N), A.get(), N, N);
+	multiply<T, S>(G.get(), GH.get(), A.get(), N, N, N);
+
+	for (size_t i = 0; i < N; ++i)
+		std::copy(A[i], A[i] + N, L[i]);
+
+	if (!cholesky::decompose<T, S>(L.get(), N))
+		return std::unexpected{"matrix is not positive definite"};
+
+	for (size_t i = 0; i < N; ++i)
+		if (std::abs(std::imag(L[i][i])) > tolerance || std::real(L[i][i]) <= 0)
+			return std::unexpected{"diagonal of L is not real positive"};
+
+	conjugate_transpose<T, S>(L.get(), LH.get(), N, N);
+	zeros<T, S>(LLH.get(), N, N);
+	multiply<T, S>(L.get(), LH.get(), LLH.get(), N, N, N);
+
+	R reconstruction_error = complex_max_error(A.get(), LLH.get(), N, N);
+	if (reconstruction_error > tolerance)
+	{
+		std::string response = std::format("Reconstruction error ||A - L*L^H||_max = {}", reconstruction_error);
+		return std::unexpected{response};
+	}
+
+	return 0;
+}
+
+
 int main(int argc, char* argv[]) 
 {
 
@@ -266,6 +429,10 @@ int main(int argc, char* argv[])
 	heracles.add_labor(0, "lu::decompose", &lu_decomposition<T, AVX512>, nullptr);
 	heracles.add_labor(1, "qr::decompose", &qr_decomposition<T, AVX512>, nullptr);
 	heracles.add_labor(2, "cholesky::decompose", &cholesky_decomposition<T, AVX512>, nullptr);
+	heracles.add_labor(3, "lu::decompose<complex>", &complex_lu_decomposition<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(4, "qr::decompose<complex>", &complex_qr_decomposition<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(5, "cholesky::decompose<complex>", &hermitian_cholesky_decomposition<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(6, "cholesky::decompose<complex<float>>", &hermitian_cholesky_decomposition<std::complex<float>, AVX>, nullptr);
 
 	try 
 	{
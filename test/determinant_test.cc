@@ -0,0 +1,256 @@
+/**
+ * \file determinant_test.cc
+ * \brief unit test for determinant.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+
+#include "test_utils.h"
+#include "broadcast.h"
+#include "determinant.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+template<typename T, typename S>
+std::expected<E, U> 
+lu_determinant(void* instructions) 
+{
+	constexpr size_t N = 4;
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-4f : 1e-10;
+	
+	auto A = carray<T, 2, S::bytes>(N, N);
+
+	// det = -24, requires row interchanges
+	T A_data[N][N] = {
+		{1, 1, 0, 2},
+		{0, 2, 1, 3},
+		{4, 0, 1, 1},
+		{2, 3, 5, 0}
+	};
+
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+			A[i][j] = A_data[i][j];
+
+	const T expected = -24;
+
+	T d = det<T, S>(A.get(), N);
+	if (std::abs(d - expected) > tolerance * std::abs(expected))
+	{
+		std::string response = std::format("det = {}, expected {}", d, expected);
+		return std::unexpected{response};
+	}
+
+	T sign;
+	T logabsdet = slogdet<T, S>(A.get(), N, sign);
+	if (sign != T(-1) || std::abs(logabsdet - std::log(T(24))) > tolerance)
+	{
+		std::string response = std::format("slogdet = ({}, {}), expected (-1, {})", sign, logabsdet, std::log(T(24)));
+		return std::unexpected{response};
+	}
+
+	// Singular input
+	for (size_t j = 0; j < N; ++j)
+		A[3][j] = A[0][j] + A[1][j];
+
+	if (std::abs(det<T, S>(A.get(), N)) > tolerance)
+		return std::unexpected{"singular matrix has nonzero determinant"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+large_logdet(void* instructions)
+{
+	// det(A) = 1e3^N overflows, log det(A) does not
+	constexpr size_t N = 257;
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-4f : 1e-10;
+
+	auto A = carray<T, 2, S::bytes>(N, N);
+	auto L = carray<T, 2, S::bytes>(N, N);
+
+	// Diagonally dominant SPD matrix with known diagonal scaling
+	fill_rand(A.get(), N, N);
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < i; ++j)
+			A[i][j] = A[j][i] = T(1e-3) * A[i][j];
+	for (size_t i = 0; i < N; ++i)
+		A[i][i] = T(1e3);
+
+	for (size_t i = 0; i < N; ++i)
+		std::copy(A[i], A[i] + N, L[i]);
+
+	if (!cholesky::decompose<T, S>(L.get(), N))
+		return std::unexpected{"matrix is not positive definite"};
+
+	const T chol_logdet = cholesky::logdet<T, S>(L.get(), N);
+
+	T sign;
+	const T lu_logdet = slogdet<T, S>(A.get(), N, sign);
+
+	if (sign != T(1))
+		return std::unexpected{"SPD matrix has non-positive determinant"};
+
+	if (!std::isfinite(chol_logdet) || std::abs(chol_logdet - lu_logdet) > tolerance * std::abs(lu_logdet))
+	{
+		std::string response = std::format("cholesky::logdet = {}, slogdet = {}", chol_logdet, lu_logdet);
+		return std::unexpected{response};
+	}
+
+	if (std::abs(chol_logdet - N * std::log(T(1e3))) > T(1e-2) * N)
+	{
+		std::string response = std::format("logdet = {}, expected about {}", chol_logdet, N * std::log(T(1e3)));
+		return std::unexpected{response};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+complex_slogdet(void* instructions)
+{
+	using R = typename base<T>::type;
+	constexpr size_t N = 3;
+	constexpr R tolerance = std::is_same_v<R, float> ? 1e-4f : 1e-10;
+
+	auto A = carray<T, 2, S::bytes>(N, N);
+
+	// Upper triangular with a row interchange: det = -(1+i)(2)(-i) = 2i - 2
+	T A_data[N][N] = {
+		{T(0), T(2), T(5)},
+		{T(1, 1), T(3), T(4)},
+		{T(0), T(0), T(0, -1)}
+	};
+
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+			A[i][j] = A_data[i][j];
+
+	const T expected = T(-2, 2);
+	const T d = det<T, S>(A.get(), N);
+
+	if (std::abs(d - expected) > tolerance)
+	{
+		std::string response = std::format("det = ({}, {}), expected ({}, {})", d.real(), d.imag(), expected.real(), expected.imag());
+		return std::unexpected{response};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+subnormal_logdet(void* instructions)
+{
+	// Diagonal factors below numeric_limits<T>::min() mixed with normal ones
+	constexpr size_t N = 19;
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-5f : 1e-12;
+
+	auto L = carray<T, 2, S::bytes>(N, N);
+	auto P = carray<size_t, 1, S::bytes>(N);
+
+	T expected = 0;
+	for (size_t i = 0; i < N; ++i)
+	{
+		P[i] = i;
+		for (size_t j = 0; j < N; ++j)
+			L[i][j] = (j < i) ? T(1) : T(0);
+
+		L[i][i] = (i % 3 == 2) ? T(i + 1) : std::numeric_limits<T>::denorm_min() * T(3 * i + 1);
+		expected += std::log(L[i][i]);
+	}
+
+	const T chol_logdet = cholesky::logdet<T, S>(L.get(), N);
+	if (std::abs(chol_logdet - 2 * expected) > tolerance * std::abs(2 * expected))
+	{
+		std::string response = std::format("cholesky::logdet = {}, expected {}", chol_logdet, 2 * expected);
+		return std::unexpected{response};
+	}
+
+	T sign;
+	const T lu_logdet = lu::slogdet<T, S>(L.get(), P.get(), N, sign);
+	if (sign != T(1) || std::abs(lu_logdet - expected) > tolerance * std::abs(expected))
+	{
+		std::string response = std::format("lu::slogdet = ({}, {}), expected (1, {})", sign, lu_logdet, expected);
+		return std::unexpected{response};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+scaled_identity(void* instructions)
+{
+	// Perfectly conditioned, but every pivot is below the absolute tolerance of lu::decompose
+	constexpr size_t N = 5;
+	constexpr T scale = std::is_same_v<T, float> ? 1e-7f : 1e-13;
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-5f : 1e-12;
+
+	auto A = carray<T, 2, S::bytes>(N, N);
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+			A[i][j] = (i == j) ? scale : T(0);
+
+	const T expected = N * std::log(scale);
+
+	T sign;
+	const T logabsdet = slogdet<T, S>(A.get(), N, sign);
+	if (sign != T(1) || std::abs(logabsdet - expected) > tolerance * std::abs(expected))
+	{
+		std::string response = std::format("slogdet = ({}, {}), expected (1, {})", sign, logabsdet, expected);
+		return std::unexpected{response};
+	}
+
+	const T d = det<T, S>(A.get(), N);
+	const T ref = std::pow(scale, T(N));
+	if (std::abs(d - ref) > T(1e-4) * ref)
+	{
+		std::string response = std::format("det = {}, expected {}", d, ref);
+		return std::unexpected{response};
+	}
+
+	return 0;
+}
+
+int main(int argc, char* argv[]) 
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "det<double>", &lu_determinant<double, AVX512>, nullptr);
+	heracles.add_labor(1, "det<float>", &lu_determinant<float, AVX>, nullptr);
+	heracles.add_labor(2, "logdet<double>", &large_logdet<double, AVX512>, nullptr);
+	heracles.add_labor(3, "logdet<float>", &large_logdet<float, SSE>, nullptr);
+	heracles.add_labor(4, "det<complex>", &complex_slogdet<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(5, "logdet<double> subnormal", &subnormal_logdet<double, AVX>, nullptr);
+	heracles.add_labor(6, "logdet<float> subnormal", &subnormal_logdet<float, SSE>, nullptr);
+	heracles.add_labor(7, "logdet<double> subnormal, AVX512", &subnormal_logdet<double, AVX512>, nullptr);
+	heracles.add_labor(8, "slogdet<double> scaled identity", &scaled_identity<double, AVX512>, nullptr);
+	heracles.add_labor(9, "slogdet<float> scaled identity", &scaled_identity<float, AVX>, nullptr);
+
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] determinant_test: " << e.what() << "\n";
+		return -1;
+	}
+	
+	return 0;
+}
@@ -0,0 +1,193 @@
+/**
+ * \file distributed_test.cc
+ * \brief unit test for distributed.h, run with mpirun -np 4
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+
+#include "test_utils.h"
+#include "broadcast.h"
+#include "distributed.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+/** \brief A labor passes only if it passes on every rank */
+static bool
+all_ranks(const bool ok)
+{
+	int local = ok, global = 0;
+	MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+	return global;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+layout(void* instructions) 
+{
+	constexpr size_t M = 37, N = 29;
+
+	distributed::grid g;
+	auto A = carray<T, 2, S::bytes>(M, N);
+	auto B = carray<T, 2, S::bytes>(M, N);
+	fill_rand<T>(A.get(), M, N);
+
+	distributed::matrix<T> D(g, M, N, 5, 7);
+	D.scatter(A.get());
+
+	// each local element knows its global position
+	bool ok = true;
+	for (size_t i = 0; i < D.local_rows(); ++i)
+		for (size_t j = 0; j < D.local_cols(); ++j)
+			if (g.rank == 0)
+				ok &= D.local()[i][j] == A[D.global_row(i)][D.global_col(j)];
+
+	size_t total = D.local_rows() * D.local_cols(), all = 0;
+	MPI_Allreduce(&total, &all, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+	ok &= all == M * N;
+
+	D.gather(B.get());
+	if (g.rank == 0)
+		ok &= is_same<T>("gather", A.get(), B.get(), M, N, false);
+
+	if (!all_ranks(ok))
+		return std::unexpected{"scatter/gather round trip"};
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+summa(void* instructions) 
+{
+	struct shape { size_t M, K, N, mb, kb, nb; int P_r, P_c; };
+	int size;
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	for (const shape& s : {shape{64, 64, 64, 16, 16, 16, 0, 0}, 
+						   shape{75, 53, 61, 8, 16, 12, 0, 0}, 
+						   shape{33, 100, 7, 4, 9, 3, 1, size},
+						   shape{10, 3, 90, 4, 2, 16, size, 1}})
+	{
+		distributed::grid g(MPI_COMM_WORLD, s.P_r, s.P_c);
+
+		// every rank builds the same operands
+		auto A = carray<T, 2, S::bytes>(s.M, s.K);
+		auto B = carray<T, 2, S::bytes>(s.K, s.N);
+		auto C = carray<T, 2, S::bytes>(s.M, s.N);
+		auto R = carray<T, 2, S::bytes>(s.M, s.N);
+		fill_rand<T>(A.get(), s.M, s.K);
+		fill_rand<T>(B.get(), s.K, s.N);
+		fill_rand<T>(R.get(), s.M, s.N);
+
+		distributed::matrix<T> dA(g, s.M, s.K, s.mb, s.kb);
+		distributed::matrix<T> dB(g, s.K, s.N, s.kb, s.nb);
+		distributed::matrix<T> dC(g, s.M, s.N, s.mb, s.nb);
+		dA.scatter(A.get());
+		dB.scatter(B.get());
+		dC.scatter(R.get());
+
+		distributed::multiply<T, S>(dA, dB, dC);
+		dC.gather(C.get());
+
+		bool ok = true;
+		if (g.rank == 0)
+		{
+			multiply<T, S>(A.get(), B.get(), R.get(), s.M, s.K, s.N);
+			ok = is_same<T, 1e-3>("summa", C.get(), R.get(), s.M, s.N, false);
+		}
+		if (!all_ranks(ok))
+			return std::unexpected{"distributed multiply differs from multiply"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+distributed_transpose(void* instructions) 
+{
+	constexpr size_t M = 41, N = 27;
+
+	distributed::grid g;
+	auto A = carray<T, 2, S::bytes>(M, N);
+	auto B = carray<T, 2, S::bytes>(N, M);
+	fill_rand<T>(A.get(), M, N);
+
+	distributed::matrix<T> dA(g, M, N, 6, 4);
+	distributed::matrix<T> dB(g, N, M, 4, 6);
+	dA.scatter(A.get());
+	distributed::transpose(dA, dB);
+	dB.gather(B.get());
+
+	bool ok = true;
+	if (g.rank == 0)
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < N; ++j)
+				ok &= B[j][i] == A[i][j];
+
+	if (!all_ranks(ok))
+		return std::unexpected{"distributed transpose"};
+	return 0;
+}
+
+std::expected<E, U> 
+invalid_blocks(void* instructions) 
+{
+	distributed::grid g;
+	distributed::matrix<double> A(g, 8, 8, 4, 4), B(g, 8, 8, 2, 4), C(g, 8, 8, 4, 4);
+	try
+	{
+		distributed::multiply<double>(A, B, C);
+		return std::unexpected{"mismatched block sizes accepted"};
+	}
+	catch (const std::invalid_argument&) {}
+
+	for (const auto [mb, nb] : {std::pair<size_t, size_t>{0, 4}, {4, 0}})
+	{
+		try
+		{
+			distributed::matrix<double> Z(g, 8, 8, mb, nb);
+			return std::unexpected{"zero block size accepted"};
+		}
+		catch (const std::invalid_argument&) {}
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[]) 
+{
+	MPI_Init(&argc, &argv);
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "scatter/gather<double>", &layout<double, AVX512>, nullptr);
+	heracles.add_labor(1, "scatter/gather<complex<float>>", &layout<std::complex<float>, AVX512>, nullptr);
+	heracles.add_labor(2, "summa<double>", &summa<double, AVX512>, nullptr);
+	heracles.add_labor(3, "summa<float, AVX>", &summa<float, AVX>, nullptr);
+	heracles.add_labor(4, "summa<complex<double>>", &summa<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(5, "transpose<double>", &distributed_transpose<double, AVX512>, nullptr);
+	heracles.add_labor(6, "transpose<complex<float>>", &distributed_transpose<std::complex<float>, AVX512>, nullptr);
+	heracles.add_labor(7, "invalid blocks", &invalid_blocks, nullptr);
+
+	int status = 0;
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] distributed_test: " << e.what() << "\n";
+		status = -1;
+	}
+	
+	MPI_Finalize();
+	return status;
+}
@@ -0,0 +1,289 @@
+/**
+ * \file eig_test.cc
+ * \brief unit test for eig.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include "test_utils.h"
+#include "eig.h"
+#include "decompose.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+template<typename T>
+static double
+tolerance()
+{
+	return std::is_same_v<typename base<T>::type, float> ? 1e-4 : 1e-11;
+}
+
+/** \brief Largest |Qᴴ·Q - I| */
+template<typename T>
+static double
+orthogonality(T** Q, const size_t N)
+{
+	double err = 0;
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			T s = T(0);
+			for (size_t k = 0; k < N; ++k)
+				s += conjugate(Q[k][i]) * Q[k][j];
+			err = std::max(err, double(std::abs(s - T(i == j ? 1 : 0))));
+		}
+	return err;
+}
+
+/** \brief Largest |Z·T·Zᴴ - A| relative to the largest |A| */
+template<typename T>
+static double
+reconstruction(T** A, T** Z, T** H, const size_t N)
+{
+	std::vector<T> ZT(N * N, T(0));
+	for (size_t i = 0; i < N; ++i)
+		for (size_t k = 0; k < N; ++k)
+			for (size_t j = 0; j < N; ++j)
+				ZT[i * N + j] += Z[i][k] * H[k][j];
+
+	double err = 0, scale = 1e-30;
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			T s = T(0);
+			for (size_t k = 0; k < N; ++k)
+				s += ZT[i * N + k] * conjugate(Z[j][k]);
+			err = std::max(err, double(std::abs(s - A[i][j])));
+			scale = std::max(scale, double(std::abs(A[i][j])));
+		}
+	return err / scale;
+}
+
+/** \brief Random unitary matrix from the QR decomposition of a random one */
+template<typename T, typename S>
+static void
+random_unitary(T** Q, const size_t N, const unsigned seed)
+{
+	auto A = carray<T, 2, S::bytes>(N, N);
+	auto R = carray<T, 2, S::bytes>(N, N);
+	fill_rand<T>(A.get(), N, N, seed);
+	qr::decompose<T, S>(A.get(), Q, R.get(), N, N);
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+hessenberg_form(void* instructions)
+{
+	for (const size_t N : {1, 2, 5, 40, 129, 200})
+	{
+		auto A = carray<T, 2, S::bytes>(N, N);
+		auto H = carray<T, 2, S::bytes>(N, N);
+		auto Q = carray<T, 2, S::bytes>(N, N);
+		fill_rand<T>(A.get(), N, N, unsigned(N));
+		for (size_t i = 0; i < N; ++i)
+			std::copy(A[i], A[i] + N, H[i]);
+
+		eig::hessenberg<T, S>(H.get(), N, Q.get());
+
+		for (size_t i = 2; i < N; ++i)
+			for (size_t j = 0; j + 1 < i; ++j)
+				if (H[i][j] != T(0))
+					return std::unexpected{"not upper Hessenberg"};
+
+		if (orthogonality(Q.get(), N) > tolerance<T>() * N)
+			return std::unexpected{"Q not unitary"};
+		if (reconstruction(A.get(), Q.get(), H.get(), N) > tolerance<T>() * N)
+			return std::unexpected{"Q·H·Qᴴ differs from A"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+schur_form(void* instructions)
+{
+	for (const size_t N : {1, 2, 3, 10, 50, 160, 300})
+	{
+		auto A = carray<T, 2, S::bytes>(N, N);
+		auto H = carray<T, 2, S::bytes>(N, N);
+		auto Z = carray<T, 2, S::bytes>(N, N);
+		std::vector<std::complex<typename base<T>::type>> w(N);
+		fill_rand<T>(A.get(), N, N, unsigned(N) + 7);
+		for (size_t i = 0; i < N; ++i)
+			std::copy(A[i], A[i] + N, H[i]);
+
+		if (!eig::general<T, S>(H.get(), w.data(), N, Z.get()))
+			return std::unexpected{"QR iteration did not converge"};
+
+		// Triangular, or quasi triangular with isolated 2×2 blocks for real types
+		for (size_t i = 1; i < N; ++i)
+		{
+			for (size_t j = 0; j + 1 < i; ++j)
+				if (H[i][j] != T(0))
+					return std::unexpected{"not quasi triangular"};
+			if (H[i][i - 1] != T(0))
+			{
+				if (is_complex_v<T> || (i > 1 && H[i - 1][i - 2] != T(0)))
+					return std::unexpected{"bad diagonal block"};
+				if (w[i].imag() == 0)
+					return std::unexpected{"2×2 block with real eigenvalues"};
+			}
+		}
+
+		if (orthogonality(Z.get(), N) > tolerance<T>() * N)
+			return std::unexpected{"Z not unitary"};
+		if (reconstruction(A.get(), Z.get(), H.get(), N) > tolerance<T>() * N)
+			return std::unexpected{"Z·T·Zᴴ differs from A"};
+
+		// Sum of the eigenvalues is the trace
+		std::complex<double> trace = 0, sum = 0;
+		for (size_t i = 0; i < N; ++i)
+		{
+			trace += std::complex<double>(A[i][i]);
+			sum += std::complex<double>(w[i]);
+		}
+		if (std::abs(trace - sum) > tolerance<T>() * N * 10)
+			return std::unexpected{"eigenvalues do not sum to the trace"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+known_spectrum(void* instructions)
+{
+	using R = typename base<T>::type;
+	using C = std::complex<R>;
+
+	for (const size_t N : {8, 64, 250})
+	{
+		// T0 = upper triangular with a mildly coupled, well separated spectrum;
+		// real types get complex pairs as 2×2 blocks [a b; -b a]
+		auto T0 = carray<T, 2, S::bytes>(N, N);
+		fill_rand<T>(T0.get(), N, N, unsigned(N) + 3);
+		std::vector<C> expect;
+		for (size_t i = 0; i < N; ++i)
+		{
+			for (size_t j = 0; j < i; ++j)
+				T0[i][j] = T(0);
+			for (size_t j = i + 1; j < N; ++j)
+				T0[i][j] *= R(0.1);
+		}
+		for (size_t i = 0; i < N; )
+		{
+			const R a = R(i) / R(4) - R(N) / R(8);
+			if constexpr (!is_complex_v<T>)
+				if (i % 3 == 0 && i + 1 < N)
+				{
+					const R b = R(1) + R(i % 7) / R(4);
+					T0[i][i] = a; T0[i][i + 1] = b;
+					T0[i + 1][i] = -b; T0[i + 1][i + 1] = a;
+					expect.emplace_back(a, b);
+					expect.emplace_back(a, -b);
+					i += 2;
+					continue;
+				}
+			if constexpr (is_complex_v<T>)
+				T0[i][i] = T(a, R(i % 5) - R(2));
+			else
+				T0[i][i] = a;
+			expect.push_back(C(T0[i][i]));
+			i += 1;
+		}
+
+		auto Q = carray<T, 2, S::bytes>(N, N);
+		auto A = carray<T, 2, S::bytes>(N, N);
+		random_unitary<T, S>(Q.get(), N, unsigned(N));
+		std::vector<T> QT(N * N, T(0));
+		for (size_t i = 0; i < N; ++i)
+			for (size_t k = 0; k < N; ++k)
+				for (size_t l = 0; l < N; ++l)
+					QT[i * N + l] += Q[i][k] * T0[k][l];
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+			{
+				T s = T(0);
+				for (size_t l = 0; l < N; ++l)
+					s += QT[i * N + l] * conjugate(Q[j][l]);
+				A[i][j] = s;
+			}
+
+		std::vector<C> w(N);
+		if (!eig::general<T, S>(A.get(), w.data(), N))
+			return std::unexpected{"QR iteration did not converge"};
+
+		// Each expected eigenvalue has its own computed match
+		std::vector<bool> used(N, false);
+		for (const C& e : expect)
+		{
+			size_t best = N;
+			for (size_t i = 0; i < N; ++i)
+				if (!used[i] && (best == N || std::abs(w[i] - e) < std::abs(w[best] - e)))
+					best = i;
+			used[best] = true;
+			if (std::abs(w[best] - e) > tolerance<T>() * 100 * std::max<R>(R(1), std::abs(e)))
+				return std::unexpected{"eigenvalue not recovered"};
+		}
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+invalid(void* instructions)
+{
+	T** A = nullptr;
+	std::vector<std::complex<typename base<T>::type>> w(4);
+	try
+	{
+		eig::general<T, S>(A, w.data(), 4);
+	}
+	catch (const std::runtime_error&)
+	{
+		return 0;
+	}
+	return std::unexpected{"null matrix accepted"};
+}
+
+int main(int argc, char* argv[])
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "eig::hessenberg<double>", &hessenberg_form<double, AVX512>, nullptr);
+	heracles.add_labor(1, "eig::hessenberg<complex<double>, AVX>", &hessenberg_form<std::complex<double>, AVX>, nullptr);
+	heracles.add_labor(2, "eig::hessenberg<float, SSE>", &hessenberg_form<float, SSE>, nullptr);
+	heracles.add_labor(3, "eig::general<double>", &schur_form<double, AVX512>, nullptr);
+	heracles.add_labor(4, "eig::general<complex<double>>", &schur_form<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(5, "eig::general<double, NONE>", &schur_form<double, NONE>, nullptr);
+	heracles.add_labor(6, "eig::general<double> spectrum", &known_spectrum<double, AVX512>, nullptr);
+	heracles.add_labor(7, "eig::general<complex<double>, AVX> spectrum", &known_spectrum<std::complex<double>, AVX>, nullptr);
+	heracles.add_labor(8, "eig::general<float> spectrum", &known_spectrum<float, AVX512>, nullptr);
+	heracles.add_labor(9, "eig::general<double> invalid", &invalid<double, AVX512>, nullptr);
+
+	try
+	{
+		heracles.perform_labors();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "[EXCEPT] eig_test: " << e.what() << "\n";
+		return -1;
+	}
+
+	return 0;
+}
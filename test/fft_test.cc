@@ -0,0 +1,253 @@
+/**
+ * \file fft_test.cc
+ * \brief unit test for fft.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <numbers>
+#include <vector>
+
+#include "test_utils.h"
+#include "fft.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+/** \brief Direct O(n²) DFT of x with the sign of exponent given by dir, in long double */
+template<typename T>
+static std::vector<T>
+dft(const T* x, const size_t n, const size_t stride, const fft::Direction dir)
+{
+	const long double sign = dir == fft::Direction::FORWARD ? -1 : 1;
+	std::vector<std::complex<long double>> w(n);
+	for (size_t t = 0; t < n; ++t)
+		w[t] = std::polar(1.0L, sign * 2 * std::numbers::pi_v<long double> * t / n);
+
+	std::vector<T> X(n);
+	for (size_t q = 0; q < n; ++q)
+	{
+		std::complex<long double> acc = 0;
+		for (size_t t = 0; t < n; ++t)
+			acc += std::complex<long double>(x[t * stride].real(), x[t * stride].imag()) * w[(q * t) % n];
+		if (dir == fft::Direction::INVERSE)
+			acc /= n;
+		X[q] = T(acc.real(), acc.imag());
+	}
+	return X;
+}
+
+/** \brief Largest |a - b| relative to the largest |b| */
+template<typename T>
+static double
+relative_error(const T* a, const T* b, const size_t n)
+{
+	double err = 0, scale = 1e-30;
+	for (size_t i = 0; i < n; ++i)
+	{
+		err = std::max(err, double(std::abs(a[i] - b[i])));
+		scale = std::max(scale, double(std::abs(b[i])));
+	}
+	return err / scale;
+}
+
+template<typename T>
+static double
+tolerance()
+{
+	return std::is_same_v<typename base<T>::type, float> ? 2e-5 : 1e-12;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+complex_rows(void* instructions)
+{
+	for (const size_t N : {1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 30, 32, 64, 97, 128, 210, 256, 1000, 1024, 4096})
+	{
+		constexpr size_t M = 3;
+		auto A = carray<T, 2, S::bytes>(M, N);
+		auto B = carray<T, 2, S::bytes>(M, N);
+		fill_rand<T>(A.get(), M, N, unsigned(N));
+
+		const fft::plan<T> p(N);
+		fft::fft<T, S>(p, A.get(), B.get(), M);
+
+		for (size_t i = 0; i < M; ++i)
+		{
+			const auto X = dft(A[i], N, 1, fft::Direction::FORWARD);
+			if (relative_error(B[i], X.data(), N) > tolerance<T>())
+				return std::unexpected{"forward transform differs from the DFT"};
+		}
+
+		// In place inverse returns the input
+		fft::fft<T, S>(p, B.get(), B.get(), M, fft::Direction::INVERSE);
+		for (size_t i = 0; i < M; ++i)
+			if (relative_error(B[i], A[i], N) > tolerance<T>())
+				return std::unexpected{"inverse does not invert"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+long_sequence(void* instructions)
+{
+	// One row longer than the threshold where passes are split across threads
+	for (const size_t N : {size_t(1) << 16, size_t(3) << 14 })
+	{
+		auto A = carray<T, 2, S::bytes>(1, N);
+		auto B = carray<T, 2, S::bytes>(1, N);
+		fill_rand<T>(A.get(), 1, N, 5);
+
+		fft::fft<T, S>(A.get(), B.get(), 1, N);
+
+		// Spot check frequencies against the direct sum
+		for (const size_t q : {size_t(0), size_t(1), size_t(777), N / 2, N - 1})
+		{
+			std::complex<long double> acc = 0;
+			for (size_t t = 0; t < N; ++t)
+				acc += std::complex<long double>(A[0][t].real(), A[0][t].imag())
+					* std::polar(1.0L, -2 * std::numbers::pi_v<long double> * ((q * t) % N) / N);
+			if (std::abs(std::complex<double>(acc) - std::complex<double>(B[0][q])) > 1e-6 * std::sqrt(double(N)) * 10)
+				return std::unexpected{"long transform differs from the direct sum"};
+		}
+
+		fft::fft<T, S>(B.get(), B.get(), 1, N, fft::Direction::INVERSE);
+		if (relative_error(B[0], A[0], N) > tolerance<T>() * 10)
+			return std::unexpected{"long inverse does not invert"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+two_dimensional(void* instructions)
+{
+	constexpr size_t M = 12, N = 20;
+	auto A = carray<T, 2, S::bytes>(M, N);
+	auto B = carray<T, 2, S::bytes>(M, N);
+	auto C = carray<T, 2, S::bytes>(M, N);
+	fill_rand<T>(A.get(), M, N, 9);
+
+	// Columns alone
+	fft::fft_columns<T, S>(A.get(), C.get(), M, N);
+	for (size_t j = 0; j < N; ++j)
+	{
+		const auto X = dft(A[0] + j, M, N, fft::Direction::FORWARD);
+		for (size_t i = 0; i < M; ++i)
+			if (std::abs(C[i][j] - X[i]) > tolerance<T>() * 100)
+				return std::unexpected{"column transform"};
+	}
+
+	// Rows of the column transform give the 2D transform
+	fft::fft2<T, S>(A.get(), B.get(), M, N);
+	for (size_t i = 0; i < M; ++i)
+	{
+		const auto X = dft(C[i], N, 1, fft::Direction::FORWARD);
+		if (relative_error(B[i], X.data(), N) > tolerance<T>() * 10)
+			return std::unexpected{"2D transform"};
+	}
+
+	fft::fft2<T, S>(B.get(), B.get(), M, N, fft::Direction::INVERSE);
+	for (size_t i = 0; i < M; ++i)
+		if (relative_error(B[i], A[i], N) > tolerance<T>() * 10)
+			return std::unexpected{"2D inverse"};
+
+	return 0;
+}
+
+template<typename R, typename S>
+std::expected<E, U>
+real_transforms(void* instructions)
+{
+	using T = std::complex<R>;
+
+	for (const size_t N : {1, 2, 3, 8, 9, 30, 64, 100, 243, 512})
+	{
+		constexpr size_t M = 4;
+		const size_t H = N / 2 + 1;
+		auto A = carray<R, 2, S::bytes>(M, N);
+		auto X = carray<T, 2, S::bytes>(M, H);
+		auto B = carray<R, 2, S::bytes>(M, N);
+		fill_rand<R>(A.get(), M, N, unsigned(N));
+
+		fft::rfft<R, S>(A.get(), X.get(), M, N);
+
+		for (size_t i = 0; i < M; ++i)
+		{
+			std::vector<T> row(A[i], A[i] + N);
+			const auto full = dft(row.data(), N, 1, fft::Direction::FORWARD);
+			if (relative_error(X[i], full.data(), H) > tolerance<T>() * 10)
+				return std::unexpected{"real transform differs from the DFT"};
+		}
+
+		fft::irfft<R, S>(X.get(), B.get(), M, N);
+		for (size_t i = 0; i < M; ++i)
+			if (relative_error(B[i], A[i], N) > tolerance<T>() * 10)
+				return std::unexpected{"irfft does not invert rfft"};
+	}
+
+	// 2D real round trip and agreement with the complex 2D transform
+	constexpr size_t M = 6, N = 10, H = N / 2 + 1;
+	auto A = carray<R, 2, S::bytes>(M, N);
+	auto Ac = carray<T, 2, S::bytes>(M, N);
+	auto X = carray<T, 2, S::bytes>(M, H);
+	auto B = carray<R, 2, S::bytes>(M, N);
+	fill_rand<R>(A.get(), M, N, 17);
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+			Ac[i][j] = A[i][j];
+
+	fft::rfft2<R, S>(A.get(), X.get(), M, N);
+	fft::fft2<T, S>(Ac.get(), Ac.get(), M, N);
+	for (size_t i = 0; i < M; ++i)
+		if (relative_error(X[i], Ac[i], H) > tolerance<T>() * 10)
+			return std::unexpected{"rfft2 differs from fft2"};
+
+	fft::irfft2<R, S>(X.get(), B.get(), M, N);
+	for (size_t i = 0; i < M; ++i)
+		if (relative_error(B[i], A[i], N) > tolerance<T>() * 10)
+			return std::unexpected{"irfft2 does not invert rfft2"};
+
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "fft<complex<double>>", &complex_rows<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(1, "fft<complex<float>>", &complex_rows<std::complex<float>, AVX512>, nullptr);
+	heracles.add_labor(2, "fft<complex<double>, AVX>", &complex_rows<std::complex<double>, AVX>, nullptr);
+	heracles.add_labor(3, "fft<complex<float>, SSE>", &complex_rows<std::complex<float>, SSE>, nullptr);
+	heracles.add_labor(4, "fft<complex<double>, SSE>", &complex_rows<std::complex<double>, SSE>, nullptr);
+	heracles.add_labor(5, "fft<complex<double>, NONE>", &complex_rows<std::complex<double>, NONE>, nullptr);
+	heracles.add_labor(6, "fft<complex<double>> long", &long_sequence<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(7, "fft2<complex<double>>", &two_dimensional<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(8, "fft2<complex<float>, AVX>", &two_dimensional<std::complex<float>, AVX>, nullptr);
+	heracles.add_labor(9, "rfft<double>", &real_transforms<double, AVX512>, nullptr);
+	heracles.add_labor(10, "rfft<float, AVX>", &real_transforms<float, AVX>, nullptr);
+
+	try
+	{
+		heracles.perform_labors();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "[EXCEPT] fft_test: " << e.what() << "\n";
+		return -1;
+	}
+
+	return 0;
+}
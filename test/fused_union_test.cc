@@ -266,6 +266,28 @@ void test_all_ops()
 	test_matrix_op<T, FusionPolicy::FUSION_FIRST, std::divides<>, std::divides<>>("(A / B) / D");
 }	
 
+// Integer elements truncate the fractional fills, so divisions are limited to nonzero divisors
+template<typename T>
+void test_integer_ops()
+{
+	test_scalar_op_rhs<T, FusionPolicy::UNION_FIRST, std::plus<>, std::multiplies<>>("(A + B) * D", 3);
+	test_scalar_op_rhs<T, FusionPolicy::UNION_FIRST, std::multiplies<>, std::plus<>>("(A * B) + D", 5);
+	test_scalar_op_rhs<T, FusionPolicy::UNION_FIRST, std::multiplies<>, std::minus<>>("(A * B) - D", 5);
+	test_scalar_op_rhs<T, FusionPolicy::UNION_FIRST, std::multiplies<>, std::divides<>>("(A * B) / D", 4);
+	test_scalar_op_rhs<T, FusionPolicy::FUSION_FIRST, std::plus<>, std::multiplies<>>("A + (B * D)", -3);
+	test_scalar_op_rhs<T, FusionPolicy::FUSION_FIRST, std::minus<>, std::multiplies<>>("A - (B * D)", -3);
+
+	test_scalar_op_lhs<T, FusionPolicy::UNION_FIRST, std::minus<>, std::multiplies<>>("D * (A - B)", 3);
+	test_scalar_op_lhs<T, FusionPolicy::FUSION_FIRST, std::plus<>, std::multiplies<>>("A + (D * B)", 7);
+	test_scalar_op_lhs<T, FusionPolicy::FUSION_FIRST, std::minus<>, std::minus<>>("A - (D - B)", 7);
+
+	test_matrix_op<T, FusionPolicy::UNION_FIRST, std::plus<>, std::minus<>>("(A + B) - D");
+	test_matrix_op<T, FusionPolicy::UNION_FIRST, std::multiplies<>, std::plus<>>("(A * B) + D");
+	test_matrix_op<T, FusionPolicy::UNION_FIRST, std::minus<>, std::multiplies<>>("(A - B) * D");
+	test_matrix_op<T, FusionPolicy::FUSION_FIRST, std::plus<>, std::multiplies<>>("A + (B * D)");
+	test_matrix_op<T, FusionPolicy::FUSION_FIRST, std::minus<>, std::multiplies<>>("A - (B * D)");
+}
+
 int main(int argc, char* argv[]) 
 {
 	try
@@ -274,6 +296,9 @@ int main(int argc, char* argv[])
 		test_all_ops<double>();
 		test_all_ops<std::complex<float>>();
 		test_all_ops<std::complex<double>>();
+		test_integer_ops<int16_t>();
+		test_integer_ops<int32_t>();
+		test_integer_ops<int64_t>();
 	}
 	catch(const std::exception& e)
 	{
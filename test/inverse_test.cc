@@ -76,6 +76,54 @@ lu_inverse(void* instructions)
 	return 0;
 }
 
+template<typename T, typename S>
+std::expected<E, U> 
+pivoted_lu_inverse(void* instructions) 
+{
+	constexpr size_t N = 4;
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-5f : 1e-12;
+	
+	auto A = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto A_lu = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto A_inv = aligned_alloc_2D<T, S::bytes>(N, N);
+	
+	// Partial pivoting visits the rows as a 4-cycle, so P is not its own inverse
+	T A_data[4][4] = {
+		{1, 2, 3, 4},
+		{10, 1, 0, 2},
+		{0, 20, 1, 1},
+		{0, 0, 30, 1}
+	};
+	
+	for (size_t i = 0; i < N; ++i) 
+		for (size_t j = 0; j < N; ++j)
+		{
+			A_lu[i][j] = A_data[i][j];
+			A[i][j] = A_data[i][j]; 
+		} 
+	
+	if (!lu::inverse<T, S>(A_lu.get(), A_inv.get(), N))
+		return std::unexpected("matrix is singular");
+
+	auto I = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto I_lu = aligned_alloc_2D<T, S::bytes>(N, N);
+
+	identity<T, S>(I.get(), N, N);
+	zeros<T, S>(I_lu.get(), N, N);
+
+	multiply<T>(A.get(), A_inv.get(), I_lu.get(), N, N, N);
+	
+	T lu_error = matrix_max_error(I.get(), I_lu.get(), N, N);
+	
+	if (lu_error > tolerance)
+	{
+		std::string response = std::format("inversion error: {}", lu_error);
+		return std::unexpected(response);
+	}
+
+	return 0;
+}
+
 template<typename T, typename S>
 std::expected<E, U> 
 qr_inverse(void* instructions) 
@@ -131,6 +179,140 @@ qr_inverse(void* instructions)
 	return 0;
 }
 
+template<typename T, typename S>
+std::expected<E, U> 
+cholesky_inverse(void* instructions) 
+{
+	constexpr size_t N = 67;
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-5f : 1e-12;
+	
+	auto G = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto Gt = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto A = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto A_chol = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto A_inv = aligned_alloc_2D<T, S::bytes>(N, N);
+
+	// SPD: A = G*G^T + N*I
+	fill_rand(G.get(), N, N);
+	zeros<T, S>(Gt.get(), N, N);
+	transpose<T, S>(G.get(), Gt.get(), N, N);
+	identity<T, S>(A.get(), N, N);
+	scalar::unite<T, std::multiplies<>, S>(A.get(), T(N), A.get(), N, N);
+	multiply<T, S>(G.get(), Gt.get(), A.get(), N, N, N);
+
+	for (size_t i = 0; i < N; ++i)
+		std::copy(A[i], A[i] + N, A_chol[i]);
+
+	if (!cholesky::inverse<T, S>(A_chol.get(), A_inv.get(), N))
+		return std::unexpected("matrix is not positive definite");
+
+	auto I = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto I_chol = aligned_alloc_2D<T, S::bytes>(N, N);
+
+	identity<T, S>(I.get(), N, N);
+	zeros<T, S>(I_chol.get(), N, N);
+
+	multiply<T, S>(A.get(), A_inv.get(), I_chol.get(), N, N, N);
+
+	T chol_error = matrix_max_error(I.get(), I_chol.get(), N, N);
+
+	if (chol_error > tolerance)
+	{
+		std::string response = std::format("inversion error: {}", chol_error);
+		return std::unexpected(response);
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+gauss_jordan_inverse(void* instructions) 
+{
+	// N is not a multiple of the panel width so the last panel is partial
+	constexpr size_t N = 101;
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-4f : 1e-10;
+	
+	auto A = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto A_inv = aligned_alloc_2D<T, S::bytes>(N, N);
+
+	fill_rand(A.get(), N, N);
+
+	for (size_t i = 0; i < N; ++i)
+		std::copy(A[i], A[i] + N, A_inv[i]);
+
+	if (!gauss_jordan::inverse<T, S>(A_inv.get(), N))
+		return std::unexpected("matrix is singular");
+
+	auto I = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto I_gj = aligned_alloc_2D<T, S::bytes>(N, N);
+
+	identity<T, S>(I.get(), N, N);
+	zeros<T, S>(I_gj.get(), N, N);
+
+	multiply<T, S>(A.get(), A_inv.get(), I_gj.get(), N, N, N);
+
+	T gj_error = matrix_max_error(I.get(), I_gj.get(), N, N);
+
+	if (gj_error > tolerance)
+	{
+		std::string response = std::format("inversion error: {}", gj_error);
+		return std::unexpected(response);
+	}
+
+	// A singular matrix must be rejected
+	for (size_t j = 0; j < N; ++j)
+		A[N - 1][j] = A[0][j];
+
+	if (gauss_jordan::inverse<T, S>(A.get(), N))
+		return std::unexpected("singular matrix was inverted");
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+gauss_jordan_large_pivot(void* instructions) 
+{
+	// |pivot| >> 1: scaling the pivot row as c + (1/pivot - 1) c cancels
+	constexpr size_t N = 37;
+	constexpr T scale = std::is_same_v<T, float> ? 1e4f : 1e8;
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-4f : 1e-10;
+	
+	auto A = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto A_inv = aligned_alloc_2D<T, S::bytes>(N, N);
+
+	fill_rand(A.get(), N, N);
+	for (size_t i = 0; i < N; ++i)
+	{
+		A[i][i] += T(N);
+		for (size_t j = 0; j < N; ++j)
+			A[i][j] *= scale;
+		std::copy(A[i], A[i] + N, A_inv[i]);
+	}
+
+	if (!gauss_jordan::inverse<T, S>(A_inv.get(), N))
+		return std::unexpected("matrix is singular");
+
+	auto I = aligned_alloc_2D<T, S::bytes>(N, N);
+	auto I_gj = aligned_alloc_2D<T, S::bytes>(N, N);
+
+	identity<T, S>(I.get(), N, N);
+	zeros<T, S>(I_gj.get(), N, N);
+
+	multiply<T, S>(A.get(), A_inv.get(), I_gj.get(), N, N, N);
+
+	T gj_error = matrix_max_error(I.get(), I_gj.get(), N, N);
+
+	if (gj_error > tolerance)
+	{
+		std::string response = std::format("inversion error: {}", gj_error);
+		return std::unexpected(response);
+	}
+
+	return 0;
+}
+
 int main(int argc, char* argv[]) 
 {
 	using T = double;
@@ -140,6 +322,13 @@ int main(int argc, char* argv[])
 
 		heracles.add_labor(0, "LU inverse", &lu_inverse<T, AVX512>, nullptr);
 		heracles.add_labor(1, "QR inverse", &qr_inverse<T, AVX512>, nullptr);
+		heracles.add_labor(2, "Cholesky inverse", &cholesky_inverse<T, AVX512>, nullptr);
+		heracles.add_labor(3, "Cholesky inverse<float>", &cholesky_inverse<float, AVX>, nullptr);
+		heracles.add_labor(4, "Gauss-Jordan inverse", &gauss_jordan_inverse<T, AVX512>, nullptr);
+		heracles.add_labor(5, "Gauss-Jordan inverse<float>", &gauss_jordan_inverse<float, SSE>, nullptr);
+		heracles.add_labor(6, "Gauss-Jordan inverse (large pivots)", &gauss_jordan_large_pivot<T, AVX512>, nullptr);
+		heracles.add_labor(7, "Gauss-Jordan inverse<float> (large pivots)", &gauss_jordan_large_pivot<float, AVX>, nullptr);
+		heracles.add_labor(8, "LU inverse (pivoted)", &pivoted_lu_inverse<T, AVX512>, nullptr);
 
 		heracles.perform_labors();
 
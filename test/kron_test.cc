@@ -0,0 +1,131 @@
+/**
+ * \file kron_test.cc
+ * \brief unit test for kron.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+
+#include "test_utils.h"
+#include "broadcast.h"
+#include "kron.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+template<typename T, typename S>
+std::expected<E, U> 
+kronecker(void* instructions) 
+{
+	constexpr size_t m = 5, n = 7, p = 6, q = 19;
+
+	auto A = carray<T, 2, S::bytes>(m, n);
+	auto B = carray<T, 2, S::bytes>(p, q);
+	auto C = carray<T, 2, S::bytes>(m * p, n * q);
+	fill_rand<T>(A.get(), m, n);
+	fill_rand<T>(B.get(), p, q);
+
+	kron<T, S>(A.get(), B.get(), C.get(), m, n, p, q);
+
+	for (size_t i = 0; i < m; ++i)
+		for (size_t j = 0; j < n; ++j)
+			for (size_t k = 0; k < p; ++k)
+				for (size_t l = 0; l < q; ++l)
+					if (!approx_equal(C[i * p + k][j * q + l], A[i][j] * B[k][l], 1e-6, 1e-6))
+						return std::unexpected{"kron element"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+khatri_rao_product(void* instructions) 
+{
+	constexpr size_t m = 9, p = 4, n = 37;
+
+	auto A = carray<T, 2, S::bytes>(m, n);
+	auto B = carray<T, 2, S::bytes>(p, n);
+	auto C = carray<T, 2, S::bytes>(m * p, n);
+	fill_rand<T>(A.get(), m, n);
+	fill_rand<T>(B.get(), p, n);
+
+	khatri_rao<T, S>(A.get(), B.get(), C.get(), m, p, n);
+
+	for (size_t i = 0; i < m; ++i)
+		for (size_t k = 0; k < p; ++k)
+			for (size_t j = 0; j < n; ++j)
+				if (!approx_equal(C[i * p + k][j], A[i][j] * B[k][j], 1e-6, 1e-6))
+					return std::unexpected{"khatri_rao element"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+structured_multiply(void* instructions) 
+{
+	constexpr size_t m = 13, n = 11, p = 17, q = 9;
+
+	auto A = carray<T, 2, S::bytes>(m, n);
+	auto B = carray<T, 2, S::bytes>(p, q);
+	auto K = carray<T, 2, S::bytes>(m * p, n * q);
+	fill_rand<T>(A.get(), m, n);
+	fill_rand<T>(B.get(), p, q);
+	kron<T, S>(A.get(), B.get(), K.get(), m, n, p, q);
+
+	for (size_t r : {1, 3, 20})
+	{
+		auto X = carray<T, 2, S::bytes>(n * q, r);
+		auto Y = carray<T, 2, S::bytes>(m * p, r);
+		auto R = carray<T, 2, S::bytes>(m * p, r);
+		fill_rand<T>(X.get(), n * q, r);
+		zeros<T, S>(Y.get(), m * p, r);
+		zeros<T, S>(R.get(), m * p, r);
+
+		kron_multiply<T, S>(A.get(), B.get(), X.get(), Y.get(), m, n, p, q, r);
+		multiply<T, S>(K.get(), X.get(), R.get(), m * p, n * q, r);
+
+		if (!is_same<T, 1e-3>("kron_multiply", Y.get(), R.get(), m * p, r, false))
+			return std::unexpected{"kron_multiply differs from explicit product"};
+	}
+
+	return 0;
+}
+
+int main(int argc, char* argv[]) 
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "kron<float>", &kronecker<float, AVX512>, nullptr);
+	heracles.add_labor(1, "kron<double, AVX>", &kronecker<double, AVX>, nullptr);
+	heracles.add_labor(2, "kron<complex<float>, SSE>", &kronecker<std::complex<float>, SSE>, nullptr);
+	heracles.add_labor(3, "kron<complex<double>>", &kronecker<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(4, "kron<double, NONE>", &kronecker<double, NONE>, nullptr);
+	heracles.add_labor(5, "khatri_rao<float>", &khatri_rao_product<float, AVX512>, nullptr);
+	heracles.add_labor(6, "khatri_rao<double, SSE>", &khatri_rao_product<double, SSE>, nullptr);
+	heracles.add_labor(7, "khatri_rao<complex<float>, AVX>", &khatri_rao_product<std::complex<float>, AVX>, nullptr);
+	heracles.add_labor(8, "kron_multiply<double>", &structured_multiply<double, AVX512>, nullptr);
+	heracles.add_labor(9, "kron_multiply<float, AVX>", &structured_multiply<float, AVX>, nullptr);
+	heracles.add_labor(10, "kron_multiply<complex<double>>", &structured_multiply<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(11, "kron_multiply<double, NONE>", &structured_multiply<double, NONE>, nullptr);
+
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] kron_test: " << e.what() << "\n";
+		return -1;
+	}
+	
+	return 0;
+}
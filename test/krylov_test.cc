@@ -0,0 +1,398 @@
+/**
+ * \file krylov_test.cc
+ * \brief unit test for krylov.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include "test_utils.h"
+#include "krylov.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+template<typename T>
+static double
+tolerance()
+{
+	return std::is_same_v<typename base<T>::type, float> ? 2e-3 : 1e-7;
+}
+
+/** \brief A = Q·D·Qᴴ (N×N) with a random unitary Q and D = diag(d) */
+template<typename T, typename S>
+static void
+hermitian(T** A, const std::vector<typename base<T>::type>& d, const unsigned seed)
+{
+	const size_t N = d.size();
+	auto G = carray<T, 2, S::bytes>(N, N);
+	auto Q = carray<T, 2, S::bytes>(N, N);
+	auto R = carray<T, 2, S::bytes>(N, N);
+	fill_rand<T>(G.get(), N, N, seed);
+	qr::decompose<T, S>(G.get(), Q.get(), R.get(), N, N);
+
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			T s = T(0);
+			for (size_t l = 0; l < N; ++l)
+				s += Q[i][l] * d[l] * conjugate(Q[j][l]);
+			A[i][j] = s;
+		}
+}
+
+/** \brief Largest ‖A·x - λ·x‖ / max(|λ|, 1) over the rows of X */
+template<typename T, typename V, typename L, typename Op>
+static double
+residual(Op& op, const size_t N, const L* w, V** X, const size_t k)
+{
+	double worst = 0;
+	std::vector<T> x(N), y(N);
+	for (size_t i = 0; i < k; ++i)
+	{
+		if constexpr (is_complex_v<V> && !is_complex_v<T>)
+		{
+			// Real operator, complex vector: apply to both parts
+			std::vector<T> yi(N);
+			for (size_t j = 0; j < N; ++j)
+				x[j] = X[i][j].real();
+			op(x.data(), y.data());
+			for (size_t j = 0; j < N; ++j)
+				x[j] = X[i][j].imag();
+			op(x.data(), yi.data());
+
+			double r = 0;
+			for (size_t j = 0; j < N; ++j)
+				r += std::norm(std::complex<double>(y[j], yi[j]) - std::complex<double>(w[i]) * std::complex<double>(X[i][j]));
+			worst = std::max(worst, std::sqrt(r) / std::max(1.0, double(std::abs(w[i]))));
+		}
+		else
+		{
+			for (size_t j = 0; j < N; ++j)
+				x[j] = X[i][j];
+			op(x.data(), y.data());
+
+			double r = 0;
+			for (size_t j = 0; j < N; ++j)
+				r += std::norm(std::complex<double>(y[j]) - std::complex<double>(w[i]) * std::complex<double>(x[j]));
+			worst = std::max(worst, std::sqrt(r) / std::max(1.0, double(std::abs(w[i]))));
+		}
+	}
+	return worst;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+lanczos_dense(void* instructions)
+{
+	using R = typename base<T>::type;
+
+	constexpr size_t N = 300, k = 6;
+	std::vector<R> d(N);
+	for (size_t i = 0; i < N; ++i)
+		d[i] = R(i % 2 ? 1 : -1) * (R(1) + R(i) / R(10));	// ±(1 + i/10), largest |λ| at the end
+
+	auto A = carray<T, 2, S::bytes>(N, N);
+	hermitian<T, S>(A.get(), d, 11);
+
+	struct target_case { eig::Target target; std::vector<R> expect; };
+	std::vector<R> sorted = d;
+	std::sort(sorted.begin(), sorted.end());
+	std::vector<R> by_magnitude = d;
+	std::sort(by_magnitude.begin(), by_magnitude.end(), [](R a, R b) { return std::abs(a) > std::abs(b); });
+
+	for (const target_case& c : {
+		target_case{eig::Target::LARGEST_REAL, std::vector<R>(sorted.rbegin(), sorted.rbegin() + k)},
+		target_case{eig::Target::SMALLEST_REAL, std::vector<R>(sorted.begin(), sorted.begin() + k)},
+		target_case{eig::Target::LARGEST_MAGNITUDE, std::vector<R>(by_magnitude.begin(), by_magnitude.begin() + k)}})
+	{
+		std::vector<R> w(k);
+		auto X = carray<T, 2, S::bytes>(k, N);
+		if (eig::lanczos<T, S>(A.get(), N, k, w.data(), X.get(), c.target) != k)
+			return std::unexpected{"lanczos did not converge"};
+
+		for (size_t i = 0; i < k; ++i)
+			if (std::abs(w[i] - c.expect[i]) > tolerance<T>() * 10 * std::abs(c.expect[i]))
+				return std::unexpected{"eigenvalue differs"};
+
+		auto op = eig::_dense_operator<T, S>(A.get(), N);
+		if (residual<T>(op, N, w.data(), X.get(), k) > tolerance<T>() * 100)
+			return std::unexpected{"eigenvector residual"};
+
+		for (size_t i = 0; i < k; ++i)
+			for (size_t j = 0; j < k; ++j)
+			{
+				T s = T(0);
+				for (size_t l = 0; l < N; ++l)
+					s += conjugate(X[i][l]) * X[j][l];
+				if (std::abs(s - T(i == j ? 1 : 0)) > tolerance<T>() * 100)
+					return std::unexpected{"eigenvectors not orthonormal"};
+			}
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+lanczos_callback(void* instructions)
+{
+	using R = typename base<T>::type;
+
+	// Tridiagonal operator with a varying diagonal, applied without storing it
+	constexpr size_t N = 20000, k = 5;
+	auto op = [](const T* x, T* y)
+	{
+		#pragma omp parallel for schedule(static)
+		for (size_t i = 0; i < N; ++i)
+		{
+			T s = R(4) * std::sin(R(i) / R(N) * R(3)) * x[i];
+			if (i > 0)
+				s += x[i - 1];
+			if (i + 1 < N)
+				s += x[i + 1];
+			y[i] = s;
+		}
+	};
+
+	std::vector<R> w(k);
+	auto X = carray<T, 2, S::bytes>(k, N);
+	if (eig::lanczos<T, S>(op, N, k, w.data(), X.get(), eig::Target::LARGEST_REAL, 40) != k)
+		return std::unexpected{"lanczos did not converge"};
+
+	if (residual<T>(op, N, w.data(), X.get(), k) > tolerance<T>() * 100)
+		return std::unexpected{"eigenvector residual"};
+	for (size_t i = 1; i < k; ++i)
+		if (w[i] > w[i - 1])
+			return std::unexpected{"eigenvalues out of order"};
+
+	// Gershgorin: the spectrum lies in [-6, 6], and the top is near 4 + 2
+	if (w[0] > R(6) || w[0] < R(5))
+		return std::unexpected{"largest eigenvalue out of range"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+lanczos_sparse(void* instructions)
+{
+	using R = typename base<T>::type;
+
+	// Block tridiagonal symmetric matrix in 8×8 blocks, checked against eig::general
+	constexpr size_t N = 256, b = 8, k = 4;
+	auto A = carray<T, 2, S::bytes>(N, N);
+	fill_rand<T>(A.get(), N, N, 21);
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			const size_t I = i / b, J = j / b;
+			if ((I > J ? I - J : J - I) > 1)
+				A[i][j] = T(0);
+		}
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < i; ++j)
+			A[i][j] = A[j][i];
+
+	bsr::matrix<T> As(A.get(), N, N, b, b);
+
+	std::vector<R> w(k);
+	auto X = carray<T, 2, S::bytes>(k, N);
+	if (eig::lanczos<T, S>(As, k, w.data(), X.get()) != k)
+		return std::unexpected{"lanczos did not converge"};
+
+	std::vector<std::complex<R>> all(N);
+	eig::general<T, S>(A.get(), all.data(), N);
+	std::sort(all.begin(), all.end(), [](auto a, auto b) { return std::abs(a) > std::abs(b); });
+	for (size_t i = 0; i < k; ++i)
+		if (std::abs(w[i] - all[i].real()) > tolerance<T>() * 10 * std::abs(w[i]))
+			return std::unexpected{"eigenvalue differs from dense"};
+
+	return 0;
+}
+
+/** \brief True if every eigenvalue with negative imaginary part follows its conjugate */
+template<typename C>
+static bool
+pairs_ordered(const C* w, const size_t k, const double tol)
+{
+	for (size_t i = 0; i < k; ++i)
+		if (w[i].imag() < 0 && (i == 0 || std::abs(w[i - 1] - std::conj(w[i])) > tol * std::abs(w[i])))
+			return false;
+	return true;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+arnoldi_dense(void* instructions)
+{
+	using R = typename base<T>::type;
+	using C = std::complex<R>;
+
+	// A = Q·T0·Qᴴ with T0 upper triangular (2×2 rotation blocks for real pairs)
+	constexpr size_t N = 200, k = 6;
+	auto T0 = carray<T, 2, S::bytes>(N, N);
+	fill_rand<T>(T0.get(), N, N, 31);
+	std::vector<C> spectrum;
+	for (size_t i = 0; i < N; ++i)
+	{
+		for (size_t j = 0; j < i; ++j)
+			T0[i][j] = T(0);
+		for (size_t j = i + 1; j < N; ++j)
+			T0[i][j] *= R(0.05);
+	}
+	for (size_t i = 0; i < N; )
+	{
+		const R r = R(1) + R(i) / R(20);
+		if constexpr (!is_complex_v<T>)
+			if (i % 4 == 0 && i + 1 < N)
+			{
+				T0[i][i] = T0[i + 1][i + 1] = r * R(0.6);
+				T0[i][i + 1] = r * R(0.8);
+				T0[i + 1][i] = -r * R(0.8);
+				spectrum.emplace_back(r * R(0.6), r * R(0.8));
+				spectrum.emplace_back(r * R(0.6), -r * R(0.8));
+				i += 2;
+				continue;
+			}
+		if constexpr (is_complex_v<T>)
+			T0[i][i] = std::polar(r, R(i));
+		else
+			T0[i][i] = i % 2 ? r : -r;
+		spectrum.push_back(C(T0[i][i]));
+		++i;
+	}
+
+	auto G = carray<T, 2, S::bytes>(N, N);
+	auto Q = carray<T, 2, S::bytes>(N, N);
+	auto Rq = carray<T, 2, S::bytes>(N, N);
+	auto A = carray<T, 2, S::bytes>(N, N);
+	fill_rand<T>(G.get(), N, N, 32);
+	qr::decompose<T, S>(G.get(), Q.get(), Rq.get(), N, N);
+	std::vector<T> QT(N * N, T(0));
+	for (size_t i = 0; i < N; ++i)
+		for (size_t l = 0; l < N; ++l)
+			for (size_t j = 0; j < N; ++j)
+				QT[i * N + j] += Q[i][l] * T0[l][j];
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			T s = T(0);
+			for (size_t l = 0; l < N; ++l)
+				s += QT[i * N + l] * conjugate(Q[j][l]);
+			A[i][j] = s;
+		}
+
+	std::vector<C> w(k);
+	auto X = carray<C, 2, S::bytes>(k, N);
+	if (eig::arnoldi<T, S>(A.get(), N, k, w.data(), X.get()) != k)
+		return std::unexpected{"arnoldi did not converge"};
+
+	std::sort(spectrum.begin(), spectrum.end(), [](C a, C b) { return std::abs(a) > std::abs(b); });
+	for (size_t i = 0; i < k; ++i)
+	{
+		R best = std::numeric_limits<R>::max();
+		for (size_t l = 0; l < k + 2; ++l)
+			best = std::min(best, std::abs(w[i] - spectrum[l]));
+		if (best > tolerance<T>() * 10 * std::abs(w[i]))
+			return std::unexpected{"eigenvalue not among the largest"};
+	}
+
+	if constexpr (!is_complex_v<T>)
+		if (!pairs_ordered(w.data(), k, tolerance<T>() * 10))
+			return std::unexpected{"conjugate pair not listed positive imaginary part first"};
+
+	auto op = eig::_dense_operator<T, S>(A.get(), N);
+	if (residual<T>(op, N, w.data(), X.get(), k) > tolerance<T>() * 100)
+		return std::unexpected{"eigenvector residual"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+arnoldi_pairs(void* instructions)
+{
+	using C = std::complex<T>;
+
+	// Random real non-symmetric matrices have conjugate pairs at the top of the spectrum
+	constexpr size_t N = 30, k = 4;
+	for (const unsigned seed : {5u, 17u, 23u})
+	{
+		auto A = carray<T, 2, S::bytes>(N, N);
+		fill_rand<T>(A.get(), N, N, seed);
+
+		std::vector<C> w(k);
+		auto X = carray<C, 2, S::bytes>(k, N);
+		if (eig::arnoldi<T, S>(A.get(), N, k, w.data(), X.get()) != k)
+			return std::unexpected{"arnoldi did not converge"};
+
+		if (!pairs_ordered(w.data(), k, tolerance<T>() * 10))
+			return std::unexpected{"conjugate pair not listed positive imaginary part first"};
+
+		auto op = eig::_dense_operator<T, S>(A.get(), N);
+		if (residual<T>(op, N, w.data(), X.get(), k) > tolerance<T>() * 100)
+			return std::unexpected{"eigenvector residual"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+invalid(void* instructions)
+{
+	using R = typename base<T>::type;
+
+	auto A = carray<T, 2, S::bytes>(8, 8);
+	std::vector<R> w(9);
+	for (const size_t k : {size_t(0), size_t(9)})
+	{
+		try
+		{
+			eig::lanczos<T, S>(A.get(), 8, k, w.data());
+			return std::unexpected{"bad k accepted"};
+		}
+		catch (const std::invalid_argument&) {}
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "eig::lanczos<double> dense", &lanczos_dense<double, AVX512>, nullptr);
+	heracles.add_labor(1, "eig::lanczos<complex<double>, AVX> dense", &lanczos_dense<std::complex<double>, AVX>, nullptr);
+	heracles.add_labor(2, "eig::lanczos<float> dense", &lanczos_dense<float, AVX512>, nullptr);
+	heracles.add_labor(3, "eig::lanczos<double, NONE> dense", &lanczos_dense<double, NONE>, nullptr);
+	heracles.add_labor(4, "eig::lanczos<double> callback", &lanczos_callback<double, AVX512>, nullptr);
+	heracles.add_labor(5, "eig::lanczos<double> bsr", &lanczos_sparse<double, AVX512>, nullptr);
+	heracles.add_labor(6, "eig::arnoldi<double>", &arnoldi_dense<double, AVX512>, nullptr);
+	heracles.add_labor(7, "eig::arnoldi<complex<double>>", &arnoldi_dense<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(8, "eig::arnoldi<float, SSE>", &arnoldi_dense<float, SSE>, nullptr);
+	heracles.add_labor(9, "eig::lanczos<double> invalid", &invalid<double, AVX512>, nullptr);
+	heracles.add_labor(10, "eig::arnoldi<double> conjugate pairs", &arnoldi_pairs<double, AVX512>, nullptr);
+
+	try
+	{
+		heracles.perform_labors();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "[EXCEPT] krylov_test: " << e.what() << "\n";
+		return -1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,206 @@
+/**
+ * \file matfun_test.cc
+ * \brief unit test for matfun.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+
+#include "test_utils.h"
+#include "broadcast.h"
+#include "matfun.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+template<typename T, typename S>
+std::expected<E, U> 
+matrix_exponential(void* instructions) 
+{
+	constexpr size_t N = 24;
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-4f : 1e-11;
+	
+	auto A = carray<T, 2, S::bytes>(N, N);
+	auto A_neg = carray<T, 2, S::bytes>(N, N);
+	auto E_pos = carray<T, 2, S::bytes>(N, N);
+	auto E_neg = carray<T, 2, S::bytes>(N, N);
+	auto I = carray<T, 2, S::bytes>(N, N);
+	auto EE = carray<T, 2, S::bytes>(N, N);
+
+	identity<T, S>(I.get(), N, N);
+
+	// Small, medium and large norms exercise each Padé degree and the squaring phase
+	for (T scale : {T(1e-3), T(0.1), T(1), T(8)})
+	{
+		fill_rand(A.get(), N, N);
+		scalar::unite<T, std::multiplies<>, S>(A.get(), scale / T(N), A.get(), N, N);
+		scalar::unite<T, std::multiplies<>, S>(A.get(), T(-1), A_neg.get(), N, N);
+
+		if (!expm<T, S>(A.get(), E_pos.get(), N) || !expm<T, S>(A_neg.get(), E_neg.get(), N))
+			return std::unexpected{"expm failed"};
+
+		// exp(A)·exp(-A) = I
+		zeros<T, S>(EE.get(), N, N);
+		multiply<T, S>(E_pos.get(), E_neg.get(), EE.get(), N, N, N);
+
+		T error = matrix_max_error(I.get(), EE.get(), N, N);
+		if (error > tolerance)
+		{
+			std::string response = std::format("||exp(A)exp(-A) - I||_max = {} at scale {}", error, scale);
+			return std::unexpected{response};
+		}
+	}
+
+	// Diagonal and nilpotent cases have closed forms
+	zeros<T, S>(A.get(), N, N);
+	for (size_t i = 0; i < N; ++i)
+		A[i][i] = T(i) / T(4);
+	A[0][1] = T(3);
+
+	expm<T, S>(A.get(), E_pos.get(), N);
+
+	for (size_t i = 0; i < N; ++i)
+		if (std::abs(E_pos[i][i] - std::exp(A[i][i])) > tolerance * std::exp(A[i][i]))
+			return std::unexpected{"diagonal of exp(A) is wrong"};
+
+	// exp([[0, 3], [0, 1/4]])[0][1] = 3·(e^(1/4) - 1)/(1/4)
+	const T e01 = T(12) * (std::exp(T(0.25)) - T(1));
+	if (std::abs(E_pos[0][1] - e01) > tolerance * e01)
+	{
+		std::string response = std::format("exp(A)[0][1] = {}, expected {}", E_pos[0][1], e01);
+		return std::unexpected{response};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+matrix_square_root(void* instructions) 
+{
+	constexpr size_t N = 32;
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-3f : 1e-10;
+	
+	auto G = carray<T, 2, S::bytes>(N, N);
+	auto Gt = carray<T, 2, S::bytes>(N, N);
+	auto A = carray<T, 2, S::bytes>(N, N);
+	auto X = carray<T, 2, S::bytes>(N, N);
+	auto XX = carray<T, 2, S::bytes>(N, N);
+
+	// SPD with eigenvalues spread over several orders of magnitude
+	fill_rand(G.get(), N, N);
+	zeros<T, S>(Gt.get(), N, N);
+	transpose<T, S>(G.get(), Gt.get(), N, N);
+	identity<T, S>(A.get(), N, N);
+	scalar::unite<T, std::multiplies<>, S>(A.get(), T(1e-2), A.get(), N, N);
+	multiply<T, S>(G.get(), Gt.get(), A.get(), N, N, N);
+
+	if (!sqrtm<T, S>(A.get(), X.get(), N))
+		return std::unexpected{"sqrtm did not converge"};
+
+	zeros<T, S>(XX.get(), N, N);
+	multiply<T, S>(X.get(), X.get(), XX.get(), N, N, N);
+
+	T error = matrix_max_error(A.get(), XX.get(), N, N);
+	if (error > tolerance)
+	{
+		std::string response = std::format("||X*X - A||_max = {}", error);
+		return std::unexpected{response};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+matrix_power(void* instructions) 
+{
+	constexpr size_t N = 17;
+	constexpr T tolerance = std::is_same_v<T, float> ? 1e-3f : 1e-11;
+	
+	auto A = carray<T, 2, S::bytes>(N, N);
+	auto P = carray<T, 2, S::bytes>(N, N);
+	auto R = carray<T, 2, S::bytes>(N, N);
+	auto Q = carray<T, 2, S::bytes>(N, N);
+	auto I = carray<T, 2, S::bytes>(N, N);
+
+	fill_rand(A.get(), N, N);
+	for (size_t i = 0; i < N; ++i)
+		A[i][i] += T(2);
+	identity<T, S>(I.get(), N, N);
+
+	// A^7 against repeated multiplication
+	identity<T, S>(R.get(), N, N);
+	for (size_t k = 0; k < 7; ++k)
+	{
+		zeros<T, S>(Q.get(), N, N);
+		multiply<T, S>(R.get(), A.get(), Q.get(), N, N, N);
+		for (size_t i = 0; i < N; ++i)
+			std::copy(Q[i], Q[i] + N, R[i]);
+	}
+
+	matpow<T, S>(A.get(), P.get(), N, 7);
+
+	T error = matrix_max_error(R.get(), P.get(), N, N) / matrix_max_error(R.get(), I.get(), N, N);
+	if (error > tolerance)
+	{
+		std::string response = std::format("relative ||A^7 - A·A·...·A||_max = {}", error);
+		return std::unexpected{response};
+	}
+
+	// A^-3·A^3 = I
+	matpow<T, S>(A.get(), P.get(), N, 3);
+	if (!matpow<T, S>(A.get(), R.get(), N, -3))
+		return std::unexpected{"matpow with negative exponent failed"};
+
+	zeros<T, S>(Q.get(), N, N);
+	multiply<T, S>(R.get(), P.get(), Q.get(), N, N, N);
+
+	error = matrix_max_error(I.get(), Q.get(), N, N);
+	if (error > tolerance)
+	{
+		std::string response = std::format("||A^-3 A^3 - I||_max = {}", error);
+		return std::unexpected{response};
+	}
+
+	matpow<T, S>(A.get(), P.get(), N, 0);
+	if (matrix_max_error(I.get(), P.get(), N, N) != T(0))
+		return std::unexpected{"A^0 is not the identity"};
+
+	return 0;
+}
+
+
+int main(int argc, char* argv[]) 
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "expm<double>", &matrix_exponential<double, AVX512>, nullptr);
+	heracles.add_labor(1, "expm<float>", &matrix_exponential<float, AVX>, nullptr);
+	heracles.add_labor(2, "sqrtm<double>", &matrix_square_root<double, AVX512>, nullptr);
+	heracles.add_labor(3, "sqrtm<float>", &matrix_square_root<float, AVX512>, nullptr);
+	heracles.add_labor(4, "matpow<double>", &matrix_power<double, AVX512>, nullptr);
+	heracles.add_labor(5, "matpow<float>", &matrix_power<float, SSE>, nullptr);
+
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] matfun_test: " << e.what() << "\n";
+		return -1;
+	}
+	
+	return 0;
+}
@@ -10,6 +10,7 @@
 #include <complex>
 #include <format>
 #include <cstring>
+#include <omp.h>
 
 using namespace damm;
 
@@ -58,6 +59,70 @@ test_all_ops(const size_t M, const size_t N, const size_t P)
 	return ret;
 }
 
+/**
+ * Shapes with a long inner dimension take the stream-K path when more than
+ * one thread is available, so four threads are requested whatever the core
+ * count. Checks that the shape is split, against the naive product and that
+ * a repeated call reproduces the result bit for bit.
+ */
+template<typename T>
+bool
+test_long_inner(const size_t M, const size_t N, const size_t P)
+{
+	static constexpr size_t ALIGN = 64;
+	bool ret = true;
+
+	const int threads = omp_get_max_threads();
+	omp_set_num_threads(4);
+
+	const bool split = _stream_k_splits<T, SSE, multiply_kernel>(M, N, P) > 1
+		&& _stream_k_splits<T, AVX, multiply_kernel>(M, N, P) > 1
+		&& _stream_k_splits<T, AVX512, multiply_kernel>(M, N, P) > 1;
+	printf("[%-4s] %s\n", (split ? "OK" : "FAIL"), std::format("multiply<{}> long inner takes stream-K:", typeid(T).name()).c_str());
+	ret &= split;
+
+	carray<T, 2, ALIGN> A(M, N);
+	carray<T, 2, ALIGN> B(N, P);
+	carray<T, 2, ALIGN> C_ref(M, P);
+	carray<T, 2, ALIGN> C_sse(M, P);
+	carray<T, 2, ALIGN> C_avx(M, P);
+	carray<T, 2, ALIGN> C_avx512(M, P);
+	carray<T, 2, ALIGN> C_repeat(M, P);
+
+	fill_rand<T>(A.get(), M, N);
+	fill_rand<T>(B.get(), N, P);
+	fill_rand<T>(C_ref.get(), M, P, 7);
+
+	std::memcpy(C_sse.begin(), C_ref.begin(), M * P * sizeof(T));
+	std::memcpy(C_avx.begin(), C_ref.begin(), M * P * sizeof(T));
+	std::memcpy(C_avx512.begin(), C_ref.begin(), M * P * sizeof(T));
+	std::memcpy(C_repeat.begin(), C_ref.begin(), M * P * sizeof(T));
+
+	multiply_naive<T>(A.get(), B.get(), C_ref.get(), M, N, P);
+
+	multiply<T, SSE>(A.get(), B.get(), C_sse.get(), M, N, P);
+
+	multiply<T, AVX>(A.get(), B.get(), C_avx.get(), M, N, P);
+
+	multiply<T, AVX512>(A.get(), B.get(), C_avx512.get(), M, N, P);
+
+	multiply<T, AVX512>(A.get(), B.get(), C_repeat.get(), M, N, P);
+
+	ret &= is_same<T>(std::format("multiply<{},{}> long inner:", typeid(T).name(), "SSE").c_str(), C_ref.get(), C_sse.get(), M, P);
+
+	ret &= is_same<T>(std::format("multiply<{},{}> long inner:", typeid(T).name(), "AVX").c_str(), C_ref.get(), C_avx.get(), M, P);
+
+	ret &= is_same<T>(std::format("multiply<{},{}> long inner:", typeid(T).name(), "AVX512").c_str(), C_ref.get(), C_avx512.get(), M, P);
+
+	const bool reproducible = std::memcmp(C_avx512.begin(), C_repeat.begin(), M * P * sizeof(T)) == 0;
+	printf("[%-4s] %s\n", (reproducible ? "OK" : "FAIL"), std::format("multiply<{},{}> long inner reproducible:", typeid(T).name(), "AVX512").c_str());
+	ret &= reproducible;
+
+	omp_set_num_threads(threads);
+
+	return ret;
+}
+
 int main(int argc, char* argv[])
 {
 	static constexpr size_t M[] = {1024};
@@ -81,6 +146,16 @@ int main(int argc, char* argv[])
 				}
 			}
 		}
+
+		static constexpr size_t long_inner[][3] = {{64, 100000, 64}, {37, 20000, 29}, {130, 60000, 5}};
+		for (const auto& [m, n, p] : long_inner)
+		{
+			bool all_ops = true;
+			all_ops &= test_long_inner<double>(m, n, p);
+			all_ops &= test_long_inner<std::complex<double>>(m, n, p);
+			std::string report = std::format("[{}] multiply: M={}, N={}, P={}", ((all_ops) ? "OK" : "FAIL"), m, n, p);
+			std::cout << report << std::endl;
+		}
 	}
 	catch(const std::exception& e)
 	{
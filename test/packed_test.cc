@@ -0,0 +1,273 @@
+/**
+ * \file packed_test.cc
+ * \brief unit test for packed.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+#include "test_utils.h"
+#include "decompose.h"
+#include "packed.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+/** \brief Fill A with a Hermitian positive-definite matrix Bᴴ·B + N·I */
+template<typename T>
+static void
+fill_spd(T** A, const size_t N)
+{
+	auto B = carray<T, 2, 64>(N, N);
+	fill_rand<T>(B.get(), N, N, 7);
+
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j <= i; ++j)
+		{
+			T sum = T(0);
+			for (size_t k = 0; k < N; ++k)
+				sum += conjugate(B[k][i]) * B[k][j];
+			A[i][j] = sum;
+			A[j][i] = conjugate(sum);
+		}
+
+	for (size_t i = 0; i < N; ++i)
+		A[i][i] = T(std::real(A[i][i]) + N);
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+pack_unpack(void* instructions)
+{
+	constexpr size_t N = 37;
+
+	auto A = carray<T, 2, S::bytes>(N, N);
+	auto R = carray<T, 2, S::bytes>(N, N);
+	auto AP = carray<T, 1, S::bytes>(packed::elements(N));
+	auto UP = carray<T, 1, S::bytes>(packed::elements(N));
+	fill_spd<T>(A.get(), N);
+
+	packed::pack<T>(A.get(), AP.get(), N, LOWER);
+	packed::pack<T>(A.get(), UP.get(), N, UPPER);
+
+	for (size_t k = 0; k < packed::elements(N); ++k)
+		if (AP[k] != UP[k])
+			return std::unexpected{"upper and lower packing differ"};
+
+	packed::unpack<T>(AP.get(), R.get(), N);
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+			if (R[i][j] != A[i][j])
+				return std::unexpected{"symmetric round trip"};
+
+	packed::unpack<T>(AP.get(), R.get(), N, false);
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+			if (R[i][j] != (j <= i ? A[i][j] : T(0)))
+				return std::unexpected{"triangular round trip"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+symmetric_multiply(void* instructions)
+{
+	const double tol = std::is_same_v<typename base<T>::type, float> ? 1e-3 : 1e-9;
+
+	for (const size_t N : {1, 5, 64, 301})
+	{
+		constexpr size_t P = 19;
+
+		auto A = carray<T, 2, S::bytes>(N, N);
+		auto AP = carray<T, 1, S::bytes>(packed::elements(N));
+		auto x = carray<T, 1, S::bytes>(N);
+		auto y = carray<T, 1, S::bytes>(N);
+		auto B = carray<T, 2, S::bytes>(N, P);
+		auto C = carray<T, 2, S::bytes>(N, P);
+		fill_spd<T>(A.get(), N);
+		fill_rand<T>(B.get(), N, P, 3);
+		fill_rand<T>(C.get(), N, P, 4);
+		for (size_t i = 0; i < N; ++i)
+		{
+			x[i] = B[i][0];
+			y[i] = C[i][1];
+		}
+
+		// Dense references, accumulated onto the initial y and C
+		std::vector<T> y_ref(N);
+		auto C_ref = carray<T, 2, S::bytes>(N, P);
+		for (size_t i = 0; i < N; ++i)
+		{
+			y_ref[i] = y[i];
+			for (size_t j = 0; j < N; ++j)
+				y_ref[i] += A[i][j] * x[j];
+			for (size_t p = 0; p < P; ++p)
+			{
+				C_ref[i][p] = C[i][p];
+				for (size_t j = 0; j < N; ++j)
+					C_ref[i][p] += A[i][j] * B[j][p];
+			}
+		}
+
+		packed::pack<T>(A.get(), AP.get(), N);
+		packed::multiply<T, S>(AP.get(), x.get(), y.get(), N);
+		packed::multiply<T, S>(AP.get(), B.get(), C.get(), N, P);
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			if (!approx_equal(y[i], y_ref[i], tol, tol))
+				return std::unexpected{"matrix-vector product"};
+			for (size_t p = 0; p < P; ++p)
+				if (!approx_equal(C[i][p], C_ref[i][p], tol, tol))
+					return std::unexpected{"matrix-matrix product"};
+		}
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+cholesky_solve(void* instructions)
+{
+	const double tol = std::is_same_v<typename base<T>::type, float> ? 1e-3 : 1e-9;
+
+	for (const size_t N : {1, 3, 64, 65, 200})
+	{
+		auto A = carray<T, 2, S::bytes>(N, N);
+		auto L = carray<T, 2, S::bytes>(N, N);
+		auto LP = carray<T, 1, S::bytes>(packed::elements(N));
+		auto b = carray<T, 1, S::bytes>(N);
+		auto x = carray<T, 1, S::bytes>(N);
+		fill_spd<T>(A.get(), N);
+		for (size_t i = 0; i < N; ++i)
+			b[i] = T(std::sin(double(i)) + 2);
+
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+				L[i][j] = A[i][j];
+
+		packed::pack<T>(A.get(), LP.get(), N);
+		if (!packed::decompose<T, S>(LP.get(), N))
+			return std::unexpected{"positive definite matrix rejected"};
+		if (!cholesky::decompose<T, S>(L.get(), N))
+			return std::unexpected{"dense decomposition failed"};
+
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j <= i; ++j)
+				if (!approx_equal(LP[packed::offset(i) + j], L[i][j], tol, tol))
+					return std::unexpected{"factor differs from dense cholesky"};
+
+		packed::solve<T, S>(LP.get(), b.get(), x.get(), N);
+
+		for (size_t i = 0; i < N; ++i)
+		{
+			T r = T(0);
+			for (size_t j = 0; j < N; ++j)
+				r += A[i][j] * x[j];
+			if (!approx_equal(r, b[i], tol, tol))
+				return std::unexpected{"residual of A x = b"};
+		}
+	}
+
+	// Indefinite input
+	constexpr size_t N = 4;
+	auto AP = carray<T, 1, S::bytes>(packed::elements(N));
+	for (size_t k = 0; k < packed::elements(N); ++k)
+		AP[k] = T(1);
+	if (packed::decompose<T, S>(AP.get(), N))
+		return std::unexpected{"singular matrix accepted"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+triangular_solve(void* instructions)
+{
+	const double tol = std::is_same_v<typename base<T>::type, float> ? 1e-3 : 1e-9;
+	constexpr size_t N = 53;
+
+	auto Up = carray<T, 2, S::bytes>(N, N);
+	auto LP = carray<T, 1, S::bytes>(packed::elements(N));
+	auto b = carray<T, 1, S::bytes>(N);
+	auto x = carray<T, 1, S::bytes>(N);
+	fill_rand<T>(Up.get(), N, N, 11);
+	for (size_t i = 0; i < N; ++i)
+	{
+		Up[i][i] += T(N);
+		for (size_t j = 0; j < i; ++j)
+			Up[i][j] = T(0);
+		b[i] = T(1) / T(i + 1);
+	}
+
+	// U packs as L = Uᴴ; backward substitution then solves U x = b
+	packed::pack<T>(Up.get(), LP.get(), N, UPPER);
+
+	for (const bool unit : {false, true})
+	{
+		packed::backward_substitution<T, S>(LP.get(), b.get(), x.get(), N, unit);
+		for (size_t i = 0; i < N; ++i)
+		{
+			T r = unit ? x[i] : Up[i][i] * x[i];
+			for (size_t j = i + 1; j < N; ++j)
+				r += Up[i][j] * x[j];
+			if (!approx_equal(r, b[i], tol, tol))
+				return std::unexpected{"backward substitution"};
+		}
+
+		// Uᴴ is lower triangular and stored as is
+		packed::forward_substitution<T, S>(LP.get(), b.get(), x.get(), N, unit);
+		for (size_t i = 0; i < N; ++i)
+		{
+			T r = unit ? x[i] : conjugate(Up[i][i]) * x[i];
+			for (size_t j = 0; j < i; ++j)
+				r += conjugate(Up[j][i]) * x[j];
+			if (!approx_equal(r, b[i], tol, tol))
+				return std::unexpected{"forward substitution"};
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "pack<double>", &pack_unpack<double, AVX512>, nullptr);
+	heracles.add_labor(1, "pack<complex<double>>", &pack_unpack<std::complex<double>, AVX>, nullptr);
+	heracles.add_labor(2, "multiply<double>", &symmetric_multiply<double, AVX512>, nullptr);
+	heracles.add_labor(3, "multiply<float, AVX>", &symmetric_multiply<float, AVX>, nullptr);
+	heracles.add_labor(4, "multiply<complex<double>>", &symmetric_multiply<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(5, "multiply<complex<float>, SSE>", &symmetric_multiply<std::complex<float>, SSE>, nullptr);
+	heracles.add_labor(6, "multiply<double, NONE>", &symmetric_multiply<double, NONE>, nullptr);
+	heracles.add_labor(7, "decompose<double>", &cholesky_solve<double, AVX512>, nullptr);
+	heracles.add_labor(8, "decompose<float, AVX>", &cholesky_solve<float, AVX>, nullptr);
+	heracles.add_labor(9, "decompose<complex<double>, AVX>", &cholesky_solve<std::complex<double>, AVX>, nullptr);
+	heracles.add_labor(10, "decompose<double, NONE>", &cholesky_solve<double, NONE>, nullptr);
+	heracles.add_labor(11, "substitution<double>", &triangular_solve<double, AVX512>, nullptr);
+	heracles.add_labor(12, "substitution<complex<double>, AVX>", &triangular_solve<std::complex<double>, AVX>, nullptr);
+
+	try
+	{
+		heracles.perform_labors();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "[EXCEPT] packed_test: " << e.what() << "\n";
+		return -1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,207 @@
+/**
+ * \file permute_test.cc
+ * \brief unit test for permute.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <numeric>
+#include <algorithm>
+
+#include "test_utils.h"
+#include "broadcast.h"
+#include "permute.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+static std::vector<size_t>
+random_permutation(const size_t N, const unsigned seed)
+{
+	std::vector<size_t> P(N);
+	std::iota(P.begin(), P.end(), 0);
+	std::shuffle(P.begin(), P.end(), std::mt19937(seed));
+	return P;
+}
+
+template<typename T>
+bool
+rows_match(T** A, T** B, const size_t* P, const size_t M, const size_t N, const bool inverse)
+{
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+			if ((inverse ? B[P[i]][j] != A[i][j] : B[i][j] != A[P[i]][j]))
+				return false;
+	return true;
+}
+
+template<typename T>
+bool
+columns_match(T** A, T** B, const size_t* P, const size_t M, const size_t N, const bool inverse)
+{
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+			if ((inverse ? B[i][P[j]] != A[i][j] : B[i][j] != A[i][P[j]]))
+				return false;
+	return true;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+row_permutation(void* instructions) 
+{
+	constexpr size_t M = 67;
+	constexpr size_t N = 29;
+
+	auto A = carray<T, 2, S::bytes>(M, N);
+	auto B = carray<T, 2, S::bytes>(M, N);
+	auto C = carray<T, 2, S::bytes>(M, N);
+	fill_rand<T>(A.get(), M, N);
+
+	const auto P = random_permutation(M, 7);
+
+	for (bool inverse : {false, true})
+	{
+		permute_rows<T, S>(A.get(), P.data(), B.get(), M, N, inverse);
+		if (!rows_match(A.get(), B.get(), P.data(), M, N, inverse))
+			return std::unexpected{inverse ? "inverse out of place" : "out of place"};
+
+		for (size_t i = 0; i < M; ++i)
+			std::copy(A[i], A[i] + N, C[i]);
+		permute_rows<T, S>(C.get(), P.data(), M, N, inverse);
+		if (!rows_match(A.get(), C.get(), P.data(), M, N, inverse))
+			return std::unexpected{inverse ? "inverse in place" : "in place"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+column_permutation(void* instructions) 
+{
+	constexpr size_t M = 13;
+	constexpr size_t N = 71;
+
+	auto A = carray<T, 2, S::bytes>(M, N);
+	auto B = carray<T, 2, S::bytes>(M, N);
+	auto C = carray<T, 2, S::bytes>(M, N);
+	fill_rand<T>(A.get(), M, N);
+
+	const auto P = random_permutation(N, 11);
+
+	for (bool inverse : {false, true})
+	{
+		permute_columns<T, S>(A.get(), P.data(), B.get(), M, N, inverse);
+		if (!columns_match(A.get(), B.get(), P.data(), M, N, inverse))
+			return std::unexpected{inverse ? "inverse out of place" : "out of place"};
+
+		for (size_t i = 0; i < M; ++i)
+			std::copy(A[i], A[i] + N, C[i]);
+		permute_columns<T, S>(C.get(), P.data(), M, N, inverse);
+		if (!columns_match(A.get(), C.get(), P.data(), M, N, inverse))
+			return std::unexpected{inverse ? "inverse in place" : "in place"};
+	}
+
+	// Applying P and then P⁻¹ through invert_permutation restores A
+	std::vector<size_t> P_inv(N);
+	invert_permutation(P.data(), P_inv.data(), N);
+	permute_columns<T, S>(A.get(), P.data(), B.get(), M, N);
+	permute_columns<T, S>(B.get(), P_inv.data(), C.get(), M, N);
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+			if (C[i][j] != A[i][j])
+				return std::unexpected{"invert_permutation round trip"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+gather_scatter(void* instructions) 
+{
+	constexpr size_t M = 40;
+	constexpr size_t N = 37;
+	constexpr size_t K = 19;
+
+	auto A = carray<T, 2, S::bytes>(M, N);
+	auto R = carray<T, 2, S::bytes>(K, N);
+	auto C = carray<T, 2, S::bytes>(M, K);
+	auto B = carray<T, 2, S::bytes>(M, N);
+	fill_rand<T>(A.get(), M, N);
+
+	// K distinct row and column indices
+	auto rows = random_permutation(M, 3);
+	auto cols = random_permutation(N, 5);
+	rows.resize(K);
+	cols.resize(K);
+
+	gather_rows<T, S>(A.get(), rows.data(), R.get(), M, N, K);
+	for (size_t k = 0; k < K; ++k)
+		for (size_t j = 0; j < N; ++j)
+			if (R[k][j] != A[rows[k]][j])
+				return std::unexpected{"gather_rows"};
+
+	gather_columns<T, S>(A.get(), cols.data(), C.get(), M, N, K);
+	for (size_t i = 0; i < M; ++i)
+		for (size_t k = 0; k < K; ++k)
+			if (C[i][k] != A[i][cols[k]])
+				return std::unexpected{"gather_columns"};
+
+	// Scattering the gathered rows and columns back onto zeros recovers them in place
+	zeros<T, S>(B.get(), M, N);
+	scatter_rows<T, S>(R.get(), rows.data(), B.get(), M, N, K);
+	for (size_t k = 0; k < K; ++k)
+		for (size_t j = 0; j < N; ++j)
+			if (B[rows[k]][j] != A[rows[k]][j])
+				return std::unexpected{"scatter_rows"};
+
+	zeros<T, S>(B.get(), M, N);
+	scatter_columns<T, S>(C.get(), cols.data(), B.get(), M, N, K);
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			const bool hit = std::find(cols.begin(), cols.end(), j) != cols.end();
+			if (B[i][j] != (hit ? A[i][j] : T(0)))
+				return std::unexpected{"scatter_columns"};
+		}
+
+	return 0;
+}
+
+int main(int argc, char* argv[]) 
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "permute_rows<double>", &row_permutation<double, AVX512>, nullptr);
+	heracles.add_labor(1, "permute_rows<complex<float>>", &row_permutation<std::complex<float>, AVX>, nullptr);
+	heracles.add_labor(2, "permute_columns<double>", &column_permutation<double, AVX512>, nullptr);
+	heracles.add_labor(3, "permute_columns<float>", &column_permutation<float, AVX512>, nullptr);
+	heracles.add_labor(4, "permute_columns<float, AVX>", &column_permutation<float, AVX>, nullptr);
+	heracles.add_labor(5, "permute_columns<complex<float>>", &column_permutation<std::complex<float>, AVX512>, nullptr);
+	heracles.add_labor(6, "permute_columns<complex<double>>", &column_permutation<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(7, "gather/scatter<double>", &gather_scatter<double, AVX512>, nullptr);
+	heracles.add_labor(8, "gather/scatter<float>", &gather_scatter<float, AVX>, nullptr);
+	heracles.add_labor(9, "gather/scatter<complex<double>>", &gather_scatter<std::complex<double>, SSE>, nullptr);
+
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] permute_test: " << e.what() << "\n";
+		return -1;
+	}
+	
+	return 0;
+}
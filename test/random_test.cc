@@ -0,0 +1,202 @@
+/**
+ * \file random_test.cc
+ * \brief unit test for random.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <cstring>
+
+#include "test_utils.h"
+#include "random.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+template<typename S>
+std::expected<E, U> 
+philox_known_answer(void* instructions) 
+{
+	// Known-answer vectors of Philox-4x32-10 from the Random123 distribution
+	struct kat { uint32_t ctr[4]; uint32_t key[2]; uint32_t out[4]; };
+	constexpr kat kats[] = {
+		{{0, 0, 0, 0}, {0, 0}, {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+		{{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}, 
+			{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+		{{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}, 
+			{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}
+	};
+
+	for (const auto& k : kats)
+	{
+		const uint64_t ctr = (uint64_t(k.ctr[1]) << 32) | k.ctr[0];
+		const uint64_t stream = (uint64_t(k.ctr[3]) << 32) | k.ctr[2];
+		const uint64_t seed = (uint64_t(k.key[1]) << 32) | k.key[0];
+		const size_t lane = ctr % _philox_lanes;
+
+		alignas(64) uint32_t words[_philox_words];
+		_philox_block<S>(ctr / _philox_lanes, seed, stream, words);
+
+		for (size_t w = 0; w < 4; ++w)
+			if (words[w * _philox_lanes + lane] != k.out[w])
+				return std::unexpected{"philox output mismatch"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+thread_invariance(void* instructions) 
+{
+	constexpr size_t M = 123;
+	constexpr size_t N = 77;
+
+	auto A = carray<T, 2, S::bytes>(M, N);
+	auto B = carray<T, 2, S::bytes>(M, N);
+
+	const int threads = omp_get_max_threads();
+
+	for (bool normal : {false, true})
+	{
+		omp_set_num_threads(1);
+		normal ? random_normal<T, S>(A.get(), M, N, 42, 7) : random_uniform<T, S>(A.get(), M, N, 42, 7);
+		omp_set_num_threads(4);
+		normal ? random_normal<T, S>(B.get(), M, N, 42, 7) : random_uniform<T, S>(B.get(), M, N, 42, 7);
+		omp_set_num_threads(threads);
+
+		if (std::memcmp(A[0], B[0], sizeof(T) * M * N) != 0)
+			return std::unexpected{normal ? "normal differs across thread counts" : "uniform differs across thread counts"};
+	}
+
+	// Uniforms are integer-exact, so the scalar and AVX-512 paths agree bitwise
+	random_uniform<T, S>(A.get(), M, N, 42, 7);
+	random_uniform<T, NONE>(B.get(), M, N, 42, 7);
+	if (std::memcmp(A[0], B[0], sizeof(T) * M * N) != 0)
+		return std::unexpected{"uniform differs between SIMD and scalar paths"};
+
+	// A different stream gives different values
+	random_uniform<T, S>(B.get(), M, N, 42, 8);
+	if (std::memcmp(A[0], B[0], sizeof(T) * M * N) == 0)
+		return std::unexpected{"streams overlap"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+distribution_moments(void* instructions) 
+{
+	constexpr size_t M = 1000;
+	constexpr size_t N = 1001;
+	constexpr double L = double(M * N);
+
+	auto A = carray<T, 2, S::bytes>(M, N);
+
+	// Uniform on [-1, 3): mean 1, variance 16/12
+	random_uniform<T, S>(A.get(), M, N, 2025, 0, T(-1), T(3));
+	double sum = 0, sum2 = 0;
+	T lo = A[0][0], hi = A[0][0];
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			sum += A[i][j];
+			sum2 += double(A[i][j]) * A[i][j];
+			lo = std::min(lo, A[i][j]);
+			hi = std::max(hi, A[i][j]);
+		}
+	double mean = sum / L;
+	double var = sum2 / L - mean * mean;
+	if (lo < T(-1) || hi >= T(3) || std::abs(mean - 1) > 5e-3 || std::abs(var - 16.0 / 12.0) > 5e-3)
+	{
+		std::string response = std::format("uniform mean {} var {} range [{}, {})", mean, var, lo, hi);
+		return std::unexpected{response};
+	}
+
+	// Normal(2, 0.5): mean, variance and the mass within one standard deviation
+	random_normal<T, S>(A.get(), M, N, 2025, 1, T(2), T(0.5));
+	sum = sum2 = 0;
+	double inside = 0;
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			sum += A[i][j];
+			sum2 += double(A[i][j]) * A[i][j];
+			inside += std::abs(A[i][j] - T(2)) < T(0.5);
+		}
+	mean = sum / L;
+	var = sum2 / L - mean * mean;
+	if (std::abs(mean - 2) > 3e-3 || std::abs(var - 0.25) > 3e-3 || std::abs(inside / L - 0.682689) > 3e-3)
+	{
+		std::string response = std::format("normal mean {} var {} within 1σ {}", mean, var, inside / L);
+		return std::unexpected{response};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+complex_normal(void* instructions) 
+{
+	constexpr size_t M = 300;
+	constexpr size_t N = 333;
+	constexpr double L = double(M * N);
+	using R = typename base<T>::type;
+
+	auto A = carray<T, 2, S::bytes>(M, N);
+
+	random_normal<T, S>(A.get(), M, N, 99);
+	double re = 0, im = 0, re2 = 0, im2 = 0, cross = 0;
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			const R a = A[i][j].real(), b = A[i][j].imag();
+			re += a; im += b;
+			re2 += a * a; im2 += b * b;
+			cross += a * b;
+		}
+
+	if (std::abs(re / L) > 1e-2 || std::abs(im / L) > 1e-2 || std::abs(re2 / L - 1) > 2e-2 || 
+		std::abs(im2 / L - 1) > 2e-2 || std::abs(cross / L) > 1e-2)
+	{
+		return std::unexpected{"complex components are not independent standard normals"};
+	}
+
+	return 0;
+}
+
+int main(int argc, char* argv[]) 
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "philox<AVX512>", &philox_known_answer<AVX512>, nullptr);
+	heracles.add_labor(1, "philox<NONE>", &philox_known_answer<NONE>, nullptr);
+	heracles.add_labor(2, "thread invariance<double>", &thread_invariance<double, AVX512>, nullptr);
+	heracles.add_labor(3, "thread invariance<float>", &thread_invariance<float, AVX512>, nullptr);
+	heracles.add_labor(4, "moments<double>", &distribution_moments<double, AVX512>, nullptr);
+	heracles.add_labor(5, "moments<float>", &distribution_moments<float, AVX512>, nullptr);
+	heracles.add_labor(6, "moments<float, AVX>", &distribution_moments<float, AVX>, nullptr);
+	heracles.add_labor(7, "random_normal<complex>", &complex_normal<std::complex<double>, AVX512>, nullptr);
+
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] random_test: " << e.what() << "\n";
+		return -1;
+	}
+	
+	return 0;
+}
@@ -26,7 +26,12 @@ void test_op(const char* name, const size_t M, const size_t N)
 	//i.e. a specific geometric series. 
 	if constexpr (std::is_same_v<O, std::plus<>>) 
 	{
-		if constexpr (std::is_same_v<T, std::complex<float>> || std::is_same_v<T, std::complex<double>>) 
+		if constexpr (std::is_integral_v<T>)
+		{
+			// Integer sums wrap identically in every lane order
+			fill_rand<T>(A.get(), M, N);
+		}
+		else if constexpr (std::is_same_v<T, std::complex<float>> || std::is_same_v<T, std::complex<double>>) 
 		{
 			// Complex geometric series: z_n = (0.8 + 0.1i)^n
 			// Converges because |0.8 + 0.1i| = sqrt(0.8^2 + 0.1^2) ≈ 0.806 < 1
@@ -52,7 +57,15 @@ void test_op(const char* name, const size_t M, const size_t N)
 
 if constexpr (std::is_same_v<O, std::multiplies<>>)
 {
-	if constexpr (std::is_same_v<T, std::complex<float>> || std::is_same_v<T, std::complex<double>>) 
+	if constexpr (std::is_integral_v<T>)
+	{
+		// Signs of ±1 with a few factors of 2, so the product stays representable
+		fill_rand<T>(A.get(), M, N);
+		size_t twos = 0;
+		for (auto it = A.begin(); it != A.end(); ++it)
+			*it = (*it % 97 == 0 && twos++ < 8) ? T(2) : (*it < 0 ? T(-1) : T(1));
+	}
+	else if constexpr (std::is_same_v<T, std::complex<float>> || std::is_same_v<T, std::complex<double>>) 
 	{
 		using real_type = typename T::value_type;
 		real_type root_val = std::pow(static_cast<real_type>(2.0), static_cast<real_type>(1.0) / static_cast<real_type>(M * N));
@@ -86,6 +99,14 @@ if constexpr (std::is_same_v<O, std::multiplies<>>)
 	bool test_sse = approx_equal<T>(r_ref, r_sse, 1e-2);
 	bool test_avx = approx_equal<T>(r_ref, r_avx, 1e-2);
 	bool test_avx512 = approx_equal<T>(r_ref, r_avx512, 1e-2);
+
+	if constexpr (std::is_integral_v<T>)
+	{
+		test_none = r_ref == r_none;
+		test_sse = r_ref == r_sse;
+		test_avx = r_ref == r_avx;
+		test_avx512 = r_ref == r_avx512;
+	}
 	test_all = ( test_none && test_sse && test_avx && test_avx512 );
 
 	std::cout << "[" << (test_none ? "OK  " : "FAIL") << "] " << "reduce<NONE>: " << r_ref << std::endl;
@@ -108,6 +129,13 @@ test_all_ops(const size_t M, const size_t N)
 	test_op<std::complex<float>, std::plus<>>("std::complex<float>: sum(A)", M , N);
 	test_op<std::complex<float>, std::multiplies<>>("std::complex<float>: product(A)", M , N);
 
+	test_op<int64_t, std::plus<>>("int64_t: sum(A)", M , N);
+	test_op<int64_t, std::multiplies<>>("int64_t: product(A)", M , N);
+	test_op<int32_t, std::plus<>>("int32_t: sum(A)", M , N);
+	test_op<int32_t, std::multiplies<>>("int32_t: product(A)", M , N);
+	test_op<int16_t, std::plus<>>("int16_t: sum(A)", M , N);
+	test_op<int16_t, std::multiplies<>>("int16_t: product(A)", M , N);
+
 }
 
 int main(int argc, char* argv[]) 
@@ -0,0 +1,277 @@
+/**
+ * \file reducer_test.cc
+ * \brief unit test for reducer.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include "test_utils.h"
+#include "reduce.h"
+#include "fused_reduce.h"
+#include "reducer.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+/** \brief Split M rows into chunks of varying height, including empty ones */
+static std::vector<size_t>
+chunk_heights(const size_t M, const unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<size_t> h(0, 7);
+	std::vector<size_t> heights;
+	for (size_t done = 0; done < M; )
+	{
+		const size_t k = std::min(h(gen), M - done);
+		heights.push_back(k);
+		done += k;
+	}
+	return heights;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+chunked_sum(void* instructions) 
+{
+	constexpr size_t M = 301, N = 13;
+
+	auto A = carray<T, 2, S::bytes>(M, N);
+	fill_rand<T>(A.get(), M, N);
+
+	reducer<T, std::plus<>, S> whole;
+	whole.update(A.get(), M, N);
+
+	// Any chunking gives the same bits
+	for (unsigned seed : {1u, 2u, 3u})
+	{
+		reducer<T, std::plus<>, S> r;
+		size_t row = 0;
+		for (size_t h : chunk_heights(M, seed))
+		{
+			if (h != 0)
+				r.update(A.get() + row, h, N);
+			row += h;
+		}
+		if (r.result() != whole.result() || r.count() != M * N)
+			return std::unexpected{"result depends on chunking"};
+	}
+
+	// Element-wise chunks that end mid-block
+	reducer<T, std::plus<>, S> odd;
+	for (size_t i = 0; i < M * N; i += 5)
+		odd.update(A[0] + i, std::min<size_t>(5, M * N - i));
+	if (odd.result() != whole.result())
+		return std::unexpected{"result depends on chunking"};
+
+	const T expect = reduce<T, std::plus<>, S>(A.get(), T(0), M, N);
+	if (!approx_equal(whole.result(), expect, 1e-4, 1e-4))
+		return std::unexpected{"differs from reduce"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+chunked_product(void* instructions) 
+{
+	constexpr size_t M = 97, N = 11;
+
+	auto A = carray<T, 2, S::bytes>(M, N);
+	std::mt19937 gen(5);
+	std::uniform_real_distribution<double> d(0.999, 1.001);
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+			A[i][j] = T(d(gen));
+
+	reducer<T, std::multiplies<>, S> r(T(2));
+	for (size_t i = 0; i < M; ++i)
+		r.update(A.get() + i, 1, N);
+
+	T expect = T(2);
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+			expect *= A[i][j];
+
+	if (!approx_equal(r.result(), expect, 1e-4, 1e-6))
+		return std::unexpected{"product"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+streaming_dot(void* instructions) 
+{
+	constexpr size_t M = 257, N = 19;
+
+	auto A = carray<T, 2, S::bytes>(M, N);
+	auto B = carray<T, 2, S::bytes>(M, N);
+	fill_rand<T>(A.get(), M, N);
+	fill_rand<T>(B.get(), M, N);
+
+	fused_reducer<T, std::multiplies<>, std::plus<>, S> whole;
+	whole.update(A.get(), B.get(), M, N);
+
+	fused_reducer<T, std::multiplies<>, std::plus<>, S> chunked;
+	size_t row = 0;
+	for (size_t h : chunk_heights(M, 9))
+	{
+		if (h != 0)
+			chunked.update(A.get() + row, B.get() + row, h, N);
+		row += h;
+	}
+	if (chunked.result() != whole.result())
+		return std::unexpected{"dot depends on chunking"};
+
+	const T expect = fused_reduce<T, std::multiplies<>, std::plus<>, S>(A.get(), B.get(), T(0), M, N);
+	if (!approx_equal(whole.result(), expect, 1e-4, 1e-4))
+		return std::unexpected{"differs from fused_reduce"};
+
+	// squared distance
+	fused_reducer<T, std::minus<>, std::plus<>, S> diff;
+	diff.update(A[0], B[0], 7);
+	T expect_diff = 0;
+	for (size_t j = 0; j < 7; ++j)
+		expect_diff += A[0][j] - B[0][j];
+	if (!approx_equal(diff.result(), expect_diff, 1e-5, 1e-6))
+		return std::unexpected{"staged tail"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+thread_merge(void* instructions) 
+{
+	constexpr size_t M = 512, N = 33;
+
+	auto A = carray<T, 2, S::bytes>(M, N);
+	auto B = carray<T, 2, S::bytes>(M, N);
+	fill_rand<T>(A.get(), M, N);
+	fill_rand<T>(B.get(), M, N);
+
+	reducer<T, std::plus<>, S> sum;
+	fused_reducer<T, std::multiplies<>, std::plus<>, S> dot;
+
+	#pragma omp parallel
+	{
+		reducer<T, std::plus<>, S> local_sum;
+		fused_reducer<T, std::multiplies<>, std::plus<>, S> local_dot;
+
+		#pragma omp for schedule(static)
+		for (size_t i = 0; i < M; ++i)
+		{
+			local_sum.update(A.get() + i, 1, N);
+			local_dot.update(A.get() + i, B.get() + i, 1, N);
+		}
+
+		#pragma omp critical
+		{
+			sum.merge(local_sum);
+			dot.merge(local_dot);
+		}
+	}
+
+	if (sum.count() != M * N || dot.count() != M * N)
+		return std::unexpected{"merged count"};
+	if (!approx_equal(sum.result(), reduce<T, std::plus<>, S>(A.get(), T(0), M, N), 1e-4, 1e-4))
+		return std::unexpected{"merged sum"};
+	if (!approx_equal(dot.result(), fused_reduce<T, std::multiplies<>, std::plus<>, S>(A.get(), B.get(), T(0), M, N), 1e-4, 1e-4))
+		return std::unexpected{"merged dot"};
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+moments(void* instructions) 
+{
+	constexpr size_t M = 211, N = 23;
+
+	// A large offset makes the naive sum-of-squares variance lose most digits
+	auto A = carray<T, 2, S::bytes>(M, N);
+	std::mt19937 gen(3);
+	std::normal_distribution<double> d(1e4, 2.0);
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+			A[i][j] = T(d(gen));
+
+	double mean = 0, var = 0;
+	T lo = A[0][0], hi = A[0][0];
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			mean += A[i][j];
+			lo = std::min(lo, A[i][j]);
+			hi = std::max(hi, A[i][j]);
+		}
+	mean /= M * N;
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+			var += (A[i][j] - mean) * (A[i][j] - mean);
+	var /= M * N - 1;
+
+	moments_reducer<T, S> whole, first, second;
+	whole.update(A.get(), M, N);
+	first.update(A.get(), 100, N);
+	second.update(A[100], (M - 100) * N - 3);
+	second.update(A[M - 1] + N - 3, 3);
+	first.merge(second);
+
+	for (const auto* r : {&whole, &first})
+	{
+		if (r->count() != M * N)
+			return std::unexpected{"count"};
+		if (!approx_equal<double>(r->mean(), mean, 1e-6, 1e-6))
+			return std::unexpected{"mean"};
+		if (!approx_equal<double>(r->variance(1), var, 1e-3, 1e-6))
+			return std::unexpected{"variance"};
+		if (r->min() != lo || r->max() != hi)
+			return std::unexpected{"min/max"};
+	}
+
+	return 0;
+}
+
+int main(int argc, char* argv[]) 
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "reducer<double, plus>", &chunked_sum<double, AVX512>, nullptr);
+	heracles.add_labor(1, "reducer<float, plus, AVX>", &chunked_sum<float, AVX>, nullptr);
+	heracles.add_labor(2, "reducer<complex<float>, plus>", &chunked_sum<std::complex<float>, AVX512>, nullptr);
+	heracles.add_labor(3, "reducer<double, plus, NONE>", &chunked_sum<double, NONE>, nullptr);
+	heracles.add_labor(4, "reducer<double, multiplies, SSE>", &chunked_product<double, SSE>, nullptr);
+	heracles.add_labor(5, "reducer<complex<double>, multiplies>", &chunked_product<std::complex<double>, AVX512>, nullptr);
+	heracles.add_labor(6, "fused_reducer<double>", &streaming_dot<double, AVX512>, nullptr);
+	heracles.add_labor(7, "fused_reducer<float, SSE>", &streaming_dot<float, SSE>, nullptr);
+	heracles.add_labor(8, "fused_reducer<complex<double>, AVX>", &streaming_dot<std::complex<double>, AVX>, nullptr);
+	heracles.add_labor(9, "merge<double>", &thread_merge<double, AVX512>, nullptr);
+	heracles.add_labor(10, "merge<complex<float>, AVX>", &thread_merge<std::complex<float>, AVX>, nullptr);
+	heracles.add_labor(11, "moments_reducer<double>", &moments<double, AVX512>, nullptr);
+	heracles.add_labor(12, "moments_reducer<float, AVX>", &moments<float, AVX>, nullptr);
+	heracles.add_labor(13, "moments_reducer<double, NONE>", &moments<double, NONE>, nullptr);
+
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] reducer_test: " << e.what() << "\n";
+		return -1;
+	}
+	
+	return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * \file scan_test.cc
+ * \brief unit test for scan.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+#include "test_utils.h"
+#include "scan.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+// Products stay bounded when the factors are close to one
+template<typename T, typename O>
+void
+fill_scan_input(T** A, const size_t M, const size_t N)
+{
+	using real_t = typename base<T>::type;
+	std::mt19937 gen(11);
+	std::uniform_real_distribution<real_t> d(-1, 1);
+	const real_t spread = std::same_as<O, std::plus<>> ? 1 : 1e-3;
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			if constexpr (is_complex_v<T>)
+				A[i][j] = std::same_as<O, std::plus<>> ? T(d(gen), d(gen)) : T(1 + spread * d(gen), spread * d(gen));
+			else
+				A[i][j] = std::same_as<O, std::plus<>> ? T(d(gen)) : T(1 + spread * d(gen));
+		}
+}
+
+template<typename T>
+bool
+close(const T a, const T b)
+{
+	using real_t = typename base<T>::type;
+	const double tol = std::is_same_v<real_t, float> ? 2e-3 : 1e-9;
+	return std::abs(a - b) <= tol * std::max(1.0, double(std::abs(b)));
+}
+
+template<typename T, typename O, ScanMode Mode>
+T
+reference_step(T& carry, const T x)
+{
+	const T before = carry;
+	carry = O{}(carry, x);
+	return Mode == ScanMode::INCLUSIVE ? carry : before;
+}
+
+template<typename T, typename O, ScanMode Mode, typename S>
+std::expected<E, U> 
+flat_scan(void* instructions) 
+{
+	for (auto [M, N] : {std::pair<size_t, size_t>{1, 1}, {3, 7}, {61, 97}, {1000, 1003}})
+	{
+		auto A = carray<T, 2, S::bytes>(M, N);
+		auto B = carray<T, 2, S::bytes>(M, N);
+		fill_scan_input<T, O>(A.get(), M, N);
+
+		const T total = scan<T, O, Mode, S>(A.get(), B.get(), M, N);
+
+		T carry = seed_left_fold<T, O>();
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < N; ++j)
+				if (!close(B[i][j], reference_step<T, O, Mode>(carry, A[i][j])))
+					return std::unexpected{"scan element"};
+		if (!close(total, carry))
+			return std::unexpected{"scan total"};
+
+		// in place
+		scan<T, O, Mode, S>(A.get(), A.get(), M, N);
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < N; ++j)
+				if (A[i][j] != B[i][j])
+					return std::unexpected{"in place scan"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename O, ScanMode Mode, typename S>
+std::expected<E, U> 
+row_column_scan(void* instructions) 
+{
+	for (auto [M, N] : {std::pair<size_t, size_t>{1, 1}, {5, 3}, {67, 131}, {200, 64}})
+	{
+		auto A = carray<T, 2, S::bytes>(M, N);
+		auto R = carray<T, 2, S::bytes>(M, N);
+		auto C = carray<T, 2, S::bytes>(M, N);
+		fill_scan_input<T, O>(A.get(), M, N);
+
+		scan_rows<T, O, Mode, S>(A.get(), R.get(), M, N);
+		scan_columns<T, O, Mode, S>(A.get(), C.get(), M, N);
+
+		for (size_t i = 0; i < M; ++i)
+		{
+			T carry = seed_left_fold<T, O>();
+			for (size_t j = 0; j < N; ++j)
+				if (!close(R[i][j], reference_step<T, O, Mode>(carry, A[i][j])))
+					return std::unexpected{"scan_rows element"};
+		}
+
+		for (size_t j = 0; j < N; ++j)
+		{
+			T carry = seed_left_fold<T, O>();
+			for (size_t i = 0; i < M; ++i)
+				if (!close(C[i][j], reference_step<T, O, Mode>(carry, A[i][j])))
+					return std::unexpected{"scan_columns element"};
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char* argv[]) 
+{
+	using P = std::plus<>;
+	using X = std::multiplies<>;
+	constexpr auto I = ScanMode::INCLUSIVE;
+	constexpr auto Z = ScanMode::EXCLUSIVE;
+
+	oracle::Heracles<E, U> heracles{};
+	size_t n = 0;
+	heracles.add_labor(n++, "scan<float, plus>", &flat_scan<float, P, I, AVX512>, nullptr);
+	heracles.add_labor(n++, "scan<double, plus, exclusive>", &flat_scan<double, P, Z, AVX512>, nullptr);
+	heracles.add_labor(n++, "scan<float, multiplies, AVX>", &flat_scan<float, X, I, AVX>, nullptr);
+	heracles.add_labor(n++, "scan<double, plus, AVX, exclusive>", &flat_scan<double, P, Z, AVX>, nullptr);
+	heracles.add_labor(n++, "scan<float, plus, SSE, exclusive>", &flat_scan<float, P, Z, SSE>, nullptr);
+	heracles.add_labor(n++, "scan<double, multiplies, SSE>", &flat_scan<double, X, I, SSE>, nullptr);
+	heracles.add_labor(n++, "scan<complex<float>, plus>", &flat_scan<std::complex<float>, P, I, AVX512>, nullptr);
+	heracles.add_labor(n++, "scan<complex<float>, multiplies, AVX, exclusive>", &flat_scan<std::complex<float>, X, Z, AVX>, nullptr);
+	heracles.add_labor(n++, "scan<complex<double>, multiplies, exclusive>", &flat_scan<std::complex<double>, X, Z, AVX512>, nullptr);
+	heracles.add_labor(n++, "scan<complex<double>, plus, SSE>", &flat_scan<std::complex<double>, P, I, SSE>, nullptr);
+	heracles.add_labor(n++, "scan<double, plus, NONE>", &flat_scan<double, P, I, NONE>, nullptr);
+	heracles.add_labor(n++, "scan_rows/columns<float, plus>", &row_column_scan<float, P, I, AVX512>, nullptr);
+	heracles.add_labor(n++, "scan_rows/columns<double, multiplies, exclusive>", &row_column_scan<double, X, Z, AVX512>, nullptr);
+	heracles.add_labor(n++, "scan_rows/columns<float, plus, AVX, exclusive>", &row_column_scan<float, P, Z, AVX>, nullptr);
+	heracles.add_labor(n++, "scan_rows/columns<complex<float>, multiplies, SSE>", &row_column_scan<std::complex<float>, X, I, SSE>, nullptr);
+	heracles.add_labor(n++, "scan_rows/columns<complex<double>, plus, AVX>", &row_column_scan<std::complex<double>, P, I, AVX>, nullptr);
+	heracles.add_labor(n++, "scan_rows/columns<float, plus, NONE, exclusive>", &row_column_scan<float, P, Z, NONE>, nullptr);
+
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] scan_test: " << e.what() << "\n";
+		return -1;
+	}
+	
+	return 0;
+}
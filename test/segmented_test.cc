@@ -0,0 +1,273 @@
+/**
+ * \file segmented_test.cc
+ * \brief unit test for segmented.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include "test_utils.h"
+#include "segmented.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+/** \brief Offsets for count segments of length 0–200, with a few empty and one long segment */
+static std::vector<size_t>
+make_offsets(const size_t count, const size_t start, const unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<size_t> length(3, 200);
+	std::bernoulli_distribution empty(0.05);
+
+	std::vector<size_t> offsets{start};
+	for (size_t s = 0; s < count; ++s)
+	{
+		size_t n = empty(gen) ? 0 : length(gen);
+		if (s == count / 3)
+			n = 100000;
+		offsets.push_back(offsets.back() + n);
+	}
+	return offsets;
+}
+
+/** \brief Offsets for count segments of length 0–longest, mostly shorter than two registers */
+static std::vector<size_t>
+make_short_offsets(const size_t count, const size_t longest, const unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<size_t> length(0, longest);
+
+	std::vector<size_t> offsets{0};
+	for (size_t s = 0; s < count; ++s)
+		offsets.push_back(offsets.back() + length(gen));
+	return offsets;
+}
+
+/** \brief Random values; multiplies gets values near one so products stay finite */
+template<typename T, typename O>
+static std::vector<T>
+make_values(const size_t n, const unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::vector<T> a(n);
+	for (auto& x : a)
+	{
+		if constexpr (std::is_integral_v<T>)
+			x = std::same_as<O, std::multiplies<>> ? T(gen() % 2 ? 1 : -1) : T(int(gen() % 200) - 100) | T(1);	// odd, never zero
+		else
+		{
+			std::uniform_real_distribution<typename base<T>::type> dist(-1, 1);
+			const auto scale = std::same_as<O, std::multiplies<>> ? typename base<T>::type(1e-3) : 1;
+			if constexpr (is_complex_v<T>)
+				x = T(std::same_as<O, std::multiplies<>> ? 1 : 0, 0) + T(dist(gen), dist(gen)) * scale;
+			else
+				x = (std::same_as<O, std::multiplies<>> ? 1 : 0) + dist(gen) * scale;
+		}
+	}
+	return a;
+}
+
+template<typename T>
+static bool
+close(const T a, const T b, const double scale)
+{
+	if constexpr (std::is_integral_v<T>)
+		return a == b;
+	else
+	{
+		const double tol = std::is_same_v<typename base<T>::type, float> ? 1e-4 : 1e-11;
+		return std::abs(a - b) <= tol * std::max(1.0, scale);
+	}
+}
+
+template<typename T, typename O, typename S>
+std::expected<E, U>
+segment_reduce(void* instructions)
+{
+	constexpr size_t count = 20000, start = 7;
+	const auto offsets = make_offsets(count, start, 1);
+	const auto A = make_values<T, O>(offsets.back(), 2);
+	const T seed = std::same_as<O, std::plus<>> ? T(3) : T(1);
+
+	std::vector<T> out(count);
+	segmented_reduce<T, O, S>(A.data(), offsets.data(), count, out.data(), seed);
+
+	for (size_t s = 0; s < count; ++s)
+	{
+		T r = seed;
+		double scale = 0;
+		for (size_t k = offsets[s]; k < offsets[s + 1]; ++k)
+		{
+			r = O{}(r, A[k]);
+			scale += double(std::abs(A[k]));
+		}
+		if (!close(out[s], r, scale))
+			return std::unexpected{"segment differs from the serial fold"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename Un, typename R, typename S>
+std::expected<E, U>
+segment_fused_reduce(void* instructions)
+{
+	constexpr size_t count = 15000;
+	const auto offsets = make_offsets(count, 0, 3);
+	const auto A = make_values<T, R>(offsets.back(), 4);
+	const auto B = make_values<T, R>(offsets.back(), 5);
+
+	std::vector<T> out(count);
+	segmented_fused_reduce<T, Un, R, S>(A.data(), B.data(), offsets.data(), count, out.data());
+
+	for (size_t s = 0; s < count; ++s)
+	{
+		T r = seed_left_fold<T, R>();
+		double scale = 0;
+		for (size_t k = offsets[s]; k < offsets[s + 1]; ++k)
+		{
+			r = R{}(r, Un{}(A[k], B[k]));
+			scale += double(std::abs(Un{}(A[k], B[k])));
+		}
+		if (!close(out[s], r, scale))
+			return std::unexpected{"segment differs from the serial fold"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename O, typename S>
+std::expected<E, U>
+short_segment_reduce(void* instructions)
+{
+	// Lengths 0 to 2W + 3: full and partial sets of lanes, plus a few segments folded in place
+	constexpr size_t count = 6000;
+	const auto offsets = make_short_offsets(count, 2 * S::template elements<T>() + 3, 6);
+	const auto A = make_values<T, O>(offsets.back(), 7);
+	const T seed = std::same_as<O, std::plus<>> ? T(3) : T(1);
+
+	std::vector<T> out(count);
+	segmented_reduce<T, O, S>(A.data(), offsets.data(), count, out.data(), seed);
+
+	for (size_t s = 0; s < count; ++s)
+	{
+		T r = seed;
+		double scale = 0;
+		for (size_t k = offsets[s]; k < offsets[s + 1]; ++k)
+		{
+			r = O{}(r, A[k]);
+			scale += double(std::abs(A[k]));
+		}
+		if (!close(out[s], r, scale))
+			return std::unexpected{"short segment differs from the serial fold"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename Un, typename R, typename S>
+std::expected<E, U>
+short_segment_fused_reduce(void* instructions)
+{
+	constexpr size_t count = 6000;
+	const auto offsets = make_short_offsets(count, 2 * S::template elements<T>() + 3, 8);
+	const auto A = make_values<T, R>(offsets.back(), 9);
+	const auto B = make_values<T, R>(offsets.back(), 10);
+
+	std::vector<T> out(count);
+	segmented_fused_reduce<T, Un, R, S>(A.data(), B.data(), offsets.data(), count, out.data());
+
+	for (size_t s = 0; s < count; ++s)
+	{
+		T r = seed_left_fold<T, R>();
+		double scale = 0;
+		for (size_t k = offsets[s]; k < offsets[s + 1]; ++k)
+		{
+			r = R{}(r, Un{}(A[k], B[k]));
+			scale += double(std::abs(Un{}(A[k], B[k])));
+		}
+		if (!close(out[s], r, scale))
+			return std::unexpected{"short segment differs from the serial fold"};
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U>
+edge_cases(void* instructions)
+{
+	// Every thread boundary inside one segment, empty segments at both ends
+	const std::vector<size_t> offsets{0, 0, 200000, 200000, 200001, 200001};
+	std::vector<T> A(200001, T(1));
+	std::vector<T> out(5);
+	segmented_reduce<T, std::plus<>, S>(A.data(), offsets.data(), 5, out.data());
+	if (out[0] != T(0) || out[1] != T(200000) || out[2] != T(0) || out[3] != T(1) || out[4] != T(0))
+		return std::unexpected{"boundary segments"};
+
+	// All segments empty
+	const std::vector<size_t> none{4, 4, 4};
+	segmented_reduce<T, std::plus<>, S>(A.data(), none.data(), 2, out.data(), T(9));
+	if (out[0] != T(9) || out[1] != T(9))
+		return std::unexpected{"empty segments take the seed"};
+
+	try
+	{
+		const std::vector<size_t> bad{0, 5, 3};
+		segmented_reduce<T, std::plus<>, S>(A.data(), bad.data(), 2, out.data());
+		return std::unexpected{"decreasing offsets accepted"};
+	}
+	catch (const std::invalid_argument&) {}
+
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "segmented_reduce<double, +>", &segment_reduce<double, std::plus<>, AVX512>, nullptr);
+	heracles.add_labor(1, "segmented_reduce<float, +, AVX>", &segment_reduce<float, std::plus<>, AVX>, nullptr);
+	heracles.add_labor(2, "segmented_reduce<double, *, SSE>", &segment_reduce<double, std::multiplies<>, SSE>, nullptr);
+	heracles.add_labor(3, "segmented_reduce<complex<double>, +>", &segment_reduce<std::complex<double>, std::plus<>, AVX512>, nullptr);
+	heracles.add_labor(4, "segmented_reduce<complex<float>, *, AVX>", &segment_reduce<std::complex<float>, std::multiplies<>, AVX>, nullptr);
+	heracles.add_labor(5, "segmented_reduce<int32_t, +>", &segment_reduce<int32_t, std::plus<>, AVX512>, nullptr);
+	heracles.add_labor(6, "segmented_reduce<int64_t, *, AVX>", &segment_reduce<int64_t, std::multiplies<>, AVX>, nullptr);
+	heracles.add_labor(7, "segmented_reduce<double, +, NONE>", &segment_reduce<double, std::plus<>, NONE>, nullptr);
+	heracles.add_labor(8, "segmented_fused_reduce<double, *, +>", &segment_fused_reduce<double, std::multiplies<>, std::plus<>, AVX512>, nullptr);
+	heracles.add_labor(9, "segmented_fused_reduce<float, -, +, SSE>", &segment_fused_reduce<float, std::minus<>, std::plus<>, SSE>, nullptr);
+	heracles.add_labor(10, "segmented_fused_reduce<complex<double>, *, +>", &segment_fused_reduce<std::complex<double>, std::multiplies<>, std::plus<>, AVX512>, nullptr);
+	heracles.add_labor(11, "segmented_fused_reduce<int32_t, /, +, AVX>", &segment_fused_reduce<int32_t, std::divides<>, std::plus<>, AVX>, nullptr);
+	heracles.add_labor(12, "segmented_reduce<double> edges", &edge_cases<double, AVX512>, nullptr);
+	heracles.add_labor(13, "segmented_reduce<int32_t, SSE> edges", &edge_cases<int32_t, SSE>, nullptr);
+	heracles.add_labor(14, "segmented_reduce<double, +> short", &short_segment_reduce<double, std::plus<>, AVX512>, nullptr);
+	heracles.add_labor(15, "segmented_reduce<float, *, AVX> short", &short_segment_reduce<float, std::multiplies<>, AVX>, nullptr);
+	heracles.add_labor(16, "segmented_reduce<int16_t, +, AVX512> short", &short_segment_reduce<int16_t, std::plus<>, AVX512>, nullptr);
+	heracles.add_labor(17, "segmented_reduce<complex<float>, *, SSE> short", &short_segment_reduce<std::complex<float>, std::multiplies<>, SSE>, nullptr);
+	heracles.add_labor(18, "segmented_fused_reduce<double, *, +> short", &short_segment_fused_reduce<double, std::multiplies<>, std::plus<>, AVX512>, nullptr);
+	heracles.add_labor(19, "segmented_fused_reduce<float, /, *, AVX> short", &short_segment_fused_reduce<float, std::divides<>, std::multiplies<>, AVX>, nullptr);
+	heracles.add_labor(20, "segmented_fused_reduce<complex<double>, -, +> short", &short_segment_fused_reduce<std::complex<double>, std::minus<>, std::plus<>, AVX512>, nullptr);
+	heracles.add_labor(21, "segmented_fused_reduce<int32_t, *, +, SSE> short", &short_segment_fused_reduce<int32_t, std::multiplies<>, std::plus<>, SSE>, nullptr);
+
+	try
+	{
+		heracles.perform_labors();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "[EXCEPT] segmented_test: " << e.what() << "\n";
+		return -1;
+	}
+
+	return 0;
+}
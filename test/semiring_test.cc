@@ -0,0 +1,149 @@
+/**
+ * \file semiring_test.cc
+ * \brief unit test for semiring.h
+ * \author cpapakonstantinou
+ * \date 2025
+ */
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+#include "test_utils.h"
+#include "broadcast.h"
+#include "multiply.h"
+#include "carray.h"
+#include "oracle.h"
+#include "heracles.h"
+
+using namespace damm;
+using E = int;
+using U = std::string_view;
+
+int oracle::log_level = LOG_INFO;
+bool oracle::use_syslog = false;
+
+template<typename SR, typename T>
+void
+fill_operand(T** A, const size_t M, const size_t N, const unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<T> d(0, 4);
+	for (size_t i = 0; i < M; ++i)
+		for (size_t j = 0; j < N; ++j)
+		{
+			if constexpr (std::same_as<SR, or_and>)
+				A[i][j] = d(gen) < 1 ? T(1) : T(0);
+			else if constexpr (std::same_as<SR, min_plus> || std::same_as<SR, max_plus>)
+				A[i][j] = d(gen) < 0.4 ? SR::template zero<T>() : d(gen);  // missing edges
+			else
+				A[i][j] = d(gen);
+		}
+}
+
+template<typename SR, typename T, typename S>
+std::expected<E, U> 
+semiring_product(void* instructions) 
+{
+	for (auto [M, N, P] : {std::tuple<size_t, size_t, size_t>{64, 64, 64}, {37, 53, 29}, {5, 200, 3}, {130, 7, 67}, {16, 40000, 24}})
+	{
+		auto A = carray<T, 2, S::bytes>(M, N);
+		auto B = carray<T, 2, S::bytes>(N, P);
+		auto C = carray<T, 2, S::bytes>(M, P);
+		auto R = carray<T, 2, S::bytes>(M, P);
+		fill_operand<SR, T>(A.get(), M, N, 1);
+		fill_operand<SR, T>(B.get(), N, P, 2);
+		fill_operand<SR, T>(C.get(), M, P, 3);
+
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < P; ++j)
+			{
+				T r = C[i][j];
+				for (size_t k = 0; k < N; ++k)
+					r = SR::add(r, SR::mul(A[i][k], B[k][j]));
+				R[i][j] = r;
+			}
+
+		semiring_multiply<SR, T, S>(A.get(), B.get(), C.get(), M, N, P);
+
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < P; ++j)
+			{
+				// min/max select an operand exactly, only the ⊗ rounding can differ
+				const bool inf = std::isinf(R[i][j]) || std::isinf(C[i][j]);
+				if (inf ? C[i][j] != R[i][j] : std::abs(C[i][j] - R[i][j]) > 1e-4 * std::max(T(1), std::abs(R[i][j])))
+					return std::unexpected{"semiring product differs from reference"};
+			}
+	}
+
+	return 0;
+}
+
+template<typename T, typename S>
+std::expected<E, U> 
+shortest_paths(void* instructions) 
+{
+	constexpr size_t n = 150;
+	constexpr T inf = std::numeric_limits<T>::infinity();
+
+	auto D = carray<T, 2, S::bytes>(n, n);
+	auto F = carray<T, 2, S::bytes>(n, n);
+	auto X = carray<T, 2, S::bytes>(n, n);
+
+	std::mt19937 gen(7);
+	std::uniform_real_distribution<T> w(1, 10);
+	std::bernoulli_distribution edge(0.03);
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+			D[i][j] = F[i][j] = i == j ? T(0) : edge(gen) ? w(gen) : inf;
+
+	// Floyd-Warshall reference
+	for (size_t k = 0; k < n; ++k)
+		for (size_t i = 0; i < n; ++i)
+			for (size_t j = 0; j < n; ++j)
+				F[i][j] = std::min(F[i][j], F[i][k] + F[k][j]);
+
+	// Repeated squaring: path lengths covered double each product
+	for (size_t len = 1; len < n - 1; len *= 2)
+	{
+		for (size_t i = 0; i < n; ++i)
+			std::copy(D[i], D[i] + n, X[i]);
+		semiring_multiply<min_plus, T, S>(X.get(), X.get(), D.get(), n, n, n);
+	}
+
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+			if (std::isinf(F[i][j]) ? D[i][j] != F[i][j] : std::abs(D[i][j] - F[i][j]) > 1e-3)
+				return std::unexpected{"min-plus squaring differs from Floyd-Warshall"};
+
+	return 0;
+}
+
+int main(int argc, char* argv[]) 
+{
+
+	oracle::Heracles<E, U> heracles{};
+	heracles.add_labor(0, "plus_times<double>", &semiring_product<plus_times, double, AVX512>, nullptr);
+	heracles.add_labor(1, "min_plus<float>", &semiring_product<min_plus, float, AVX512>, nullptr);
+	heracles.add_labor(2, "min_plus<double, AVX>", &semiring_product<min_plus, double, AVX>, nullptr);
+	heracles.add_labor(3, "min_plus<float, NONE>", &semiring_product<min_plus, float, NONE>, nullptr);
+	heracles.add_labor(4, "max_plus<double>", &semiring_product<max_plus, double, AVX512>, nullptr);
+	heracles.add_labor(5, "max_plus<float, SSE>", &semiring_product<max_plus, float, SSE>, nullptr);
+	heracles.add_labor(6, "max_times<float>", &semiring_product<max_times, float, AVX512>, nullptr);
+	heracles.add_labor(7, "max_times<double, AVX>", &semiring_product<max_times, double, AVX>, nullptr);
+	heracles.add_labor(8, "or_and<float>", &semiring_product<or_and, float, AVX512>, nullptr);
+	heracles.add_labor(9, "or_and<double, SSE>", &semiring_product<or_and, double, SSE>, nullptr);
+	heracles.add_labor(10, "all pairs shortest paths<float>", &shortest_paths<float, AVX512>, nullptr);
+	heracles.add_labor(11, "all pairs shortest paths<double, AVX>", &shortest_paths<double, AVX>, nullptr);
+
+	try 
+	{
+		heracles.perform_labors();
+	} 
+	catch (const std::exception& e) 
+	{
+		std::cerr << "[EXCEPT] semiring_test: " << e.what() << "\n";
+		return -1;
+	}
+	
+	return 0;
+}
@@ -266,6 +266,15 @@ void fill_rand(T** A, const size_t M, const size_t N, unsigned seed = 42)
 			for (size_t j = 0; j < N; ++j) 
 				A[i][j] = std::complex<double>(dist(rng), dist(rng));
 	}
+	else if constexpr (std::is_integral_v<T>) 
+	{
+		// wide enough for 64-bit products to carry into the high words
+		const T bound = sizeof(T) >= 8 ? T(3000000000) : T(1000);
+		std::uniform_int_distribution<T> dist(-bound, bound);
+		for (size_t i = 0; i < M; ++i) 
+			for (size_t j = 0; j < N; ++j) 
+				A[i][j] = dist(rng);
+	}
 }
 
 /**
@@ -39,6 +39,47 @@ void test_all_kernels(const size_t M, const size_t N)
 	
 }
 
+template<typename T, typename S>
+void test_aspect_ratio(const size_t M, const size_t N)
+{
+	carray<T, 2, S::bytes> A(M, N);
+	carray<T, 2, S::bytes> B_ref(N, M);
+	carray<T, 2, S::bytes> B_test(N, M);
+	
+	fill_rand<T>(A.get(), M, N);
+	transpose_naive<T>(A.get(), B_ref.get(), M, N);
+
+	// A transpose reads and writes every element once
+	double blocked = benchmark([&]() { transpose<T, S>(A.get(), B_test.get(), M, N); });
+	bool blocked_verified = is_same<T>("", B_ref.get(), B_test.get(), N, M, false);
+
+	double recursive = benchmark([&]() { cache_oblivious::transpose<T, S>(A.get(), B_test.get(), M, N); });
+	bool recursive_verified = is_same<T>("", B_ref.get(), B_test.get(), N, M, false);
+
+	std::cout << std::format("{:<16} {:<12.3f} {:<12.3f} {:<12.3f} {:<12.3f} {:<8}\n",
+		std::to_string(M) + "x" + std::to_string(N),
+		blocked, compute_bandwidth_w<T>(2 * M * N, blocked),
+		recursive, compute_bandwidth_w<T>(2 * M * N, recursive),
+		(blocked_verified && recursive_verified) ? "PASS" : "FAIL");
+}
+
+template<typename T, typename S>
+void test_all_aspect_ratios()
+{
+	static constexpr size_t shapes[][2] = {
+		{10, 1000000}, {1000000, 10}, {64, 65536}, {65536, 64}, 
+		{1000, 10000}, {4096, 4096}, {4000, 4000}};
+
+	std::cout << "\nTranspose blocked vs cache-oblivious\n";
+	std::cout << "Type: " << typeid(T).name() << " | SIMD_WIDTH: " << S::template elements<T>() << "\n";
+	std::cout << std::format("{:<16} {:<12} {:<12} {:<12} {:<12} {:<8}\n", 
+		"Shape", "Blocked(ms)", "BW (GB/s)", "Recur(ms)", "BW (GB/s)", "Verify");
+	std::cout << std::string(76, '-') << "\n";
+
+	for (const auto& shape : shapes)
+		test_aspect_ratio<T, S>(shape[0], shape[1]);
+}
+
 int main(int argc, char* argv[])
 {
 	static constexpr size_t M = 1024;
@@ -51,6 +92,9 @@ int main(int argc, char* argv[])
 		test_all_kernels<double, AVX512>(M, N);
 		test_all_kernels<std::complex<float>, AVX512>(M, N);
 		test_all_kernels<std::complex<double>, AVX512>(M, N);
+
+		test_all_aspect_ratios<float, AVX512>();
+		test_all_aspect_ratios<double, AVX512>();
 	}
 	catch(const std::exception& e)
 	{
@@ -88,6 +88,156 @@ test_all_ops(const size_t M, const size_t N)
 	return ret;
 }
 
+template<typename T>
+bool
+test_cache_oblivious(const size_t M, const size_t N)
+{
+	static constexpr size_t ALIGN = 64;
+	bool ret = true;
+
+	carray<T, 2, ALIGN> A(M, N);
+	carray<T, 2, ALIGN> B_none(N, M);
+	carray<T, 2, ALIGN> B_sse(N, M);
+	carray<T, 2, ALIGN> B_avx(N, M);
+	carray<T, 2, ALIGN> B_avx512(N, M);
+
+	fill_rand<T>(A.get(), M , N);
+
+	cache_oblivious::transpose<T, NONE>(A.get(), B_none.get(), M, N);
+	cache_oblivious::transpose<T, SSE>(A.get(), B_sse.get(), M, N);
+	cache_oblivious::transpose<T, AVX>(A.get(), B_avx.get(), M, N);
+	cache_oblivious::transpose<T, AVX512>(A.get(), B_avx512.get(), M, N);
+
+	ret &= is_transposed<T>(std::format("cache_oblivious::transpose<{},{}>", typeid(T).name(), "NONE").c_str(), A.get(), B_none.get(), M, N);
+	ret &= is_transposed<T>(std::format("cache_oblivious::transpose<{},{}>", typeid(T).name(), "SSE").c_str(), A.get(), B_sse.get(), M, N);
+	ret &= is_transposed<T>(std::format("cache_oblivious::transpose<{},{}>", typeid(T).name(), "AVX").c_str(), A.get(), B_avx.get(), M, N);
+	ret &= is_transposed<T>(std::format("cache_oblivious::transpose<{},{}>", typeid(T).name(), "AVX512").c_str(), A.get(), B_avx512.get(), M, N);
+	return ret;
+}
+
+template<typename T, typename S>
+bool
+test_cache_oblivious_conjugate(const size_t M, const size_t N)
+{
+	static constexpr size_t ALIGN = 64;
+
+	carray<T, 2, ALIGN> A(M, N);
+	carray<T, 2, ALIGN> B_ref(N, M);
+	carray<T, 2, ALIGN> B(N, M);
+
+	fill_rand<T>(A.get(), M , N);
+
+	conjugate_transpose<T, S>(A.get(), B_ref.get(), M, N);
+	cache_oblivious::conjugate_transpose<T, S>(A.get(), B.get(), M, N);
+
+	const std::string name = std::format("cache_oblivious::conjugate_transpose<{},{}>", typeid(T).name(), typeid(S).name());
+	for (size_t i = 0; i < N; i++)
+	{
+		for (size_t j = 0; j < M; j++)
+		{
+			if (B[i][j] != B_ref[i][j])
+			{
+				printf("[%s] %s:\n", "FAIL", name.c_str());
+				return false;
+			}
+		}
+	}
+	printf("[ %s ] %s:\n", "OK", name.c_str());
+	return true;
+}
+
+template<typename T>
+bool
+test_cache_oblivious_conjugate(const size_t M, const size_t N)
+{
+	bool ret = true;
+	ret &= test_cache_oblivious_conjugate<T, NONE>(M, N);
+	ret &= test_cache_oblivious_conjugate<T, SSE>(M, N);
+	ret &= test_cache_oblivious_conjugate<T, AVX>(M, N);
+	ret &= test_cache_oblivious_conjugate<T, AVX512>(M, N);
+	return ret;
+}
+
+template<typename T, typename S>
+bool
+is_fused_transposed(const char* name, T** A, T** B0, T** B, const size_t M, const size_t N, 
+	const T alpha, const T beta, const bool conj)
+{
+	using R = typename base<T>::type;
+	constexpr R tolerance = std::is_same_v<R, float> ? 1e-5f : 1e-12;
+
+	for (size_t i = 0; i < M; i++)
+	{
+		for (size_t j = 0; j < N; j++)
+		{
+			const T a = conj ? conjugate(A[i][j]) : A[i][j];
+			const T expected = alpha * a + beta * B0[j][i];
+			if (std::abs(B[j][i] - expected) > tolerance * (R(1) + std::abs(expected)))
+			{
+				printf("[%s] %s:\n", "FAIL", name);
+				return false;
+			}
+		}
+	}
+	printf("[ %s ] %s:\n", "OK", name);
+	return true;
+}
+
+template<typename T, typename S>
+bool
+test_fused_ops(const size_t M, const size_t N)
+{
+	bool ret = true;
+
+	carray<T, 2, S::bytes> A(M, N);
+	carray<T, 2, S::bytes> B0(N, M);
+	carray<T, 2, S::bytes> B(N, M);
+
+	fill_rand<T>(A.get(), M, N);
+	fill_rand<T>(B0.get(), N, M);
+
+	const T alpha = T(0.5);
+	const T beta = T(-1.5);
+
+	// B = Aᴴ
+	conjugate_transpose<T, S>(A.get(), B.get(), M, N);
+	ret &= is_fused_transposed<T, S>(std::format("conjugate_transpose<{},{}>", typeid(T).name(), typeid(S).name()).c_str(), 
+		A.get(), B0.get(), B.get(), M, N, T(1), T(0), true);
+
+	// B = alpha * Aᵀ, prior B not read
+	transpose<T, S>(A.get(), B.get(), M, N, alpha, T(0));
+	ret &= is_fused_transposed<T, S>(std::format("transpose<{},{}>(alpha)", typeid(T).name(), typeid(S).name()).c_str(), 
+		A.get(), B0.get(), B.get(), M, N, alpha, T(0), false);
+
+	// B = alpha * Aᵀ + beta * B
+	for (size_t i = 0; i < N; i++)
+		std::copy(B0[i], B0[i] + M, B[i]);
+	transpose<T, S>(A.get(), B.get(), M, N, alpha, beta);
+	ret &= is_fused_transposed<T, S>(std::format("transpose<{},{}>(alpha, beta)", typeid(T).name(), typeid(S).name()).c_str(), 
+		A.get(), B0.get(), B.get(), M, N, alpha, beta, false);
+
+	// B = alpha * Aᴴ + beta * B
+	for (size_t i = 0; i < N; i++)
+		std::copy(B0[i], B0[i] + M, B[i]);
+	conjugate_transpose<T, S>(A.get(), B.get(), M, N, alpha, beta);
+	ret &= is_fused_transposed<T, S>(std::format("conjugate_transpose<{},{}>(alpha, beta)", typeid(T).name(), typeid(S).name()).c_str(), 
+		A.get(), B0.get(), B.get(), M, N, alpha, beta, true);
+
+	return ret;
+}
+
+template<typename T>
+bool
+test_fused_ops(const size_t M, const size_t N)
+{
+	bool ret = true;
+	ret &= test_fused_ops<T, NONE>(M, N);
+	ret &= test_fused_ops<T, SSE>(M, N);
+	ret &= test_fused_ops<T, AVX>(M, N);
+	ret &= test_fused_ops<T, AVX512>(M, N);
+	return ret;
+}
+
 int main() 
 {
 
@@ -109,6 +259,38 @@ int main()
 				std::cout << report << std::endl;
 			}
 		}
+
+		// Fused conjugate, scale and accumulate, including dimensions off the tile size
+		static constexpr size_t F[][2] = {{16, 16}, {64, 32}, {37, 19}, {5, 70}};
+		for(const auto& f : F)
+		{
+			bool fused_ops = true;
+			fused_ops &= test_fused_ops<float>(f[0], f[1]);
+			fused_ops &= test_fused_ops<double>(f[0], f[1]);
+			fused_ops &= test_fused_ops<std::complex<float>>(f[0], f[1]);
+			fused_ops &= test_fused_ops<std::complex<double>>(f[0], f[1]);
+			std::string report = std::format("[{}] fused transpose: M={}, N={}", ((fused_ops) ? "OK" : "FAIL"), f[0], f[1]);
+			std::cout << report << std::endl;
+		}
+
+		// Cache-oblivious recursion on square, thin, tall and odd shapes
+		static constexpr size_t C[][2] = {{1024, 1024}, {3, 5000}, {5000, 3}, {333, 777}, {37, 19}};
+		for(const auto& c : C)
+		{
+			bool co_ops = true;
+			co_ops &= test_cache_oblivious<float>(c[0], c[1]);
+			co_ops &= test_cache_oblivious<double>(c[0], c[1]);
+			co_ops &= test_cache_oblivious<std::complex<float>>(c[0], c[1]);
+			co_ops &= test_cache_oblivious<std::complex<double>>(c[0], c[1]);
+			std::string report = std::format("[{}] cache_oblivious::transpose: M={}, N={}", ((co_ops) ? "OK" : "FAIL"), c[0], c[1]);
+			std::cout << report << std::endl;
+
+			bool co_conj_ops = true;
+			co_conj_ops &= test_cache_oblivious_conjugate<std::complex<float>>(c[0], c[1]);
+			co_conj_ops &= test_cache_oblivious_conjugate<std::complex<double>>(c[0], c[1]);
+			report = std::format("[{}] cache_oblivious::conjugate_transpose: M={}, N={}", ((co_conj_ops) ? "OK" : "FAIL"), c[0], c[1]);
+			std::cout << report << std::endl;
+		}
 	}
 	catch(const std::exception& e)
 	{
@@ -30,6 +30,13 @@ void test_matrix_op(const char* name, const size_t M, const size_t N)
 	std::fill(A.begin(), A.end(), 3.0);
 	std::fill(B.begin(), B.end(), 2.0);
 
+	if constexpr (std::is_integral_v<T>)
+	{
+		fill_rand<T>(A.get(), M, N, 1);
+		fill_rand<T>(B.get(), M, N, 2);
+		std::replace(B.begin(), B.end(), T(0), T(1));
+	}
+
 	// Reference naive implementation
 	union_naive_matrix<T, O>(A.get(), B.get(), C_ref.get(), M, N);
 	
@@ -63,6 +70,9 @@ void test_scalar_op(const char* name, const size_t M, const size_t N)
 
 	std::fill(A.begin(), A.end(), 4.0);
 
+	if constexpr (std::is_integral_v<T>)
+		fill_rand<T>(A.get(), M, N, 1);
+
 	// Reference naive implementation
 	union_naive_scalar<T, O>(A.get(), scalar_val, C_ref.get(), M, N);
 	
@@ -92,6 +102,13 @@ void test_op(const char* name, const size_t M, const size_t N)
 	test_matrix_op<std::complex<float>, O>(name, M, N);
 	test_scalar_op<std::complex<double>, O>(name, M, N);
 	test_scalar_op<std::complex<float>, O>(name, M, N);
+
+	test_matrix_op<int64_t, O>(name, M, N);
+	test_matrix_op<int32_t, O>(name, M, N);
+	test_matrix_op<int16_t, O>(name, M, N);
+	test_scalar_op<int64_t, O>(name, M, N);
+	test_scalar_op<int32_t, O>(name, M, N);
+	test_scalar_op<int16_t, O>(name, M, N);
 }
 
 int main(int argc, char* argv[]) 